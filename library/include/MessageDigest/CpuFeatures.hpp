@@ -0,0 +1,56 @@
+/**
+ * @file CpuFeatures.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigest_CpuFeatures_INCLUDED
+#define MessageDigest_CpuFeatures_INCLUDED
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define MESSAGEDIGEST_X86 1
+#endif
+
+// enable instruction set extensions for a single function,
+// so the library can be built without global -m flags
+#if defined(__GNUC__) || defined(__clang__)
+#define MESSAGEDIGEST_TARGET(isa) __attribute__((target(isa)))
+#else
+#define MESSAGEDIGEST_TARGET(isa)
+#endif
+
+// keep a function out of its callers
+#if defined(__GNUC__) || defined(__clang__)
+#define MESSAGEDIGEST_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define MESSAGEDIGEST_NOINLINE __declspec(noinline)
+#else
+#define MESSAGEDIGEST_NOINLINE
+#endif
+
+// copy a function into every caller, e.g. to build it for a larger instruction set
+#if defined(__GNUC__) || defined(__clang__)
+#define MESSAGEDIGEST_ALWAYS_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define MESSAGEDIGEST_ALWAYS_INLINE __forceinline
+#else
+#define MESSAGEDIGEST_ALWAYS_INLINE inline
+#endif
+
+/**
+ * @brief Runtime detection of the instruction set extensions used by
+ * the accelerated kernels. The CPU is queried only once per process.
+ */
+class CpuFeatures {
+public:
+  static bool hasSSSE3();
+  static bool hasSSE41();
+  static bool hasSSE42();
+  static bool hasPCLMUL();
+  static bool hasSHA();
+  static bool hasAVX2();
+  static bool hasAVX512F();
+};
+
+#endif //MessageDigest_CpuFeatures_INCLUDED
@@ -18,31 +18,101 @@
 
 typedef std::unique_ptr<MessageDigestImpl> MessageDigestImplPtr;
 typedef std::function<std::unique_ptr<MessageDigestImpl>(void)> MessageDigestImplCreatorFunc;
-typedef std::map<std::string,MessageDigestImplCreatorFunc> MessageDigestImplMap;
+typedef std::function<bool(void)> MessageDigestSupportedFunc;
+
+/// one implementation of an algorithm, e.g. a kernel for an instruction set
+struct MessageDigestVariant {
+	std::string name;
+	/// higher ranks are preferred
+	int rank;
+	/// false if the CPU lacks the required instructions
+	MessageDigestSupportedFunc isSupported;
+	MessageDigestImplCreatorFunc create;
+};
+
+/// variants of each algorithm, ordered by rank
+typedef std::map<std::string,std::vector<MessageDigestVariant>> MessageDigestVariantMap;
 
 class MessageDigest {
 public:
 	~MessageDigest() = default;
 
+	/**
+	 * @brief Create an instance of the best variant supported by this CPU
+	 *
+	 * A variant forced by setPreferredVariant() or by the environment
+	 * variable MESSAGEDIGEST_VARIANT, e.g. "SHA256=generic,CRC32=pclmul",
+	 * is used instead.
+	 * @return nullptr for unknown algorithms or unsupported forced variants
+	 */
 	static std::unique_ptr<MessageDigest> createInstance(const std::string& algorithm);
+	/// create an instance of a certain variant, an empty name selects the best
+	static std::unique_ptr<MessageDigest> createInstance(const std::string& algorithm,
+							     const std::string& variant);
+	/// register an implementation as variant "generic"
 	static void registerAlgorithm(const std::string& name,
 				      MessageDigestImplCreatorFunc createFunc);
+	static void registerVariant(const std::string& algorithm,
+				    const std::string& variant, int rank,
+				    MessageDigestSupportedFunc supportedFunc,
+				    MessageDigestImplCreatorFunc createFunc);
 	static std::vector<std::string> getAlgorithms();
+	/// names of the variants supported by this CPU, best first
+	static std::vector<std::string> getVariants(const std::string& algorithm);
+	/**
+	 * @brief Force a variant for createInstance(), takes precedence over the environment
+	 * @param variant empty to select the best variant again
+	 * @return false if the variant is unknown or not supported by this CPU
+	 */
+	static bool setPreferredVariant(const std::string& algorithm, const std::string& variant);
 
 	std::string digest();
+	/// write the binary digest to buffer, which holds at least getDigestSize() bytes
+	void digestBinary(uint8_t* buffer);
+	size_t getDigestSize() const;
+	/// input block of the compression function in bytes, 0 if there is none
+	size_t getBlockSize() const;
 	std::string getAlgorithm() const;
+	/// name of the variant chosen by createInstance()
+	std::string getVariant() const;
 	void update(const void* data, size_t offset, size_t len);
 	void reset();
 
 	void update(const void* data, size_t len);
 	void update(const std::string& data);
+	/// feed a whole file, returns false if it can't be read, see MessageDigestFile
+	bool updateFile(const std::string& fileName);
+	/// reuse the caller's buffer for files that are read instead of mapped
+	bool updateFile(const std::string& fileName, uint8_t* buffer, size_t bufferSize);
+
+	/// digest of a whole file, empty if the file can't be read or the algorithm is unknown
+	static std::string hashFile(const std::string& fileName, const std::string& algorithm);
+
+	std::vector<std::string> digestBatch(const std::vector<MessageDigestInput>& inputs);
+	/// binary digests of several messages, getDigestSize() bytes each
+	void digestBatch(const MessageDigestInput* inputs, size_t numInputs, uint8_t* digests);
+
+	/// versioned binary state to resume hashing later, possibly on another machine
+	std::vector<uint8_t> exportState() const;
+	bool importState(const uint8_t* state, size_t size);
+	bool importState(const std::vector<uint8_t>& state);
+
+	/// independent copy, e.g. to hash several messages with a common prefix once
+	std::unique_ptr<MessageDigest> clone() const;
+	/**
+	 * @brief Copy the running state into an existing instance without allocating
+	 * @return false if target is a different algorithm, it is unchanged then
+	 */
+	bool cloneInto(MessageDigest& target) const;
 
 protected:
-	static MessageDigestImplMap &getImplementationMap();
+	static MessageDigestVariantMap &getVariantMap();
+	static std::map<std::string,std::string> &getPreferredVariants();
 
 private:
 	MessageDigest() = default;
 	MessageDigestImplPtr mDigestImpl;
+	std::string mVariant;
 };
 
 template<class T>
@@ -53,4 +123,20 @@ public:
   }
 };
 
+/// registers an implementation with a Kernel enum as one variant per kernel
+template<class T>
+class MessageDigestKernelRegistrar {
+public:
+  MessageDigestKernelRegistrar(const std::string& name, const std::string& variant,
+                               int rank, typename T::Kernel kernel){
+    MessageDigest::registerVariant(name, variant, rank,
+                                   [kernel]() { return T::isSupported(kernel); },
+                                   [kernel]() {
+                                     std::unique_ptr<T> impl(new T());
+                                     impl->setKernel(kernel);
+                                     return MessageDigestImplPtr(std::move(impl));
+                                   });
+  }
+};
+
 #endif //MessageDigest_INCLUDED
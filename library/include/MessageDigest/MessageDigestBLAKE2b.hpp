@@ -0,0 +1,116 @@
+/**
+ * @file MessageDigestBLAKE2b.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestBLAKE2b_INCLUDED
+#define MessageDigestBLAKE2b_INCLUDED
+
+#include "MessageDigest/MessageDigestImpl.hpp"
+
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief BLAKE2b of RFC 7693, registered as "BLAKE2b"
+ *
+ * 64 bit words and 128 byte blocks, digests of 1 to 64 bytes with or without
+ * a key of up to 64 bytes. Unlike the Merkle-Damgard hashes the last block is
+ * compressed with a flag instead of padding, so _buffer keeps up to a whole
+ * block until more data arrives.
+ *
+ * The SIMD kernels keep the 4x4 working state as four rows and run the
+ * column step of each round on all columns at once. Rotating rows two to
+ * four by one, two and three words lines up the diagonals for the second
+ * step, rotating them back restores the columns.
+ */
+class MessageDigestBLAKE2b:public MessageDigestImpl {
+public:
+  /// implementations of the compression function
+  enum class Kernel {
+    Generic, ///< portable C++
+    SSE41,   ///< rows in pairs of 128 bit registers
+    AVX2     ///< one 256 bit register per row
+  };
+
+  /// length of the binary digest in bytes, may be shortened with setDigestSize()
+  static constexpr size_t DIGEST_SIZE = 64;
+  /// longest key in bytes
+  static constexpr size_t MAX_KEY_SIZE = 64;
+
+  MessageDigestBLAKE2b();
+  ~MessageDigestBLAKE2b() = default;
+
+  static std::unique_ptr<MessageDigestImpl> create();
+
+  // MessageDigestImpl interface
+public:
+  virtual std::string digest();
+  virtual void digestBinary(uint8_t* buffer);
+  virtual size_t getDigestSize() const;
+  virtual size_t getBlockSize() const;
+  virtual std::string getAlgorithm() const;
+  virtual void reset();
+  virtual std::vector<uint8_t> exportState() const;
+  virtual bool importState(const uint8_t* state, size_t size);
+  virtual std::unique_ptr<MessageDigestImpl> clone() const;
+  virtual bool cloneInto(MessageDigestImpl& target) const;
+
+  virtual void update(const void *data, const size_t offset, const size_t len);
+
+  /// length of the digest in bytes, returns false unless 1 to DIGEST_SIZE, resets the state
+  bool setDigestSize(size_t digestSize);
+  /**
+   * @brief Hash keyed, i.e. compute a MAC, resets the state
+   * @param keyLength up to MAX_KEY_SIZE, 0 hashes without a key again
+   * @return false if the key is too long
+   */
+  bool setKey(const void* key, size_t keyLength);
+
+  /// select the compression function, returns false if the CPU lacks support
+  bool setKernel(Kernel kernel);
+  Kernel getKernel() const;
+
+  static bool isSupported(Kernel kernel);
+
+protected:
+  static constexpr size_t BLOCK_SIZE = 128;
+  static constexpr size_t HASH_SIZE = 8;
+
+  /**
+   * @brief Chaining value of a node: the IV XORed with the parameter block
+   *
+   * The tree parameters of the BLAKE2 paper, section 2.10, are used by the
+   * parallel variant, a sequential hash is a tree with fanout and depth 1.
+   */
+  static void initHash(uint64_t* hash, size_t digestSize, size_t keyLength,
+                       uint8_t fanout = 1, uint8_t depth = 1, uint64_t nodeOffset = 0,
+                       uint8_t nodeDepth = 0, uint8_t innerLength = 0);
+  /// compress nBlocks consecutive blocks which are not the last ones, numBytes counts them
+  void processBlocks(uint64_t* hash, const uint8_t* data, size_t nBlocks, uint64_t& numBytes) const;
+  /// compress the last numBytes of a node, at most a block, padded with zeros
+  void processLastBlock(uint64_t* hash, const uint8_t* data, size_t numBytes, uint64_t counter, bool lastNode) const;
+  /// little endian bytes of a final hash, truncated to digestSize bytes
+  static void hashToBytes(const uint64_t* hash, uint8_t* buffer, size_t digestSize);
+
+  size_t  _digestSize;
+  size_t  _keyLength;
+  uint8_t _key[MAX_KEY_SIZE];
+
+  Kernel _kernel;
+
+private:
+  /// size of compressed data in bytes, including the key block
+  uint64_t _numBytes;
+  /// valid bytes in _buffer, a full block stays until more data follows
+  size_t   _bufferSize;
+
+  uint8_t  _buffer[BLOCK_SIZE];
+  uint64_t _hash[HASH_SIZE];
+};
+
+#endif //MessageDigestBLAKE2b_INCLUDED
@@ -0,0 +1,72 @@
+/**
+ * @file MessageDigestBLAKE2bp.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestBLAKE2bp_INCLUDED
+#define MessageDigestBLAKE2bp_INCLUDED
+
+#include "MessageDigest/MessageDigestBLAKE2b.hpp"
+
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief BLAKE2bp of the BLAKE2 paper, registered as "BLAKE2bp"
+ *
+ * A tree of fanout 4 and depth 2 over BLAKE2b: block i of the message goes
+ * to leaf i mod 4, the root hashes the four 64 byte leaf digests. Every leaf
+ * starts with the key block of a keyed hash. Digest size and key are set as
+ * for BLAKE2b, the digests are different.
+ *
+ * The leaves receive their blocks in lockstep, a chunk of four blocks at a
+ * time. Kernel::AVX2 puts one leaf into each 64 bit lane and compresses a
+ * whole chunk in a single pass of the rounds, the other kernels compress
+ * the leaves one after another.
+ */
+class MessageDigestBLAKE2bp:public MessageDigestBLAKE2b {
+public:
+  /// number of leaves
+  static constexpr size_t LEAVES = 4;
+
+  MessageDigestBLAKE2bp();
+  ~MessageDigestBLAKE2bp() = default;
+
+  static std::unique_ptr<MessageDigestImpl> create();
+
+  // MessageDigestImpl interface
+public:
+  void digestBinary(uint8_t* buffer);
+  std::string getAlgorithm() const;
+  void reset();
+  std::vector<uint8_t> exportState() const;
+  bool importState(const uint8_t* state, size_t size);
+  std::unique_ptr<MessageDigestImpl> clone() const;
+  bool cloneInto(MessageDigestImpl& target) const;
+
+  void update(const void *data, const size_t offset, const size_t len);
+
+private:
+  /// one block for each leaf
+  static constexpr size_t CHUNK_SIZE = LEAVES * BLOCK_SIZE;
+
+  /// compress nChunks consecutive chunks which are not the last ones
+  void processChunks(const uint8_t* data, size_t nChunks);
+
+  /// chaining values of the leaves
+  uint64_t _leafHash[LEAVES][HASH_SIZE];
+  /// size of data compressed by each leaf in bytes, the same for all leaves
+  uint64_t _leafBytes;
+  /// last full chunk, compressed once more data follows
+  uint8_t  _lastChunk[CHUNK_SIZE];
+  bool     _hasLastChunk;
+  /// partial chunk after _lastChunk
+  uint8_t  _chunk[CHUNK_SIZE];
+  size_t   _chunkSize;
+};
+
+#endif //MessageDigestBLAKE2bp_INCLUDED
@@ -0,0 +1,72 @@
+/**
+ * @file MessageDigestBLAKE2sp.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestBLAKE2sp_INCLUDED
+#define MessageDigestBLAKE2sp_INCLUDED
+
+#include "MessageDigest/MessageDigestBLAKE2s.hpp"
+
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief BLAKE2sp of the BLAKE2 paper, registered as "BLAKE2sp"
+ *
+ * A tree of fanout 8 and depth 2 over BLAKE2s: block i of the message goes
+ * to leaf i mod 8, the root hashes the eight 32 byte leaf digests. Every leaf
+ * starts with the key block of a keyed hash. Digest size and key are set as
+ * for BLAKE2s, the digests are different.
+ *
+ * The leaves receive their blocks in lockstep, a chunk of eight blocks at a
+ * time. Kernel::AVX2 puts one leaf into each 32 bit lane and compresses a
+ * whole chunk in a single pass of the rounds, the other kernels compress
+ * the leaves one after another.
+ */
+class MessageDigestBLAKE2sp:public MessageDigestBLAKE2s {
+public:
+  /// number of leaves
+  static constexpr size_t LEAVES = 8;
+
+  MessageDigestBLAKE2sp();
+  ~MessageDigestBLAKE2sp() = default;
+
+  static std::unique_ptr<MessageDigestImpl> create();
+
+  // MessageDigestImpl interface
+public:
+  void digestBinary(uint8_t* buffer);
+  std::string getAlgorithm() const;
+  void reset();
+  std::vector<uint8_t> exportState() const;
+  bool importState(const uint8_t* state, size_t size);
+  std::unique_ptr<MessageDigestImpl> clone() const;
+  bool cloneInto(MessageDigestImpl& target) const;
+
+  void update(const void *data, const size_t offset, const size_t len);
+
+private:
+  /// one block for each leaf
+  static constexpr size_t CHUNK_SIZE = LEAVES * BLOCK_SIZE;
+
+  /// compress nChunks consecutive chunks which are not the last ones
+  void processChunks(const uint8_t* data, size_t nChunks);
+
+  /// chaining values of the leaves
+  uint32_t _leafHash[LEAVES][HASH_SIZE];
+  /// size of data compressed by each leaf in bytes, the same for all leaves
+  uint64_t _leafBytes;
+  /// last full chunk, compressed once more data follows
+  uint8_t  _lastChunk[CHUNK_SIZE];
+  bool     _hasLastChunk;
+  /// partial chunk after _lastChunk
+  uint8_t  _chunk[CHUNK_SIZE];
+  size_t   _chunkSize;
+};
+
+#endif //MessageDigestBLAKE2sp_INCLUDED
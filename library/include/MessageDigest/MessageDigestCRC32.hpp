@@ -25,6 +25,15 @@
 
 class MessageDigestCRC32:public MessageDigestImpl {
 public:
+    /// implementations of update()
+    enum class Kernel {
+        SlicingBy8, ///< portable C++, eight table look-ups per 8 bytes
+        PCLMUL      ///< carry-less multiplication folding
+    };
+
+    /// length of the binary digest in bytes
+    static constexpr size_t DIGEST_SIZE = 4;
+
     MessageDigestCRC32();
     ~MessageDigestCRC32() = default;
 
@@ -33,13 +42,47 @@ public:
 	// MessageDigestImpl interface
 public:
 	std::string digest();
+	void digestBinary(uint8_t* buffer);
+	size_t getDigestSize() const;
 	std::string getAlgorithm() const;
 	void update(const void *data, const size_t offset, const size_t len);
 	void reset();
+	std::vector<uint8_t> exportState() const;
+	bool importState(const uint8_t* state, size_t size);
+	std::unique_ptr<MessageDigestImpl> clone() const;
+	bool cloneInto(MessageDigestImpl& target) const;
+
+    /// select the implementation, returns false if the CPU lacks support
+    bool setKernel(Kernel kernel);
+    Kernel getKernel() const;
+
+    static bool isSupported(Kernel kernel);
+
+    /// append the data hashed by other, as if it had been passed to update()
+    void combine(const MessageDigestCRC32& other);
+
+    /**
+     * @brief Hash a large buffer on several threads
+     *
+     * The buffer is split into one chunk per thread, the partial hashes are
+     * merged in order with combine(). Small buffers are hashed by update().
+     * @param numThreads number of threads, 0 for one per hardware thread
+     */
+    void updateParallel(const void *data, const size_t offset, const size_t len, unsigned numThreads = 0);
+
+    /**
+     * @brief Hash the content of a file on several threads, each reading its own chunk
+     * @return false if the file can't be read, the hash is unchanged then
+     */
+    bool updateParallel(const std::string& fileName, unsigned numThreads = 0);
 
 private:
     /// hash
     uint32_t _hash;
+    /// size of processed data in bytes
+    uint64_t _numBytes;
+
+    Kernel _kernel;
 
 };
 
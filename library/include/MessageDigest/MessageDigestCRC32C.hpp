@@ -0,0 +1,62 @@
+/**
+ * @file MessageDigestCRC32C.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigest_CRC32C_INCLUDED
+#define MessageDigest_CRC32C_INCLUDED
+
+#include "MessageDigest/MessageDigestImpl.hpp"
+
+#include <cstdint>
+#include <string>
+#include <memory>
+
+/**
+ * @brief CRC-32C with the Castagnoli polynomial 0x1EDC6F41 (RFC 3720)
+ */
+class MessageDigestCRC32C:public MessageDigestImpl {
+public:
+    /// implementations of update()
+    enum class Kernel {
+        SlicingBy8, ///< portable C++, eight table look-ups per 8 bytes
+        SSE42       ///< crc32 instruction on three interleaved streams
+    };
+
+    /// length of the binary digest in bytes
+    static constexpr size_t DIGEST_SIZE = 4;
+
+    MessageDigestCRC32C();
+    ~MessageDigestCRC32C() = default;
+
+    static std::unique_ptr<MessageDigestImpl> create();
+
+    // MessageDigestImpl interface
+public:
+    std::string digest();
+    void digestBinary(uint8_t* buffer);
+    size_t getDigestSize() const;
+    std::string getAlgorithm() const;
+    void update(const void *data, const size_t offset, const size_t len);
+    void reset();
+    std::vector<uint8_t> exportState() const;
+    bool importState(const uint8_t* state, size_t size);
+    std::unique_ptr<MessageDigestImpl> clone() const;
+    bool cloneInto(MessageDigestImpl& target) const;
+
+    /// select the implementation, returns false if the CPU lacks support
+    bool setKernel(Kernel kernel);
+    Kernel getKernel() const;
+
+    static bool isSupported(Kernel kernel);
+
+private:
+    /// hash
+    uint32_t _hash;
+
+    Kernel _kernel;
+};
+
+#endif //MessageDigest_CRC32C_INCLUDED
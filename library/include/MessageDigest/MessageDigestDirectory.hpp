@@ -0,0 +1,59 @@
+/**
+ * @file MessageDigestDirectory.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestDirectory_INCLUDED
+#define MessageDigestDirectory_INCLUDED
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * path relative to the root and digest of a file, the digest is empty if the
+ * file can't be read. A subdirectory that can't be read is listed with an
+ * empty digest and a trailing '/', the files below it are missing.
+ */
+typedef std::pair<std::string,std::string> MessageDigestDirectoryEntry;
+
+/**
+ * @brief Hashes every regular file below a directory on a work-stealing
+ * thread pool.
+ *
+ * Each worker has its own queue of directories to scan and files to hash and
+ * steals from the others once it runs dry, so a huge file keeps only one
+ * worker busy while the rest drain the small ones. Every worker keeps one
+ * MessageDigest instance and one read buffer for all of its files.
+ *
+ * Symbolic links are not followed. The result is sorted by path and doesn't
+ * depend on the scheduling.
+ */
+class MessageDigestDirectory {
+public:
+  explicit MessageDigestDirectory(const std::string& algorithm);
+
+  /**
+   * @brief Hash all regular files below root
+   * @return false if the algorithm is unknown or root can't be read
+   */
+  bool hashTree(const std::string& root, std::vector<MessageDigestDirectoryEntry>& entries);
+
+  /// 0 selects one thread per core
+  void setNumThreads(unsigned numThreads);
+  unsigned getNumThreads() const;
+
+  /// read buffer per worker for small files, large files are mapped
+  void setBufferSize(size_t bufferSize);
+  size_t getBufferSize() const;
+
+private:
+  std::string _algorithm;
+  unsigned    _numThreads;
+  size_t      _bufferSize;
+};
+
+#endif //MessageDigestDirectory_INCLUDED
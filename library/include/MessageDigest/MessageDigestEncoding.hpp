@@ -0,0 +1,67 @@
+/**
+ * @file MessageDigestEncoding.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestEncoding_INCLUDED
+#define MessageDigestEncoding_INCLUDED
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Text encodings of binary digests: lower case hex, base64 and
+ * base32 as defined in RFC 4648.
+ *
+ * Hex is what digest() and the checksum files use, so it has SIMD kernels
+ * for both directions. The decoders accept upper and lower case hex and
+ * return false on any invalid character instead of guessing.
+ */
+class MessageDigestEncoding {
+public:
+  /// implementations of the hex encoder and decoder
+  enum class Kernel {
+    Generic, ///< portable C++, one table look-up per nibble
+    SSSE3,   ///< 16 bytes per pshufb round
+    AVX2     ///< 32 bytes per round
+  };
+
+  static bool isSupported(Kernel kernel);
+  /// fastest kernel supported by this CPU
+  static Kernel getBestKernel();
+
+  /// write 2*size hex characters, no terminating zero
+  static void encodeHex(const uint8_t* data, size_t size, char* hex);
+  static void encodeHex(const uint8_t* data, size_t size, char* hex, Kernel kernel);
+
+  /**
+   * @brief Decode length hex characters into length/2 bytes
+   * @return false if length is odd or a character is not a hex digit
+   */
+  static bool decodeHex(const char* hex, size_t length, uint8_t* data);
+  static bool decodeHex(const char* hex, size_t length, uint8_t* data, Kernel kernel);
+
+  static std::string toHex(const uint8_t* data, size_t size);
+  static std::string toBase64(const uint8_t* data, size_t size);
+  static std::string toBase32(const uint8_t* data, size_t size);
+
+  static bool fromHex(const std::string& hex, std::vector<uint8_t>& data);
+  /// padding is optional
+  static bool fromBase64(const std::string& base64, std::vector<uint8_t>& data);
+  /// padding is optional, lower case is accepted
+  static bool fromBase32(const std::string& base32, std::vector<uint8_t>& data);
+
+  /**
+   * @brief Split a line of a checksum file into digest and file name
+   *
+   * Understands the output of sha256sum and friends ("<hex>  <file>", or
+   * "<hex> *<file>" in binary mode) and the BSD style "SHA256 (<file>) = <hex>".
+   * @return false if the line has neither format or the digest is empty or not valid hex
+   */
+  static bool parseChecksumLine(const std::string& line, std::vector<uint8_t>& digest, std::string& fileName);
+};
+
+#endif //MessageDigestEncoding_INCLUDED
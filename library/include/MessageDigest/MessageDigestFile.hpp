@@ -0,0 +1,45 @@
+/**
+ * @file MessageDigestFile.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestFile_INCLUDED
+#define MessageDigestFile_INCLUDED
+
+#include "MessageDigest/MessageDigestImpl.hpp"
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Feeds whole files into a message digest.
+ *
+ * Regular files are memory mapped and handed to update() straight from the
+ * page cache, without a copy into a user buffer. The kernel is told that the
+ * mapping is read sequentially and the next window is prefetched while the
+ * current one is hashed. Small files, pipes and special files are read() in
+ * chunks instead.
+ *
+ * A mapped file that another process truncates while it is hashed raises
+ * SIGBUS, which terminates the process unless the caller handles it. Only
+ * hash files this way that are not shrunk concurrently.
+ */
+class MessageDigestFile {
+public:
+  /// files below this size are read, mapping them costs more than the copy
+  static constexpr uint64_t MinMapSize = 64*1024;
+  /// bytes hashed between two prefetch hints
+  static constexpr size_t WindowSize = 4*1024*1024;
+  /// buffer size of the read() fallback
+  static constexpr size_t ReadBufferSize = 256*1024;
+
+  /// feed the whole file into digest, returns false if it can't be read
+  static bool update(MessageDigestImpl& digest, const std::string& fileName);
+  /// reuse the caller's buffer for files that are read instead of mapped, a
+  /// null buffer or a bufferSize of 0 selects an internal one
+  static bool update(MessageDigestImpl& digest, const std::string& fileName, uint8_t* buffer, size_t bufferSize);
+};
+
+#endif //MessageDigestFile_INCLUDED
@@ -0,0 +1,78 @@
+/**
+ * @file MessageDigestFileBatch.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestFileBatch_INCLUDED
+#define MessageDigestFileBatch_INCLUDED
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Hashes many files with reads kept in flight across all of them.
+ *
+ * The io_uring engine keeps up to getQueueDepth() chunk reads queued at the
+ * device, into buffers registered with the kernel once. Completed chunks are
+ * fed in file order into a digest per open file while the next reads are
+ * already running, so I/O and hashing overlap even on a single thread.
+ *
+ * Where io_uring is not available, or the kernel refuses it, getQueueDepth()
+ * threads hash one file each with MessageDigestFile. The io_uring engine
+ * leaves pipes and devices to these threads as well, and all files it hasn't
+ * finished if the ring fails during a batch.
+ */
+class MessageDigestFileBatch {
+public:
+  enum class Engine {
+    Threads, ///< blocking reads, one file per thread
+    IoUring  ///< asynchronous reads through io_uring
+  };
+
+  /// upper bound of setQueueDepth(), the thread engine starts as many threads
+  static constexpr unsigned MaxQueueDepth = 256;
+
+  explicit MessageDigestFileBatch(const std::string& algorithm);
+
+  /**
+   * @brief Hash every file
+   * @return digests in the order of fileNames, empty for files that can't
+   * be read and for all files if the algorithm is unknown
+   */
+  std::vector<std::string> hashFiles(const std::vector<std::string>& fileNames);
+
+  /// select the engine, returns false if the system lacks support
+  bool setEngine(Engine engine);
+  Engine getEngine() const;
+
+  static bool isSupported(Engine engine);
+
+  /// reads in flight for the io_uring engine, threads for the thread engine, 1 to MaxQueueDepth
+  void setQueueDepth(unsigned queueDepth);
+  unsigned getQueueDepth() const;
+
+  /// size of a single read of the io_uring engine
+  void setChunkSize(size_t chunkSize);
+  size_t getChunkSize() const;
+
+private:
+  std::vector<std::string> hashFilesThreads(const std::vector<std::string>& fileNames);
+  /**
+   * @brief Hash the regular files through the ring
+   * @param remaining receives the indices of the files left for hashFilesThreads(),
+   * the pipes and devices, or the unfinished files if the ring fails
+   * @return false if the ring can't be set up or fails during the batch
+   */
+  bool hashFilesIoUring(const std::vector<std::string>& fileNames, std::vector<std::string>& digests,
+                        std::vector<size_t>& remaining);
+
+  std::string _algorithm;
+  Engine      _engine;
+  unsigned    _queueDepth;
+  size_t      _chunkSize;
+};
+
+#endif //MessageDigestFileBatch_INCLUDED
@@ -0,0 +1,88 @@
+/**
+ * @file MessageDigestHMAC.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestHMAC_INCLUDED
+#define MessageDigestHMAC_INCLUDED
+
+#include "MessageDigest/MessageDigest.hpp"
+
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Keyed-hash message authentication code of RFC 2104
+ *
+ *   HMAC(K, m) = H((K ^ opad) || H((K ^ ipad) || m))
+ *
+ * Both padded keys fill exactly one block, so the states after hashing them
+ * are computed once per key. Every MAC starts from copies of these midstates
+ * and costs the blocks of the message plus one block for the outer hash, no
+ * matter how long the key is. Copies are made with cloneInto(), so computing
+ * a MAC doesn't allocate.
+ *
+ * Works for every algorithm with a block structure, i.e. getBlockSize() > 0.
+ */
+class MessageDigestHMAC {
+public:
+  /**
+   * @brief Create a keyed instance, keys longer than a block are hashed first
+   * @return nullptr for unknown algorithms or those without blocks, e.g. CRC32
+   */
+  static std::unique_ptr<MessageDigestHMAC> createInstance(const std::string& algorithm,
+                                                           const void* key, size_t keyLength);
+  static std::unique_ptr<MessageDigestHMAC> createInstance(const std::string& algorithm,
+                                                           const std::string& key);
+
+  /// e.g. "HMAC-SHA256"
+  std::string getAlgorithm() const;
+  size_t getDigestSize() const;
+
+  void update(const void* data, size_t len);
+  void update(const std::string& data);
+  /// hex MAC of the data so far, more data may follow
+  std::string digest();
+  void digestBinary(uint8_t* buffer);
+  /// forget the data, keep the key
+  void reset();
+
+  /// MAC of a single message, resets the current state
+  std::string operator()(const std::string& text);
+  void operator()(const void* data, size_t numBytes, uint8_t* buffer);
+
+  /**
+   * @brief Check a MAC in constant time
+   * @param macLength may be shorter than getDigestSize() for truncated MACs, but not 0
+   */
+  bool verify(const void* data, size_t numBytes, const uint8_t* mac, size_t macLength);
+
+  /// MACs of several messages, getDigestSize() bytes each, resets the current state
+  void digestBatch(const MessageDigestInput* inputs, size_t numInputs, uint8_t* macs);
+  /**
+   * @brief Check the MACs of several messages, getDigestSize() bytes each
+   * @param valid receives one result per message, may be nullptr
+   * @return true if all MACs match
+   */
+  bool verifyBatch(const MessageDigestInput* inputs, size_t numInputs, const uint8_t* macs, bool* valid);
+
+private:
+  MessageDigestHMAC() = default;
+
+  /// midstates after the inner and outer padded key
+  std::unique_ptr<MessageDigest> _innerKey;
+  std::unique_ptr<MessageDigest> _outerKey;
+  /// running inner hash and scratch space for the outer one
+  std::unique_ptr<MessageDigest> _inner;
+  std::unique_ptr<MessageDigest> _outer;
+  /// inner hash of the last message
+  std::vector<uint8_t> _innerHash;
+  /// MAC compared by verify()
+  std::vector<uint8_t> _mac;
+};
+
+#endif //MessageDigestHMAC_INCLUDED
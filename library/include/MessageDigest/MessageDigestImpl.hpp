@@ -8,15 +8,32 @@
 #ifndef MessageDigestImpl_INCLUDED
 #define MessageDigestImpl_INCLUDED
 
-#include <string>
+#include "MessageDigest/MessageDigestEncoding.hpp"
+
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <typeinfo>
+#include <type_traits>
+#include <vector>
+#include <utility>
+
+/// a message to be hashed: pointer to the data and its length in bytes
+typedef std::pair<const void*,size_t> MessageDigestInput;
 
 class MessageDigestImpl {
 public:
 	MessageDigestImpl() = default;
-	~MessageDigestImpl() = default;
+	virtual ~MessageDigestImpl() = default;
 
 	virtual std::string digest() = 0;
+	/// write the binary digest to buffer, which holds at least getDigestSize() bytes
+	virtual void digestBinary(uint8_t* buffer) = 0;
+	/// length of the binary digest in bytes
+	virtual size_t getDigestSize() const = 0;
+	/// input block of the compression function in bytes, 0 if there is none, e.g. for CRC32
+	virtual size_t getBlockSize() const;
 	virtual std::string getAlgorithm() const = 0;
 	virtual void update(const void* data, size_t offset, size_t len) = 0;
 	virtual void reset() = 0;
@@ -26,9 +43,61 @@ public:
 
 	std::string operator()(const void* data, size_t numBytes);
 	std::string operator()(const std::string& text);
+	void operator()(const void* data, size_t numBytes, uint8_t* buffer);
+
+	std::vector<std::string> digestBatch(const std::vector<MessageDigestInput>& inputs);
+	virtual void digestBatch(const MessageDigestInput* inputs, size_t numInputs, uint8_t* digests);
+
+	/// serialize the running state, see MessageDigestState.hpp, empty if not supported
+	virtual std::vector<uint8_t> exportState() const;
+	/// continue from a state of exportState(), returns false and keeps the current state if it doesn't fit
+	virtual bool importState(const uint8_t* state, size_t size);
+
+	/// independent copy of the running state and the selected kernels
+	virtual std::unique_ptr<MessageDigestImpl> clone() const = 0;
+	/// copy the running state into target without allocating, returns false if target is another class
+	virtual bool cloneInto(MessageDigestImpl& target) const = 0;
+
+	/// lower case hex of a binary digest, kept for callers of earlier versions
+	static std::string toHex(const uint8_t* data, size_t size);
 
 };
 
+/// clone() of an implementation with a copy constructor
+template<class T>
+std::unique_ptr<MessageDigestImpl> cloneDigest(const T& md)
+{
+  return std::unique_ptr<MessageDigestImpl>(new T(md));
+}
+
+/// cloneInto() of an implementation with a copy assignment
+template<class T>
+bool cloneDigestInto(const T& md, MessageDigestImpl& target)
+{
+  // a derived class, e.g. SHA224 for SHA256, has a different state
+  if (typeid(target) != typeid(md))
+    return false;
+
+  static_cast<T&>(target) = md;
+  return true;
+}
+
+/**
+ * @brief Compile-time length of the binary digest of an algorithm,
+ * taken from its DIGEST_SIZE constant
+ */
+template<class T>
+struct MessageDigestSize : std::integral_constant<size_t, T::DIGEST_SIZE> {};
+
+/// binary digest of the current state, without touching the heap
+template<class T>
+std::array<uint8_t, MessageDigestSize<T>::value> digestArray(T& md)
+{
+  std::array<uint8_t, MessageDigestSize<T>::value> buffer;
+  md.digestBinary(buffer.data());
+  return buffer;
+}
+
 inline void MessageDigestImpl::update(const void *data, size_t len) { update(data,0,len); }
 
 inline void MessageDigestImpl::update(const std::string &data)
@@ -52,6 +121,64 @@ inline std::string MessageDigestImpl::operator()(const std::string &text)
   return digest();
 }
 
+/// compute binary MD of a memory block, buffer holds at least getDigestSize() bytes
+inline void MessageDigestImpl::operator()(const void *data, size_t len, uint8_t *buffer)
+{
+  reset();
+  update(data,len);
+  digestBinary(buffer);
+}
+
+/// forwards to MessageDigestEncoding::toHex(), new code should call that one
+inline std::string MessageDigestImpl::toHex(const uint8_t *data, size_t size)
+{
+  return MessageDigestEncoding::toHex(data, size);
+}
+
+/// compute MD of several independent messages, resets the current state
+inline std::vector<std::string> MessageDigestImpl::digestBatch(const std::vector<MessageDigestInput> &inputs)
+{
+  size_t digestSize = getDigestSize();
+  std::vector<uint8_t> binary(inputs.size() * digestSize);
+  digestBatch(inputs.data(), inputs.size(), binary.data());
+
+  std::vector<std::string> digests;
+  digests.reserve(inputs.size());
+  for (size_t i = 0; i < inputs.size(); i++)
+    digests.push_back(MessageDigestEncoding::toHex(binary.data() + i * digestSize, digestSize));
+  return digests;
+}
+
+/// compute binary MD of several independent messages, getDigestSize() bytes each, resets the current state
+inline void MessageDigestImpl::digestBatch(const MessageDigestInput *inputs, size_t numInputs, uint8_t *digests)
+{
+  size_t digestSize = getDigestSize();
+  for (size_t i = 0; i < numInputs; i++)
+  {
+    reset();
+    update(inputs[i].first,inputs[i].second);
+    digestBinary(digests + i * digestSize);
+  }
+  reset();
+}
+
+inline size_t MessageDigestImpl::getBlockSize() const
+{
+  return 0;
+}
+
+inline std::vector<uint8_t> MessageDigestImpl::exportState() const
+{
+  return std::vector<uint8_t>();
+}
+
+inline bool MessageDigestImpl::importState(const uint8_t *state, size_t size)
+{
+  (void) state;
+  (void) size;
+  return false;
+}
+
 namespace{
 
   inline uint32_t swap32(uint32_t x)
@@ -0,0 +1,105 @@
+/**
+ * @file MessageDigestKeccak.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestKeccak_INCLUDED
+#define MessageDigestKeccak_INCLUDED
+
+#include "MessageDigest/MessageDigestImpl.hpp"
+
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Keccak sponge of FIPS 202, common part of SHA-3 and SHAKE
+ *
+ * Message bytes are XORed straight into the first getBlockSize() bytes of
+ * the 200 byte state, the rate, and every full rate is followed by the
+ * Keccak-f[1600] permutation. There is no separate block buffer.
+ *
+ * The permutation runs its rounds written out lane by lane. Six lanes are
+ * kept complemented, which turns 20 of the 25 NOT operations of chi into
+ * plain AND and OR.
+ */
+class MessageDigestKeccak:public MessageDigestImpl {
+public:
+  /// engines for digestBatch()
+  enum class BatchKernel {
+    Serial,  ///< one message after another
+    AVX2     ///< 4 messages in parallel
+  };
+
+  // MessageDigestImpl interface
+  std::string digest();
+  void digestBinary(uint8_t* buffer);
+  size_t getDigestSize() const;
+  /// the rate in bytes
+  size_t getBlockSize() const;
+  void update(const void *data, const size_t offset, const size_t len);
+  void reset();
+  std::vector<uint8_t> exportState() const;
+  bool importState(const uint8_t* state, size_t size);
+
+  using MessageDigestImpl::digestBatch;
+  void digestBatch(const MessageDigestInput* inputs, size_t numInputs, uint8_t* digests);
+
+  /**
+   * @brief Read output of any length
+   *
+   * The first call finishes the data so far, every further call continues
+   * the output where the previous one stopped. The first getDigestSize()
+   * bytes are the digest. update() and reset() start over, the state of
+   * exportState() doesn't include the output position.
+   */
+  void squeeze(uint8_t* output, size_t numBytes);
+
+  /// select the batch engine, returns false if the CPU lacks support
+  bool setBatchKernel(BatchKernel kernel);
+  BatchKernel getBatchKernel() const;
+
+  static bool isSupported(BatchKernel kernel);
+
+protected:
+  /**
+   * @param rate       in bytes, 200 minus twice the security level
+   * @param digestSize in bytes
+   * @param domain     padding byte with the domain separation bits, 0x06 for SHA-3, 0x1F for SHAKE
+   */
+  MessageDigestKeccak(size_t rate, size_t digestSize, uint8_t domain);
+
+  /// Keccak-f[1600] on a state with complemented lanes
+  static void permute(uint64_t* state);
+
+  /// pad a copy of the state and run the first permutation
+  void finish(uint64_t* output) const;
+  /// read numBytes output, position counts the bytes taken from the current rate
+  void squeeze(uint64_t* output, size_t& position, uint8_t* buffer, size_t numBytes) const;
+
+  template<size_t RATE, uint8_t DOMAIN>
+  void digestBatchMultiBuffer(const MessageDigestInput* inputs, size_t numInputs, uint8_t* digests);
+
+  static constexpr size_t STATE_SIZE = 25;
+
+  size_t  _rate;
+  size_t  _digestSize;
+  uint8_t _domain;
+
+  /// lanes of the sponge, see permute() for the complemented ones
+  uint64_t _state[STATE_SIZE];
+  /// bytes absorbed into the current rate
+  size_t   _position;
+
+  /// state of squeeze(), valid if _squeezing
+  uint64_t _output[STATE_SIZE];
+  size_t   _outputPosition;
+  bool     _squeezing;
+
+  BatchKernel _batchKernel;
+};
+
+#endif //MessageDigestKeccak_INCLUDED
@@ -22,9 +22,20 @@
 #include <cstdint>
 #include <string>
 #include <memory>
+#include <vector>
 
 class MessageDigestMD5:public MessageDigestImpl {
 public:
+	/// engines for digestBatch()
+	enum class BatchKernel {
+		Serial,  ///< one message after another
+		AVX2,    ///< 8 messages in parallel
+		AVX512   ///< 16 messages in parallel
+	};
+
+	/// length of the binary digest in bytes
+	static constexpr size_t DIGEST_SIZE = 16;
+
 	MessageDigestMD5();
 	~MessageDigestMD5() = default;
 
@@ -33,15 +44,45 @@ public:
 	// MessageDigestImpl interface
 public:
 	std::string digest();
+	void digestBinary(uint8_t* buffer);
+	size_t getDigestSize() const;
+	size_t getBlockSize() const;
 	std::string getAlgorithm() const;
 	void update(const void *data, const size_t offset, const size_t len);
 	void reset();
+	std::vector<uint8_t> exportState() const;
+	bool importState(const uint8_t* state, size_t size);
+	std::unique_ptr<MessageDigestImpl> clone() const;
+	bool cloneInto(MessageDigestImpl& target) const;
+
+	using MessageDigestImpl::digestBatch;
+	void digestBatch(const MessageDigestInput* inputs, size_t numInputs, uint8_t* digests);
+
+	/// select the batch engine, returns false if the CPU lacks support
+	bool setBatchKernel(BatchKernel kernel);
+	BatchKernel getBatchKernel() const;
+
+	static bool isSupported(BatchKernel kernel);
 
 private:
         /// process 64 bytes
         void processBlock(const void* data);
+        /// process nBlocks consecutive blocks, the hot path of update()
+        void processBlocks(const void* data, size_t nBlocks);
         void processBuffer();
 
+        /// binary representation of a final hash, DIGEST_SIZE bytes
+        static void hashToBytes(const uint32_t* hash, uint8_t* buffer);
+
+        /// compression function of a multi-buffer engine
+        typedef void (*ProcessBlocksFunc)(uint32_t* hash, const uint8_t* const* blocks);
+
+        template<size_t LANES>
+        void digestBatchMultiBuffer(const MessageDigestInput* inputs, size_t numInputs, uint8_t* digests,
+                                    ProcessBlocksFunc processBlocks);
+        /// one message after another, padded on the stack instead of in _buffer
+        void digestBatchSerial(const MessageDigestInput* inputs, size_t numInputs, uint8_t* digests);
+
         static constexpr uint8_t BLOCK_SIZE = 64;
         static constexpr uint8_t HASH_SIZE = 4;
 
@@ -53,6 +94,7 @@ private:
 	uint8_t  _buffer[BLOCK_SIZE];
 	uint32_t _hash[HASH_SIZE];
 
+	BatchKernel _batchKernel;
 };
 
 #endif //MessageDigestMD5_INCLUDED
@@ -0,0 +1,179 @@
+/**
+ * @file MessageDigestMultiBuffer.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestMultiBuffer_INCLUDED
+#define MessageDigestMultiBuffer_INCLUDED
+
+#include "MessageDigest/MessageDigestImpl.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Lane scheduler for multi-buffer engines, which run the compression
+ * function of LANES independent messages side by side in SIMD registers.
+ *
+ * Every lane reads the full blocks of its message directly from the caller's
+ * memory, followed by one or two padded tail blocks. As soon as a message is
+ * done its lane is refilled with the next one, so short messages retire early
+ * and a single long message doesn't stall the others.
+ *
+ * Padding::pad() writes the tail blocks, see MessageDigestMultiBuffer::pad().
+ * Usually Padding is the derived engine itself.
+ */
+template<size_t LANES, size_t BLOCK_SIZE, class Padding>
+class MessageDigestLaneScheduler {
+public:
+  MessageDigestLaneScheduler(const MessageDigestInput* inputs, size_t numInputs)
+    : _inputs(inputs), _numInputs(numInputs)
+  {
+  }
+
+  /**
+   * @brief Run all messages through the engine
+   * @param initLane      void(size_t lane), load the initial hash into a lane
+   * @param processBlocks void(const uint8_t* const* blocks), one block per lane
+   * @param finishLane    void(size_t lane, size_t message), lane holds the final hash of a message
+   */
+  template<class InitLane, class ProcessBlocks, class FinishLane>
+  void run(InitLane initLane, ProcessBlocks processBlocks, FinishLane finishLane)
+  {
+    // idle lanes are fed with zeros, their result is never read
+    static const uint8_t idleBlock[BLOCK_SIZE] = { 0 };
+
+    Lane lanes[LANES];
+    const uint8_t* blocks[LANES];
+    size_t nextMessage = 0;
+
+    for (;;)
+    {
+      size_t active = 0;
+      for (size_t i = 0; i < LANES; i++)
+      {
+        Lane& lane = lanes[i];
+        if (!lane.active && nextMessage < _numInputs)
+        {
+          assign(lane, nextMessage++);
+          initLane(i);
+        }
+
+        if (lane.active)
+        {
+          blocks[i] = lane.block();
+          active++;
+        }
+        else
+          blocks[i] = idleBlock;
+      }
+
+      if (active == 0)
+        return;
+
+      processBlocks(blocks);
+
+      for (size_t i = 0; i < LANES; i++)
+      {
+        Lane& lane = lanes[i];
+        if (lane.active && ++lane.position == lane.numBlocks)
+        {
+          lane.active = false;
+          finishLane(i, lane.message);
+        }
+      }
+    }
+  }
+
+private:
+  struct Lane
+  {
+    bool           active = false;
+    size_t         message;
+    const uint8_t* data;
+    /// full blocks read directly from data
+    size_t         fullBlocks;
+    size_t         numBlocks;
+    size_t         position;
+    uint8_t        tail[2*BLOCK_SIZE];
+
+    const uint8_t* block() const
+    {
+      if (position < fullBlocks)
+        return data + position * BLOCK_SIZE;
+      return tail + (position - fullBlocks) * BLOCK_SIZE;
+    }
+  };
+
+  void assign(Lane& lane, size_t message)
+  {
+    const MessageDigestInput& input = _inputs[message];
+    size_t numBytes = input.second;
+
+    lane.active     = true;
+    lane.message    = message;
+    lane.data       = (const uint8_t*) input.first;
+    lane.fullBlocks = numBytes / BLOCK_SIZE;
+    lane.position   = 0;
+    lane.numBlocks  = lane.fullBlocks +
+        Padding::pad(lane.tail, lane.data + lane.fullBlocks * BLOCK_SIZE, numBytes % BLOCK_SIZE, numBytes);
+  }
+
+  const MessageDigestInput* _inputs;
+  size_t                    _numInputs;
+};
+
+/**
+ * @brief Multi-buffer engine with the Merkle-Damgard padding of
+ * processBuffer(): a "1" bit, zeros and the message length in bits stored in
+ * the last LENGTH_SIZE bytes.
+ */
+template<size_t LANES, size_t BLOCK_SIZE, size_t LENGTH_SIZE, bool BIG_ENDIAN_LENGTH>
+class MessageDigestMultiBuffer
+  : public MessageDigestLaneScheduler<LANES, BLOCK_SIZE, MessageDigestMultiBuffer<LANES, BLOCK_SIZE, LENGTH_SIZE, BIG_ENDIAN_LENGTH> > {
+public:
+  MessageDigestMultiBuffer(const MessageDigestInput* inputs, size_t numInputs)
+    : MessageDigestLaneScheduler<LANES, BLOCK_SIZE, MessageDigestMultiBuffer>(inputs, numInputs)
+  {
+  }
+
+  /**
+   * @brief Pad the last partial block of a message
+   * @param padded   receives one or two blocks
+   * @param tail     remaining bytes of the message, less than BLOCK_SIZE
+   * @param numBytes total length of the message
+   * @return number of padded blocks
+   */
+  static size_t pad(uint8_t* padded, const uint8_t* tail, size_t tailSize, uint64_t numBytes)
+  {
+    // "1" bit and length must fit behind the message
+    size_t numBlocks = (tailSize + 1 + LENGTH_SIZE > BLOCK_SIZE) ? 2 : 1;
+    size_t paddedLength = numBlocks * BLOCK_SIZE;
+
+    if (tailSize > 0)
+      std::memcpy(padded, tail, tailSize);
+    padded[tailSize] = 128;
+    std::memset(padded + tailSize + 1, 0, paddedLength - tailSize - 1);
+
+    // add message length in bits as 64 bit number
+    uint64_t msgBits = 8 * numBytes;
+    if (BIG_ENDIAN_LENGTH)
+    {
+      uint8_t* addLength = padded + paddedLength - 1;
+      for (int i = 0; i < 8; i++, msgBits >>= 8)
+        *addLength-- = msgBits & 0xFF;
+    }
+    else
+    {
+      uint8_t* addLength = padded + paddedLength - LENGTH_SIZE;
+      for (int i = 0; i < 8; i++, msgBits >>= 8)
+        *addLength++ = msgBits & 0xFF;
+    }
+
+    return numBlocks;
+  }
+};
+
+#endif //MessageDigestMultiBuffer_INCLUDED
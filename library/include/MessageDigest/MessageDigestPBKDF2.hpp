@@ -0,0 +1,56 @@
+/**
+ * @file MessageDigestPBKDF2.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestPBKDF2_INCLUDED
+#define MessageDigestPBKDF2_INCLUDED
+
+#include "MessageDigest/MessageDigestImpl.hpp"
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Password based key derivation PBKDF2 of RFC 8018 with HMAC over
+ * SHA-1, SHA-224, SHA-256, SHA-384, SHA-512 or SHA-512/t
+ *
+ * The padded password is hashed once per password, each iteration then runs
+ * the compression function exactly twice on two prepared blocks, one for the
+ * inner and one for the outer hash, straight on the state words. Nothing is
+ * allocated or formatted inside the loop.
+ *
+ * Output blocks and passwords are independent and spread over threads. A
+ * single SHA-NI stream outruns the multi-buffer kernels, so every thread
+ * keeps the fastest single stream kernel.
+ */
+class MessageDigestPBKDF2 {
+public:
+  /// true for "SHA1", "SHA224", "SHA256", "SHA384", "SHA512", "SHA512/224" and "SHA512/256"
+  static bool isSupported(const std::string& algorithm);
+
+  /**
+   * @brief Derive keyLength bytes from a password
+   * @param numThreads threads for the output blocks, 0 for one per hardware thread
+   * @return false if the algorithm isn't supported or iterations is 0
+   */
+  static bool deriveKey(const std::string& algorithm,
+                        const void* password, size_t passwordLength,
+                        const void* salt, size_t saltLength,
+                        uint32_t iterations, uint8_t* key, size_t keyLength,
+                        unsigned numThreads = 0);
+
+  /**
+   * @brief Derive keys of several passwords, each with its own salt
+   * @param keys receives keyLength bytes per password
+   * @param numThreads 0 for one per hardware thread
+   */
+  static bool deriveKeys(const std::string& algorithm,
+                         const MessageDigestInput* passwords, const MessageDigestInput* salts,
+                         size_t numPasswords, uint32_t iterations, uint8_t* keys, size_t keyLength,
+                         unsigned numThreads = 0);
+};
+
+#endif //MessageDigestPBKDF2_INCLUDED
@@ -0,0 +1,77 @@
+/**
+ * @file MessageDigestRIPEMD.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestRIPEMD_INCLUDED
+#define MessageDigestRIPEMD_INCLUDED
+
+#include "MessageDigest/MessageDigestImpl.hpp"
+
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Common part of RIPEMD-128, RIPEMD-160 and RIPEMD-320
+ *
+ * All three share the MD4 style framing: 64 byte blocks, little endian words
+ * and length. The compression functions run a left and a right line over
+ * the same block. The lines only meet when the chaining value is updated,
+ * so compress128() and compress160() process one step of each line at a
+ * time and give the CPU two independent dependency chains.
+ *
+ * Subclasses set the initial hash in reset() and pick a compression
+ * function in processBlocks().
+ */
+class MessageDigestRIPEMD:public MessageDigestImpl {
+public:
+  // MessageDigestImpl interface
+  std::string digest();
+  void digestBinary(uint8_t* buffer);
+  size_t getDigestSize() const;
+  size_t getBlockSize() const;
+  void update(const void *data, const size_t offset, const size_t len);
+  std::vector<uint8_t> exportState() const;
+  bool importState(const uint8_t* state, size_t size);
+
+  using MessageDigestImpl::digestBatch;
+  void digestBatch(const MessageDigestInput* inputs, size_t numInputs, uint8_t* digests);
+
+protected:
+  /// hashSize: words of the chaining value, 4, 5 or 10
+  explicit MessageDigestRIPEMD(size_t hashSize);
+
+  /// process nBlocks consecutive blocks, the hot path of update()
+  virtual void processBlocks(const void* data, size_t nBlocks) = 0;
+  void processBuffer();
+
+  /// one message after another, padded on the stack instead of in _buffer
+  void digestBatchSerial(const MessageDigestInput* inputs, size_t numInputs, uint8_t* digests);
+
+  /// binary representation of a final hash, 4*hashSize bytes
+  static void hashToBytes(const uint32_t* hash, size_t hashSize, uint8_t* buffer);
+
+  // compression functions on hash, nBlocks consecutive blocks of data
+  static void compress128(uint32_t* hash, const uint8_t* data, size_t nBlocks);
+  static void compress160(uint32_t* hash, const uint8_t* data, size_t nBlocks);
+  static void compress320(uint32_t* hash, const uint8_t* data, size_t nBlocks);
+
+  static constexpr uint8_t BLOCK_SIZE = 64;
+  static constexpr uint8_t MAX_HASH_SIZE = 10;
+
+  /// words of _hash in use
+  size_t   _hashSize;
+  /// size of processed data in bytes
+  uint64_t _numBytes;
+  /// valid bytes in _buffer
+  size_t   _bufferSize;
+
+  uint8_t  _buffer[BLOCK_SIZE];
+  uint32_t _hash[MAX_HASH_SIZE];
+};
+
+#endif //MessageDigestRIPEMD_INCLUDED
@@ -0,0 +1,38 @@
+/**
+ * @file MessageDigestRIPEMD128.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestRIPEMD128_INCLUDED
+#define MessageDigestRIPEMD128_INCLUDED
+
+#include "MessageDigest/MessageDigestRIPEMD.hpp"
+
+#include <cstdint>
+#include <string>
+#include <memory>
+
+class MessageDigestRIPEMD128:public MessageDigestRIPEMD {
+public:
+  /// length of the binary digest in bytes
+  static constexpr size_t DIGEST_SIZE = 16;
+
+  MessageDigestRIPEMD128();
+  ~MessageDigestRIPEMD128() = default;
+
+  static std::unique_ptr<MessageDigestImpl> create();
+
+  // MessageDigestImpl interface
+public:
+  std::string getAlgorithm() const;
+  void reset();
+  std::unique_ptr<MessageDigestImpl> clone() const;
+  bool cloneInto(MessageDigestImpl& target) const;
+
+protected:
+  void processBlocks(const void* data, size_t nBlocks);
+};
+
+#endif //MessageDigestRIPEMD128_INCLUDED
@@ -0,0 +1,66 @@
+/**
+ * @file MessageDigestRIPEMD160.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestRIPEMD160_INCLUDED
+#define MessageDigestRIPEMD160_INCLUDED
+
+#include "MessageDigest/MessageDigestRIPEMD.hpp"
+
+#include <cstdint>
+#include <string>
+#include <memory>
+
+class MessageDigestRIPEMD160:public MessageDigestRIPEMD {
+public:
+  /// engines for digestBatch()
+  enum class BatchKernel {
+    Serial,  ///< one message after another
+    AVX2,    ///< 8 messages in parallel
+    AVX512   ///< 16 messages in parallel
+  };
+
+  /// length of the binary digest in bytes
+  static constexpr size_t DIGEST_SIZE = 20;
+
+  MessageDigestRIPEMD160();
+  ~MessageDigestRIPEMD160() = default;
+
+  static std::unique_ptr<MessageDigestImpl> create();
+
+  // MessageDigestImpl interface
+public:
+  std::string getAlgorithm() const;
+  void reset();
+  std::unique_ptr<MessageDigestImpl> clone() const;
+  bool cloneInto(MessageDigestImpl& target) const;
+
+  using MessageDigestImpl::digestBatch;
+  void digestBatch(const MessageDigestInput* inputs, size_t numInputs, uint8_t* digests);
+
+  /// select the batch engine, returns false if the CPU lacks support
+  bool setBatchKernel(BatchKernel kernel);
+  BatchKernel getBatchKernel() const;
+
+  static bool isSupported(BatchKernel kernel);
+
+protected:
+  void processBlocks(const void* data, size_t nBlocks);
+
+private:
+  /// compression function of a multi-buffer engine
+  typedef void (*ProcessBlocksFunc)(uint32_t* hash, const uint8_t* const* blocks);
+
+  template<size_t LANES>
+  void digestBatchMultiBuffer(const MessageDigestInput* inputs, size_t numInputs, uint8_t* digests,
+                              ProcessBlocksFunc processBlocks);
+
+  static constexpr uint8_t HASH_SIZE = 5;
+
+  BatchKernel _batchKernel;
+};
+
+#endif //MessageDigestRIPEMD160_INCLUDED
@@ -0,0 +1,38 @@
+/**
+ * @file MessageDigestRIPEMD320.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestRIPEMD320_INCLUDED
+#define MessageDigestRIPEMD320_INCLUDED
+
+#include "MessageDigest/MessageDigestRIPEMD.hpp"
+
+#include <cstdint>
+#include <string>
+#include <memory>
+
+class MessageDigestRIPEMD320:public MessageDigestRIPEMD {
+public:
+  /// length of the binary digest in bytes
+  static constexpr size_t DIGEST_SIZE = 40;
+
+  MessageDigestRIPEMD320();
+  ~MessageDigestRIPEMD320() = default;
+
+  static std::unique_ptr<MessageDigestImpl> create();
+
+  // MessageDigestImpl interface
+public:
+  std::string getAlgorithm() const;
+  void reset();
+  std::unique_ptr<MessageDigestImpl> clone() const;
+  bool cloneInto(MessageDigestImpl& target) const;
+
+protected:
+  void processBlocks(const void* data, size_t nBlocks);
+};
+
+#endif //MessageDigestRIPEMD320_INCLUDED
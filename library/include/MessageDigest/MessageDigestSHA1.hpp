@@ -25,6 +25,15 @@
 
 class MessageDigestSHA1:public MessageDigestImpl {
 public:
+  /// implementations of the compression function
+  enum class Kernel {
+    Generic, ///< portable C++
+    SHANI    ///< Intel SHA extensions
+  };
+
+  /// length of the binary digest in bytes
+  static constexpr size_t DIGEST_SIZE = 20;
+
   MessageDigestSHA1();
   ~MessageDigestSHA1() = default;
 
@@ -33,13 +42,32 @@ public:
   // MessageDigestImpl interface
 public:
   std::string digest();
+  void digestBinary(uint8_t* buffer);
+  size_t getDigestSize() const;
+  size_t getBlockSize() const;
   std::string getAlgorithm() const;
   void update(const void *data, const size_t offset, const size_t len);
   void reset();
+  std::vector<uint8_t> exportState() const;
+  bool importState(const uint8_t* state, size_t size);
+  std::unique_ptr<MessageDigestImpl> clone() const;
+  bool cloneInto(MessageDigestImpl& target) const;
+
+  /// padded on the stack instead of in _buffer
+  using MessageDigestImpl::digestBatch;
+  void digestBatch(const MessageDigestInput* inputs, size_t numInputs, uint8_t* digests);
+
+  /// select the compression function, returns false if the CPU lacks support
+  bool setKernel(Kernel kernel);
+  Kernel getKernel() const;
+
+  static bool isSupported(Kernel kernel);
 
-private:
+protected:
   /// process 64 bytes
   void processBlock(const void* data);
+  /// process nBlocks consecutive blocks, the hot path of update()
+  void processBlocks(const void* data, size_t nBlocks);
   void processBuffer();
 
   static constexpr uint8_t BLOCK_SIZE = 64;
@@ -53,6 +81,7 @@ private:
   uint8_t  _buffer[BLOCK_SIZE];
   uint32_t _hash[HASH_SIZE];
 
+  Kernel   _kernel;
 };
 
 #endif //MessageDigestSHA1_INCLUDED
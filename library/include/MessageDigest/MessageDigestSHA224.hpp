@@ -25,6 +25,9 @@
 
 class MessageDigestSHA224:public MessageDigestSHA256 {
 public:
+  /// length of the binary digest in bytes
+  static constexpr size_t DIGEST_SIZE = 28;
+
   MessageDigestSHA224();
   ~MessageDigestSHA224() = default;
 
@@ -32,9 +35,11 @@ public:
 
   // MessageDigestImpl interface
 public:
-  std::string digest();
+  size_t getDigestSize() const;
   std::string getAlgorithm() const;
   void reset();
+  std::unique_ptr<MessageDigestImpl> clone() const;
+  bool cloneInto(MessageDigestImpl& target) const;
 
 };
 
@@ -0,0 +1,105 @@
+/**
+ * @file MessageDigestSHA256Tree.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestSHA256Tree_INCLUDED
+#define MessageDigestSHA256Tree_INCLUDED
+
+#include "MessageDigest/MessageDigestImpl.hpp"
+
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief SHA-256 Merkle tree over fixed size leaves, registered as "SHA256-TREE"
+ *
+ * The message is split into leaves of LEAF_SIZE bytes, the last one may be
+ * shorter and an empty message is a single empty leaf. The tree is the one of
+ * RFC 6962 section 2.1:
+ *
+ *   leaf = SHA256(0x00 || data)
+ *   node = SHA256(0x01 || left || right)
+ *
+ * where the left subtree of each node holds the largest power of two of the
+ * leaves below it. The digest only depends on the message, not on the number
+ * of threads or the sizes passed to update().
+ *
+ * Large updates are hashed straight from the caller's memory in batches of
+ * two leaves per thread. Smaller ones are collected into up to
+ * PENDING_LEAVES leaves before these are hashed in parallel, which bounds
+ * the buffer that clone() copies. The threads are started on the first batch
+ * and kept until the instance is destroyed, clones start their own.
+ */
+class MessageDigestSHA256Tree:public MessageDigestImpl {
+public:
+  /// bytes per leaf
+  static constexpr size_t LEAF_SIZE = 1024*1024;
+  /// length of the binary digest in bytes
+  static constexpr size_t DIGEST_SIZE = 32;
+  /// full leaves buffered from small updates before they are hashed
+  static constexpr size_t PENDING_LEAVES = 4;
+
+  MessageDigestSHA256Tree();
+  ~MessageDigestSHA256Tree() = default;
+
+  static std::unique_ptr<MessageDigestImpl> create();
+
+  // MessageDigestImpl interface
+public:
+  std::string digest();
+  void digestBinary(uint8_t* buffer);
+  size_t getDigestSize() const;
+  std::string getAlgorithm() const;
+  void update(const void *data, const size_t offset, const size_t len);
+  void reset();
+  std::unique_ptr<MessageDigestImpl> clone() const;
+  bool cloneInto(MessageDigestImpl& target) const;
+
+  /// threads hashing leaves, 0 selects one per core
+  void setNumThreads(unsigned numThreads);
+  unsigned getNumThreads() const;
+
+private:
+  class LeafWorkers;
+
+  /// owns the threads, copies of the digest start without them
+  struct WorkerHandle
+  {
+    WorkerHandle();
+    WorkerHandle(const WorkerHandle&);
+    WorkerHandle& operator=(const WorkerHandle&);
+    ~WorkerHandle();
+
+    std::unique_ptr<LeafWorkers> workers;
+  };
+
+  /// root of a complete subtree
+  struct Subtree
+  {
+    uint8_t  hash[DIGEST_SIZE];
+    uint64_t numLeaves;
+  };
+
+  /// hash numLeaves full leaves in parallel and add them to stack
+  void hashLeaves(const uint8_t* data, size_t numLeaves, std::vector<Subtree>& stack) const;
+  /// add a leaf, merging equal sized subtrees
+  static void pushLeaf(const uint8_t* hash, std::vector<Subtree>& stack);
+
+  unsigned threadCount() const;
+  size_t batchSize() const;
+
+  unsigned _numThreads;
+  mutable WorkerHandle _workers;
+  /// up to PENDING_LEAVES full leaves, followed by the current partial leaf
+  std::vector<uint8_t> _pending;
+  /// complete subtrees, the number of leaves halves from bottom to top
+  std::vector<Subtree> _stack;
+  uint64_t _numBytes;
+};
+
+#endif //MessageDigestSHA256Tree_INCLUDED
@@ -0,0 +1,34 @@
+/**
+ * @file MessageDigestSHA3_224.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestSHA3_224_INCLUDED
+#define MessageDigestSHA3_224_INCLUDED
+
+#include "MessageDigest/MessageDigestKeccak.hpp"
+
+#include <cstdint>
+#include <string>
+#include <memory>
+
+class MessageDigestSHA3_224:public MessageDigestKeccak {
+public:
+  /// length of the binary digest in bytes
+  static constexpr size_t DIGEST_SIZE = 28;
+
+  MessageDigestSHA3_224();
+  ~MessageDigestSHA3_224() = default;
+
+  static std::unique_ptr<MessageDigestImpl> create();
+
+  // MessageDigestImpl interface
+public:
+  std::string getAlgorithm() const;
+  std::unique_ptr<MessageDigestImpl> clone() const;
+  bool cloneInto(MessageDigestImpl& target) const;
+};
+
+#endif //MessageDigestSHA3_224_INCLUDED
@@ -0,0 +1,34 @@
+/**
+ * @file MessageDigestSHA3_256.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestSHA3_256_INCLUDED
+#define MessageDigestSHA3_256_INCLUDED
+
+#include "MessageDigest/MessageDigestKeccak.hpp"
+
+#include <cstdint>
+#include <string>
+#include <memory>
+
+class MessageDigestSHA3_256:public MessageDigestKeccak {
+public:
+  /// length of the binary digest in bytes
+  static constexpr size_t DIGEST_SIZE = 32;
+
+  MessageDigestSHA3_256();
+  ~MessageDigestSHA3_256() = default;
+
+  static std::unique_ptr<MessageDigestImpl> create();
+
+  // MessageDigestImpl interface
+public:
+  std::string getAlgorithm() const;
+  std::unique_ptr<MessageDigestImpl> clone() const;
+  bool cloneInto(MessageDigestImpl& target) const;
+};
+
+#endif //MessageDigestSHA3_256_INCLUDED
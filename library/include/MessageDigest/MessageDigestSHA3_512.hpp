@@ -0,0 +1,34 @@
+/**
+ * @file MessageDigestSHA3_512.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestSHA3_512_INCLUDED
+#define MessageDigestSHA3_512_INCLUDED
+
+#include "MessageDigest/MessageDigestKeccak.hpp"
+
+#include <cstdint>
+#include <string>
+#include <memory>
+
+class MessageDigestSHA3_512:public MessageDigestKeccak {
+public:
+  /// length of the binary digest in bytes
+  static constexpr size_t DIGEST_SIZE = 64;
+
+  MessageDigestSHA3_512();
+  ~MessageDigestSHA3_512() = default;
+
+  static std::unique_ptr<MessageDigestImpl> create();
+
+  // MessageDigestImpl interface
+public:
+  std::string getAlgorithm() const;
+  std::unique_ptr<MessageDigestImpl> clone() const;
+  bool cloneInto(MessageDigestImpl& target) const;
+};
+
+#endif //MessageDigestSHA3_512_INCLUDED
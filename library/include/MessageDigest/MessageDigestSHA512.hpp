@@ -22,9 +22,20 @@
 #include <cstdint>
 #include <string>
 #include <memory>
+#include <vector>
 
 class MessageDigestSHA512:public MessageDigestImpl {
 public:
+  /// engines for digestBatch()
+  enum class BatchKernel {
+    Serial,  ///< one message after another
+    AVX2,    ///< 4 messages in parallel
+    AVX512   ///< 8 messages in parallel
+  };
+
+  /// length of the binary digest in bytes
+  static constexpr size_t DIGEST_SIZE = 64;
+
   MessageDigestSHA512();
   ~MessageDigestSHA512() = default;
 
@@ -33,16 +44,37 @@ public:
   // MessageDigestImpl interface
 public:
   virtual std::string digest();
+  virtual void digestBinary(uint8_t* buffer);
+  virtual size_t getDigestSize() const;
+  virtual size_t getBlockSize() const;
   virtual std::string getAlgorithm() const;
   virtual void reset();
+  virtual std::vector<uint8_t> exportState() const;
+  virtual bool importState(const uint8_t* state, size_t size);
+  virtual std::unique_ptr<MessageDigestImpl> clone() const;
+  virtual bool cloneInto(MessageDigestImpl& target) const;
 
   void update(const void *data, const size_t offset, const size_t len);
 
+  using MessageDigestImpl::digestBatch;
+  void digestBatch(const MessageDigestInput* inputs, size_t numInputs, uint8_t* digests);
+
+  /// select the batch engine, returns false if the CPU lacks support
+  bool setBatchKernel(BatchKernel kernel);
+  BatchKernel getBatchKernel() const;
+
+  static bool isSupported(BatchKernel kernel);
+
 protected:
-  /// process 64 bytes
+  /// process 128 bytes
   virtual void processBlock(const void* data);
+  /// process nBlocks consecutive blocks, the hot path of update()
+  void processBlocks(const void* data, size_t nBlocks);
   virtual void processBuffer();
 
+  /// binary representation of a final hash, truncated to digestSize bytes
+  static void hashToBytes(const uint64_t* hash, uint8_t* buffer, size_t digestSize);
+
   static constexpr uint8_t BLOCK_SIZE = 128;
   static constexpr uint8_t HASH_SIZE = 8;
 
@@ -53,6 +85,18 @@ protected:
 
   uint8_t  _buffer[BLOCK_SIZE];
   uint64_t _hash[HASH_SIZE];
+
+  BatchKernel _batchKernel;
+
+private:
+  /// compression function of a multi-buffer engine
+  typedef void (*ProcessBlocksFunc)(uint64_t* hash, const uint8_t* const* blocks);
+
+  template<size_t LANES>
+  void digestBatchMultiBuffer(const MessageDigestInput* inputs, size_t numInputs, uint8_t* digests,
+                              ProcessBlocksFunc processBlocks);
+  /// one message after another, padded on the stack instead of in _buffer
+  void digestBatchSerial(const MessageDigestInput* inputs, size_t numInputs, uint8_t* digests);
 };
 
 #endif //MessageDigestSHA512_INCLUDED
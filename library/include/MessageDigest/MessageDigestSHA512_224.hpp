@@ -0,0 +1,50 @@
+/**
+ * @file MessageDigestSHA512_224.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ *
+ * based on:
+ * sha256.h and sha256.cpp
+ * from hash-library by Stephan Brume
+ * (http://create.stephan-brumme.com/hash-library)
+ *
+ * Copyright (c) 2014 Stephan Brumme. All rights reserved.
+ * see http://create.stephan-brumme.com/disclaimer.html
+ *
+ */
+#ifndef MessageDigestSHA512_224_INCLUDED
+#define MessageDigestSHA512_224_INCLUDED
+
+#include "MessageDigest/MessageDigestSHA512.hpp"
+
+#include <cstdint>
+#include <string>
+#include <memory>
+
+/**
+ * @brief SHA-512/224 of FIPS 180-4, SHA-512 with its own initial hash,
+ * truncated to 224 bits
+ */
+class MessageDigestSHA512_224:public MessageDigestSHA512 {
+public:
+  /// length of the binary digest in bytes
+  static constexpr size_t DIGEST_SIZE = 28;
+
+  MessageDigestSHA512_224();
+  ~MessageDigestSHA512_224() = default;
+
+  static std::unique_ptr<MessageDigestImpl> create();
+
+  // MessageDigestImpl interface
+public:
+  size_t getDigestSize() const;
+  std::string getAlgorithm() const;
+  void reset();
+  std::unique_ptr<MessageDigestImpl> clone() const;
+  bool cloneInto(MessageDigestImpl& target) const;
+
+};
+
+#endif //MessageDigestSHA512_224_INCLUDED
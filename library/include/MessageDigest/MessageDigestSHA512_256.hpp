@@ -0,0 +1,54 @@
+/**
+ * @file MessageDigestSHA512_256.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ *
+ * based on:
+ * sha256.h and sha256.cpp
+ * from hash-library by Stephan Brume
+ * (http://create.stephan-brumme.com/hash-library)
+ *
+ * Copyright (c) 2014 Stephan Brumme. All rights reserved.
+ * see http://create.stephan-brumme.com/disclaimer.html
+ *
+ */
+#ifndef MessageDigestSHA512_256_INCLUDED
+#define MessageDigestSHA512_256_INCLUDED
+
+#include "MessageDigest/MessageDigestSHA512.hpp"
+
+#include <cstdint>
+#include <string>
+#include <memory>
+
+/**
+ * @brief SHA-512/256 of FIPS 180-4, SHA-512 with its own initial hash,
+ * truncated to 256 bits
+ *
+ * As long as SHA-256 as a digest, but 80 rounds over 128 byte blocks of 64 bit
+ * words are faster per byte than 64 rounds over 64 byte blocks on 64 bit CPUs
+ * without SHA extensions.
+ */
+class MessageDigestSHA512_256:public MessageDigestSHA512 {
+public:
+  /// length of the binary digest in bytes
+  static constexpr size_t DIGEST_SIZE = 32;
+
+  MessageDigestSHA512_256();
+  ~MessageDigestSHA512_256() = default;
+
+  static std::unique_ptr<MessageDigestImpl> create();
+
+  // MessageDigestImpl interface
+public:
+  size_t getDigestSize() const;
+  std::string getAlgorithm() const;
+  void reset();
+  std::unique_ptr<MessageDigestImpl> clone() const;
+  bool cloneInto(MessageDigestImpl& target) const;
+
+};
+
+#endif //MessageDigestSHA512_256_INCLUDED
@@ -0,0 +1,42 @@
+/**
+ * @file MessageDigestSHAKE128.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestSHAKE128_INCLUDED
+#define MessageDigestSHAKE128_INCLUDED
+
+#include "MessageDigest/MessageDigestKeccak.hpp"
+
+#include <cstdint>
+#include <string>
+#include <memory>
+
+/**
+ * @brief Extendable output function SHAKE128
+ *
+ * digest() returns getDigestSize() bytes, squeeze() reads any amount.
+ */
+class MessageDigestSHAKE128:public MessageDigestKeccak {
+public:
+  /// length of the binary digest in bytes, twice the security level by default
+  static constexpr size_t DIGEST_SIZE = 32;
+
+  MessageDigestSHAKE128();
+  ~MessageDigestSHAKE128() = default;
+
+  static std::unique_ptr<MessageDigestImpl> create();
+
+  // MessageDigestImpl interface
+public:
+  std::string getAlgorithm() const;
+  std::unique_ptr<MessageDigestImpl> clone() const;
+  bool cloneInto(MessageDigestImpl& target) const;
+
+  /// length of digest() in bytes, returns false for 0
+  bool setDigestSize(size_t digestSize);
+};
+
+#endif //MessageDigestSHAKE128_INCLUDED
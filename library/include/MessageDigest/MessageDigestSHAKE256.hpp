@@ -0,0 +1,42 @@
+/**
+ * @file MessageDigestSHAKE256.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestSHAKE256_INCLUDED
+#define MessageDigestSHAKE256_INCLUDED
+
+#include "MessageDigest/MessageDigestKeccak.hpp"
+
+#include <cstdint>
+#include <string>
+#include <memory>
+
+/**
+ * @brief Extendable output function SHAKE256
+ *
+ * digest() returns getDigestSize() bytes, squeeze() reads any amount.
+ */
+class MessageDigestSHAKE256:public MessageDigestKeccak {
+public:
+  /// length of the binary digest in bytes, twice the security level by default
+  static constexpr size_t DIGEST_SIZE = 64;
+
+  MessageDigestSHAKE256();
+  ~MessageDigestSHAKE256() = default;
+
+  static std::unique_ptr<MessageDigestImpl> create();
+
+  // MessageDigestImpl interface
+public:
+  std::string getAlgorithm() const;
+  std::unique_ptr<MessageDigestImpl> clone() const;
+  bool cloneInto(MessageDigestImpl& target) const;
+
+  /// length of digest() in bytes, returns false for 0
+  bool setDigestSize(size_t digestSize);
+};
+
+#endif //MessageDigestSHAKE256_INCLUDED
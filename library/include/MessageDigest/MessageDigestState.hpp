@@ -0,0 +1,150 @@
+/**
+ * @file MessageDigestState.h
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+#ifndef MessageDigestState_INCLUDED
+#define MessageDigestState_INCLUDED
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Binary format of MessageDigestImpl::exportState()
+ *
+ *   version   1 byte, currently 1
+ *   length    1 byte, length of the algorithm name
+ *   algorithm as returned by getAlgorithm()
+ *   fields    of the algorithm, integers little endian
+ *
+ * The block hashes store the processed length, their chaining value and the
+ * bytes waiting in _buffer, so a state is at most a few dozen bytes larger
+ * than the hash itself. It doesn't depend on the kernel or the byte order of
+ * the machine that wrote it.
+ */
+class MessageDigestStateWriter {
+public:
+  static constexpr uint8_t VERSION = 1;
+
+  explicit MessageDigestStateWriter(const std::string& algorithm)
+  {
+    write(VERSION);
+    _state.push_back((uint8_t) algorithm.length());
+    _state.insert(_state.end(), algorithm.begin(), algorithm.end());
+  }
+
+  void write(uint8_t value)
+  {
+    _state.push_back(value);
+  }
+
+  void write(uint32_t value)
+  {
+    for (int i = 0; i < 4; i++, value >>= 8)
+      _state.push_back(value & 0xFF);
+  }
+
+  void write(uint64_t value)
+  {
+    for (int i = 0; i < 8; i++, value >>= 8)
+      _state.push_back(value & 0xFF);
+  }
+
+  void write(const uint8_t* data, size_t size)
+  {
+    _state.insert(_state.end(), data, data + size);
+  }
+
+  const std::vector<uint8_t>& state() const
+  {
+    return _state;
+  }
+
+private:
+  std::vector<uint8_t> _state;
+};
+
+/**
+ * @brief Reads a state of MessageDigestStateWriter, every read returns false
+ * once the state is too short
+ */
+class MessageDigestStateReader {
+public:
+  MessageDigestStateReader(const uint8_t* state, size_t size)
+    : _current(state), _remaining(size)
+  {
+  }
+
+  /// true if version and algorithm match
+  bool readHeader(const std::string& algorithm)
+  {
+    uint8_t version, length;
+    if (!read(version) || version != MessageDigestStateWriter::VERSION ||
+        !read(length) || length != algorithm.length() || _remaining < length)
+      return false;
+
+    bool match = std::memcmp(_current, algorithm.data(), length) == 0;
+    _current   += length;
+    _remaining -= length;
+    return match;
+  }
+
+  bool read(uint8_t& value)
+  {
+    if (_remaining < 1)
+      return false;
+    value = *_current++;
+    _remaining--;
+    return true;
+  }
+
+  bool read(uint32_t& value)
+  {
+    if (_remaining < 4)
+      return false;
+    value = 0;
+    for (int i = 3; i >= 0; i--)
+      value = (value << 8) | _current[i];
+    _current   += 4;
+    _remaining -= 4;
+    return true;
+  }
+
+  bool read(uint64_t& value)
+  {
+    if (_remaining < 8)
+      return false;
+    value = 0;
+    for (int i = 7; i >= 0; i--)
+      value = (value << 8) | _current[i];
+    _current   += 8;
+    _remaining -= 8;
+    return true;
+  }
+
+  bool read(uint8_t* data, size_t size)
+  {
+    if (_remaining < size)
+      return false;
+    std::memcpy(data, _current, size);
+    _current   += size;
+    _remaining -= size;
+    return true;
+  }
+
+  /// true if the whole state was read, trailing bytes mean a different format
+  bool atEnd() const
+  {
+    return _remaining == 0;
+  }
+
+private:
+  const uint8_t* _current;
+  size_t         _remaining;
+};
+
+#endif //MessageDigestState_INCLUDED
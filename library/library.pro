@@ -8,23 +8,81 @@ DEFINES += LIBRARY_MESSAGE_DIGEST
 
 QMAKE_CXXFLAGS += -std=c++11
 
+CONFIG += thread
+
 INCLUDEPATH = $$PWD/include/
 
 SOURCES += \
     src/MessageDigest.cpp \
+    src/CpuFeatures.cpp \
+    src/MessageDigestDirectory.cpp \
+    src/MessageDigestEncoding.cpp \
+    src/MessageDigestFile.cpp \
+    src/MessageDigestFileBatch.cpp \
+    src/MessageDigestHMAC.cpp \
+    src/MessageDigestBLAKE2b.cpp \
+    src/MessageDigestBLAKE2bp.cpp \
+    src/MessageDigestBLAKE2s.cpp \
+    src/MessageDigestBLAKE2sp.cpp \
     src/MessageDigestCRC32.cpp \
+    src/MessageDigestCRC32C.cpp \
+    src/MessageDigestKeccak.cpp \
     src/MessageDigestMD5.cpp \
+    src/MessageDigestPBKDF2.cpp \
+    src/MessageDigestRIPEMD.cpp \
+    src/MessageDigestRIPEMD128.cpp \
+    src/MessageDigestRIPEMD160.cpp \
+    src/MessageDigestRIPEMD320.cpp \
     src/MessageDigestSHA1.cpp \
     src/MessageDigestSHA224.cpp \
     src/MessageDigestSHA256.cpp \
-    src/MessageDigestSHA512.cpp
+    src/MessageDigestSHA256Tree.cpp \
+    src/MessageDigestSHA384.cpp \
+    src/MessageDigestSHA3_224.cpp \
+    src/MessageDigestSHA3_256.cpp \
+    src/MessageDigestSHA3_384.cpp \
+    src/MessageDigestSHA3_512.cpp \
+    src/MessageDigestSHA512.cpp \
+    src/MessageDigestSHA512_224.cpp \
+    src/MessageDigestSHA512_256.cpp \
+    src/MessageDigestSHAKE128.cpp \
+    src/MessageDigestSHAKE256.cpp
 
 HEADERS += \
     include/MessageDigest/MessageDigest.hpp \
     include/MessageDigest/MessageDigestImpl.hpp \
+    include/MessageDigest/CpuFeatures.hpp \
+    include/MessageDigest/MessageDigestDirectory.hpp \
+    include/MessageDigest/MessageDigestEncoding.hpp \
+    include/MessageDigest/MessageDigestFile.hpp \
+    include/MessageDigest/MessageDigestFileBatch.hpp \
+    include/MessageDigest/MessageDigestHMAC.hpp \
+    include/MessageDigest/MessageDigestBLAKE2b.hpp \
+    include/MessageDigest/MessageDigestBLAKE2bp.hpp \
+    include/MessageDigest/MessageDigestBLAKE2s.hpp \
+    include/MessageDigest/MessageDigestBLAKE2sp.hpp \
+    include/MessageDigest/MessageDigestMultiBuffer.hpp \
+    include/MessageDigest/MessageDigestState.hpp \
     include/MessageDigest/MessageDigestCRC32.hpp \
+    include/MessageDigest/MessageDigestCRC32C.hpp \
+    include/MessageDigest/MessageDigestKeccak.hpp \
     include/MessageDigest/MessageDigestMD5.hpp \
+    include/MessageDigest/MessageDigestPBKDF2.hpp \
+    include/MessageDigest/MessageDigestRIPEMD.hpp \
+    include/MessageDigest/MessageDigestRIPEMD128.hpp \
+    include/MessageDigest/MessageDigestRIPEMD160.hpp \
+    include/MessageDigest/MessageDigestRIPEMD320.hpp \
     include/MessageDigest/MessageDigestSHA1.hpp \
     include/MessageDigest/MessageDigestSHA224.hpp \
     include/MessageDigest/MessageDigestSHA256.hpp \
-    include/MessageDigest/MessageDigestSHA512.hpp
+    include/MessageDigest/MessageDigestSHA256Tree.hpp \
+    include/MessageDigest/MessageDigestSHA384.hpp \
+    include/MessageDigest/MessageDigestSHA3_224.hpp \
+    include/MessageDigest/MessageDigestSHA3_256.hpp \
+    include/MessageDigest/MessageDigestSHA3_384.hpp \
+    include/MessageDigest/MessageDigestSHA3_512.hpp \
+    include/MessageDigest/MessageDigestSHA512.hpp \
+    include/MessageDigest/MessageDigestSHA512_224.hpp \
+    include/MessageDigest/MessageDigestSHA512_256.hpp \
+    include/MessageDigest/MessageDigestSHAKE128.hpp \
+    include/MessageDigest/MessageDigestSHAKE256.hpp
@@ -0,0 +1,131 @@
+/**
+ * @file CpuFeatures.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/CpuFeatures.hpp"
+
+#include <cstdint>
+
+#ifdef MESSAGEDIGEST_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace
+{
+  struct Features
+  {
+    bool ssse3   = false;
+    bool sse41   = false;
+    bool sse42   = false;
+    bool pclmul  = false;
+    bool sha     = false;
+    bool avx2    = false;
+    bool avx512f = false;
+
+    Features()
+    {
+#ifdef MESSAGEDIGEST_X86
+      uint32_t regs[4];
+
+      cpuid(0, regs);
+      uint32_t maxLeaf = regs[0];
+
+      cpuid(1, regs);
+      ssse3  = (regs[2] & (1u <<  9)) != 0;
+      sse41  = (regs[2] & (1u << 19)) != 0;
+      sse42  = (regs[2] & (1u << 20)) != 0;
+      pclmul = (regs[2] & (1u <<  1)) != 0;
+
+      // the OS must save the YMM/ZMM registers on context switches
+      bool osxsave = (regs[2] & (1u << 27)) != 0;
+      uint64_t xcr0 = osxsave ? xgetbv() : 0;
+      bool ymmState = (xcr0 & 0x06) == 0x06;
+      bool zmmState = (xcr0 & 0xE6) == 0xE6;
+
+      if (maxLeaf >= 7)
+      {
+        cpuid(7, regs);
+        sha     = (regs[1] & (1u << 29)) != 0;
+        avx2    = (regs[1] & (1u <<  5)) != 0 && ymmState;
+        avx512f = (regs[1] & (1u << 16)) != 0 && zmmState;
+      }
+#endif
+    }
+
+#ifdef MESSAGEDIGEST_X86
+    /// regs = { eax, ebx, ecx, edx }
+    static void cpuid(uint32_t leaf, uint32_t regs[4])
+    {
+#ifdef _MSC_VER
+      int info[4];
+      __cpuidex(info, (int) leaf, 0);
+      for (int i = 0; i < 4; i++)
+        regs[i] = (uint32_t) info[i];
+#else
+      __cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+    }
+
+    /// extended control register 0, which state components the OS enabled
+    static uint64_t xgetbv()
+    {
+#ifdef _MSC_VER
+      return _xgetbv(0);
+#else
+      uint32_t eax, edx;
+      __asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+      return ((uint64_t) edx << 32) | eax;
+#endif
+    }
+#endif
+  };
+
+  const Features& features()
+  {
+    static const Features detected;
+    return detected;
+  }
+}
+
+bool CpuFeatures::hasSSSE3()
+{
+  return features().ssse3;
+}
+
+bool CpuFeatures::hasSSE41()
+{
+  return features().sse41;
+}
+
+bool CpuFeatures::hasSSE42()
+{
+  return features().sse42;
+}
+
+bool CpuFeatures::hasPCLMUL()
+{
+  return features().pclmul;
+}
+
+bool CpuFeatures::hasSHA()
+{
+  return features().sha;
+}
+
+bool CpuFeatures::hasAVX2()
+{
+  return features().avx2;
+}
+
+bool CpuFeatures::hasAVX512F()
+{
+  return features().avx512f;
+}
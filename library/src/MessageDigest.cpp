@@ -7,47 +7,152 @@
  */
 #include "MessageDigest/MessageDigest.hpp"
 #include "MessageDigest/MessageDigestImpl.hpp"
+#include "MessageDigest/MessageDigestFile.hpp"
 #include <utility>
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+namespace
+{
+  /// variant forced by MESSAGEDIGEST_VARIANT="ALGORITHM=variant,..."
+  std::string variantFromEnvironment(const std::string& algorithm)
+  {
+    const char* env = std::getenv("MESSAGEDIGEST_VARIANT");
+    if (env == nullptr)
+      return "";
+
+    std::istringstream entries(env);
+    std::string entry;
+    while (std::getline(entries, entry, ','))
+    {
+      size_t separator = entry.find('=');
+      if (separator != std::string::npos && entry.substr(0, separator) == algorithm)
+        return entry.substr(separator + 1);
+    }
+    return "";
+  }
+}
 
 std::unique_ptr<MessageDigest> MessageDigest::createInstance(const std::string &algorithm)
 {
-  MessageDigestImplMap& implMap = getImplementationMap();
-  auto it = implMap.find(algorithm);
+  std::map<std::string,std::string>& preferred = getPreferredVariants();
+  auto it = preferred.find(algorithm);
+
+  if(it != preferred.end())
+    return createInstance(algorithm, it->second);
+  return createInstance(algorithm, variantFromEnvironment(algorithm));
+}
+
+std::unique_ptr<MessageDigest> MessageDigest::createInstance(const std::string &algorithm, const std::string &variant)
+{
+  MessageDigestVariantMap& variantMap = getVariantMap();
+  auto it = variantMap.find(algorithm);
+  if(it == variantMap.end())
+    return nullptr;
 
-  std::unique_ptr<MessageDigest> digestPtr;
-  if(it == implMap.end()){
-      digestPtr = nullptr;
-  }else{
-      digestPtr = std::unique_ptr<MessageDigest>(new MessageDigest());
-      digestPtr->mDigestImpl = it->second();
+  // ordered by rank, take the first one that fits
+  for(const auto& candidate : it->second){
+      if(!variant.empty() && candidate.name != variant)
+        continue;
+      if(!candidate.isSupported())
+        continue;
+
+      std::unique_ptr<MessageDigest> digestPtr(new MessageDigest());
+      digestPtr->mDigestImpl = candidate.create();
+      digestPtr->mVariant = candidate.name;
+      return digestPtr;
     }
 
-  return digestPtr;
+  return nullptr;
 }
 
 void MessageDigest::registerAlgorithm(const std::string &name, MessageDigestImplCreatorFunc createFunc)
 {
-  MessageDigestImplMap& implMap = getImplementationMap();
-  implMap.insert(std::make_pair(name,createFunc));
+  registerVariant(name, "generic", 0, []() { return true; }, createFunc);
+}
+
+void MessageDigest::registerVariant(const std::string &algorithm, const std::string &variant, int rank,
+                                    MessageDigestSupportedFunc supportedFunc,
+                                    MessageDigestImplCreatorFunc createFunc)
+{
+  std::vector<MessageDigestVariant>& variants = getVariantMap()[algorithm];
+
+  // first registration wins, like std::map::insert
+  for(const auto& existing : variants){
+      if(existing.name == variant)
+        return;
+    }
+
+  MessageDigestVariant entry = { variant, rank, supportedFunc, createFunc };
+  auto position = std::find_if(variants.begin(), variants.end(),
+                               [rank](const MessageDigestVariant& other) { return other.rank < rank; });
+  variants.insert(position, entry);
 }
 
 std::vector<std::string>
 MessageDigest::getAlgorithms()
 {
   std::vector<std::string> algorithms;
-  MessageDigestImplMap& implMap = getImplementationMap();
+  MessageDigestVariantMap& variantMap = getVariantMap();
 
-  for(auto it = implMap.begin(); it != implMap.end(); it++ ){
+  for(auto it = variantMap.begin(); it != variantMap.end(); it++ ){
       algorithms.push_back(it->first);
   }
 
   return algorithms;
 }
 
-MessageDigestImplMap& MessageDigest::getImplementationMap()
+std::string MessageDigest::hashFile(const std::string &fileName, const std::string &algorithm)
+{
+  std::unique_ptr<MessageDigest> digest = createInstance(algorithm);
+  if (!digest || !digest->updateFile(fileName))
+    return "";
+  return digest->digest();
+}
+
+std::vector<std::string> MessageDigest::getVariants(const std::string &algorithm)
 {
-  static MessageDigestImplMap implMap;
-  return implMap;
+  std::vector<std::string> variants;
+  MessageDigestVariantMap& variantMap = getVariantMap();
+  auto it = variantMap.find(algorithm);
+  if(it == variantMap.end())
+    return variants;
+
+  for(const auto& variant : it->second){
+      if(variant.isSupported())
+        variants.push_back(variant.name);
+  }
+
+  return variants;
+}
+
+bool MessageDigest::setPreferredVariant(const std::string &algorithm, const std::string &variant)
+{
+  std::map<std::string,std::string>& preferred = getPreferredVariants();
+  if(variant.empty()){
+      preferred.erase(algorithm);
+      return true;
+  }
+
+  std::vector<std::string> variants = getVariants(algorithm);
+  if(std::find(variants.begin(), variants.end(), variant) == variants.end())
+    return false;
+
+  preferred[algorithm] = variant;
+  return true;
+}
+
+MessageDigestVariantMap& MessageDigest::getVariantMap()
+{
+  static MessageDigestVariantMap variantMap;
+  return variantMap;
+}
+
+std::map<std::string,std::string>& MessageDigest::getPreferredVariants()
+{
+  static std::map<std::string,std::string> preferred;
+  return preferred;
 }
 
 //**************************************************************
@@ -58,11 +163,31 @@ std::string MessageDigest::digest()
   return mDigestImpl->digest();
 }
 
+void MessageDigest::digestBinary(uint8_t *buffer)
+{
+  mDigestImpl->digestBinary(buffer);
+}
+
+size_t MessageDigest::getDigestSize() const
+{
+  return mDigestImpl->getDigestSize();
+}
+
+size_t MessageDigest::getBlockSize() const
+{
+  return mDigestImpl->getBlockSize();
+}
+
 std::string MessageDigest::getAlgorithm() const
 {
   return mDigestImpl->getAlgorithm();
 }
 
+std::string MessageDigest::getVariant() const
+{
+  return mVariant;
+}
+
 void MessageDigest::update(const void *data, size_t offset, size_t len)
 {
   mDigestImpl->update(data,offset,len);
@@ -83,3 +208,55 @@ void MessageDigest::update(const std::string &data)
   mDigestImpl->update(data);
 }
 
+bool MessageDigest::updateFile(const std::string &fileName)
+{
+  return MessageDigestFile::update(*mDigestImpl, fileName);
+}
+
+bool MessageDigest::updateFile(const std::string &fileName, uint8_t *buffer, size_t bufferSize)
+{
+  return MessageDigestFile::update(*mDigestImpl, fileName, buffer, bufferSize);
+}
+
+std::vector<std::string> MessageDigest::digestBatch(const std::vector<MessageDigestInput> &inputs)
+{
+  return mDigestImpl->digestBatch(inputs);
+}
+
+void MessageDigest::digestBatch(const MessageDigestInput *inputs, size_t numInputs, uint8_t *digests)
+{
+  mDigestImpl->digestBatch(inputs, numInputs, digests);
+}
+
+std::vector<uint8_t> MessageDigest::exportState() const
+{
+  return mDigestImpl->exportState();
+}
+
+bool MessageDigest::importState(const uint8_t *state, size_t size)
+{
+  return mDigestImpl->importState(state, size);
+}
+
+bool MessageDigest::importState(const std::vector<uint8_t> &state)
+{
+  return importState(state.data(), state.size());
+}
+
+std::unique_ptr<MessageDigest> MessageDigest::clone() const
+{
+  std::unique_ptr<MessageDigest> digestPtr(new MessageDigest());
+  digestPtr->mDigestImpl = mDigestImpl->clone();
+  digestPtr->mVariant = mVariant;
+  return digestPtr;
+}
+
+bool MessageDigest::cloneInto(MessageDigest &target) const
+{
+  if (!mDigestImpl->cloneInto(*target.mDigestImpl))
+    return false;
+
+  // the kernel was copied along with the state
+  target.mVariant = mVariant;
+  return true;
+}
@@ -0,0 +1,572 @@
+/**
+ * @file MessageDigestBLAKE2b.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/MessageDigestBLAKE2b.hpp"
+#include "MessageDigest/MessageDigest.hpp"
+#include "MessageDigest/MessageDigestEncoding.hpp"
+#include "MessageDigest/CpuFeatures.hpp"
+#include "MessageDigest/MessageDigestState.hpp"
+
+#include <cstring>
+
+#ifdef MESSAGEDIGEST_X86
+#include <immintrin.h>
+#endif
+
+// big endian architectures need #define __BYTE_ORDER __BIG_ENDIAN
+#ifndef _MSC_VER
+#include <endian.h>
+#endif
+
+static MessageDigestKernelRegistrar<MessageDigestBLAKE2b> registrar("BLAKE2b", "generic", 0, MessageDigestBLAKE2b::Kernel::Generic);
+static MessageDigestKernelRegistrar<MessageDigestBLAKE2b> registrarSSE41("BLAKE2b", "sse41", 10, MessageDigestBLAKE2b::Kernel::SSE41);
+static MessageDigestKernelRegistrar<MessageDigestBLAKE2b> registrarAVX2("BLAKE2b", "avx2", 20, MessageDigestBLAKE2b::Kernel::AVX2);
+
+namespace
+{
+  /* Initialization vector of RFC 7693 section 2.6, the one of SHA-512 */
+  static constexpr uint64_t IV[] = {
+    0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
+    0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179
+  };
+
+  /* Message schedule of RFC 7693 section 2.7, rounds 10 and 11 repeat 0 and 1 */
+  static constexpr uint8_t SIGMA[12][16] = {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+    { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+    {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+    {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+    {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+    { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+    { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+    {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+    { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 }
+  };
+
+  /// compression of nBlocks blocks, counter includes the first one and grows by a block per further one
+  typedef void (*ProcessBlocksFunc)(uint64_t* hash, const uint8_t* data, size_t nBlocks,
+                                    uint64_t counter, uint64_t lastBlock, uint64_t lastNode);
+
+  /// little endian word of a block
+  inline uint64_t load64(const uint8_t* data)
+  {
+    uint64_t word;
+    std::memcpy(&word, data, 8);
+#if defined(__BYTE_ORDER) && (__BYTE_ORDER != 0) && (__BYTE_ORDER == __BIG_ENDIAN)
+    word = swap64(word);
+#endif
+    return word;
+  }
+
+  /**
+   * @brief The circular right shift operation
+   */
+  inline uint64_t rotateRight(uint64_t a, uint64_t c)
+  {
+    return (a >> c) | (a << (64 - c));
+  }
+
+  /// mixing function G of RFC 7693 section 3.1
+  inline void mix(uint64_t& a, uint64_t& b, uint64_t& c, uint64_t& d, uint64_t x, uint64_t y)
+  {
+    a = a + b + x; d = rotateRight(d ^ a, 32);
+    c = c + d;     b = rotateRight(b ^ c, 24);
+    a = a + b + y; d = rotateRight(d ^ a, 16);
+    c = c + d;     b = rotateRight(b ^ c, 63);
+  }
+
+  /**
+   * @brief Compression function of Kernel::Generic
+   */
+  MESSAGEDIGEST_NOINLINE
+  void processBlocksGeneric(uint64_t* hash, const uint8_t* data, size_t nBlocks,
+                            uint64_t counter, uint64_t lastBlock, uint64_t lastNode)
+  {
+    for (; nBlocks > 0; nBlocks--, data += 128, counter += 128)
+    {
+      uint64_t m[16];
+      for (int i = 0; i < 16; i++)
+        m[i] = load64(data + 8*i);
+
+      uint64_t v[16];
+      for (int i = 0; i < 8; i++)
+      {
+        v[i]     = hash[i];
+        v[i + 8] = IV[i];
+      }
+      v[12] ^= counter;
+      v[14] ^= lastBlock;
+      v[15] ^= lastNode;
+
+      for (int round = 0; round < 12; round++)
+      {
+        const uint8_t* s = SIGMA[round];
+
+        // columns
+        mix(v[0], v[4], v[ 8], v[12], m[s[ 0]], m[s[ 1]]);
+        mix(v[1], v[5], v[ 9], v[13], m[s[ 2]], m[s[ 3]]);
+        mix(v[2], v[6], v[10], v[14], m[s[ 4]], m[s[ 5]]);
+        mix(v[3], v[7], v[11], v[15], m[s[ 6]], m[s[ 7]]);
+        // diagonals
+        mix(v[0], v[5], v[10], v[15], m[s[ 8]], m[s[ 9]]);
+        mix(v[1], v[6], v[11], v[12], m[s[10]], m[s[11]]);
+        mix(v[2], v[7], v[ 8], v[13], m[s[12]], m[s[13]]);
+        mix(v[3], v[4], v[ 9], v[14], m[s[14]], m[s[15]]);
+      }
+
+      for (int i = 0; i < 8; i++)
+        hash[i] ^= v[i] ^ v[i + 8];
+    }
+  }
+
+#ifdef MESSAGEDIGEST_X86
+  // row kernels: row1 = v0..v3, row2 = v4..v7, row3 = v8..v11, row4 = v12..v15
+
+  /// words i and j of a block as one register, i in the lower half
+  MESSAGEDIGEST_TARGET("sse4.1")
+  MESSAGEDIGEST_ALWAYS_INLINE __m128i loadWordsSSE41(const uint8_t* data, int i, int j)
+  {
+    return _mm_set_epi64x((long long) load64(data + 8*j), (long long) load64(data + 8*i));
+  }
+
+  /// G on two columns, the halves of the rows are independent
+  MESSAGEDIGEST_TARGET("sse4.1")
+  MESSAGEDIGEST_ALWAYS_INLINE void mixSSE41(__m128i& a, __m128i& b, __m128i& c, __m128i& d, __m128i x, __m128i y)
+  {
+    const __m128i rotate24 = _mm_setr_epi8(3,4,5,6,7,0,1,2, 11,12,13,14,15,8,9,10);
+    const __m128i rotate16 = _mm_setr_epi8(2,3,4,5,6,7,0,1, 10,11,12,13,14,15,8,9);
+
+    a = _mm_add_epi64(_mm_add_epi64(a, b), x);
+    d = _mm_shuffle_epi32(_mm_xor_si128(d, a), _MM_SHUFFLE(2,3,0,1));
+    c = _mm_add_epi64(c, d);
+    b = _mm_shuffle_epi8(_mm_xor_si128(b, c), rotate24);
+    a = _mm_add_epi64(_mm_add_epi64(a, b), y);
+    d = _mm_shuffle_epi8(_mm_xor_si128(d, a), rotate16);
+    c = _mm_add_epi64(c, d);
+    b = _mm_xor_si128(b, c);
+    b = _mm_xor_si128(_mm_srli_epi64(b, 63), _mm_add_epi64(b, b));
+  }
+
+  /**
+   * @brief One round on rows held as low and high halves,
+   * row[0], row[1] is row1 and so on
+   */
+  MESSAGEDIGEST_TARGET("sse4.1")
+  MESSAGEDIGEST_ALWAYS_INLINE void roundSSE41(__m128i* row, const uint8_t* data, const uint8_t* s)
+  {
+    mixSSE41(row[0], row[2], row[4], row[6], loadWordsSSE41(data, s[ 0], s[ 2]), loadWordsSSE41(data, s[ 1], s[ 3]));
+    mixSSE41(row[1], row[3], row[5], row[7], loadWordsSSE41(data, s[ 4], s[ 6]), loadWordsSSE41(data, s[ 5], s[ 7]));
+
+    // diagonalize: rotate row2 left by one word, row3 by two, row4 by three
+    __m128i t0 = _mm_alignr_epi8(row[3], row[2], 8);
+    __m128i t1 = _mm_alignr_epi8(row[2], row[3], 8);
+    row[2] = t0; row[3] = t1;
+    t0 = row[4]; row[4] = row[5]; row[5] = t0;
+    t0 = _mm_alignr_epi8(row[6], row[7], 8);
+    t1 = _mm_alignr_epi8(row[7], row[6], 8);
+    row[6] = t0; row[7] = t1;
+
+    mixSSE41(row[0], row[2], row[4], row[6], loadWordsSSE41(data, s[ 8], s[10]), loadWordsSSE41(data, s[ 9], s[11]));
+    mixSSE41(row[1], row[3], row[5], row[7], loadWordsSSE41(data, s[12], s[14]), loadWordsSSE41(data, s[13], s[15]));
+
+    // and back
+    t0 = _mm_alignr_epi8(row[2], row[3], 8);
+    t1 = _mm_alignr_epi8(row[3], row[2], 8);
+    row[2] = t0; row[3] = t1;
+    t0 = row[4]; row[4] = row[5]; row[5] = t0;
+    t0 = _mm_alignr_epi8(row[7], row[6], 8);
+    t1 = _mm_alignr_epi8(row[6], row[7], 8);
+    row[6] = t0; row[7] = t1;
+  }
+
+  /// compression function of Kernel::SSE41
+  MESSAGEDIGEST_TARGET("sse4.1")
+  void processBlocksSSE41(uint64_t* hash, const uint8_t* data, size_t nBlocks,
+                          uint64_t counter, uint64_t lastBlock, uint64_t lastNode)
+  {
+    __m128i h[4];
+    for (int i = 0; i < 4; i++)
+      h[i] = _mm_loadu_si128((const __m128i*) (hash + 2*i));
+
+    for (; nBlocks > 0; nBlocks--, data += 128, counter += 128)
+    {
+      __m128i row[8];
+      for (int i = 0; i < 4; i++)
+      {
+        row[i]     = h[i];
+        row[i + 4] = _mm_loadu_si128((const __m128i*) (IV + 2*i));
+      }
+      row[6] = _mm_xor_si128(row[6], _mm_set_epi64x(0, (long long) counter));
+      row[7] = _mm_xor_si128(row[7], _mm_set_epi64x((long long) lastNode, (long long) lastBlock));
+
+      // written out, so that the message indices are constants
+      roundSSE41(row, data, SIGMA[ 0]);
+      roundSSE41(row, data, SIGMA[ 1]);
+      roundSSE41(row, data, SIGMA[ 2]);
+      roundSSE41(row, data, SIGMA[ 3]);
+      roundSSE41(row, data, SIGMA[ 4]);
+      roundSSE41(row, data, SIGMA[ 5]);
+      roundSSE41(row, data, SIGMA[ 6]);
+      roundSSE41(row, data, SIGMA[ 7]);
+      roundSSE41(row, data, SIGMA[ 8]);
+      roundSSE41(row, data, SIGMA[ 9]);
+      roundSSE41(row, data, SIGMA[10]);
+      roundSSE41(row, data, SIGMA[11]);
+
+      for (int i = 0; i < 4; i++)
+        h[i] = _mm_xor_si128(h[i], _mm_xor_si128(row[i], row[i + 4]));
+    }
+
+    for (int i = 0; i < 4; i++)
+      _mm_storeu_si128((__m128i*) (hash + 2*i), h[i]);
+  }
+
+  /// words i, j, k and l of a block as one register, i in the lowest quarter
+  MESSAGEDIGEST_TARGET("avx2")
+  MESSAGEDIGEST_ALWAYS_INLINE __m256i loadWordsAVX2(const uint8_t* data, int i, int j, int k, int l)
+  {
+    return _mm256_set_epi64x((long long) load64(data + 8*l), (long long) load64(data + 8*k),
+                             (long long) load64(data + 8*j), (long long) load64(data + 8*i));
+  }
+
+  /// G on all four columns or diagonals
+  MESSAGEDIGEST_TARGET("avx2")
+  MESSAGEDIGEST_ALWAYS_INLINE void mixAVX2(__m256i& a, __m256i& b, __m256i& c, __m256i& d, __m256i x, __m256i y)
+  {
+    const __m256i rotate24 = _mm256_setr_epi8(3,4,5,6,7,0,1,2, 11,12,13,14,15,8,9,10,
+                                              3,4,5,6,7,0,1,2, 11,12,13,14,15,8,9,10);
+    const __m256i rotate16 = _mm256_setr_epi8(2,3,4,5,6,7,0,1, 10,11,12,13,14,15,8,9,
+                                              2,3,4,5,6,7,0,1, 10,11,12,13,14,15,8,9);
+
+    a = _mm256_add_epi64(_mm256_add_epi64(a, b), x);
+    d = _mm256_shuffle_epi32(_mm256_xor_si256(d, a), _MM_SHUFFLE(2,3,0,1));
+    c = _mm256_add_epi64(c, d);
+    b = _mm256_shuffle_epi8(_mm256_xor_si256(b, c), rotate24);
+    a = _mm256_add_epi64(_mm256_add_epi64(a, b), y);
+    d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rotate16);
+    c = _mm256_add_epi64(c, d);
+    b = _mm256_xor_si256(b, c);
+    b = _mm256_xor_si256(_mm256_srli_epi64(b, 63), _mm256_add_epi64(b, b));
+  }
+
+  /// one round on rows held in one register each
+  MESSAGEDIGEST_TARGET("avx2")
+  MESSAGEDIGEST_ALWAYS_INLINE void roundAVX2(__m256i& row1, __m256i& row2, __m256i& row3, __m256i& row4,
+                                             const uint8_t* data, const uint8_t* s)
+  {
+    mixAVX2(row1, row2, row3, row4, loadWordsAVX2(data, s[0], s[2], s[4], s[6]), loadWordsAVX2(data, s[1], s[3], s[5], s[7]));
+
+    // diagonalize: rotate row2 left by one word, row3 by two, row4 by three
+    row2 = _mm256_permute4x64_epi64(row2, _MM_SHUFFLE(0,3,2,1));
+    row3 = _mm256_permute4x64_epi64(row3, _MM_SHUFFLE(1,0,3,2));
+    row4 = _mm256_permute4x64_epi64(row4, _MM_SHUFFLE(2,1,0,3));
+
+    mixAVX2(row1, row2, row3, row4, loadWordsAVX2(data, s[8], s[10], s[12], s[14]), loadWordsAVX2(data, s[9], s[11], s[13], s[15]));
+
+    // and back
+    row2 = _mm256_permute4x64_epi64(row2, _MM_SHUFFLE(2,1,0,3));
+    row3 = _mm256_permute4x64_epi64(row3, _MM_SHUFFLE(1,0,3,2));
+    row4 = _mm256_permute4x64_epi64(row4, _MM_SHUFFLE(0,3,2,1));
+  }
+
+  /// compression function of Kernel::AVX2
+  MESSAGEDIGEST_TARGET("avx2")
+  void processBlocksAVX2(uint64_t* hash, const uint8_t* data, size_t nBlocks,
+                         uint64_t counter, uint64_t lastBlock, uint64_t lastNode)
+  {
+    __m256i h1 = _mm256_loadu_si256((const __m256i*) (hash + 0));
+    __m256i h2 = _mm256_loadu_si256((const __m256i*) (hash + 4));
+
+    for (; nBlocks > 0; nBlocks--, data += 128, counter += 128)
+    {
+      __m256i row1 = h1;
+      __m256i row2 = h2;
+      __m256i row3 = _mm256_loadu_si256((const __m256i*) (IV + 0));
+      __m256i row4 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*) (IV + 4)),
+                                      _mm256_set_epi64x((long long) lastNode, (long long) lastBlock, 0, (long long) counter));
+
+      // written out, so that the message indices are constants
+      roundAVX2(row1, row2, row3, row4, data, SIGMA[ 0]);
+      roundAVX2(row1, row2, row3, row4, data, SIGMA[ 1]);
+      roundAVX2(row1, row2, row3, row4, data, SIGMA[ 2]);
+      roundAVX2(row1, row2, row3, row4, data, SIGMA[ 3]);
+      roundAVX2(row1, row2, row3, row4, data, SIGMA[ 4]);
+      roundAVX2(row1, row2, row3, row4, data, SIGMA[ 5]);
+      roundAVX2(row1, row2, row3, row4, data, SIGMA[ 6]);
+      roundAVX2(row1, row2, row3, row4, data, SIGMA[ 7]);
+      roundAVX2(row1, row2, row3, row4, data, SIGMA[ 8]);
+      roundAVX2(row1, row2, row3, row4, data, SIGMA[ 9]);
+      roundAVX2(row1, row2, row3, row4, data, SIGMA[10]);
+      roundAVX2(row1, row2, row3, row4, data, SIGMA[11]);
+
+      h1 = _mm256_xor_si256(h1, _mm256_xor_si256(row1, row3));
+      h2 = _mm256_xor_si256(h2, _mm256_xor_si256(row2, row4));
+    }
+
+    _mm256_storeu_si256((__m256i*) (hash + 0), h1);
+    _mm256_storeu_si256((__m256i*) (hash + 4), h2);
+  }
+#endif
+
+  ProcessBlocksFunc selectKernel(MessageDigestBLAKE2b::Kernel kernel)
+  {
+    switch (kernel)
+    {
+#ifdef MESSAGEDIGEST_X86
+    case MessageDigestBLAKE2b::Kernel::SSE41:
+      return processBlocksSSE41;
+    case MessageDigestBLAKE2b::Kernel::AVX2:
+      return processBlocksAVX2;
+#endif
+    default:
+      return processBlocksGeneric;
+    }
+  }
+}
+
+MessageDigestBLAKE2b::MessageDigestBLAKE2b()
+  : _digestSize(DIGEST_SIZE),
+    _keyLength(0)
+{
+  if (isSupported(Kernel::AVX2))
+    _kernel = Kernel::AVX2;
+  else if (isSupported(Kernel::SSE41))
+    _kernel = Kernel::SSE41;
+  else
+    _kernel = Kernel::Generic;
+
+  reset();
+}
+
+std::string MessageDigestBLAKE2b::getAlgorithm() const
+{
+  return "BLAKE2b";
+}
+
+void MessageDigestBLAKE2b::reset()
+{
+  initHash(_hash, _digestSize, _keyLength);
+  _numBytes = 0;
+
+  // the key is the first block, padded with zeros
+  _bufferSize = 0;
+  if (_keyLength > 0)
+  {
+    std::memset(_buffer, 0, BLOCK_SIZE);
+    std::memcpy(_buffer, _key, _keyLength);
+    _bufferSize = BLOCK_SIZE;
+  }
+}
+
+void MessageDigestBLAKE2b::initHash(uint64_t *hash, size_t digestSize, size_t keyLength,
+                                    uint8_t fanout, uint8_t depth, uint64_t nodeOffset,
+                                    uint8_t nodeDepth, uint8_t innerLength)
+{
+  // parameter block of RFC 7693 section 2.5, salt and personalization are zero
+  for (size_t i = 0; i < HASH_SIZE; i++)
+    hash[i] = IV[i];
+  hash[0] ^= digestSize | (keyLength << 8) | ((uint64_t) fanout << 16) | ((uint64_t) depth << 24);
+  hash[1] ^= nodeOffset;
+  hash[2] ^= nodeDepth | ((uint64_t) innerLength << 8);
+}
+
+bool MessageDigestBLAKE2b::setDigestSize(size_t digestSize)
+{
+  if (digestSize == 0 || digestSize > DIGEST_SIZE)
+    return false;
+
+  _digestSize = digestSize;
+  reset();
+  return true;
+}
+
+bool MessageDigestBLAKE2b::setKey(const void *key, size_t keyLength)
+{
+  if (keyLength > MAX_KEY_SIZE)
+    return false;
+
+  std::memset(_key, 0, MAX_KEY_SIZE);
+  if (keyLength > 0)
+    std::memcpy(_key, key, keyLength);
+  _keyLength = keyLength;
+  reset();
+  return true;
+}
+
+std::vector<uint8_t> MessageDigestBLAKE2b::exportState() const
+{
+  // a keyed state is as secret as the key, a fresh one holds the key block
+  MessageDigestStateWriter writer(getAlgorithm());
+  writer.write((uint8_t) _digestSize);
+  writer.write(_numBytes);
+  for (size_t i = 0; i < HASH_SIZE; i++)
+    writer.write(_hash[i]);
+  writer.write((uint8_t) _bufferSize);
+  writer.write(_buffer, _bufferSize);
+  return writer.state();
+}
+
+bool MessageDigestBLAKE2b::importState(const uint8_t *state, size_t size)
+{
+  MessageDigestStateReader reader(state, size);
+  uint8_t  digestSize;
+  uint64_t numBytes;
+  uint64_t hash[HASH_SIZE];
+  uint8_t  bufferSize;
+  uint8_t  buffer[BLOCK_SIZE];
+
+  if (!reader.readHeader(getAlgorithm()) || !reader.read(digestSize) || digestSize != _digestSize ||
+      !reader.read(numBytes) || numBytes % BLOCK_SIZE != 0)
+    return false;
+  for (size_t i = 0; i < HASH_SIZE; i++)
+    if (!reader.read(hash[i]))
+      return false;
+  // only the empty message leaves the buffer empty
+  if (!reader.read(bufferSize) || bufferSize > BLOCK_SIZE || (bufferSize == 0 && numBytes > 0) ||
+      !reader.read(buffer, bufferSize) || !reader.atEnd())
+    return false;
+
+  _numBytes   = numBytes;
+  _bufferSize = bufferSize;
+  std::memcpy(_hash, hash, sizeof(_hash));
+  std::memcpy(_buffer, buffer, bufferSize);
+  return true;
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestBLAKE2b::create()
+{
+  return std::unique_ptr<MessageDigestImpl>(new MessageDigestBLAKE2b());
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestBLAKE2b::clone() const
+{
+  return cloneDigest(*this);
+}
+
+bool MessageDigestBLAKE2b::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
+
+bool MessageDigestBLAKE2b::setKernel(Kernel kernel)
+{
+  if (!isSupported(kernel))
+    return false;
+
+  _kernel = kernel;
+  return true;
+}
+
+MessageDigestBLAKE2b::Kernel MessageDigestBLAKE2b::getKernel() const
+{
+  return _kernel;
+}
+
+bool MessageDigestBLAKE2b::isSupported(Kernel kernel)
+{
+  switch (kernel)
+  {
+#ifdef MESSAGEDIGEST_X86
+  case Kernel::SSE41:
+    return CpuFeatures::hasSSE41();
+  case Kernel::AVX2:
+    return CpuFeatures::hasAVX2();
+#else
+  case Kernel::SSE41:
+  case Kernel::AVX2:
+    return false;
+#endif
+  default:
+    return true;
+  }
+}
+
+size_t MessageDigestBLAKE2b::getDigestSize() const
+{
+  return _digestSize;
+}
+
+size_t MessageDigestBLAKE2b::getBlockSize() const
+{
+  return BLOCK_SIZE;
+}
+
+void MessageDigestBLAKE2b::processBlocks(uint64_t *hash, const uint8_t *data, size_t nBlocks, uint64_t &numBytes) const
+{
+  if (nBlocks == 0)
+    return;
+
+  selectKernel(_kernel)(hash, data, nBlocks, numBytes + BLOCK_SIZE, 0, 0);
+  numBytes += nBlocks * BLOCK_SIZE;
+}
+
+void MessageDigestBLAKE2b::processLastBlock(uint64_t *hash, const uint8_t *data, size_t numBytes,
+                                            uint64_t counter, bool lastNode) const
+{
+  uint8_t block[BLOCK_SIZE] = { 0 };
+  std::memcpy(block, data, numBytes);
+  selectKernel(_kernel)(hash, block, 1, counter + numBytes, ~(uint64_t) 0, lastNode ? ~(uint64_t) 0 : 0);
+}
+
+void MessageDigestBLAKE2b::hashToBytes(const uint64_t *hash, uint8_t *buffer, size_t digestSize)
+{
+  for (size_t i = 0; i < digestSize; i++)
+    buffer[i] = (uint8_t) (hash[i / 8] >> (8 * (i % 8)));
+}
+
+void MessageDigestBLAKE2b::update(const void *data, const size_t offset, const size_t len)
+{
+  const uint8_t* current = (const uint8_t*) data + offset;
+  size_t numBytes = len;
+
+  // the last block is compressed differently, so a full buffer waits for more data
+  if (_bufferSize + numBytes <= BLOCK_SIZE)
+  {
+    std::memcpy(_buffer + _bufferSize, current, numBytes);
+    _bufferSize += numBytes;
+    return;
+  }
+
+  if (_bufferSize > 0)
+  {
+    size_t fill = BLOCK_SIZE - _bufferSize;
+    std::memcpy(_buffer + _bufferSize, current, fill);
+    current  += fill;
+    numBytes -= fill;
+    processBlocks(_hash, _buffer, 1, _numBytes);
+  }
+
+  // whole blocks straight from the caller's memory, keep at least one byte
+  size_t nBlocks = (numBytes - 1) / BLOCK_SIZE;
+  processBlocks(_hash, current, nBlocks, _numBytes);
+  current  += nBlocks * BLOCK_SIZE;
+  numBytes -= nBlocks * BLOCK_SIZE;
+
+  std::memcpy(_buffer, current, numBytes);
+  _bufferSize = numBytes;
+}
+
+std::string MessageDigestBLAKE2b::digest()
+{
+  uint8_t buffer[DIGEST_SIZE];
+  digestBinary(buffer);
+  return MessageDigestEncoding::toHex(buffer, getDigestSize());
+}
+
+void MessageDigestBLAKE2b::digestBinary(uint8_t *buffer)
+{
+  // finish a copy, more data may follow
+  uint64_t hash[HASH_SIZE];
+  std::memcpy(hash, _hash, sizeof(hash));
+
+  processLastBlock(hash, _buffer, _bufferSize, _numBytes, false);
+  hashToBytes(hash, buffer, _digestSize);
+}
@@ -0,0 +1,348 @@
+/**
+ * @file MessageDigestBLAKE2bp.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/MessageDigestBLAKE2bp.hpp"
+#include "MessageDigest/MessageDigest.hpp"
+#include "MessageDigest/CpuFeatures.hpp"
+#include "MessageDigest/MessageDigestState.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef MESSAGEDIGEST_X86
+#include <immintrin.h>
+#endif
+
+static MessageDigestKernelRegistrar<MessageDigestBLAKE2bp> registrar("BLAKE2bp", "generic", 0, MessageDigestBLAKE2bp::Kernel::Generic);
+static MessageDigestKernelRegistrar<MessageDigestBLAKE2bp> registrarSSE41("BLAKE2bp", "sse41", 10, MessageDigestBLAKE2bp::Kernel::SSE41);
+static MessageDigestKernelRegistrar<MessageDigestBLAKE2bp> registrarAVX2("BLAKE2bp", "avx2", 20, MessageDigestBLAKE2bp::Kernel::AVX2);
+
+namespace
+{
+#ifdef MESSAGEDIGEST_X86
+  /* Initialization vector of RFC 7693 section 2.6 */
+  static constexpr uint64_t IV[] = {
+    0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
+    0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179
+  };
+
+  /* Message schedule of RFC 7693 section 2.7, rounds 10 and 11 repeat 0 and 1 */
+  static constexpr uint8_t SIGMA[12][16] = {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+    { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+    {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+    {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+    {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+    { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+    { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+    {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+    { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 },
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 }
+  };
+
+  // leaf kernel: v[i] and m[i] hold word i of the working state and the block of every leaf
+
+  MESSAGEDIGEST_TARGET("avx2")
+  MESSAGEDIGEST_ALWAYS_INLINE void mixAVX2(__m256i& a, __m256i& b, __m256i& c, __m256i& d, __m256i x, __m256i y)
+  {
+    const __m256i rotate24 = _mm256_setr_epi8(3,4,5,6,7,0,1,2, 11,12,13,14,15,8,9,10,
+                                              3,4,5,6,7,0,1,2, 11,12,13,14,15,8,9,10);
+    const __m256i rotate16 = _mm256_setr_epi8(2,3,4,5,6,7,0,1, 10,11,12,13,14,15,8,9,
+                                              2,3,4,5,6,7,0,1, 10,11,12,13,14,15,8,9);
+
+    a = _mm256_add_epi64(_mm256_add_epi64(a, b), x);
+    d = _mm256_shuffle_epi32(_mm256_xor_si256(d, a), _MM_SHUFFLE(2,3,0,1));
+    c = _mm256_add_epi64(c, d);
+    b = _mm256_shuffle_epi8(_mm256_xor_si256(b, c), rotate24);
+    a = _mm256_add_epi64(_mm256_add_epi64(a, b), y);
+    d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rotate16);
+    c = _mm256_add_epi64(c, d);
+    b = _mm256_xor_si256(b, c);
+    b = _mm256_xor_si256(_mm256_srli_epi64(b, 63), _mm256_add_epi64(b, b));
+  }
+
+  MESSAGEDIGEST_TARGET("avx2")
+  MESSAGEDIGEST_ALWAYS_INLINE void roundAVX2(__m256i* v, const __m256i* m, const uint8_t* s)
+  {
+    // columns
+    mixAVX2(v[0], v[4], v[ 8], v[12], m[s[ 0]], m[s[ 1]]);
+    mixAVX2(v[1], v[5], v[ 9], v[13], m[s[ 2]], m[s[ 3]]);
+    mixAVX2(v[2], v[6], v[10], v[14], m[s[ 4]], m[s[ 5]]);
+    mixAVX2(v[3], v[7], v[11], v[15], m[s[ 6]], m[s[ 7]]);
+    // diagonals
+    mixAVX2(v[0], v[5], v[10], v[15], m[s[ 8]], m[s[ 9]]);
+    mixAVX2(v[1], v[6], v[11], v[12], m[s[10]], m[s[11]]);
+    mixAVX2(v[2], v[7], v[ 8], v[13], m[s[12]], m[s[13]]);
+    mixAVX2(v[3], v[4], v[ 9], v[14], m[s[14]], m[s[15]]);
+  }
+
+  /**
+   * @brief Compress nChunks chunks, one block per leaf and 64 bit lane
+   * @param counter of every leaf including the first chunk
+   */
+  MESSAGEDIGEST_TARGET("avx2")
+  void processChunksAVX2(uint64_t (*hash)[8], const uint8_t* data, size_t nChunks, uint64_t counter)
+  {
+    __m256i h[8];
+    for (int i = 0; i < 8; i++)
+      h[i] = _mm256_set_epi64x((long long) hash[3][i], (long long) hash[2][i],
+                               (long long) hash[1][i], (long long) hash[0][i]);
+
+    for (; nChunks > 0; nChunks--, data += 4*128, counter += 128)
+    {
+      // transpose four words of each leaf at a time
+      __m256i m[16];
+      for (int i = 0; i < 16; i += 4)
+      {
+        __m256i leaf0 = _mm256_loadu_si256((const __m256i*) (data + 0*128 + 8*i));
+        __m256i leaf1 = _mm256_loadu_si256((const __m256i*) (data + 1*128 + 8*i));
+        __m256i leaf2 = _mm256_loadu_si256((const __m256i*) (data + 2*128 + 8*i));
+        __m256i leaf3 = _mm256_loadu_si256((const __m256i*) (data + 3*128 + 8*i));
+        __m256i t0 = _mm256_unpacklo_epi64(leaf0, leaf1);
+        __m256i t1 = _mm256_unpackhi_epi64(leaf0, leaf1);
+        __m256i t2 = _mm256_unpacklo_epi64(leaf2, leaf3);
+        __m256i t3 = _mm256_unpackhi_epi64(leaf2, leaf3);
+        m[i + 0] = _mm256_permute2x128_si256(t0, t2, 0x20);
+        m[i + 1] = _mm256_permute2x128_si256(t1, t3, 0x20);
+        m[i + 2] = _mm256_permute2x128_si256(t0, t2, 0x31);
+        m[i + 3] = _mm256_permute2x128_si256(t1, t3, 0x31);
+      }
+
+      __m256i v[16];
+      for (int i = 0; i < 8; i++)
+      {
+        v[i]     = h[i];
+        v[i + 8] = _mm256_set1_epi64x((long long) IV[i]);
+      }
+      v[12] = _mm256_xor_si256(v[12], _mm256_set1_epi64x((long long) counter));
+
+      // written out, so that the message indices are constants
+      roundAVX2(v, m, SIGMA[ 0]);
+      roundAVX2(v, m, SIGMA[ 1]);
+      roundAVX2(v, m, SIGMA[ 2]);
+      roundAVX2(v, m, SIGMA[ 3]);
+      roundAVX2(v, m, SIGMA[ 4]);
+      roundAVX2(v, m, SIGMA[ 5]);
+      roundAVX2(v, m, SIGMA[ 6]);
+      roundAVX2(v, m, SIGMA[ 7]);
+      roundAVX2(v, m, SIGMA[ 8]);
+      roundAVX2(v, m, SIGMA[ 9]);
+      roundAVX2(v, m, SIGMA[10]);
+      roundAVX2(v, m, SIGMA[11]);
+
+      for (int i = 0; i < 8; i++)
+        h[i] = _mm256_xor_si256(h[i], _mm256_xor_si256(v[i], v[i + 8]));
+    }
+
+    for (int i = 0; i < 8; i++)
+    {
+      uint64_t lanes[4];
+      _mm256_storeu_si256((__m256i*) lanes, h[i]);
+      for (int leaf = 0; leaf < 4; leaf++)
+        hash[leaf][i] = lanes[leaf];
+    }
+  }
+#endif
+}
+
+MessageDigestBLAKE2bp::MessageDigestBLAKE2bp()
+{
+  reset();
+}
+
+std::string MessageDigestBLAKE2bp::getAlgorithm() const
+{
+  return "BLAKE2bp";
+}
+
+void MessageDigestBLAKE2bp::reset()
+{
+  for (size_t leaf = 0; leaf < LEAVES; leaf++)
+    initHash(_leafHash[leaf], _digestSize, _keyLength, LEAVES, 2, leaf, 0, DIGEST_SIZE);
+  _leafBytes = 0;
+  _chunkSize = 0;
+
+  // every leaf starts with the padded key block
+  _hasLastChunk = _keyLength > 0;
+  if (_hasLastChunk)
+  {
+    std::memset(_lastChunk, 0, CHUNK_SIZE);
+    for (size_t leaf = 0; leaf < LEAVES; leaf++)
+      std::memcpy(_lastChunk + leaf * BLOCK_SIZE, _key, _keyLength);
+  }
+}
+
+std::vector<uint8_t> MessageDigestBLAKE2bp::exportState() const
+{
+  // the root depends on the key length, not only the leaves
+  MessageDigestStateWriter writer(getAlgorithm());
+  writer.write((uint8_t) _digestSize);
+  writer.write((uint8_t) _keyLength);
+  writer.write(_leafBytes);
+  for (size_t leaf = 0; leaf < LEAVES; leaf++)
+    for (size_t i = 0; i < HASH_SIZE; i++)
+      writer.write(_leafHash[leaf][i]);
+  writer.write((uint8_t) _hasLastChunk);
+  if (_hasLastChunk)
+    writer.write(_lastChunk, CHUNK_SIZE);
+  writer.write((uint32_t) _chunkSize);
+  writer.write(_chunk, _chunkSize);
+  return writer.state();
+}
+
+bool MessageDigestBLAKE2bp::importState(const uint8_t *state, size_t size)
+{
+  MessageDigestStateReader reader(state, size);
+  uint8_t  digestSize;
+  uint8_t  keyLength;
+  uint64_t leafBytes;
+  uint64_t leafHash[LEAVES][HASH_SIZE];
+  uint8_t  hasLastChunk;
+  uint8_t  lastChunk[CHUNK_SIZE];
+  uint32_t chunkSize;
+  uint8_t  chunk[CHUNK_SIZE];
+
+  if (!reader.readHeader(getAlgorithm()) || !reader.read(digestSize) || digestSize != _digestSize ||
+      !reader.read(keyLength) || keyLength != _keyLength || !reader.read(leafBytes) || leafBytes % BLOCK_SIZE != 0)
+    return false;
+  for (size_t leaf = 0; leaf < LEAVES; leaf++)
+    for (size_t i = 0; i < HASH_SIZE; i++)
+      if (!reader.read(leafHash[leaf][i]))
+        return false;
+  // the leaves compress a chunk only when the next one is complete
+  if (!reader.read(hasLastChunk) || hasLastChunk > 1 || (!hasLastChunk && leafBytes > 0) ||
+      (hasLastChunk && !reader.read(lastChunk, CHUNK_SIZE)))
+    return false;
+  if (!reader.read(chunkSize) || chunkSize >= CHUNK_SIZE || !reader.read(chunk, chunkSize) || !reader.atEnd())
+    return false;
+
+  std::memcpy(_leafHash, leafHash, sizeof(_leafHash));
+  _leafBytes    = leafBytes;
+  _hasLastChunk = hasLastChunk != 0;
+  if (_hasLastChunk)
+    std::memcpy(_lastChunk, lastChunk, CHUNK_SIZE);
+  _chunkSize = chunkSize;
+  std::memcpy(_chunk, chunk, chunkSize);
+  return true;
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestBLAKE2bp::create()
+{
+  return std::unique_ptr<MessageDigestImpl>(new MessageDigestBLAKE2bp());
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestBLAKE2bp::clone() const
+{
+  return cloneDigest(*this);
+}
+
+bool MessageDigestBLAKE2bp::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
+
+void MessageDigestBLAKE2bp::processChunks(const uint8_t *data, size_t nChunks)
+{
+  if (nChunks == 0)
+    return;
+
+#ifdef MESSAGEDIGEST_X86
+  if (_kernel == Kernel::AVX2)
+  {
+    processChunksAVX2(_leafHash, data, nChunks, _leafBytes + BLOCK_SIZE);
+    _leafBytes += nChunks * BLOCK_SIZE;
+    return;
+  }
+#endif
+
+  for (size_t leaf = 0; leaf < LEAVES; leaf++)
+  {
+    uint64_t numBytes = _leafBytes;
+    for (size_t i = 0; i < nChunks; i++)
+      processBlocks(_leafHash[leaf], data + i * CHUNK_SIZE + leaf * BLOCK_SIZE, 1, numBytes);
+  }
+  _leafBytes += nChunks * BLOCK_SIZE;
+}
+
+void MessageDigestBLAKE2bp::update(const void *data, const size_t offset, const size_t len)
+{
+  const uint8_t* current = (const uint8_t*) data + offset;
+  size_t numBytes = len;
+
+  // complete the partial chunk first
+  if (_chunkSize > 0)
+  {
+    size_t add = std::min(numBytes, CHUNK_SIZE - _chunkSize);
+    std::memcpy(_chunk + _chunkSize, current, add);
+    _chunkSize += add;
+    current    += add;
+    numBytes   -= add;
+
+    if (_chunkSize < CHUNK_SIZE)
+      return;
+
+    if (_hasLastChunk)
+      processChunks(_lastChunk, 1);
+    std::memcpy(_lastChunk, _chunk, CHUNK_SIZE);
+    _hasLastChunk = true;
+    _chunkSize = 0;
+  }
+
+  // whole chunks straight from the caller's memory, the last one waits
+  size_t nChunks = numBytes / CHUNK_SIZE;
+  if (nChunks > 0)
+  {
+    if (_hasLastChunk)
+      processChunks(_lastChunk, 1);
+    processChunks(current, nChunks - 1);
+    std::memcpy(_lastChunk, current + (nChunks - 1) * CHUNK_SIZE, CHUNK_SIZE);
+    _hasLastChunk = true;
+
+    current  += nChunks * CHUNK_SIZE;
+    numBytes -= nChunks * CHUNK_SIZE;
+  }
+
+  std::memcpy(_chunk, current, numBytes);
+  _chunkSize = numBytes;
+}
+
+void MessageDigestBLAKE2bp::digestBinary(uint8_t *buffer)
+{
+  // finish copies of the leaves, more data may follow
+  uint8_t leafDigests[LEAVES * DIGEST_SIZE];
+  for (size_t leaf = 0; leaf < LEAVES; leaf++)
+  {
+    uint64_t hash[HASH_SIZE];
+    std::memcpy(hash, _leafHash[leaf], sizeof(hash));
+    uint64_t numBytes = _leafBytes;
+
+    const uint8_t* last = _hasLastChunk ? _lastChunk + leaf * BLOCK_SIZE : _chunk;
+    size_t lastSize = _hasLastChunk ? BLOCK_SIZE : 0;
+
+    // the partial chunk reaches the first leaves only
+    if (_chunkSize > leaf * BLOCK_SIZE)
+    {
+      if (_hasLastChunk)
+        processBlocks(hash, last, 1, numBytes);
+      last     = _chunk + leaf * BLOCK_SIZE;
+      lastSize = std::min(_chunkSize - leaf * BLOCK_SIZE, (size_t) BLOCK_SIZE);
+    }
+
+    processLastBlock(hash, last, lastSize, numBytes, leaf == LEAVES - 1);
+    hashToBytes(hash, leafDigests + leaf * DIGEST_SIZE, DIGEST_SIZE);
+  }
+
+  uint64_t root[HASH_SIZE];
+  uint64_t numBytes = 0;
+  initHash(root, _digestSize, _keyLength, LEAVES, 2, 0, 1, DIGEST_SIZE);
+  processBlocks(root, leafDigests, sizeof(leafDigests) / BLOCK_SIZE - 1, numBytes);
+  processLastBlock(root, leafDigests + numBytes, BLOCK_SIZE, numBytes, true);
+  hashToBytes(root, buffer, _digestSize);
+}
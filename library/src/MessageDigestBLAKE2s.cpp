@@ -0,0 +1,493 @@
+/**
+ * @file MessageDigestBLAKE2s.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/MessageDigestBLAKE2s.hpp"
+#include "MessageDigest/MessageDigest.hpp"
+#include "MessageDigest/MessageDigestEncoding.hpp"
+#include "MessageDigest/CpuFeatures.hpp"
+#include "MessageDigest/MessageDigestState.hpp"
+
+#include <cstring>
+
+#ifdef MESSAGEDIGEST_X86
+#include <immintrin.h>
+#endif
+
+// big endian architectures need #define __BYTE_ORDER __BIG_ENDIAN
+#ifndef _MSC_VER
+#include <endian.h>
+#endif
+
+static MessageDigestKernelRegistrar<MessageDigestBLAKE2s> registrar("BLAKE2s", "generic", 0, MessageDigestBLAKE2s::Kernel::Generic);
+static MessageDigestKernelRegistrar<MessageDigestBLAKE2s> registrarSSE41("BLAKE2s", "sse41", 10, MessageDigestBLAKE2s::Kernel::SSE41);
+static MessageDigestKernelRegistrar<MessageDigestBLAKE2s> registrarAVX2("BLAKE2s", "avx2", 20, MessageDigestBLAKE2s::Kernel::AVX2);
+
+namespace
+{
+  /* Initialization vector of RFC 7693 section 2.6, the one of SHA-256 */
+  static constexpr uint32_t IV[] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+  };
+
+  /* Message schedule of RFC 7693 section 2.7 */
+  static constexpr uint8_t SIGMA[10][16] = {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+    { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+    {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+    {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+    {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+    { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+    { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+    {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+    { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 }
+  };
+
+  /// compression of nBlocks blocks, counter includes the first one and grows by a block per further one
+  typedef void (*ProcessBlocksFunc)(uint32_t* hash, const uint8_t* data, size_t nBlocks,
+                                    uint64_t counter, uint32_t lastBlock, uint32_t lastNode);
+
+  /// little endian word of a block
+  inline uint32_t load32(const uint8_t* data)
+  {
+    uint32_t word;
+    std::memcpy(&word, data, 4);
+#if defined(__BYTE_ORDER) && (__BYTE_ORDER != 0) && (__BYTE_ORDER == __BIG_ENDIAN)
+    word = swap32(word);
+#endif
+    return word;
+  }
+
+  /**
+   * @brief The circular right shift operation
+   */
+  inline uint32_t rotateRight(uint32_t a, uint32_t c)
+  {
+    return (a >> c) | (a << (32 - c));
+  }
+
+  /// mixing function G of RFC 7693 section 3.1
+  inline void mix(uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d, uint32_t x, uint32_t y)
+  {
+    a = a + b + x; d = rotateRight(d ^ a, 16);
+    c = c + d;     b = rotateRight(b ^ c, 12);
+    a = a + b + y; d = rotateRight(d ^ a,  8);
+    c = c + d;     b = rotateRight(b ^ c,  7);
+  }
+
+  /**
+   * @brief Compression function of Kernel::Generic
+   */
+  MESSAGEDIGEST_NOINLINE
+  void processBlocksGeneric(uint32_t* hash, const uint8_t* data, size_t nBlocks,
+                            uint64_t counter, uint32_t lastBlock, uint32_t lastNode)
+  {
+    for (; nBlocks > 0; nBlocks--, data += 64, counter += 64)
+    {
+      uint32_t m[16];
+      for (int i = 0; i < 16; i++)
+        m[i] = load32(data + 4*i);
+
+      uint32_t v[16];
+      for (int i = 0; i < 8; i++)
+      {
+        v[i]     = hash[i];
+        v[i + 8] = IV[i];
+      }
+      v[12] ^= (uint32_t) counter;
+      v[13] ^= (uint32_t) (counter >> 32);
+      v[14] ^= lastBlock;
+      v[15] ^= lastNode;
+
+      for (int round = 0; round < 10; round++)
+      {
+        const uint8_t* s = SIGMA[round];
+
+        // columns
+        mix(v[0], v[4], v[ 8], v[12], m[s[ 0]], m[s[ 1]]);
+        mix(v[1], v[5], v[ 9], v[13], m[s[ 2]], m[s[ 3]]);
+        mix(v[2], v[6], v[10], v[14], m[s[ 4]], m[s[ 5]]);
+        mix(v[3], v[7], v[11], v[15], m[s[ 6]], m[s[ 7]]);
+        // diagonals
+        mix(v[0], v[5], v[10], v[15], m[s[ 8]], m[s[ 9]]);
+        mix(v[1], v[6], v[11], v[12], m[s[10]], m[s[11]]);
+        mix(v[2], v[7], v[ 8], v[13], m[s[12]], m[s[13]]);
+        mix(v[3], v[4], v[ 9], v[14], m[s[14]], m[s[15]]);
+      }
+
+      for (int i = 0; i < 8; i++)
+        hash[i] ^= v[i] ^ v[i + 8];
+    }
+  }
+
+#ifdef MESSAGEDIGEST_X86
+  // row kernel: row1 = v0..v3, row2 = v4..v7, row3 = v8..v11, row4 = v12..v15
+
+  /// words i, j, k and l of a block as one register, i in the lowest quarter
+  MESSAGEDIGEST_TARGET("sse4.1")
+  MESSAGEDIGEST_ALWAYS_INLINE __m128i loadWordsSSE41(const uint8_t* data, int i, int j, int k, int l)
+  {
+    return _mm_set_epi32((int) load32(data + 4*l), (int) load32(data + 4*k),
+                         (int) load32(data + 4*j), (int) load32(data + 4*i));
+  }
+
+  /// G on all four columns or diagonals
+  MESSAGEDIGEST_TARGET("sse4.1")
+  MESSAGEDIGEST_ALWAYS_INLINE void mixSSE41(__m128i& a, __m128i& b, __m128i& c, __m128i& d, __m128i x, __m128i y)
+  {
+    const __m128i rotate16 = _mm_setr_epi8(2,3,0,1, 6,7,4,5, 10,11,8,9, 14,15,12,13);
+    const __m128i rotate8  = _mm_setr_epi8(1,2,3,0, 5,6,7,4, 9,10,11,8, 13,14,15,12);
+
+    a = _mm_add_epi32(_mm_add_epi32(a, b), x);
+    d = _mm_shuffle_epi8(_mm_xor_si128(d, a), rotate16);
+    c = _mm_add_epi32(c, d);
+    b = _mm_xor_si128(b, c);
+    b = _mm_or_si128(_mm_srli_epi32(b, 12), _mm_slli_epi32(b, 20));
+    a = _mm_add_epi32(_mm_add_epi32(a, b), y);
+    d = _mm_shuffle_epi8(_mm_xor_si128(d, a), rotate8);
+    c = _mm_add_epi32(c, d);
+    b = _mm_xor_si128(b, c);
+    b = _mm_or_si128(_mm_srli_epi32(b, 7), _mm_slli_epi32(b, 25));
+  }
+
+  /// one round, the message words of the columns and then those of the diagonals
+  MESSAGEDIGEST_TARGET("sse4.1")
+  MESSAGEDIGEST_ALWAYS_INLINE void roundSSE41(__m128i& row1, __m128i& row2, __m128i& row3, __m128i& row4,
+                                              const uint8_t* data, const uint8_t* s)
+  {
+    mixSSE41(row1, row2, row3, row4,
+             loadWordsSSE41(data, s[0], s[2], s[4], s[6]), loadWordsSSE41(data, s[1], s[3], s[5], s[7]));
+
+    // diagonalize: rotate row2 left by one word, row3 by two, row4 by three
+    row2 = _mm_shuffle_epi32(row2, _MM_SHUFFLE(0,3,2,1));
+    row3 = _mm_shuffle_epi32(row3, _MM_SHUFFLE(1,0,3,2));
+    row4 = _mm_shuffle_epi32(row4, _MM_SHUFFLE(2,1,0,3));
+
+    mixSSE41(row1, row2, row3, row4,
+             loadWordsSSE41(data, s[8], s[10], s[12], s[14]), loadWordsSSE41(data, s[9], s[11], s[13], s[15]));
+
+    // and back
+    row2 = _mm_shuffle_epi32(row2, _MM_SHUFFLE(2,1,0,3));
+    row3 = _mm_shuffle_epi32(row3, _MM_SHUFFLE(1,0,3,2));
+    row4 = _mm_shuffle_epi32(row4, _MM_SHUFFLE(0,3,2,1));
+  }
+
+  /// the block loop of the row kernels, inlined into each of them
+  MESSAGEDIGEST_TARGET("sse4.1")
+  MESSAGEDIGEST_ALWAYS_INLINE void processBlocksRows(uint32_t* hash, const uint8_t* data, size_t nBlocks,
+                                                     uint64_t counter, uint32_t lastBlock, uint32_t lastNode)
+  {
+    __m128i h1 = _mm_loadu_si128((const __m128i*) (hash + 0));
+    __m128i h2 = _mm_loadu_si128((const __m128i*) (hash + 4));
+
+    for (; nBlocks > 0; nBlocks--, data += 64, counter += 64)
+    {
+      __m128i row1 = h1;
+      __m128i row2 = h2;
+      __m128i row3 = _mm_loadu_si128((const __m128i*) (IV + 0));
+      __m128i row4 = _mm_xor_si128(_mm_loadu_si128((const __m128i*) (IV + 4)),
+                                   _mm_set_epi32((int) lastNode, (int) lastBlock, (int) (counter >> 32), (int) counter));
+
+      // written out, so that the message indices are constants
+      roundSSE41(row1, row2, row3, row4, data, SIGMA[0]);
+      roundSSE41(row1, row2, row3, row4, data, SIGMA[1]);
+      roundSSE41(row1, row2, row3, row4, data, SIGMA[2]);
+      roundSSE41(row1, row2, row3, row4, data, SIGMA[3]);
+      roundSSE41(row1, row2, row3, row4, data, SIGMA[4]);
+      roundSSE41(row1, row2, row3, row4, data, SIGMA[5]);
+      roundSSE41(row1, row2, row3, row4, data, SIGMA[6]);
+      roundSSE41(row1, row2, row3, row4, data, SIGMA[7]);
+      roundSSE41(row1, row2, row3, row4, data, SIGMA[8]);
+      roundSSE41(row1, row2, row3, row4, data, SIGMA[9]);
+
+      h1 = _mm_xor_si128(h1, _mm_xor_si128(row1, row3));
+      h2 = _mm_xor_si128(h2, _mm_xor_si128(row2, row4));
+    }
+
+    _mm_storeu_si128((__m128i*) (hash + 0), h1);
+    _mm_storeu_si128((__m128i*) (hash + 4), h2);
+  }
+
+  /// compression function of Kernel::SSE41
+  MESSAGEDIGEST_TARGET("sse4.1")
+  void processBlocksSSE41(uint32_t* hash, const uint8_t* data, size_t nBlocks,
+                          uint64_t counter, uint32_t lastBlock, uint32_t lastNode)
+  {
+    processBlocksRows(hash, data, nBlocks, counter, lastBlock, lastNode);
+  }
+
+  /**
+   * @brief Compression function of Kernel::AVX2
+   *
+   * A BLAKE2s state fills only four xmm registers, so this is the SSE4.1
+   * kernel in VEX encoding. The three operand forms save the register
+   * copies; the gain is in BLAKE2sp, where eight leaves fill ymm registers.
+   */
+  MESSAGEDIGEST_TARGET("avx2")
+  void processBlocksAVX2(uint32_t* hash, const uint8_t* data, size_t nBlocks,
+                         uint64_t counter, uint32_t lastBlock, uint32_t lastNode)
+  {
+    processBlocksRows(hash, data, nBlocks, counter, lastBlock, lastNode);
+  }
+#endif
+
+  ProcessBlocksFunc selectKernel(MessageDigestBLAKE2s::Kernel kernel)
+  {
+    switch (kernel)
+    {
+#ifdef MESSAGEDIGEST_X86
+    case MessageDigestBLAKE2s::Kernel::SSE41:
+      return processBlocksSSE41;
+    case MessageDigestBLAKE2s::Kernel::AVX2:
+      return processBlocksAVX2;
+#endif
+    default:
+      return processBlocksGeneric;
+    }
+  }
+}
+
+MessageDigestBLAKE2s::MessageDigestBLAKE2s()
+  : _digestSize(DIGEST_SIZE),
+    _keyLength(0)
+{
+  if (isSupported(Kernel::AVX2))
+    _kernel = Kernel::AVX2;
+  else if (isSupported(Kernel::SSE41))
+    _kernel = Kernel::SSE41;
+  else
+    _kernel = Kernel::Generic;
+
+  reset();
+}
+
+std::string MessageDigestBLAKE2s::getAlgorithm() const
+{
+  return "BLAKE2s";
+}
+
+void MessageDigestBLAKE2s::reset()
+{
+  initHash(_hash, _digestSize, _keyLength);
+  _numBytes = 0;
+
+  // the key is the first block, padded with zeros
+  _bufferSize = 0;
+  if (_keyLength > 0)
+  {
+    std::memset(_buffer, 0, BLOCK_SIZE);
+    std::memcpy(_buffer, _key, _keyLength);
+    _bufferSize = BLOCK_SIZE;
+  }
+}
+
+void MessageDigestBLAKE2s::initHash(uint32_t *hash, size_t digestSize, size_t keyLength,
+                                    uint8_t fanout, uint8_t depth, uint64_t nodeOffset,
+                                    uint8_t nodeDepth, uint8_t innerLength)
+{
+  // parameter block of RFC 7693 section 2.5, salt and personalization are zero
+  for (size_t i = 0; i < HASH_SIZE; i++)
+    hash[i] = IV[i];
+  hash[0] ^= (uint32_t) (digestSize | (keyLength << 8) | (fanout << 16) | ((uint32_t) depth << 24));
+  hash[2] ^= (uint32_t) nodeOffset;
+  hash[3] ^= (uint32_t) ((nodeOffset >> 32) & 0xFFFF) | (nodeDepth << 16) | ((uint32_t) innerLength << 24);
+}
+
+bool MessageDigestBLAKE2s::setDigestSize(size_t digestSize)
+{
+  if (digestSize == 0 || digestSize > DIGEST_SIZE)
+    return false;
+
+  _digestSize = digestSize;
+  reset();
+  return true;
+}
+
+bool MessageDigestBLAKE2s::setKey(const void *key, size_t keyLength)
+{
+  if (keyLength > MAX_KEY_SIZE)
+    return false;
+
+  std::memset(_key, 0, MAX_KEY_SIZE);
+  if (keyLength > 0)
+    std::memcpy(_key, key, keyLength);
+  _keyLength = keyLength;
+  reset();
+  return true;
+}
+
+std::vector<uint8_t> MessageDigestBLAKE2s::exportState() const
+{
+  // a keyed state is as secret as the key, a fresh one holds the key block
+  MessageDigestStateWriter writer(getAlgorithm());
+  writer.write((uint8_t) _digestSize);
+  writer.write(_numBytes);
+  for (size_t i = 0; i < HASH_SIZE; i++)
+    writer.write(_hash[i]);
+  writer.write((uint8_t) _bufferSize);
+  writer.write(_buffer, _bufferSize);
+  return writer.state();
+}
+
+bool MessageDigestBLAKE2s::importState(const uint8_t *state, size_t size)
+{
+  MessageDigestStateReader reader(state, size);
+  uint8_t  digestSize;
+  uint64_t numBytes;
+  uint32_t hash[HASH_SIZE];
+  uint8_t  bufferSize;
+  uint8_t  buffer[BLOCK_SIZE];
+
+  if (!reader.readHeader(getAlgorithm()) || !reader.read(digestSize) || digestSize != _digestSize ||
+      !reader.read(numBytes) || numBytes % BLOCK_SIZE != 0)
+    return false;
+  for (size_t i = 0; i < HASH_SIZE; i++)
+    if (!reader.read(hash[i]))
+      return false;
+  // only the empty message leaves the buffer empty
+  if (!reader.read(bufferSize) || bufferSize > BLOCK_SIZE || (bufferSize == 0 && numBytes > 0) ||
+      !reader.read(buffer, bufferSize) || !reader.atEnd())
+    return false;
+
+  _numBytes   = numBytes;
+  _bufferSize = bufferSize;
+  std::memcpy(_hash, hash, sizeof(_hash));
+  std::memcpy(_buffer, buffer, bufferSize);
+  return true;
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestBLAKE2s::create()
+{
+  return std::unique_ptr<MessageDigestImpl>(new MessageDigestBLAKE2s());
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestBLAKE2s::clone() const
+{
+  return cloneDigest(*this);
+}
+
+bool MessageDigestBLAKE2s::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
+
+bool MessageDigestBLAKE2s::setKernel(Kernel kernel)
+{
+  if (!isSupported(kernel))
+    return false;
+
+  _kernel = kernel;
+  return true;
+}
+
+MessageDigestBLAKE2s::Kernel MessageDigestBLAKE2s::getKernel() const
+{
+  return _kernel;
+}
+
+bool MessageDigestBLAKE2s::isSupported(Kernel kernel)
+{
+  switch (kernel)
+  {
+#ifdef MESSAGEDIGEST_X86
+  case Kernel::SSE41:
+    return CpuFeatures::hasSSE41();
+  case Kernel::AVX2:
+    return CpuFeatures::hasAVX2();
+#else
+  case Kernel::SSE41:
+  case Kernel::AVX2:
+    return false;
+#endif
+  default:
+    return true;
+  }
+}
+
+size_t MessageDigestBLAKE2s::getDigestSize() const
+{
+  return _digestSize;
+}
+
+size_t MessageDigestBLAKE2s::getBlockSize() const
+{
+  return BLOCK_SIZE;
+}
+
+void MessageDigestBLAKE2s::processBlocks(uint32_t *hash, const uint8_t *data, size_t nBlocks, uint64_t &numBytes) const
+{
+  if (nBlocks == 0)
+    return;
+
+  selectKernel(_kernel)(hash, data, nBlocks, numBytes + BLOCK_SIZE, 0, 0);
+  numBytes += nBlocks * BLOCK_SIZE;
+}
+
+void MessageDigestBLAKE2s::processLastBlock(uint32_t *hash, const uint8_t *data, size_t numBytes,
+                                            uint64_t counter, bool lastNode) const
+{
+  uint8_t block[BLOCK_SIZE] = { 0 };
+  std::memcpy(block, data, numBytes);
+  selectKernel(_kernel)(hash, block, 1, counter + numBytes, ~(uint32_t) 0, lastNode ? ~(uint32_t) 0 : 0);
+}
+
+void MessageDigestBLAKE2s::hashToBytes(const uint32_t *hash, uint8_t *buffer, size_t digestSize)
+{
+  for (size_t i = 0; i < digestSize; i++)
+    buffer[i] = (uint8_t) (hash[i / 4] >> (8 * (i % 4)));
+}
+
+void MessageDigestBLAKE2s::update(const void *data, const size_t offset, const size_t len)
+{
+  const uint8_t* current = (const uint8_t*) data + offset;
+  size_t numBytes = len;
+
+  // the last block is compressed differently, so a full buffer waits for more data
+  if (_bufferSize + numBytes <= BLOCK_SIZE)
+  {
+    std::memcpy(_buffer + _bufferSize, current, numBytes);
+    _bufferSize += numBytes;
+    return;
+  }
+
+  if (_bufferSize > 0)
+  {
+    size_t fill = BLOCK_SIZE - _bufferSize;
+    std::memcpy(_buffer + _bufferSize, current, fill);
+    current  += fill;
+    numBytes -= fill;
+    processBlocks(_hash, _buffer, 1, _numBytes);
+  }
+
+  // whole blocks straight from the caller's memory, keep at least one byte
+  size_t nBlocks = (numBytes - 1) / BLOCK_SIZE;
+  processBlocks(_hash, current, nBlocks, _numBytes);
+  current  += nBlocks * BLOCK_SIZE;
+  numBytes -= nBlocks * BLOCK_SIZE;
+
+  std::memcpy(_buffer, current, numBytes);
+  _bufferSize = numBytes;
+}
+
+std::string MessageDigestBLAKE2s::digest()
+{
+  uint8_t buffer[DIGEST_SIZE];
+  digestBinary(buffer);
+  return MessageDigestEncoding::toHex(buffer, getDigestSize());
+}
+
+void MessageDigestBLAKE2s::digestBinary(uint8_t *buffer)
+{
+  // finish a copy, more data may follow
+  uint32_t hash[HASH_SIZE];
+  std::memcpy(hash, _hash, sizeof(hash));
+
+  processLastBlock(hash, _buffer, _bufferSize, _numBytes, false);
+  hashToBytes(hash, buffer, _digestSize);
+}
@@ -17,17 +17,78 @@
 
 #include "MessageDigest/MessageDigestCRC32.hpp"
 #include "MessageDigest/MessageDigest.hpp"
+#include "MessageDigest/MessageDigestEncoding.hpp"
+#include "MessageDigest/CpuFeatures.hpp"
+#include "MessageDigest/MessageDigestState.hpp"
 
 #include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#ifdef MESSAGEDIGEST_X86
+#include <immintrin.h>
+#endif
 
 // big endian architectures need #define __BYTE_ORDER __BIG_ENDIAN
 #ifndef _MSC_VER
 #include <endian.h>
 #endif
 
-static MessageDigestImplRegistrar<MessageDigestCRC32> registrar("CRC32");
+static MessageDigestKernelRegistrar<MessageDigestCRC32> registrar("CRC32", "generic", 0, MessageDigestCRC32::Kernel::SlicingBy8);
+static MessageDigestKernelRegistrar<MessageDigestCRC32> registrarPCLMUL("CRC32", "pclmul", 10, MessageDigestCRC32::Kernel::PCLMUL);
 namespace
 {
+  /// reflected polynomial
+  static constexpr uint32_t Polynomial = 0xEDB88320;
+
+  /// smallest chunk worth a thread of its own
+  static constexpr size_t MinChunkSize = 256*1024;
+
+  /**
+   * @brief Multiply two polynomials modulo the CRC polynomial,
+   * bit 31 holds x^0 in the reflected representation
+   */
+  uint32_t multiplyModP(uint32_t a, uint32_t b)
+  {
+    uint32_t product = 0;
+    for (uint32_t m = 1u << 31; m != 0; m >>= 1)
+    {
+      if (a & m)
+        product ^= b;
+      b = (b & 1) ? (b >> 1) ^ Polynomial : b >> 1;
+    }
+    return product;
+  }
+
+  /// x^(8*numBytes) modulo the CRC polynomial by repeated squaring
+  uint32_t shiftBytesModP(uint64_t numBytes)
+  {
+    // powers[k] = x^(2^k) mod P
+    struct Powers
+    {
+      uint32_t value[64];
+
+      Powers()
+      {
+        value[0] = 1u << 30;
+        for (int k = 1; k < 64; k++)
+          value[k] = multiplyModP(value[k - 1], value[k - 1]);
+      }
+    };
+    static const Powers powers;
+
+    // start with x^0, numBytes bytes are 2^3 * numBytes bits
+    uint32_t result = 1u << 31;
+    for (int k = 3; numBytes != 0 && k < 64; k++, numBytes >>= 1)
+    {
+      if (numBytes & 1)
+        result = multiplyModP(powers.value[k], result);
+    }
+    return result;
+  }
+
   /// look-up table
   static constexpr uint32_t crc32Lookup[8][256] =
   {
@@ -318,13 +379,139 @@ namespace
       0x2C8E0FFF,0xE0240F61,0x6EAB0882,0xA201081C,0xA8C40105,0x646E019B,0xEAE10678,0x264B06E6 }
   };
 
+#ifdef MESSAGEDIGEST_X86
+  /**
+   * @brief Fold 128 bit chunks with carry-less multiplication, following
+   * "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction"
+   * by Gopal et al. (Intel, 2009). All constants are bit-reflected.
+   * @param crc      inverted CRC so far
+   * @param data     at least 64 bytes
+   * @param numBytes a multiple of 16
+   * @return inverted CRC
+   */
+  MESSAGEDIGEST_TARGET("pclmul,sse4.1")
+  uint32_t crc32PCLMUL(uint32_t crc, const uint8_t* data, size_t numBytes)
+  {
+    // x^(4*128+32) mod P and x^(4*128-32) mod P: fold by 512 bits
+    const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+    // x^(128+32) mod P and x^(128-32) mod P: fold by 128 bits
+    const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+    // x^64 mod P: fold 96 to 64 bits
+    const __m128i k5   = _mm_set_epi64x(0, 0x0163cd6124);
+    // polynomial P and Barrett constant floor(x^64 / P)
+    const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+    const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+
+    // four independent accumulators hide the latency of pclmulqdq
+    __m128i x1 = _mm_loadu_si128((const __m128i*) (data +  0));
+    __m128i x2 = _mm_loadu_si128((const __m128i*) (data + 16));
+    __m128i x3 = _mm_loadu_si128((const __m128i*) (data + 32));
+    __m128i x4 = _mm_loadu_si128((const __m128i*) (data + 48));
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int) crc));
+    data     += 64;
+    numBytes -= 64;
+
+    while (numBytes >= 64)
+    {
+      __m128i x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+      __m128i x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+      __m128i x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+      __m128i x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+
+      x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+      x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+      x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+      x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+
+      x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i*) (data +  0)));
+      x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i*) (data + 16)));
+      x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i*) (data + 32)));
+      x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i*) (data + 48)));
+
+      data     += 64;
+      numBytes -= 64;
+    }
+
+    // fold the accumulators into one
+    __m128i x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    // remaining 16 byte chunks
+    while (numBytes >= 16)
+    {
+      x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+      x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+      x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i*) data)), x5);
+
+      data     += 16;
+      numBytes -= 16;
+    }
+
+    // 128 to 64 bits
+    x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+    // 64 to 32 bits
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), k5, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), poly, 0x10);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask), poly, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return (uint32_t) _mm_extract_epi32(x1, 1);
+  }
+#endif
+
 }
 
 MessageDigestCRC32::MessageDigestCRC32()
 {
+  _kernel = isSupported(Kernel::PCLMUL) ? Kernel::PCLMUL : Kernel::SlicingBy8;
+
   reset();
 }
 
+bool MessageDigestCRC32::setKernel(Kernel kernel)
+{
+  if (!isSupported(kernel))
+    return false;
+
+  _kernel = kernel;
+  return true;
+}
+
+MessageDigestCRC32::Kernel MessageDigestCRC32::getKernel() const
+{
+  return _kernel;
+}
+
+bool MessageDigestCRC32::isSupported(Kernel kernel)
+{
+  switch (kernel)
+  {
+  case Kernel::PCLMUL:
+#ifdef MESSAGEDIGEST_X86
+    return CpuFeatures::hasPCLMUL() && CpuFeatures::hasSSE41();
+#else
+    return false;
+#endif
+  default:
+    return true;
+  }
+}
+
 std::string MessageDigestCRC32::getAlgorithm() const
 {
   return "CRC32";
@@ -333,6 +520,133 @@ std::string MessageDigestCRC32::getAlgorithm() const
 void MessageDigestCRC32::reset()
 {
   this->_hash = 0;
+  this->_numBytes = 0;
+}
+
+std::vector<uint8_t> MessageDigestCRC32::exportState() const
+{
+  MessageDigestStateWriter writer(getAlgorithm());
+  writer.write(_hash);
+  writer.write(_numBytes);
+  return writer.state();
+}
+
+bool MessageDigestCRC32::importState(const uint8_t *state, size_t size)
+{
+  MessageDigestStateReader reader(state, size);
+  uint32_t hash;
+  uint64_t numBytes;
+  if (!reader.readHeader(getAlgorithm()) || !reader.read(hash) || !reader.read(numBytes) || !reader.atEnd())
+    return false;
+
+  _hash = hash;
+  _numBytes = numBytes;
+  return true;
+}
+
+void MessageDigestCRC32::combine(const MessageDigestCRC32 &other)
+{
+  // CRC(A|B) = CRC(A) * x^(8*|B|) mod P + CRC(B)
+  _hash = multiplyModP(shiftBytesModP(other._numBytes), _hash) ^ other._hash;
+  _numBytes += other._numBytes;
+}
+
+void MessageDigestCRC32::updateParallel(const void *data, const size_t offset, const size_t len, unsigned numThreads)
+{
+  if (numThreads == 0)
+    numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+  size_t numChunks = std::min<size_t>(numThreads, len / MinChunkSize);
+  if (numChunks <= 1)
+  {
+    update(data, offset, len);
+    return;
+  }
+
+  // the last chunk takes the remainder
+  size_t chunkSize = len / numChunks;
+  std::vector<MessageDigestCRC32> chunks(numChunks - 1);
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < numChunks; i++)
+  {
+    MessageDigestCRC32& chunk = chunks[i - 1];
+    chunk.setKernel(_kernel);
+    size_t chunkOffset = offset + i * chunkSize;
+    size_t chunkLength = (i + 1 < numChunks) ? chunkSize : len - i * chunkSize;
+    threads.push_back(std::thread([&chunk, data, chunkOffset, chunkLength]()
+    {
+      chunk.update(data, chunkOffset, chunkLength);
+    }));
+  }
+
+  // first chunk on the calling thread
+  update(data, offset, chunkSize);
+
+  for (auto& thread : threads)
+    thread.join();
+  for (const auto& chunk : chunks)
+    combine(chunk);
+}
+
+bool MessageDigestCRC32::updateParallel(const std::string &fileName, unsigned numThreads)
+{
+  std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+  if (!file)
+    return false;
+  uint64_t fileSize = (uint64_t) file.tellg();
+  file.close();
+
+  if (numThreads == 0)
+    numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+  size_t numChunks = (size_t) std::max<uint64_t>(std::min<uint64_t>(numThreads, fileSize / MinChunkSize), 1);
+
+  // the last chunk takes the remainder
+  uint64_t chunkSize = fileSize / numChunks;
+  std::vector<MessageDigestCRC32> chunks(numChunks);
+  std::vector<char> success(numChunks, 0);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < numChunks; i++)
+  {
+    MessageDigestCRC32& chunk = chunks[i];
+    chunk.setKernel(_kernel);
+    uint64_t chunkOffset = i * chunkSize;
+    uint64_t chunkLength = (i + 1 < numChunks) ? chunkSize : fileSize - i * chunkSize;
+    char& chunkSuccess = success[i];
+
+    auto readChunk = [&chunk, &chunkSuccess, &fileName, chunkOffset, chunkLength]()
+    {
+      std::ifstream in(fileName, std::ios::binary);
+      if (!in.seekg((std::streamoff) chunkOffset))
+        return;
+
+      std::vector<char> buffer(1024*1024);
+      uint64_t remaining = chunkLength;
+      while (remaining > 0)
+      {
+        size_t size = (size_t) std::min<uint64_t>(remaining, buffer.size());
+        if (!in.read(buffer.data(), (std::streamsize) size))
+          return;
+        chunk.update(buffer.data(), 0, size);
+        remaining -= size;
+      }
+      chunkSuccess = 1;
+    };
+
+    // last chunk on the calling thread
+    if (i + 1 < numChunks)
+      threads.push_back(std::thread(readChunk));
+    else
+      readChunk();
+  }
+
+  for (auto& thread : threads)
+    thread.join();
+  if (std::find(success.begin(), success.end(), 0) != success.end())
+    return false;
+
+  for (const auto& chunk : chunks)
+    combine(chunk);
+  return true;
 }
 
 std::unique_ptr<MessageDigestImpl> MessageDigestCRC32::create()
@@ -340,37 +654,57 @@ std::unique_ptr<MessageDigestImpl> MessageDigestCRC32::create()
   return std::unique_ptr<MessageDigestImpl>(new MessageDigestCRC32());
 }
 
-std::string MessageDigestCRC32::digest()
+std::unique_ptr<MessageDigestImpl> MessageDigestCRC32::clone() const
 {
-  // convert hash to string
-  static const char dec2hex[16+1] = "0123456789abcdef";
+  return cloneDigest(*this);
+}
 
-  char hashBuffer[8+1];
+bool MessageDigestCRC32::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
 
-  hashBuffer[0] = dec2hex[ _hash >> 28      ];
-  hashBuffer[1] = dec2hex[(_hash >> 24) & 15];
-  hashBuffer[2] = dec2hex[(_hash >> 20) & 15];
-  hashBuffer[3] = dec2hex[(_hash >> 16) & 15];
-  hashBuffer[4] = dec2hex[(_hash >> 12) & 15];
-  hashBuffer[5] = dec2hex[(_hash >>  8) & 15];
-  hashBuffer[6] = dec2hex[(_hash >>  4) & 15];
-  hashBuffer[7] = dec2hex[ _hash        & 15];
+std::string MessageDigestCRC32::digest()
+{
+  uint8_t buffer[DIGEST_SIZE];
+  digestBinary(buffer);
+  return MessageDigestEncoding::toHex(buffer, DIGEST_SIZE);
+}
 
-  // zero-terminated string
-  hashBuffer[8] = 0;
+void MessageDigestCRC32::digestBinary(uint8_t *buffer)
+{
+  // big endian, matching the usual hex notation of a CRC
+  buffer[0] = (_hash >> 24) & 0xFF;
+  buffer[1] = (_hash >> 16) & 0xFF;
+  buffer[2] = (_hash >>  8) & 0xFF;
+  buffer[3] =  _hash        & 0xFF;
+}
 
-  // convert to std::string
-  return hashBuffer;
+size_t MessageDigestCRC32::getDigestSize() const
+{
+  return DIGEST_SIZE;
 }
 
 void MessageDigestCRC32::update(const void *data, const size_t offset, const size_t len)
 {
 
   const uint8_t* dataStart = (uint8_t*)data + offset;
-  uint32_t* current = (uint32_t*) dataStart;
   uint32_t crc = ~_hash;
   size_t numBytes = len;
 
+#ifdef MESSAGEDIGEST_X86
+  // fold all 16 byte chunks, slicing-by-8 handles the tail
+  if (_kernel == Kernel::PCLMUL && numBytes >= 64)
+  {
+    size_t folded = numBytes & ~(size_t) 15;
+    crc = crc32PCLMUL(crc, dataStart, folded);
+    dataStart += folded;
+    numBytes  -= folded;
+  }
+#endif
+
+  uint32_t* current = (uint32_t*) dataStart;
+
   // process eight bytes at once
   while (numBytes >= 8)
   {
@@ -406,4 +740,5 @@ void MessageDigestCRC32::update(const void *data, const size_t offset, const siz
     crc = (crc >> 8) ^ crc32Lookup[0][(crc & 0xFF) ^ *currentChar++];
 
   _hash = ~crc;
+  _numBytes += len;
 }
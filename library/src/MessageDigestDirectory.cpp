@@ -0,0 +1,277 @@
+/**
+ * @file MessageDigestDirectory.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/MessageDigestDirectory.hpp"
+#include "MessageDigest/MessageDigest.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MESSAGEDIGEST_POSIX 1
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+#ifdef MESSAGEDIGEST_POSIX
+namespace
+{
+  struct Task
+  {
+    /// relative to the root, empty for the root itself
+    std::string path;
+    bool        directory;
+  };
+
+  /**
+   * Per-worker task queues: the owner works LIFO at the back, which keeps a
+   * directory's files close to its scan, thieves take the oldest tasks from
+   * the front, which are the largest pieces of remaining work.
+   */
+  class WorkStealingPool {
+  public:
+    explicit WorkStealingPool(unsigned numWorkers)
+      : _queues(numWorkers)
+    {
+      for (auto& queue : _queues)
+        queue.reset(new Queue());
+    }
+
+    void push(unsigned worker, Task task)
+    {
+      {
+        // counted before a thief can see the task, done() and _queued-- follow its pop
+        std::lock_guard<std::mutex> lock(_queues[worker]->mutex);
+        _pending++;
+        _queued++;
+        _queues[worker]->tasks.push_back(std::move(task));
+      }
+
+      std::lock_guard<std::mutex> lock(_idleMutex);
+      _idle.notify_one();
+    }
+
+    /// next task for worker, false once all tasks are done
+    bool pop(unsigned worker, Task& task)
+    {
+      for (;;)
+      {
+        if (tryPop(worker, task))
+          return true;
+
+        std::unique_lock<std::mutex> lock(_idleMutex);
+        _idle.wait(lock, [this]() { return _queued > 0 || _pending == 0; });
+        if (_pending == 0)
+          return false;
+      }
+    }
+
+    /// a task returned by pop() is finished, its children were pushed before
+    void done()
+    {
+      if (--_pending == 0)
+      {
+        std::lock_guard<std::mutex> lock(_idleMutex);
+        _idle.notify_all();
+      }
+    }
+
+  private:
+    struct Queue
+    {
+      std::mutex       mutex;
+      std::deque<Task> tasks;
+    };
+
+    bool tryPop(unsigned worker, Task& task)
+    {
+      size_t numQueues = _queues.size();
+      for (size_t i = 0; i < numQueues; i++)
+      {
+        Queue& queue = *_queues[(worker + i) % numQueues];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+          continue;
+
+        if (i == 0)
+        {
+          task = std::move(queue.tasks.back());
+          queue.tasks.pop_back();
+        }
+        else
+        {
+          task = std::move(queue.tasks.front());
+          queue.tasks.pop_front();
+        }
+        _queued--;
+        return true;
+      }
+      return false;
+    }
+
+    std::vector<std::unique_ptr<Queue>> _queues;
+    /// tasks pushed but not yet done
+    std::atomic<size_t> _pending{0};
+    /// tasks waiting in a queue
+    std::atomic<size_t> _queued{0};
+    std::mutex              _idleMutex;
+    std::condition_variable _idle;
+  };
+
+  std::string join(const std::string& directory, const std::string& name)
+  {
+    return directory.empty() ? name : directory + "/" + name;
+  }
+
+  /**
+   * @brief Push the files and subdirectories of a directory
+   * @param failed receives the entries that can't be examined
+   * @return false if the directory can't be opened
+   */
+  bool scanDirectory(WorkStealingPool& pool, unsigned worker, const std::string& root, const std::string& path,
+                     std::vector<MessageDigestDirectoryEntry>& failed)
+  {
+    std::string fullPath = path.empty() ? root : root + "/" + path;
+    DIR* directory = opendir(fullPath.c_str());
+    if (directory == nullptr)
+      return false;
+
+    while (dirent* entry = readdir(directory))
+    {
+      std::string name = entry->d_name;
+      if (name == "." || name == "..")
+        continue;
+
+      bool isDirectory = false;
+      bool isFile = false;
+#ifdef _DIRENT_HAVE_D_TYPE
+      isDirectory = entry->d_type == DT_DIR;
+      isFile      = entry->d_type == DT_REG;
+      if (entry->d_type == DT_UNKNOWN)
+#endif
+      {
+        // symbolic links are reported as such, not as their target
+        struct stat status;
+        if (lstat((fullPath + "/" + name).c_str(), &status) != 0)
+        {
+          failed.push_back(MessageDigestDirectoryEntry(join(path, name), ""));
+          continue;
+        }
+        isDirectory = S_ISDIR(status.st_mode);
+        isFile      = S_ISREG(status.st_mode);
+      }
+
+      if (isDirectory || isFile)
+        pool.push(worker, Task{ join(path, name), isDirectory });
+    }
+    closedir(directory);
+    return true;
+  }
+}
+#endif
+
+MessageDigestDirectory::MessageDigestDirectory(const std::string &algorithm)
+  : _algorithm(algorithm),
+    _numThreads(0),
+    _bufferSize(256*1024)
+{
+}
+
+void MessageDigestDirectory::setNumThreads(unsigned numThreads)
+{
+  _numThreads = numThreads;
+}
+
+unsigned MessageDigestDirectory::getNumThreads() const
+{
+  return _numThreads;
+}
+
+void MessageDigestDirectory::setBufferSize(size_t bufferSize)
+{
+  _bufferSize = std::max<size_t>(bufferSize, 4096);
+}
+
+size_t MessageDigestDirectory::getBufferSize() const
+{
+  return _bufferSize;
+}
+
+bool MessageDigestDirectory::hashTree(const std::string &root, std::vector<MessageDigestDirectoryEntry> &entries)
+{
+  entries.clear();
+#ifdef MESSAGEDIGEST_POSIX
+  struct stat status;
+  if (!MessageDigest::createInstance(_algorithm) ||
+      stat(root.c_str(), &status) != 0 || !S_ISDIR(status.st_mode))
+    return false;
+
+  std::string rootPath = root;
+  while (rootPath.length() > 1 && rootPath.back() == '/')
+    rootPath.pop_back();
+
+  unsigned numThreads = _numThreads;
+  if (numThreads == 0)
+    numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+  WorkStealingPool pool(numThreads);
+  pool.push(0, Task{ "", true });
+
+  std::vector<std::vector<MessageDigestDirectoryEntry>> results(numThreads);
+  std::atomic<bool> rootFailed(false);
+  auto worker = [this, &pool, &results, &rootPath, &rootFailed](unsigned index)
+  {
+    std::unique_ptr<MessageDigest> digest = MessageDigest::createInstance(_algorithm);
+    std::vector<uint8_t> buffer(_bufferSize);
+
+    Task task;
+    while (pool.pop(index, task))
+    {
+      if (task.directory)
+      {
+        bool scanned = scanDirectory(pool, index, rootPath, task.path, results[index]);
+
+        // an unreadable subdirectory stays in the result, with a trailing '/'
+        if (!scanned && task.path.empty())
+          rootFailed = true;
+        else if (!scanned)
+          results[index].push_back(MessageDigestDirectoryEntry(task.path + "/", ""));
+      }
+      else
+      {
+        digest->reset();
+        bool success = digest->updateFile(rootPath + "/" + task.path, buffer.data(), buffer.size());
+        results[index].push_back(MessageDigestDirectoryEntry(task.path, success ? digest->digest() : ""));
+      }
+      pool.done();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < numThreads; i++)
+    threads.push_back(std::thread(worker, i));
+  worker(0);
+  for (auto& thread : threads)
+    thread.join();
+
+  if (rootFailed)
+    return false;
+  for (auto& result : results)
+    entries.insert(entries.end(), result.begin(), result.end());
+  std::sort(entries.begin(), entries.end());
+  return true;
+#else
+  (void) root;
+  return false;
+#endif
+}
@@ -0,0 +1,409 @@
+/**
+ * @file MessageDigestEncoding.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/MessageDigestEncoding.hpp"
+#include "MessageDigest/CpuFeatures.hpp"
+
+#ifdef MESSAGEDIGEST_X86
+#include <immintrin.h>
+#endif
+
+namespace
+{
+  const char hexDigits[16+1] = "0123456789abcdef";
+  const char base64Digits[64+1] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  const char base32Digits[32+1] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+
+  /// character to digit value, -1 for invalid characters
+  struct DecodeTables
+  {
+    int8_t hex[256];
+    int8_t base64[256];
+    int8_t base32[256];
+
+    DecodeTables()
+    {
+      for (int i = 0; i < 256; i++)
+        hex[i] = base64[i] = base32[i] = -1;
+
+      for (int i = 0; i < 10; i++)
+        hex['0' + i] = i;
+      for (int i = 0; i < 6; i++)
+        hex['a' + i] = hex['A' + i] = 10 + i;
+
+      for (int i = 0; i < 64; i++)
+        base64[(uint8_t) base64Digits[i]] = i;
+
+      for (int i = 0; i < 32; i++)
+      {
+        base32[(uint8_t) base32Digits[i]] = i;
+        if (i < 26)
+          base32['a' + i] = i;
+      }
+    }
+  };
+
+  const DecodeTables& decodeTables()
+  {
+    static const DecodeTables tables;
+    return tables;
+  }
+
+  void encodeHexGeneric(const uint8_t* data, size_t size, char* hex)
+  {
+    for (size_t i = 0; i < size; i++)
+    {
+      hex[2*i]   = hexDigits[data[i] >> 4];
+      hex[2*i+1] = hexDigits[data[i] & 15];
+    }
+  }
+
+  bool decodeHexGeneric(const char* hex, size_t size, uint8_t* data)
+  {
+    const int8_t* table = decodeTables().hex;
+
+    // OR of all digits, negative if any character was invalid
+    int8_t invalid = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+      int8_t high = table[(uint8_t) hex[2*i]];
+      int8_t low  = table[(uint8_t) hex[2*i+1]];
+      invalid |= high | low;
+      data[i] = (uint8_t) (((high & 15) << 4) | (low & 15));
+    }
+    return invalid >= 0;
+  }
+
+#ifdef MESSAGEDIGEST_X86
+  MESSAGEDIGEST_TARGET("ssse3")
+  void encodeHexSSSE3(const uint8_t* data, size_t size, char* hex)
+  {
+    const __m128i digits = _mm_loadu_si128((const __m128i*) hexDigits);
+    const __m128i mask   = _mm_set1_epi8(15);
+
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+      __m128i bytes = _mm_loadu_si128((const __m128i*) (data + i));
+      __m128i high  = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(bytes, 4), mask));
+      __m128i low   = _mm_shuffle_epi8(digits, _mm_and_si128(bytes, mask));
+
+      _mm_storeu_si128((__m128i*) (hex + 2*i),      _mm_unpacklo_epi8(high, low));
+      _mm_storeu_si128((__m128i*) (hex + 2*i + 16), _mm_unpackhi_epi8(high, low));
+    }
+
+    encodeHexGeneric(data + i, size - i, hex + 2*i);
+  }
+
+  /// nibble values of 16 hex characters, sets invalid lanes for other characters
+  MESSAGEDIGEST_TARGET("ssse3")
+  inline __m128i hexNibblesSSSE3(__m128i chars, __m128i& invalid)
+  {
+    // unsigned x <= max  <=>  min(x, max) == x
+    __m128i digit   = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    // folding to lower case maps 'A'..'F' onto 'a'..'f' and nothing else
+    __m128i alpha   = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i isAlpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+
+    invalid = _mm_or_si128(invalid, _mm_cmpeq_epi8(_mm_or_si128(isDigit, isAlpha), _mm_setzero_si128()));
+    return _mm_or_si128(_mm_and_si128(isDigit, digit),
+                        _mm_and_si128(isAlpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+  }
+
+  MESSAGEDIGEST_TARGET("ssse3")
+  bool decodeHexSSSE3(const char* hex, size_t size, uint8_t* data)
+  {
+    // high nibble * 16 + low nibble for each pair of characters
+    const __m128i weights = _mm_set1_epi16(0x0110);
+    __m128i invalid = _mm_setzero_si128();
+
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+      __m128i first  = hexNibblesSSSE3(_mm_loadu_si128((const __m128i*) (hex + 2*i)), invalid);
+      __m128i second = hexNibblesSSSE3(_mm_loadu_si128((const __m128i*) (hex + 2*i + 16)), invalid);
+
+      __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(first, weights),
+                                       _mm_maddubs_epi16(second, weights));
+      _mm_storeu_si128((__m128i*) (data + i), bytes);
+    }
+
+    if (_mm_movemask_epi8(invalid) != 0)
+      return false;
+    return decodeHexGeneric(hex + 2*i, size - i, data + i);
+  }
+
+  MESSAGEDIGEST_TARGET("avx2")
+  void encodeHexAVX2(const uint8_t* data, size_t size, char* hex)
+  {
+    const __m256i digits = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) hexDigits));
+    const __m256i mask   = _mm256_set1_epi8(15);
+
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+      __m256i bytes = _mm256_loadu_si256((const __m256i*) (data + i));
+      __m256i high  = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), mask));
+      __m256i low   = _mm256_shuffle_epi8(digits, _mm256_and_si256(bytes, mask));
+
+      // unpack works within 128 bit lanes: bytes 0-7 | 16-23 and 8-15 | 24-31
+      __m256i lanesLow  = _mm256_unpacklo_epi8(high, low);
+      __m256i lanesHigh = _mm256_unpackhi_epi8(high, low);
+
+      _mm256_storeu_si256((__m256i*) (hex + 2*i),      _mm256_permute2x128_si256(lanesLow, lanesHigh, 0x20));
+      _mm256_storeu_si256((__m256i*) (hex + 2*i + 32), _mm256_permute2x128_si256(lanesLow, lanesHigh, 0x31));
+    }
+
+    encodeHexSSSE3(data + i, size - i, hex + 2*i);
+  }
+
+  MESSAGEDIGEST_TARGET("avx2")
+  inline __m256i hexNibblesAVX2(__m256i chars, __m256i& invalid)
+  {
+    __m256i digit   = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    __m256i alpha   = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    __m256i isAlpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+
+    invalid = _mm256_or_si256(invalid, _mm256_cmpeq_epi8(_mm256_or_si256(isDigit, isAlpha), _mm256_setzero_si256()));
+    return _mm256_or_si256(_mm256_and_si256(isDigit, digit),
+                           _mm256_and_si256(isAlpha, _mm256_add_epi8(alpha, _mm256_set1_epi8(10))));
+  }
+
+  MESSAGEDIGEST_TARGET("avx2")
+  bool decodeHexAVX2(const char* hex, size_t size, uint8_t* data)
+  {
+    const __m256i weights = _mm256_set1_epi16(0x0110);
+    __m256i invalid = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+      __m256i first  = hexNibblesAVX2(_mm256_loadu_si256((const __m256i*) (hex + 2*i)), invalid);
+      __m256i second = hexNibblesAVX2(_mm256_loadu_si256((const __m256i*) (hex + 2*i + 32)), invalid);
+
+      // pack works within 128 bit lanes, restore the order of the quadwords
+      __m256i bytes = _mm256_packus_epi16(_mm256_maddubs_epi16(first, weights),
+                                          _mm256_maddubs_epi16(second, weights));
+      _mm256_storeu_si256((__m256i*) (data + i), _mm256_permute4x64_epi64(bytes, 0xD8));
+    }
+
+    if (_mm256_movemask_epi8(invalid) != 0)
+      return false;
+    return decodeHexSSSE3(hex + 2*i, size - i, data + i);
+  }
+#endif
+
+  /// group the bits of data into BITS wide digits, padded to full groups of groupSize digits
+  template<unsigned BITS>
+  std::string encodeBits(const uint8_t* data, size_t size, const char* digits, size_t groupSize)
+  {
+    std::string text;
+    text.reserve((size * 8 + BITS - 1) / BITS + groupSize);
+
+    uint32_t bitBuffer = 0;
+    unsigned numBits = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+      bitBuffer = (bitBuffer << 8) | data[i];
+      numBits += 8;
+      while (numBits >= BITS)
+      {
+        numBits -= BITS;
+        text += digits[(bitBuffer >> numBits) & ((1u << BITS) - 1)];
+      }
+    }
+    if (numBits > 0)
+      text += digits[(bitBuffer << (BITS - numBits)) & ((1u << BITS) - 1)];
+
+    while (text.length() % groupSize != 0)
+      text += '=';
+    return text;
+  }
+
+  template<unsigned BITS>
+  bool decodeBits(const std::string& text, const int8_t* table, size_t groupSize, std::vector<uint8_t>& data)
+  {
+    size_t length = text.length();
+    while (length > 0 && text[length - 1] == '=')
+      length--;
+
+    size_t padding = text.length() - length;
+    if (padding > 0 && (text.length() % groupSize != 0 || padding >= groupSize))
+      return false;
+    // a trailing digit must contribute at least one full byte
+    if ((length * BITS) % 8 >= BITS)
+      return false;
+
+    data.clear();
+    data.reserve(length * BITS / 8);
+
+    uint32_t bitBuffer = 0;
+    unsigned numBits = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+      int8_t value = table[(uint8_t) text[i]];
+      if (value < 0)
+        return false;
+
+      bitBuffer = (bitBuffer << BITS) | (uint32_t) value;
+      numBits += BITS;
+      if (numBits >= 8)
+      {
+        numBits -= 8;
+        data.push_back((uint8_t) (bitBuffer >> numBits));
+      }
+    }
+    return true;
+  }
+}
+
+bool MessageDigestEncoding::isSupported(Kernel kernel)
+{
+  switch (kernel)
+  {
+  case Kernel::SSSE3:
+#ifdef MESSAGEDIGEST_X86
+    return CpuFeatures::hasSSSE3();
+#else
+    return false;
+#endif
+  case Kernel::AVX2:
+#ifdef MESSAGEDIGEST_X86
+    return CpuFeatures::hasAVX2();
+#else
+    return false;
+#endif
+  default:
+    return true;
+  }
+}
+
+MessageDigestEncoding::Kernel MessageDigestEncoding::getBestKernel()
+{
+  static const Kernel best = isSupported(Kernel::AVX2)  ? Kernel::AVX2 :
+                             isSupported(Kernel::SSSE3) ? Kernel::SSSE3 : Kernel::Generic;
+  return best;
+}
+
+void MessageDigestEncoding::encodeHex(const uint8_t *data, size_t size, char *hex)
+{
+  encodeHex(data, size, hex, getBestKernel());
+}
+
+void MessageDigestEncoding::encodeHex(const uint8_t *data, size_t size, char *hex, Kernel kernel)
+{
+  switch (kernel)
+  {
+#ifdef MESSAGEDIGEST_X86
+  case Kernel::SSSE3:
+    encodeHexSSSE3(data, size, hex);
+    break;
+  case Kernel::AVX2:
+    encodeHexAVX2(data, size, hex);
+    break;
+#endif
+  default:
+    encodeHexGeneric(data, size, hex);
+    break;
+  }
+}
+
+bool MessageDigestEncoding::decodeHex(const char *hex, size_t length, uint8_t *data)
+{
+  return decodeHex(hex, length, data, getBestKernel());
+}
+
+bool MessageDigestEncoding::decodeHex(const char *hex, size_t length, uint8_t *data, Kernel kernel)
+{
+  if (length % 2 != 0)
+    return false;
+
+  switch (kernel)
+  {
+#ifdef MESSAGEDIGEST_X86
+  case Kernel::SSSE3:
+    return decodeHexSSSE3(hex, length / 2, data);
+  case Kernel::AVX2:
+    return decodeHexAVX2(hex, length / 2, data);
+#endif
+  default:
+    return decodeHexGeneric(hex, length / 2, data);
+  }
+}
+
+std::string MessageDigestEncoding::toHex(const uint8_t *data, size_t size)
+{
+  std::string hex(2*size, '0');
+  encodeHex(data, size, &hex[0]);
+  return hex;
+}
+
+std::string MessageDigestEncoding::toBase64(const uint8_t *data, size_t size)
+{
+  return encodeBits<6>(data, size, base64Digits, 4);
+}
+
+std::string MessageDigestEncoding::toBase32(const uint8_t *data, size_t size)
+{
+  return encodeBits<5>(data, size, base32Digits, 8);
+}
+
+bool MessageDigestEncoding::fromHex(const std::string &hex, std::vector<uint8_t> &data)
+{
+  data.resize(hex.length() / 2);
+  if (decodeHex(hex.data(), hex.length(), data.data()))
+    return true;
+
+  data.clear();
+  return false;
+}
+
+bool MessageDigestEncoding::fromBase64(const std::string &base64, std::vector<uint8_t> &data)
+{
+  return decodeBits<6>(base64, decodeTables().base64, 4, data);
+}
+
+bool MessageDigestEncoding::fromBase32(const std::string &base32, std::vector<uint8_t> &data)
+{
+  return decodeBits<5>(base32, decodeTables().base32, 8, data);
+}
+
+bool MessageDigestEncoding::parseChecksumLine(const std::string &line, std::vector<uint8_t> &digest, std::string &fileName)
+{
+  size_t length = line.length();
+  while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r'))
+    length--;
+
+  // "<hex>  <file>" or "<hex> *<file>", fromHex() accepts an empty digest
+  size_t space = line.find(' ');
+  if (space != std::string::npos && space > 0 && space + 2 <= length &&
+      (line[space + 1] == ' ' || line[space + 1] == '*'))
+  {
+    if (fromHex(line.substr(0, space), digest))
+    {
+      fileName = line.substr(space + 2, length - space - 2);
+      return true;
+    }
+  }
+
+  // "<algorithm> (<file>) = <hex>"
+  size_t open  = line.find(" (");
+  size_t close = line.rfind(") = ", length);
+  if (open != std::string::npos && close != std::string::npos && close > open && close + 4 < length)
+  {
+    if (fromHex(line.substr(close + 4, length - close - 4), digest))
+    {
+      fileName = line.substr(open + 2, close - open - 2);
+      return true;
+    }
+  }
+
+  return false;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file MessageDigestFile.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/MessageDigestFile.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MESSAGEDIGEST_POSIX 1
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+#ifdef MESSAGEDIGEST_POSIX
+namespace
+{
+  bool updateRead(MessageDigestImpl& digest, int fd, uint8_t* buffer, size_t bufferSize)
+  {
+    std::vector<uint8_t> ownBuffer;
+    if (buffer == nullptr || bufferSize == 0)
+    {
+      ownBuffer.resize(MessageDigestFile::ReadBufferSize);
+      buffer = ownBuffer.data();
+      bufferSize = ownBuffer.size();
+    }
+
+    for (;;)
+    {
+      ssize_t numBytes = read(fd, buffer, bufferSize);
+      if (numBytes == 0)
+        return true;
+      if (numBytes < 0)
+      {
+        if (errno == EINTR)
+          continue;
+        return false;
+      }
+      digest.update(buffer, 0, (size_t) numBytes);
+    }
+  }
+
+  /// returns false if the file can't be mapped, nothing was hashed then
+  bool updateMapped(MessageDigestImpl& digest, int fd, size_t fileSize)
+  {
+    void* mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED)
+      return false;
+
+    // hints only, failures are harmless
+    uint8_t* data = (uint8_t*) mapping;
+    madvise(data, fileSize, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    madvise(data, fileSize, MADV_HUGEPAGE);
+#endif
+
+    const size_t windowSize = MessageDigestFile::WindowSize;
+    madvise(data, std::min(windowSize, fileSize), MADV_WILLNEED);
+
+    for (size_t offset = 0; offset < fileSize; offset += windowSize)
+    {
+      // prefetch the next window while this one is hashed
+      size_t next = offset + windowSize;
+      if (next < fileSize)
+        madvise(data + next, std::min(windowSize, fileSize - next), MADV_WILLNEED);
+
+      digest.update(data, offset, std::min(windowSize, fileSize - offset));
+    }
+
+    munmap(mapping, fileSize);
+    return true;
+  }
+}
+#endif
+
+bool MessageDigestFile::update(MessageDigestImpl &digest, const std::string &fileName)
+{
+  return update(digest, fileName, nullptr, 0);
+}
+
+bool MessageDigestFile::update(MessageDigestImpl &digest, const std::string &fileName, uint8_t *buffer, size_t bufferSize)
+{
+#ifdef MESSAGEDIGEST_POSIX
+  int fd = open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return false;
+
+  struct stat status;
+  bool success;
+  if (fstat(fd, &status) == 0 && S_ISREG(status.st_mode) &&
+      (uint64_t) status.st_size >= MinMapSize && (uint64_t) status.st_size <= SIZE_MAX)
+  {
+    success = updateMapped(digest, fd, (size_t) status.st_size) || updateRead(digest, fd, buffer, bufferSize);
+  }
+  else
+    success = updateRead(digest, fd, buffer, bufferSize);
+
+  close(fd);
+  return success;
+#else
+  std::ifstream file(fileName, std::ios::binary);
+  if (!file)
+    return false;
+
+  std::vector<uint8_t> ownBuffer;
+  if (buffer == nullptr || bufferSize == 0)
+  {
+    ownBuffer.resize(ReadBufferSize);
+    buffer = ownBuffer.data();
+    bufferSize = ownBuffer.size();
+  }
+
+  while (file)
+  {
+    file.read((char*) buffer, (std::streamsize) bufferSize);
+    digest.update(buffer, 0, (size_t) file.gcount());
+  }
+  return file.eof();
+#endif
+}
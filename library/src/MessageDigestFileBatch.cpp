@@ -0,0 +1,672 @@
+/**
+ * @file MessageDigestFileBatch.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/MessageDigestFileBatch.hpp"
+#include "MessageDigest/MessageDigest.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <thread>
+
+// io_uring through the raw system calls, liburing is not required
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define MESSAGEDIGEST_IO_URING 1
+#endif
+#endif
+
+#ifdef MESSAGEDIGEST_IO_URING
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace
+{
+  /// submission and completion queue shared with the kernel
+  class IoUring {
+  public:
+    IoUring() = default;
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    ~IoUring()
+    {
+      if (_sqes != nullptr)
+        munmap(_sqes, _sqesSize);
+      if (_cqRing != nullptr && _cqRing != _sqRing)
+        munmap(_cqRing, _cqRingSize);
+      if (_sqRing != nullptr)
+        munmap(_sqRing, _sqRingSize);
+      if (_fd >= 0)
+        close(_fd);
+    }
+
+    bool init(unsigned entries)
+    {
+      io_uring_params params;
+      std::memset(&params, 0, sizeof(params));
+
+      _fd = (int) syscall(__NR_io_uring_setup, entries, &params);
+      if (_fd < 0)
+        return false;
+
+      _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+      _cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+      bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+      if (singleMap)
+        _sqRingSize = _cqRingSize = std::max(_sqRingSize, _cqRingSize);
+
+      _sqRing = map(_sqRingSize, IORING_OFF_SQ_RING);
+      if (_sqRing == nullptr)
+        return false;
+      _cqRing = singleMap ? _sqRing : map(_cqRingSize, IORING_OFF_CQ_RING);
+      if (_cqRing == nullptr)
+        return false;
+      _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+      _sqes = (io_uring_sqe*) map(_sqesSize, IORING_OFF_SQES);
+      if (_sqes == nullptr)
+        return false;
+
+      uint8_t* sq = (uint8_t*) _sqRing;
+      _sqHead    = (unsigned*) (sq + params.sq_off.head);
+      _sqTail    = (unsigned*) (sq + params.sq_off.tail);
+      _sqMask    = *(unsigned*) (sq + params.sq_off.ring_mask);
+      _sqEntries = *(unsigned*) (sq + params.sq_off.ring_entries);
+      _sqArray   = (unsigned*) (sq + params.sq_off.array);
+      _localTail = *_sqTail;
+
+      uint8_t* cq = (uint8_t*) _cqRing;
+      _cqHead = (unsigned*) (cq + params.cq_off.head);
+      _cqTail = (unsigned*) (cq + params.cq_off.tail);
+      _cqMask = *(unsigned*) (cq + params.cq_off.ring_mask);
+      _cqes   = (io_uring_cqe*) (cq + params.cq_off.cqes);
+      return true;
+    }
+
+    /// pin buffers for IORING_OP_READ_FIXED, may fail on a low RLIMIT_MEMLOCK
+    bool registerBuffers(const std::vector<iovec>& buffers)
+    {
+      return syscall(__NR_io_uring_register, _fd, IORING_REGISTER_BUFFERS,
+                     buffers.data(), (unsigned) buffers.size()) == 0;
+    }
+
+    /// true if the kernel implements the operation, asked with IORING_REGISTER_PROBE
+    bool supports(uint8_t opcode)
+    {
+      const unsigned numOps = 256;
+      std::vector<uint8_t> buffer(sizeof(io_uring_probe) + numOps * sizeof(io_uring_probe_op), 0);
+      io_uring_probe* probe = (io_uring_probe*) buffer.data();
+
+      // kernels before 5.6 know neither the probe nor IORING_OP_READ
+      if (syscall(__NR_io_uring_register, _fd, IORING_REGISTER_PROBE, probe, numOps) != 0)
+        return false;
+      return opcode <= probe->last_op && (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED) != 0;
+    }
+
+    /// size of the submission queue, at least the entries passed to init()
+    unsigned getSqEntries() const
+    {
+      return _sqEntries;
+    }
+
+    /// next free submission entry, nullptr if the queue is full
+    io_uring_sqe* getSqe()
+    {
+      if (_localTail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) >= _sqEntries)
+        return nullptr;
+
+      unsigned index = _localTail & _sqMask;
+      _sqArray[index] = index;
+      _localTail++;
+      _toSubmit++;
+
+      io_uring_sqe* sqe = &_sqes[index];
+      std::memset(sqe, 0, sizeof(*sqe));
+      return sqe;
+    }
+
+    /// hand queued entries to the kernel and wait for at least one completion
+    bool submitAndWait()
+    {
+      return enter(1, IORING_ENTER_GETEVENTS);
+    }
+
+    /// hand queued entries to the kernel without waiting, frees the submission queue
+    bool submit()
+    {
+      return enter(0, 0);
+    }
+
+    bool popCqe(io_uring_cqe& cqe)
+    {
+      unsigned head = *_cqHead;
+      if (head == __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE))
+        return false;
+
+      cqe = _cqes[head & _cqMask];
+      __atomic_store_n(_cqHead, head + 1, __ATOMIC_RELEASE);
+      return true;
+    }
+
+  private:
+    bool enter(unsigned minComplete, unsigned flags)
+    {
+      __atomic_store_n(_sqTail, _localTail, __ATOMIC_RELEASE);
+      for (;;)
+      {
+        long submitted = syscall(__NR_io_uring_enter, _fd, _toSubmit, minComplete, flags, nullptr, 0);
+        if (submitted >= 0)
+        {
+          _toSubmit -= (unsigned) submitted;
+          return true;
+        }
+        if (errno != EINTR)
+          return false;
+      }
+    }
+
+    void* map(size_t size, off_t offset)
+    {
+      void* ring = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, offset);
+      return ring == MAP_FAILED ? nullptr : ring;
+    }
+
+    int           _fd = -1;
+    void*         _sqRing = nullptr;
+    void*         _cqRing = nullptr;
+    io_uring_sqe* _sqes = nullptr;
+    size_t        _sqRingSize = 0;
+    size_t        _cqRingSize = 0;
+    size_t        _sqesSize = 0;
+
+    unsigned*     _sqHead = nullptr;
+    unsigned*     _sqTail = nullptr;
+    unsigned*     _sqArray = nullptr;
+    unsigned      _sqMask = 0;
+    unsigned      _sqEntries = 0;
+    unsigned      _localTail = 0;
+    unsigned      _toSubmit = 0;
+
+    unsigned*     _cqHead = nullptr;
+    unsigned*     _cqTail = nullptr;
+    unsigned      _cqMask = 0;
+    io_uring_cqe* _cqes = nullptr;
+  };
+
+  /// a chunk read into one of the buffers
+  struct Slot
+  {
+    size_t   file;
+    uint64_t offset;
+    size_t   length;
+    /// bytes read so far, short reads are continued
+    size_t   filled;
+    bool     done;
+  };
+
+  struct OpenFile
+  {
+    int      fd = -1;
+    uint64_t size = 0;
+    uint64_t submitted = 0;
+    uint64_t hashed = 0;
+    bool     failed = false;
+    /// slots of this file in offset order, hashed from the front
+    std::deque<unsigned> slots;
+    std::unique_ptr<MessageDigest> digest;
+  };
+
+  /**
+   * Single threaded scheduler: every free buffer gets a read of the oldest
+   * open file with unread bytes, so one large file uses the whole queue and
+   * small files are opened as needed to keep it full.
+   */
+  class IoUringEngine {
+  public:
+    IoUringEngine(const std::string& algorithm, unsigned queueDepth, size_t chunkSize,
+                  const std::vector<std::string>& fileNames, std::vector<std::string>& digests)
+      : _algorithm(algorithm), _queueDepth(queueDepth), _chunkSize(chunkSize),
+        _fileNames(fileNames), _digests(digests), _files(fileNames.size())
+    {
+    }
+
+    ~IoUringEngine()
+    {
+      // after abandon() the kernel may still be reading into the buffers, a
+      // ring that can't be entered any more can't be waited for, so these leak
+      if (drain())
+        std::free(_buffers);
+    }
+
+    bool init()
+    {
+      // each buffer has at most one read queued, so a queue of that size never overflows
+      if (!_ring.init(_queueDepth) || _ring.getSqEntries() < _queueDepth)
+        return false;
+
+      // page aligned, the buffers are pinned as a whole
+      if (posix_memalign((void**) &_buffers, 4096, _queueDepth * _chunkSize) != 0)
+      {
+        _buffers = nullptr;
+        return false;
+      }
+
+      std::vector<iovec> iovecs(_queueDepth);
+      for (unsigned i = 0; i < _queueDepth; i++)
+      {
+        iovecs[i].iov_base = _buffers + i * _chunkSize;
+        iovecs[i].iov_len  = _chunkSize;
+        _freeSlots.push_back(_queueDepth - 1 - i);
+      }
+      _fixedBuffers = _ring.registerBuffers(iovecs);
+      _slots.resize(_queueDepth);
+      return true;
+    }
+
+    /**
+     * @brief Hash the files until all are done or the ring fails
+     * @return false if the ring failed, the files it didn't finish are
+     * in getDeferred() then
+     */
+    bool run()
+    {
+      for (;;)
+      {
+        while (!_broken && !_freeSlots.empty() && submitNext())
+          ;
+
+        // every file is opened and every read completed
+        if (_inFlight == 0 && !_broken)
+          return true;
+
+        if (_broken || !_ring.submitAndWait())
+        {
+          abandon();
+          return false;
+        }
+
+        io_uring_cqe cqe;
+        while (_ring.popCqe(cqe))
+          complete((unsigned) cqe.user_data, cqe.res);
+      }
+    }
+
+    /// files to hash with blocking reads, in the order of fileNames
+    std::vector<size_t> getDeferred() const
+    {
+      std::vector<size_t> deferred = _deferred;
+      std::sort(deferred.begin(), deferred.end());
+      return deferred;
+    }
+
+  private:
+    /// queue one read, returns false if no file has bytes left to submit
+    bool submitNext()
+    {
+      for (size_t file : _active)
+      {
+        OpenFile& open = _files[file];
+        if (!open.failed && open.submitted < open.size)
+        {
+          unsigned slot = _freeSlots.back();
+          _freeSlots.pop_back();
+
+          _slots[slot].file   = file;
+          _slots[slot].offset = open.submitted;
+          _slots[slot].length = (size_t) std::min<uint64_t>(_chunkSize, open.size - open.submitted);
+          _slots[slot].filled = 0;
+          _slots[slot].done   = false;
+          open.submitted += _slots[slot].length;
+          open.slots.push_back(slot);
+
+          submitRead(slot);
+          return true;
+        }
+      }
+
+      if (_active.size() < _queueDepth && _nextFile < _fileNames.size())
+      {
+        openFile(_nextFile++);
+        return true;
+      }
+      return false;
+    }
+
+    void submitRead(unsigned slot)
+    {
+      Slot& current = _slots[slot];
+      io_uring_sqe* sqe = _ring.getSqe();
+      if (sqe == nullptr && _ring.submit())
+        sqe = _ring.getSqe();
+      if (sqe == nullptr)
+      {
+        _broken = true;
+        return;
+      }
+
+      sqe->opcode    = _fixedBuffers ? IORING_OP_READ_FIXED : IORING_OP_READ;
+      sqe->fd        = _files[current.file].fd;
+      sqe->addr      = (uint64_t) (uintptr_t) (_buffers + slot * _chunkSize + current.filled);
+      sqe->len       = (uint32_t) (current.length - current.filled);
+      sqe->off       = current.offset + current.filled;
+      if (_fixedBuffers)
+        sqe->buf_index = (uint16_t) slot;
+      sqe->user_data = slot;
+      _inFlight++;
+    }
+
+    void openFile(size_t file)
+    {
+      OpenFile& open = _files[file];
+      open.digest = acquireDigest();
+
+      open.fd = ::open(_fileNames[file].c_str(), O_RDONLY | O_CLOEXEC);
+      struct stat status;
+      if (open.fd < 0 || fstat(open.fd, &status) != 0)
+      {
+        finish(file, false);
+        return;
+      }
+
+      // pipes and devices have no size to split into chunks, and a blocking
+      // read here would stall every read in flight
+      if (!S_ISREG(status.st_mode))
+      {
+        finish(file, false);
+        _deferred.push_back(file);
+        return;
+      }
+
+      open.size = (uint64_t) status.st_size;
+      if (open.size == 0)
+      {
+        finish(file, true);
+        return;
+      }
+      _active.push_back(file);
+    }
+
+    void complete(unsigned slot, int result)
+    {
+      Slot& current = _slots[slot];
+      OpenFile& open = _files[current.file];
+      _inFlight--;
+
+      if (result == -EINTR || result == -EAGAIN)
+      {
+        submitRead(slot);
+        return;
+      }
+
+      if (result > 0)
+      {
+        current.filled += (size_t) result;
+        if (current.filled < current.length)
+        {
+          submitRead(slot);
+          return;
+        }
+      }
+      else
+      {
+        // read error, or the file was truncated while reading it
+        open.failed = true;
+      }
+      current.done = true;
+
+      // hash the completed chunks at the front, in file order
+      while (!open.slots.empty() && _slots[open.slots.front()].done)
+      {
+        unsigned front = open.slots.front();
+        open.slots.pop_front();
+        if (!open.failed)
+        {
+          open.digest->update(_buffers + front * _chunkSize, 0, _slots[front].length);
+          open.hashed += _slots[front].length;
+        }
+        _freeSlots.push_back(front);
+      }
+
+      if (open.slots.empty() && (open.failed || open.hashed == open.size))
+      {
+        _active.erase(std::find(_active.begin(), _active.end(), current.file));
+        finish(current.file, !open.failed);
+      }
+    }
+
+    void finish(size_t file, bool success)
+    {
+      OpenFile& open = _files[file];
+      if (success)
+        _digests[file] = open.digest->digest();
+      if (open.fd >= 0)
+        close(open.fd);
+      open.fd = -1;
+
+      // keep the instance for the next file
+      _digestPool.push_back(std::move(open.digest));
+      open.slots.clear();
+    }
+
+    /// wait for the reads in flight without hashing them, false if the ring fails
+    bool drain()
+    {
+      while (_inFlight > 0)
+      {
+        if (!_ring.submitAndWait())
+          return false;
+
+        io_uring_cqe cqe;
+        while (_ring.popCqe(cqe))
+          _inFlight--;
+      }
+      return true;
+    }
+
+    /// on a broken ring the open and the unopened files are left to blocking reads
+    void abandon()
+    {
+      for (size_t file : _active)
+      {
+        finish(file, false);
+        _deferred.push_back(file);
+      }
+      _active.clear();
+
+      for (; _nextFile < _fileNames.size(); _nextFile++)
+        _deferred.push_back(_nextFile);
+    }
+
+    std::unique_ptr<MessageDigest> acquireDigest()
+    {
+      if (_digestPool.empty())
+        return MessageDigest::createInstance(_algorithm);
+
+      std::unique_ptr<MessageDigest> digest = std::move(_digestPool.back());
+      _digestPool.pop_back();
+      digest->reset();
+      return digest;
+    }
+
+    const std::string&              _algorithm;
+    unsigned                        _queueDepth;
+    size_t                          _chunkSize;
+    const std::vector<std::string>& _fileNames;
+    std::vector<std::string>&       _digests;
+
+    IoUring               _ring;
+    uint8_t*              _buffers = nullptr;
+    bool                  _fixedBuffers = false;
+    std::vector<Slot>     _slots;
+    std::vector<unsigned> _freeSlots;
+    unsigned              _inFlight = 0;
+    /// a read could not be queued
+    bool                  _broken = false;
+
+    std::vector<OpenFile> _files;
+    /// files with reads left to submit or complete, in the order they were opened
+    std::deque<size_t>    _active;
+    size_t                _nextFile = 0;
+    /// files the ring doesn't hash
+    std::vector<size_t>   _deferred;
+    std::vector<std::unique_ptr<MessageDigest>> _digestPool;
+  };
+}
+#endif
+
+MessageDigestFileBatch::MessageDigestFileBatch(const std::string &algorithm)
+  : _algorithm(algorithm),
+    _engine(isSupported(Engine::IoUring) ? Engine::IoUring : Engine::Threads),
+    _queueDepth(32),
+    _chunkSize(128*1024)
+{
+}
+
+bool MessageDigestFileBatch::setEngine(Engine engine)
+{
+  if (!isSupported(engine))
+    return false;
+
+  _engine = engine;
+  return true;
+}
+
+MessageDigestFileBatch::Engine MessageDigestFileBatch::getEngine() const
+{
+  return _engine;
+}
+
+bool MessageDigestFileBatch::isSupported(Engine engine)
+{
+  switch (engine)
+  {
+  case Engine::IoUring:
+  {
+#ifdef MESSAGEDIGEST_IO_URING
+    // kernels before 5.1 and seccomp filters reject the ring, kernels
+    // before 5.6 accept it but fail every IORING_OP_READ with -EINVAL
+    static const bool supported = []()
+    {
+      IoUring ring;
+      return ring.init(1) && ring.supports(IORING_OP_READ) && ring.supports(IORING_OP_READ_FIXED);
+    }();
+    return supported;
+#else
+    return false;
+#endif
+  }
+  default:
+    return true;
+  }
+}
+
+void MessageDigestFileBatch::setQueueDepth(unsigned queueDepth)
+{
+  _queueDepth = std::min(std::max(queueDepth, 1u), (unsigned) MaxQueueDepth);
+}
+
+unsigned MessageDigestFileBatch::getQueueDepth() const
+{
+  return _queueDepth;
+}
+
+void MessageDigestFileBatch::setChunkSize(size_t chunkSize)
+{
+  // keep the buffers page aligned
+  _chunkSize = std::max<size_t>((chunkSize + 4095) & ~(size_t) 4095, 4096);
+}
+
+size_t MessageDigestFileBatch::getChunkSize() const
+{
+  return _chunkSize;
+}
+
+std::vector<std::string> MessageDigestFileBatch::hashFiles(const std::vector<std::string> &fileNames)
+{
+  if (!MessageDigest::createInstance(_algorithm))
+    return std::vector<std::string>(fileNames.size());
+
+#ifdef MESSAGEDIGEST_IO_URING
+  if (_engine == Engine::IoUring)
+  {
+    std::vector<std::string> digests(fileNames.size());
+    std::vector<size_t> remaining;
+    hashFilesIoUring(fileNames, digests, remaining);
+    if (remaining.empty())
+      return digests;
+
+    // pipes and devices, or everything the ring left behind
+    std::vector<std::string> remainingNames;
+    for (size_t file : remaining)
+      remainingNames.push_back(fileNames[file]);
+
+    std::vector<std::string> remainingDigests = hashFilesThreads(remainingNames);
+    for (size_t i = 0; i < remaining.size(); i++)
+      digests[remaining[i]] = remainingDigests[i];
+    return digests;
+  }
+#endif
+  return hashFilesThreads(fileNames);
+}
+
+std::vector<std::string> MessageDigestFileBatch::hashFilesThreads(const std::vector<std::string> &fileNames)
+{
+  std::vector<std::string> digests(fileNames.size());
+  std::atomic<size_t> nextFile(0);
+
+  auto worker = [this, &fileNames, &digests, &nextFile]()
+  {
+    std::unique_ptr<MessageDigest> digest = MessageDigest::createInstance(_algorithm);
+    for (size_t file = nextFile++; file < fileNames.size(); file = nextFile++)
+    {
+      digest->reset();
+      if (digest->updateFile(fileNames[file]))
+        digests[file] = digest->digest();
+    }
+  };
+
+  unsigned numThreads = (unsigned) std::min<size_t>(_queueDepth, fileNames.size());
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < numThreads; i++)
+    threads.push_back(std::thread(worker));
+
+  // one worker on the calling thread
+  worker();
+  for (auto& thread : threads)
+    thread.join();
+  return digests;
+}
+
+bool MessageDigestFileBatch::hashFilesIoUring(const std::vector<std::string> &fileNames, std::vector<std::string> &digests,
+                                              std::vector<size_t> &remaining)
+{
+#ifdef MESSAGEDIGEST_IO_URING
+  IoUringEngine engine(_algorithm, _queueDepth, _chunkSize, fileNames, digests);
+  if (engine.init())
+  {
+    bool complete = engine.run();
+    remaining = engine.getDeferred();
+    return complete;
+  }
+#else
+  (void) digests;
+#endif
+  remaining.clear();
+  for (size_t file = 0; file < fileNames.size(); file++)
+    remaining.push_back(file);
+  return false;
+}
@@ -0,0 +1,172 @@
+/**
+ * @file MessageDigestHMAC.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/MessageDigestHMAC.hpp"
+#include "MessageDigest/MessageDigestEncoding.hpp"
+
+#include <algorithm>
+
+namespace
+{
+  const uint8_t InnerPad = 0x36;
+  const uint8_t OuterPad = 0x5c;
+
+  /// compare without an early exit, the time doesn't tell where a MAC differs
+  bool equalConstantTime(const uint8_t* a, const uint8_t* b, size_t numBytes)
+  {
+    uint8_t difference = 0;
+    for (size_t i = 0; i < numBytes; i++)
+      difference |= a[i] ^ b[i];
+    return difference == 0;
+  }
+
+  /// overwrite key material, volatile keeps the compiler from dropping the stores
+  void wipe(std::vector<uint8_t>& data)
+  {
+    volatile uint8_t* current = data.data();
+    for (size_t i = 0; i < data.size(); i++)
+      current[i] = 0;
+  }
+}
+
+std::unique_ptr<MessageDigestHMAC> MessageDigestHMAC::createInstance(const std::string &algorithm,
+                                                                     const void *key, size_t keyLength)
+{
+  std::unique_ptr<MessageDigest> innerKey = MessageDigest::createInstance(algorithm);
+  if (!innerKey || innerKey->getBlockSize() == 0)
+    return nullptr;
+
+  size_t blockSize  = innerKey->getBlockSize();
+  size_t digestSize = innerKey->getDigestSize();
+
+  // keys longer than a block are replaced by their hash, shorter ones padded with zeros
+  std::vector<uint8_t> block(blockSize, 0);
+  if (keyLength > blockSize)
+  {
+    innerKey->update(key, keyLength);
+    innerKey->digestBinary(block.data());
+    innerKey->reset();
+  }
+  else if (keyLength > 0)
+  {
+    const uint8_t* keyBytes = (const uint8_t*) key;
+    std::copy(keyBytes, keyBytes + keyLength, block.begin());
+  }
+
+  std::unique_ptr<MessageDigest> outerKey = innerKey->clone();
+
+  for (auto& byte : block)
+    byte ^= InnerPad;
+  innerKey->update(block.data(), blockSize);
+
+  for (auto& byte : block)
+    byte ^= InnerPad ^ OuterPad;
+  outerKey->update(block.data(), blockSize);
+  wipe(block);
+
+  std::unique_ptr<MessageDigestHMAC> hmac(new MessageDigestHMAC());
+  hmac->_inner = innerKey->clone();
+  hmac->_outer = outerKey->clone();
+  hmac->_innerKey = std::move(innerKey);
+  hmac->_outerKey = std::move(outerKey);
+  hmac->_innerHash.resize(digestSize);
+  hmac->_mac.resize(digestSize);
+  return hmac;
+}
+
+std::unique_ptr<MessageDigestHMAC> MessageDigestHMAC::createInstance(const std::string &algorithm, const std::string &key)
+{
+  return createInstance(algorithm, key.data(), key.length());
+}
+
+std::string MessageDigestHMAC::getAlgorithm() const
+{
+  return "HMAC-" + _innerKey->getAlgorithm();
+}
+
+size_t MessageDigestHMAC::getDigestSize() const
+{
+  return _innerHash.size();
+}
+
+void MessageDigestHMAC::update(const void *data, size_t len)
+{
+  _inner->update(data, len);
+}
+
+void MessageDigestHMAC::update(const std::string &data)
+{
+  _inner->update(data);
+}
+
+std::string MessageDigestHMAC::digest()
+{
+  digestBinary(_mac.data());
+  return MessageDigestEncoding::toHex(_mac.data(), _mac.size());
+}
+
+void MessageDigestHMAC::digestBinary(uint8_t *buffer)
+{
+  _inner->digestBinary(_innerHash.data());
+
+  // one block: the inner hash and the padding
+  _outerKey->cloneInto(*_outer);
+  _outer->update(_innerHash.data(), _innerHash.size());
+  _outer->digestBinary(buffer);
+}
+
+void MessageDigestHMAC::reset()
+{
+  _innerKey->cloneInto(*_inner);
+}
+
+std::string MessageDigestHMAC::operator()(const std::string &text)
+{
+  reset();
+  update(text);
+  return digest();
+}
+
+void MessageDigestHMAC::operator()(const void *data, size_t numBytes, uint8_t *buffer)
+{
+  reset();
+  update(data, numBytes);
+  digestBinary(buffer);
+}
+
+bool MessageDigestHMAC::verify(const void *data, size_t numBytes, const uint8_t *mac, size_t macLength)
+{
+  if (macLength == 0 || macLength > _mac.size())
+    return false;
+
+  (*this)(data, numBytes, _mac.data());
+  return equalConstantTime(_mac.data(), mac, macLength);
+}
+
+void MessageDigestHMAC::digestBatch(const MessageDigestInput *inputs, size_t numInputs, uint8_t *macs)
+{
+  size_t digestSize = getDigestSize();
+  for (size_t i = 0; i < numInputs; i++)
+    (*this)(inputs[i].first, inputs[i].second, macs + i * digestSize);
+  reset();
+}
+
+bool MessageDigestHMAC::verifyBatch(const MessageDigestInput *inputs, size_t numInputs, const uint8_t *macs, bool *valid)
+{
+  size_t digestSize = getDigestSize();
+  bool allValid = true;
+  for (size_t i = 0; i < numInputs; i++)
+  {
+    bool match = verify(inputs[i].first, inputs[i].second, macs + i * digestSize, digestSize);
+    if (valid != nullptr)
+      valid[i] = match;
+    allValid = allValid && match;
+  }
+  reset();
+  return allValid;
+}
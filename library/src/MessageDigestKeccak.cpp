@@ -0,0 +1,536 @@
+/**
+ * @file MessageDigestKeccak.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/MessageDigestKeccak.hpp"
+#include "MessageDigest/MessageDigestEncoding.hpp"
+#include "MessageDigest/CpuFeatures.hpp"
+#include "MessageDigest/MessageDigestState.hpp"
+#include "MessageDigest/MessageDigestMultiBuffer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef MESSAGEDIGEST_X86
+#include <immintrin.h>
+#endif
+
+namespace
+{
+  /// round constants of iota
+  static constexpr uint64_t RC[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+    0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+  };
+
+  /// lanes 1, 2, 8, 12, 17 and 20 are stored complemented
+  const uint32_t Complemented = (1 << 1) | (1 << 2) | (1 << 8) | (1 << 12) | (1 << 17) | (1 << 20);
+
+  inline uint64_t rotateLeft(uint64_t x, int n)
+  {
+    return (x << n) | (x >> (64 - n));
+  }
+
+  /// true value of lane i of a state with complemented lanes
+  inline uint64_t getLane(const uint64_t* state, size_t i)
+  {
+    return (Complemented >> i) & 1 ? ~state[i] : state[i];
+  }
+
+  /// little endian word, independent of the byte order of the machine
+  inline uint64_t load64(const uint8_t* data)
+  {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--)
+      value = (value << 8) | data[i];
+    return value;
+  }
+
+  /**
+   * @brief One round from a into e
+   *
+   * Lane i of the state is a[x + 5*y]. theta, rho and pi are computed plane
+   * by plane, followed by chi on the five lanes of the plane. The choice of
+   * AND, OR and the single NOT per plane keeps the complemented lanes in
+   * place, see "Keccak implementation overview" section 2.2.
+   */
+  inline void keccakRound(const uint64_t* a, uint64_t* e, uint64_t rc)
+  {
+    uint64_t b0, b1, b2, b3, b4, n;
+
+      // theta
+      uint64_t c0 = a[ 0] ^ a[ 5] ^ a[10] ^ a[15] ^ a[20];
+      uint64_t c1 = a[ 1] ^ a[ 6] ^ a[11] ^ a[16] ^ a[21];
+      uint64_t c2 = a[ 2] ^ a[ 7] ^ a[12] ^ a[17] ^ a[22];
+      uint64_t c3 = a[ 3] ^ a[ 8] ^ a[13] ^ a[18] ^ a[23];
+      uint64_t c4 = a[ 4] ^ a[ 9] ^ a[14] ^ a[19] ^ a[24];
+      uint64_t d0 = c4 ^ rotateLeft(c1, 1);
+      uint64_t d1 = c0 ^ rotateLeft(c2, 1);
+      uint64_t d2 = c1 ^ rotateLeft(c3, 1);
+      uint64_t d3 = c2 ^ rotateLeft(c4, 1);
+      uint64_t d4 = c3 ^ rotateLeft(c0, 1);
+
+      // rho and pi into plane 0, then chi and iota
+      b0 = a[ 0] ^ d0;
+      b1 = rotateLeft(a[ 6] ^ d1, 44);
+      b2 = rotateLeft(a[12] ^ d2, 43);
+      b3 = rotateLeft(a[18] ^ d3, 21);
+      b4 = rotateLeft(a[24] ^ d4, 14);
+      n = ~b2;
+      e[ 0] = b0 ^ (b1 | b2) ^ rc;
+      e[ 1] = b1 ^ (n | b3);
+      e[ 2] = b2 ^ (b3 & b4);
+      e[ 3] = b3 ^ (b4 | b0);
+      e[ 4] = b4 ^ (b0 & b1);
+
+      // rho and pi into plane 1, then chi
+      b0 = rotateLeft(a[ 3] ^ d3, 28);
+      b1 = rotateLeft(a[ 9] ^ d4, 20);
+      b2 = rotateLeft(a[10] ^ d0, 3);
+      b3 = rotateLeft(a[16] ^ d1, 45);
+      b4 = rotateLeft(a[22] ^ d2, 61);
+      n = ~b4;
+      e[ 5] = b0 ^ (b1 | b2);
+      e[ 6] = b1 ^ (b2 & b3);
+      e[ 7] = b2 ^ (b3 | n);
+      e[ 8] = b3 ^ (b4 | b0);
+      e[ 9] = b4 ^ (b0 & b1);
+
+      // rho and pi into plane 2, then chi
+      b0 = rotateLeft(a[ 1] ^ d1, 1);
+      b1 = rotateLeft(a[ 7] ^ d2, 6);
+      b2 = rotateLeft(a[13] ^ d3, 25);
+      b3 = rotateLeft(a[19] ^ d4, 8);
+      b4 = rotateLeft(a[20] ^ d0, 18);
+      n = ~b3;
+      e[10] = b0 ^ (b1 | b2);
+      e[11] = b1 ^ (b2 & b3);
+      e[12] = b2 ^ (n & b4);
+      e[13] = n ^ (b4 | b0);
+      e[14] = b4 ^ (b0 & b1);
+
+      // rho and pi into plane 3, then chi
+      b0 = rotateLeft(a[ 4] ^ d4, 27);
+      b1 = rotateLeft(a[ 5] ^ d0, 36);
+      b2 = rotateLeft(a[11] ^ d1, 10);
+      b3 = rotateLeft(a[17] ^ d2, 15);
+      b4 = rotateLeft(a[23] ^ d3, 56);
+      n = ~b3;
+      e[15] = b0 ^ (b1 & b2);
+      e[16] = b1 ^ (b2 | b3);
+      e[17] = b2 ^ (n | b4);
+      e[18] = n ^ (b4 & b0);
+      e[19] = b4 ^ (b0 | b1);
+
+      // rho and pi into plane 4, then chi
+      b0 = rotateLeft(a[ 2] ^ d2, 62);
+      b1 = rotateLeft(a[ 8] ^ d3, 55);
+      b2 = rotateLeft(a[14] ^ d4, 39);
+      b3 = rotateLeft(a[15] ^ d0, 41);
+      b4 = rotateLeft(a[21] ^ d1, 2);
+      n = ~b1;
+      e[20] = b0 ^ (n & b2);
+      e[21] = n ^ (b2 | b3);
+      e[22] = b2 ^ (b3 & b4);
+      e[23] = b3 ^ (b4 | b0);
+      e[24] = b4 ^ (b0 & b1);
+  }
+
+  /// padding of the multi-buffer engine, the whole tail fits into one block
+  template<size_t RATE, uint8_t DOMAIN>
+  struct KeccakPadding
+  {
+    static size_t pad(uint8_t* padded, const uint8_t* tail, size_t tailSize, uint64_t numBytes)
+    {
+      (void) numBytes;
+      if (tailSize > 0)
+        std::memcpy(padded, tail, tailSize);
+      std::memset(padded + tailSize, 0, RATE - tailSize);
+      padded[tailSize]  = DOMAIN;
+      padded[RATE - 1] |= 0x80;
+      return 1;
+    }
+  };
+
+#ifdef MESSAGEDIGEST_X86
+  // multi-buffer kernel: 25 rows with one lane per message, no complemented
+  // lanes since AVX2 has an AND NOT
+
+  MESSAGEDIGEST_TARGET("avx2")
+  inline __m256i rotateLeftAVX2(__m256i x, int n)
+  {
+    return _mm256_or_si256(_mm256_slli_epi64(x, n), _mm256_srli_epi64(x, 64 - n));
+  }
+
+  /// one round from a into e, the lanes in the order of keccakRound()
+  MESSAGEDIGEST_TARGET("avx2")
+  inline void keccakRoundAVX2(const __m256i* a, __m256i* e, __m256i rc)
+  {
+    __m256i b0, b1, b2, b3, b4;
+
+      // theta
+      __m256i c0 = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(a[ 0], a[ 5]), _mm256_xor_si256(a[10], a[15])), a[20]);
+      __m256i c1 = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(a[ 1], a[ 6]), _mm256_xor_si256(a[11], a[16])), a[21]);
+      __m256i c2 = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(a[ 2], a[ 7]), _mm256_xor_si256(a[12], a[17])), a[22]);
+      __m256i c3 = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(a[ 3], a[ 8]), _mm256_xor_si256(a[13], a[18])), a[23]);
+      __m256i c4 = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(a[ 4], a[ 9]), _mm256_xor_si256(a[14], a[19])), a[24]);
+      __m256i d0 = _mm256_xor_si256(c4, rotateLeftAVX2(c1, 1));
+      __m256i d1 = _mm256_xor_si256(c0, rotateLeftAVX2(c2, 1));
+      __m256i d2 = _mm256_xor_si256(c1, rotateLeftAVX2(c3, 1));
+      __m256i d3 = _mm256_xor_si256(c2, rotateLeftAVX2(c4, 1));
+      __m256i d4 = _mm256_xor_si256(c3, rotateLeftAVX2(c0, 1));
+
+      // rho and pi into plane 0, then chi and iota
+      b0 = _mm256_xor_si256(a[ 0], d0);
+      b1 = rotateLeftAVX2(_mm256_xor_si256(a[ 6], d1), 44);
+      b2 = rotateLeftAVX2(_mm256_xor_si256(a[12], d2), 43);
+      b3 = rotateLeftAVX2(_mm256_xor_si256(a[18], d3), 21);
+      b4 = rotateLeftAVX2(_mm256_xor_si256(a[24], d4), 14);
+      e[ 0] = _mm256_xor_si256(_mm256_xor_si256(b0, _mm256_andnot_si256(b1, b2)), rc);
+      e[ 1] = _mm256_xor_si256(b1, _mm256_andnot_si256(b2, b3));
+      e[ 2] = _mm256_xor_si256(b2, _mm256_andnot_si256(b3, b4));
+      e[ 3] = _mm256_xor_si256(b3, _mm256_andnot_si256(b4, b0));
+      e[ 4] = _mm256_xor_si256(b4, _mm256_andnot_si256(b0, b1));
+
+      // rho and pi into plane 1, then chi
+      b0 = rotateLeftAVX2(_mm256_xor_si256(a[ 3], d3), 28);
+      b1 = rotateLeftAVX2(_mm256_xor_si256(a[ 9], d4), 20);
+      b2 = rotateLeftAVX2(_mm256_xor_si256(a[10], d0), 3);
+      b3 = rotateLeftAVX2(_mm256_xor_si256(a[16], d1), 45);
+      b4 = rotateLeftAVX2(_mm256_xor_si256(a[22], d2), 61);
+      e[ 5] = _mm256_xor_si256(b0, _mm256_andnot_si256(b1, b2));
+      e[ 6] = _mm256_xor_si256(b1, _mm256_andnot_si256(b2, b3));
+      e[ 7] = _mm256_xor_si256(b2, _mm256_andnot_si256(b3, b4));
+      e[ 8] = _mm256_xor_si256(b3, _mm256_andnot_si256(b4, b0));
+      e[ 9] = _mm256_xor_si256(b4, _mm256_andnot_si256(b0, b1));
+
+      // rho and pi into plane 2, then chi
+      b0 = rotateLeftAVX2(_mm256_xor_si256(a[ 1], d1), 1);
+      b1 = rotateLeftAVX2(_mm256_xor_si256(a[ 7], d2), 6);
+      b2 = rotateLeftAVX2(_mm256_xor_si256(a[13], d3), 25);
+      b3 = rotateLeftAVX2(_mm256_xor_si256(a[19], d4), 8);
+      b4 = rotateLeftAVX2(_mm256_xor_si256(a[20], d0), 18);
+      e[10] = _mm256_xor_si256(b0, _mm256_andnot_si256(b1, b2));
+      e[11] = _mm256_xor_si256(b1, _mm256_andnot_si256(b2, b3));
+      e[12] = _mm256_xor_si256(b2, _mm256_andnot_si256(b3, b4));
+      e[13] = _mm256_xor_si256(b3, _mm256_andnot_si256(b4, b0));
+      e[14] = _mm256_xor_si256(b4, _mm256_andnot_si256(b0, b1));
+
+      // rho and pi into plane 3, then chi
+      b0 = rotateLeftAVX2(_mm256_xor_si256(a[ 4], d4), 27);
+      b1 = rotateLeftAVX2(_mm256_xor_si256(a[ 5], d0), 36);
+      b2 = rotateLeftAVX2(_mm256_xor_si256(a[11], d1), 10);
+      b3 = rotateLeftAVX2(_mm256_xor_si256(a[17], d2), 15);
+      b4 = rotateLeftAVX2(_mm256_xor_si256(a[23], d3), 56);
+      e[15] = _mm256_xor_si256(b0, _mm256_andnot_si256(b1, b2));
+      e[16] = _mm256_xor_si256(b1, _mm256_andnot_si256(b2, b3));
+      e[17] = _mm256_xor_si256(b2, _mm256_andnot_si256(b3, b4));
+      e[18] = _mm256_xor_si256(b3, _mm256_andnot_si256(b4, b0));
+      e[19] = _mm256_xor_si256(b4, _mm256_andnot_si256(b0, b1));
+
+      // rho and pi into plane 4, then chi
+      b0 = rotateLeftAVX2(_mm256_xor_si256(a[ 2], d2), 62);
+      b1 = rotateLeftAVX2(_mm256_xor_si256(a[ 8], d3), 55);
+      b2 = rotateLeftAVX2(_mm256_xor_si256(a[14], d4), 39);
+      b3 = rotateLeftAVX2(_mm256_xor_si256(a[15], d0), 41);
+      b4 = rotateLeftAVX2(_mm256_xor_si256(a[21], d1), 2);
+      e[20] = _mm256_xor_si256(b0, _mm256_andnot_si256(b1, b2));
+      e[21] = _mm256_xor_si256(b1, _mm256_andnot_si256(b2, b3));
+      e[22] = _mm256_xor_si256(b2, _mm256_andnot_si256(b3, b4));
+      e[23] = _mm256_xor_si256(b3, _mm256_andnot_si256(b4, b0));
+      e[24] = _mm256_xor_si256(b4, _mm256_andnot_si256(b0, b1));
+  }
+
+  /// Keccak-f[1600] on 4 states
+  MESSAGEDIGEST_TARGET("avx2")
+  void permuteAVX2(uint64_t* state)
+  {
+    __m256i a[25], e[25];
+    for (int i = 0; i < 25; i++)
+      a[i] = _mm256_loadu_si256((const __m256i*) (state + 4*i));
+
+    for (int round = 0; round < 24; round += 2)
+    {
+      keccakRoundAVX2(a, e, _mm256_set1_epi64x((long long) RC[round]));
+      keccakRoundAVX2(e, a, _mm256_set1_epi64x((long long) RC[round + 1]));
+    }
+
+    for (int i = 0; i < 25; i++)
+      _mm256_storeu_si256((__m256i*) (state + 4*i), a[i]);
+  }
+#endif
+
+}
+
+MessageDigestKeccak::MessageDigestKeccak(size_t rate, size_t digestSize, uint8_t domain)
+  : _rate(rate), _digestSize(digestSize), _domain(domain)
+{
+  if (isSupported(BatchKernel::AVX2))
+    _batchKernel = BatchKernel::AVX2;
+  else
+    _batchKernel = BatchKernel::Serial;
+
+  reset();
+}
+
+void MessageDigestKeccak::reset()
+{
+  for (size_t i = 0; i < STATE_SIZE; i++)
+    _state[i] = (Complemented >> i) & 1 ? ~0ULL : 0;
+  _position  = 0;
+  _squeezing = false;
+}
+
+std::vector<uint8_t> MessageDigestKeccak::exportState() const
+{
+  // the true lanes, the complemented ones are an implementation detail
+  MessageDigestStateWriter writer(getAlgorithm());
+  for (size_t i = 0; i < STATE_SIZE; i++)
+    writer.write(getLane(_state, i));
+  writer.write((uint8_t) _position);
+  return writer.state();
+}
+
+bool MessageDigestKeccak::importState(const uint8_t *state, size_t size)
+{
+  MessageDigestStateReader reader(state, size);
+  uint64_t lanes[STATE_SIZE];
+  uint8_t  position;
+
+  if (!reader.readHeader(getAlgorithm()))
+    return false;
+  for (size_t i = 0; i < STATE_SIZE; i++)
+    if (!reader.read(lanes[i]))
+      return false;
+  if (!reader.read(position) || position >= _rate || !reader.atEnd())
+    return false;
+
+  for (size_t i = 0; i < STATE_SIZE; i++)
+    _state[i] = getLane(lanes, i);
+  _position  = position;
+  _squeezing = false;
+  return true;
+}
+
+std::string MessageDigestKeccak::digest()
+{
+  std::vector<uint8_t> buffer(_digestSize);
+  digestBinary(buffer.data());
+  return MessageDigestEncoding::toHex(buffer.data(), _digestSize);
+}
+
+void MessageDigestKeccak::digestBinary(uint8_t *buffer)
+{
+  // the sponge keeps absorbing, the output is squeezed from a copy
+  uint64_t output[STATE_SIZE];
+  size_t position = 0;
+  finish(output);
+  squeeze(output, position, buffer, _digestSize);
+}
+
+void MessageDigestKeccak::squeeze(uint8_t *output, size_t numBytes)
+{
+  if (!_squeezing)
+  {
+    finish(_output);
+    _outputPosition = 0;
+    _squeezing      = true;
+  }
+  squeeze(_output, _outputPosition, output, numBytes);
+}
+
+void MessageDigestKeccak::finish(uint64_t *output) const
+{
+  for (size_t i = 0; i < STATE_SIZE; i++)
+    output[i] = _state[i];
+
+  // domain bits and the first "1" bit of pad10*1, the last "1" bit ends the rate
+  output[_position / 8]  ^= (uint64_t) _domain << (8 * (_position % 8));
+  output[_rate / 8 - 1]  ^= 0x8000000000000000ULL;
+  permute(output);
+}
+
+void MessageDigestKeccak::squeeze(uint64_t *output, size_t &position, uint8_t *buffer, size_t numBytes) const
+{
+  while (numBytes > 0)
+  {
+    if (position == _rate)
+    {
+      permute(output);
+      position = 0;
+    }
+
+    size_t take = std::min(numBytes, _rate - position);
+    for (size_t i = 0; i < take; i++, position++)
+      *buffer++ = (getLane(output, position / 8) >> (8 * (position % 8))) & 0xFF;
+    numBytes -= take;
+  }
+}
+
+size_t MessageDigestKeccak::getDigestSize() const
+{
+  return _digestSize;
+}
+
+size_t MessageDigestKeccak::getBlockSize() const
+{
+  return _rate;
+}
+
+void MessageDigestKeccak::update(const void *data, const size_t offset, const size_t len)
+{
+  const uint8_t* current = (const uint8_t*) data + offset;
+  size_t numBytes = len;
+
+  _squeezing = false;
+
+  // complete the current rate
+  if (_position > 0)
+  {
+    size_t add = std::min(numBytes, _rate - _position);
+    for (size_t i = 0; i < add; i++, _position++)
+      _state[_position / 8] ^= (uint64_t) *current++ << (8 * (_position % 8));
+    numBytes -= add;
+
+    if (_position < _rate)
+      return;
+
+    permute(_state);
+    _position = 0;
+  }
+
+  // full rates from the caller's memory
+  size_t rateWords = _rate / 8;
+  while (numBytes >= _rate)
+  {
+    for (size_t i = 0; i < rateWords; i++)
+      _state[i] ^= load64(current + 8*i);
+    permute(_state);
+    current  += _rate;
+    numBytes -= _rate;
+  }
+
+  for (; numBytes > 0; numBytes--, _position++)
+    _state[_position / 8] ^= (uint64_t) *current++ << (8 * (_position % 8));
+}
+
+void MessageDigestKeccak::permute(uint64_t *state)
+{
+  // two rounds per iteration swap the roles of a and e without a copy
+  uint64_t a[STATE_SIZE], e[STATE_SIZE];
+  for (size_t i = 0; i < STATE_SIZE; i++)
+    a[i] = state[i];
+
+  for (int round = 0; round < 24; round += 2)
+  {
+    keccakRound(a, e, RC[round]);
+    keccakRound(e, a, RC[round + 1]);
+  }
+
+  for (size_t i = 0; i < STATE_SIZE; i++)
+    state[i] = a[i];
+}
+
+bool MessageDigestKeccak::setBatchKernel(BatchKernel kernel)
+{
+  if (!isSupported(kernel))
+    return false;
+
+  _batchKernel = kernel;
+  return true;
+}
+
+MessageDigestKeccak::BatchKernel MessageDigestKeccak::getBatchKernel() const
+{
+  return _batchKernel;
+}
+
+bool MessageDigestKeccak::isSupported(BatchKernel kernel)
+{
+  switch (kernel)
+  {
+#ifdef MESSAGEDIGEST_X86
+  case BatchKernel::AVX2:
+    return CpuFeatures::hasAVX2();
+#else
+  case BatchKernel::AVX2:
+    return false;
+#endif
+  default:
+    return true;
+  }
+}
+
+void MessageDigestKeccak::digestBatch(const MessageDigestInput *inputs, size_t numInputs, uint8_t *digests)
+{
+#ifdef MESSAGEDIGEST_X86
+  // the engine reads the digest from the first rate, longer SHAKE output
+  // would need further permutations of single lanes
+  if (_batchKernel == BatchKernel::AVX2 && _digestSize <= _rate)
+  {
+    if (_domain == 0x06)
+    {
+      switch (_rate)
+      {
+      case 144: digestBatchMultiBuffer<144,0x06>(inputs, numInputs, digests); return;
+      case 136: digestBatchMultiBuffer<136,0x06>(inputs, numInputs, digests); return;
+      case 104: digestBatchMultiBuffer<104,0x06>(inputs, numInputs, digests); return;
+      case  72: digestBatchMultiBuffer< 72,0x06>(inputs, numInputs, digests); return;
+      }
+    }
+    else if (_domain == 0x1F)
+    {
+      switch (_rate)
+      {
+      case 168: digestBatchMultiBuffer<168,0x1F>(inputs, numInputs, digests); return;
+      case 136: digestBatchMultiBuffer<136,0x1F>(inputs, numInputs, digests); return;
+      }
+    }
+  }
+#endif
+
+  MessageDigestImpl::digestBatch(inputs, numInputs, digests);
+}
+
+#ifdef MESSAGEDIGEST_X86
+template<size_t RATE, uint8_t DOMAIN>
+void MessageDigestKeccak::digestBatchMultiBuffer(const MessageDigestInput *inputs, size_t numInputs, uint8_t *digests)
+{
+  static constexpr size_t LANES = 4;
+
+  // leave the instance as MessageDigestImpl::digestBatch() does
+  reset();
+
+  // structure of arrays, row i holds lane i of all messages
+  uint64_t state[STATE_SIZE*LANES];
+
+  MessageDigestLaneScheduler<LANES,RATE,KeccakPadding<RATE,DOMAIN> > engine(inputs, numInputs);
+  engine.run(
+        [&](size_t lane)
+        {
+          for (size_t i = 0; i < STATE_SIZE; i++)
+            state[i*LANES + lane] = 0;
+        },
+        [&](const uint8_t* const* blocks)
+        {
+          for (size_t lane = 0; lane < LANES; lane++)
+            for (size_t i = 0; i < RATE / 8; i++)
+              state[i*LANES + lane] ^= load64(blocks[lane] + 8*i);
+          permuteAVX2(state);
+        },
+        [&](size_t lane, size_t message)
+        {
+          uint8_t* digest = digests + message * _digestSize;
+          for (size_t i = 0; i < _digestSize; i++)
+            digest[i] = (state[(i / 8)*LANES + lane] >> (8 * (i % 8))) & 0xFF;
+        });
+}
+#endif
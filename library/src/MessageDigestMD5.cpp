@@ -17,8 +17,17 @@
 
 #include "MessageDigest/MessageDigestMD5.hpp"
 #include "MessageDigest/MessageDigest.hpp"
+#include "MessageDigest/MessageDigestEncoding.hpp"
+#include "MessageDigest/CpuFeatures.hpp"
+#include "MessageDigest/MessageDigestState.hpp"
+#include "MessageDigest/MessageDigestMultiBuffer.hpp"
 
 #include <iostream>
+#include <cstring>
+
+#ifdef MESSAGEDIGEST_X86
+#include <immintrin.h>
+#endif
 
 // big endian architectures need #define __BYTE_ORDER __BIG_ENDIAN
 #ifndef _MSC_VER
@@ -66,10 +75,175 @@ namespace
     return c ^ (b | ~d);
   }
 
+#ifdef MESSAGEDIGEST_X86
+  // multi-buffer kernels: hash holds four rows with one word per lane,
+  // blocks points to the next 64 bytes of every lane
+
+  /// the constants of processBlock() in the order of the 64 steps
+  static constexpr uint32_t T[64] = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+  };
+
+  /// rotations of the four steps of each round
+  static constexpr int S[4][4] = {
+    { 7, 12, 17, 22 },
+    { 5,  9, 14, 20 },
+    { 4, 11, 16, 23 },
+    { 6, 10, 15, 21 }
+  };
+
+  MESSAGEDIGEST_TARGET("avx2")
+  inline __m256i rotateLeftAVX2(__m256i a, int c)
+  {
+    return _mm256_or_si256(_mm256_sll_epi32(a, _mm_cvtsi32_si128(c)), _mm256_srl_epi32(a, _mm_cvtsi32_si128(32 - c)));
+  }
+
+  /// one step: returns the new b, the caller rotates a, b, c and d
+  MESSAGEDIGEST_TARGET("avx2")
+  inline __m256i stepAVX2(__m256i a, __m256i b, __m256i f, __m256i word, int i)
+  {
+    __m256i x = _mm256_add_epi32(_mm256_add_epi32(a, f), _mm256_add_epi32(word, _mm256_set1_epi32((int) T[i])));
+    return _mm256_add_epi32(b, rotateLeftAVX2(x, S[i >> 4][i & 3]));
+  }
+
+  /// process one block of each of 8 messages
+  MESSAGEDIGEST_TARGET("avx2")
+  void processBlocksAVX2(uint32_t* hash, const uint8_t* const* blocks)
+  {
+    // transpose to one register per message word
+    __m256i words[16];
+    for (int i = 0; i < 16; i++)
+    {
+      uint32_t column[8];
+      for (int lane = 0; lane < 8; lane++)
+        std::memcpy(&column[lane], blocks[lane] + 4*i, 4);
+      words[i] = _mm256_loadu_si256((const __m256i*) column);
+    }
+
+    __m256i* state = (__m256i*) hash;
+    __m256i a = _mm256_loadu_si256(state + 0);
+    __m256i b = _mm256_loadu_si256(state + 1);
+    __m256i c = _mm256_loadu_si256(state + 2);
+    __m256i d = _mm256_loadu_si256(state + 3);
+    __m256i x;
+
+    // first round: d ^ (b & (c ^ d))
+    for (int i = 0; i < 16; i++)
+    {
+      __m256i f = _mm256_xor_si256(d, _mm256_and_si256(b, _mm256_xor_si256(c, d)));
+      x = stepAVX2(a, b, f, words[i], i);
+      a = d; d = c; c = b; b = x;
+    }
+
+    // second round: c ^ (d & (b ^ c))
+    for (int i = 16; i < 32; i++)
+    {
+      __m256i f = _mm256_xor_si256(c, _mm256_and_si256(d, _mm256_xor_si256(b, c)));
+      x = stepAVX2(a, b, f, words[(5*i + 1) & 15], i);
+      a = d; d = c; c = b; b = x;
+    }
+
+    // third round: b ^ c ^ d
+    for (int i = 32; i < 48; i++)
+    {
+      __m256i f = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+      x = stepAVX2(a, b, f, words[(3*i + 5) & 15], i);
+      a = d; d = c; c = b; b = x;
+    }
+
+    // fourth round: c ^ (b | ~d)
+    const __m256i ones = _mm256_set1_epi32(-1);
+    for (int i = 48; i < 64; i++)
+    {
+      __m256i f = _mm256_xor_si256(c, _mm256_or_si256(b, _mm256_xor_si256(d, ones)));
+      x = stepAVX2(a, b, f, words[(7*i) & 15], i);
+      a = d; d = c; c = b; b = x;
+    }
+
+    // update hash
+    _mm256_storeu_si256(state + 0, _mm256_add_epi32(_mm256_loadu_si256(state + 0), a));
+    _mm256_storeu_si256(state + 1, _mm256_add_epi32(_mm256_loadu_si256(state + 1), b));
+    _mm256_storeu_si256(state + 2, _mm256_add_epi32(_mm256_loadu_si256(state + 2), c));
+    _mm256_storeu_si256(state + 3, _mm256_add_epi32(_mm256_loadu_si256(state + 3), d));
+  }
+
+  /// one step: returns the new b, the caller rotates a, b, c and d
+  MESSAGEDIGEST_TARGET("avx512f")
+  inline __m512i stepAVX512(__m512i a, __m512i b, __m512i f, __m512i word, int i)
+  {
+    __m512i x = _mm512_add_epi32(_mm512_add_epi32(a, f), _mm512_add_epi32(word, _mm512_set1_epi32((int) T[i])));
+    return _mm512_add_epi32(b, _mm512_rolv_epi32(x, _mm512_set1_epi32(S[i >> 4][i & 3])));
+  }
+
+  /// process one block of each of 16 messages
+  MESSAGEDIGEST_TARGET("avx512f")
+  void processBlocksAVX512(uint32_t* hash, const uint8_t* const* blocks)
+  {
+    // transpose to one register per message word
+    __m512i words[16];
+    for (int i = 0; i < 16; i++)
+    {
+      uint32_t column[16];
+      for (int lane = 0; lane < 16; lane++)
+        std::memcpy(&column[lane], blocks[lane] + 4*i, 4);
+      words[i] = _mm512_loadu_si512(column);
+    }
+
+    uint32_t* state = hash;
+    __m512i a = _mm512_loadu_si512(state +  0);
+    __m512i b = _mm512_loadu_si512(state + 16);
+    __m512i c = _mm512_loadu_si512(state + 32);
+    __m512i d = _mm512_loadu_si512(state + 48);
+    __m512i x;
+
+    // the round functions as ternary logic of b, c and d
+    for (int i = 0; i < 16; i++)
+    {
+      x = stepAVX512(a, b, _mm512_ternarylogic_epi32(b, c, d, 0xCA), words[i], i);
+      a = d; d = c; c = b; b = x;
+    }
+    for (int i = 16; i < 32; i++)
+    {
+      x = stepAVX512(a, b, _mm512_ternarylogic_epi32(b, c, d, 0xE4), words[(5*i + 1) & 15], i);
+      a = d; d = c; c = b; b = x;
+    }
+    for (int i = 32; i < 48; i++)
+    {
+      x = stepAVX512(a, b, _mm512_ternarylogic_epi32(b, c, d, 0x96), words[(3*i + 5) & 15], i);
+      a = d; d = c; c = b; b = x;
+    }
+    for (int i = 48; i < 64; i++)
+    {
+      x = stepAVX512(a, b, _mm512_ternarylogic_epi32(b, c, d, 0x39), words[(7*i) & 15], i);
+      a = d; d = c; c = b; b = x;
+    }
+
+    // update hash
+    _mm512_storeu_si512(state +  0, _mm512_add_epi32(_mm512_loadu_si512(state +  0), a));
+    _mm512_storeu_si512(state + 16, _mm512_add_epi32(_mm512_loadu_si512(state + 16), b));
+    _mm512_storeu_si512(state + 32, _mm512_add_epi32(_mm512_loadu_si512(state + 32), c));
+    _mm512_storeu_si512(state + 48, _mm512_add_epi32(_mm512_loadu_si512(state + 48), d));
+  }
+#endif
+
 }
 
 MessageDigestMD5::MessageDigestMD5()
 {
+  if (isSupported(BatchKernel::AVX512))
+    _batchKernel = BatchKernel::AVX512;
+  else if (isSupported(BatchKernel::AVX2))
+    _batchKernel = BatchKernel::AVX2;
+  else
+    _batchKernel = BatchKernel::Serial;
+
   reset();
 }
 
@@ -90,51 +264,215 @@ void MessageDigestMD5::reset()
   _hash[3] = 0x10325476;
 }
 
+std::vector<uint8_t> MessageDigestMD5::exportState() const
+{
+  MessageDigestStateWriter writer(getAlgorithm());
+  writer.write(_numBytes);
+  for (int i = 0; i < HASH_SIZE; i++)
+    writer.write(_hash[i]);
+  writer.write((uint8_t) _bufferSize);
+  writer.write(_buffer, _bufferSize);
+  return writer.state();
+}
+
+bool MessageDigestMD5::importState(const uint8_t *state, size_t size)
+{
+  MessageDigestStateReader reader(state, size);
+  uint64_t numBytes;
+  uint32_t hash[HASH_SIZE];
+  uint8_t  bufferSize;
+  uint8_t  buffer[BLOCK_SIZE];
+
+  if (!reader.readHeader(getAlgorithm()) || !reader.read(numBytes) || numBytes % BLOCK_SIZE != 0)
+    return false;
+  for (int i = 0; i < HASH_SIZE; i++)
+    if (!reader.read(hash[i]))
+      return false;
+  if (!reader.read(bufferSize) || bufferSize >= BLOCK_SIZE || !reader.read(buffer, bufferSize) || !reader.atEnd())
+    return false;
+
+  _numBytes   = numBytes;
+  _bufferSize = bufferSize;
+  for (int i = 0; i < HASH_SIZE; i++)
+    _hash[i] = hash[i];
+  for (int i = 0; i < bufferSize; i++)
+    _buffer[i] = buffer[i];
+  return true;
+}
+
 std::unique_ptr<MessageDigestImpl> MessageDigestMD5::create()
 {
   return std::unique_ptr<MessageDigestImpl>(new MessageDigestMD5());
 }
 
+std::unique_ptr<MessageDigestImpl> MessageDigestMD5::clone() const
+{
+  return cloneDigest(*this);
+}
+
+bool MessageDigestMD5::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
+
 std::string MessageDigestMD5::digest()
 {
-  // convert hash to string
-  static const char dec2hex[16+1] = "0123456789abcdef";
+  uint8_t buffer[DIGEST_SIZE];
+  digestBinary(buffer);
+  return MessageDigestEncoding::toHex(buffer, DIGEST_SIZE);
+}
 
+void MessageDigestMD5::digestBinary(uint8_t *buffer)
+{
   // save old hash if buffer is partially filled
-  uint32_t oldHash[4];
-  oldHash[0] = _hash[0];
-  oldHash[1] = _hash[1];
-  oldHash[2] = _hash[2];
-  oldHash[3] = _hash[3];
+  uint32_t oldHash[HASH_SIZE];
+  for (int i = 0; i < HASH_SIZE; i++)
+    oldHash[i] = _hash[i];
 
   // process remaining bytes
   processBuffer();
 
-  // create hash string
-  char hashBuffer[HASH_SIZE*8+1];
-  size_t offset = 0;
+  hashToBytes(_hash, buffer);
+
+  // restore old hash
+  for (int i = 0; i < HASH_SIZE; i++)
+    _hash[i] = oldHash[i];
+}
+
+size_t MessageDigestMD5::getDigestSize() const
+{
+  return DIGEST_SIZE;
+}
+
+size_t MessageDigestMD5::getBlockSize() const
+{
+  return BLOCK_SIZE;
+}
+
+void MessageDigestMD5::hashToBytes(const uint32_t *hash, uint8_t *buffer)
+{
+  // MD5 stores its words little endian
   for (int i = 0; i < HASH_SIZE; i++)
   {
-    hashBuffer[offset++] = dec2hex[(_hash[i] >>  4) & 15];
-    hashBuffer[offset++] = dec2hex[ _hash[i]        & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 12) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >>  8) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 20) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 16) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 28) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 24) & 15];
+    *buffer++ =  hash[i]        & 0xFF;
+    *buffer++ = (hash[i] >>  8) & 0xFF;
+    *buffer++ = (hash[i] >> 16) & 0xFF;
+    *buffer++ = (hash[i] >> 24) & 0xFF;
   }
+}
 
-  // zero-terminated string
-  hashBuffer[offset] = 0;
+bool MessageDigestMD5::setBatchKernel(BatchKernel kernel)
+{
+  if (!isSupported(kernel))
+    return false;
 
-  // restore old hash
-  _hash[0] = oldHash[0];
-  _hash[1] = oldHash[1];
-  _hash[2] = oldHash[2];
-  _hash[3] = oldHash[3];
+  _batchKernel = kernel;
+  return true;
+}
+
+MessageDigestMD5::BatchKernel MessageDigestMD5::getBatchKernel() const
+{
+  return _batchKernel;
+}
 
-  return hashBuffer;
+bool MessageDigestMD5::isSupported(BatchKernel kernel)
+{
+  switch (kernel)
+  {
+#ifdef MESSAGEDIGEST_X86
+  case BatchKernel::AVX2:
+    return CpuFeatures::hasAVX2();
+  case BatchKernel::AVX512:
+    return CpuFeatures::hasAVX512F();
+#else
+  case BatchKernel::AVX2:
+  case BatchKernel::AVX512:
+    return false;
+#endif
+  default:
+    return true;
+  }
+}
+
+void MessageDigestMD5::digestBatch(const MessageDigestInput *inputs, size_t numInputs, uint8_t *digests)
+{
+  switch (_batchKernel)
+  {
+#ifdef MESSAGEDIGEST_X86
+  case BatchKernel::AVX2:
+    digestBatchMultiBuffer<8>(inputs, numInputs, digests, processBlocksAVX2);
+    break;
+  case BatchKernel::AVX512:
+    digestBatchMultiBuffer<16>(inputs, numInputs, digests, processBlocksAVX512);
+    break;
+#endif
+  default:
+    digestBatchSerial(inputs, numInputs, digests);
+  }
+}
+
+template<size_t LANES>
+void MessageDigestMD5::digestBatchMultiBuffer(const MessageDigestInput *inputs, size_t numInputs, uint8_t *digests,
+                                              ProcessBlocksFunc processBlocks)
+{
+  // according to RFC 1321 section 3.3
+  static constexpr uint32_t initialHash[HASH_SIZE] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
+
+  // the lanes keep their own state; drop the streaming one as digestBatchSerial() does
+  reset();
+
+  // structure of arrays, row i holds _hash[i] of all lanes
+  uint32_t state[HASH_SIZE*LANES];
+
+  // messages of unequal length are fine: a lane takes the next message
+  // as soon as its current one is done
+  MessageDigestMultiBuffer<LANES,BLOCK_SIZE,8,false> engine(inputs, numInputs);
+  engine.run(
+        [&](size_t lane)
+        {
+          for (int i = 0; i < HASH_SIZE; i++)
+            state[i*LANES + lane] = initialHash[i];
+        },
+        [&](const uint8_t* const* blocks)
+        {
+          processBlocks(state, blocks);
+        },
+        [&](size_t lane, size_t message)
+        {
+          uint32_t hash[HASH_SIZE];
+          for (int i = 0; i < HASH_SIZE; i++)
+            hash[i] = state[i*LANES + lane];
+          hashToBytes(hash, digests + message * DIGEST_SIZE);
+        });
+}
+
+void MessageDigestMD5::digestBatchSerial(const MessageDigestInput *inputs, size_t numInputs, uint8_t *digests)
+{
+  reset();
+  uint32_t initialHash[HASH_SIZE];
+  for (int i = 0; i < HASH_SIZE; i++)
+    initialHash[i] = _hash[i];
+
+  uint8_t padded[2*BLOCK_SIZE];
+  for (size_t message = 0; message < numInputs; message++)
+  {
+    const uint8_t* data = (const uint8_t*) inputs[message].first;
+    size_t numBytes = inputs[message].second;
+    size_t fullBlocks = numBytes / BLOCK_SIZE;
+
+    for (int i = 0; i < HASH_SIZE; i++)
+      _hash[i] = initialHash[i];
+    if (fullBlocks > 0)
+      processBlocks(data, fullBlocks);
+
+    size_t numPadded = MessageDigestMultiBuffer<1,BLOCK_SIZE,8,false>::pad(
+          padded, data + fullBlocks * BLOCK_SIZE, numBytes % BLOCK_SIZE, numBytes);
+    processBlocks(padded, numPadded);
+
+    hashToBytes(_hash, digests + message * DIGEST_SIZE);
+  }
+
+  reset();
 }
 
 void MessageDigestMD5::update(const void *data, const size_t offset, const size_t len)
@@ -163,13 +501,14 @@ void MessageDigestMD5::update(const void *data, const size_t offset, const size_
   if (numBytes == 0)
     return;
 
-  // process full blocks
-  while (numBytes >= BLOCK_SIZE)
+  // process full blocks in one run
+  if (numBytes >= BLOCK_SIZE)
   {
-    processBlock(current);
-    current    += BLOCK_SIZE;
-    _numBytes += BLOCK_SIZE;
-    numBytes   -= BLOCK_SIZE;
+    size_t nBlocks = numBytes / BLOCK_SIZE;
+    processBlocks(current, nBlocks);
+    current   += nBlocks * BLOCK_SIZE;
+    _numBytes += nBlocks * BLOCK_SIZE;
+    numBytes  -= nBlocks * BLOCK_SIZE;
   }
 
   // keep remaining bytes in buffer
@@ -180,106 +519,124 @@ void MessageDigestMD5::update(const void *data, const size_t offset, const size_
   }
 }
 
+void MessageDigestMD5::processBlocks(const void *data, size_t nBlocks)
+{
+  // the chaining state stays in locals for the whole run, _hash could
+  // alias the input and would be reloaded for every block
+  uint32_t state[HASH_SIZE];
+  for (int i = 0; i < HASH_SIZE; i++)
+    state[i] = _hash[i];
+
+  const uint8_t* current = (const uint8_t*) data;
+  for (; nBlocks > 0; nBlocks--, current += BLOCK_SIZE)
+  {
+    // get last hash
+    uint32_t a = state[0];
+    uint32_t b = state[1];
+    uint32_t c = state[2];
+    uint32_t d = state[3];
+
+    // data represented as 16x 32-bit words
+    const uint32_t* words = (const uint32_t*) current;
+
+    // first round
+    a = rotateLeft(a + f1(b,c,d) + words[0]  + 0xd76aa478,  7) + b;
+    d = rotateLeft(d + f1(a,b,c) + words[1]  + 0xe8c7b756, 12) + a;
+    c = rotateLeft(c + f1(d,a,b) + words[2]  + 0x242070db, 17) + d;
+    b = rotateLeft(b + f1(c,d,a) + words[3]  + 0xc1bdceee, 22) + c;
+
+    a = rotateLeft(a + f1(b,c,d) + words[4]  + 0xf57c0faf,  7) + b;
+    d = rotateLeft(d + f1(a,b,c) + words[5]  + 0x4787c62a, 12) + a;
+    c = rotateLeft(c + f1(d,a,b) + words[6]  + 0xa8304613, 17) + d;
+    b = rotateLeft(b + f1(c,d,a) + words[7]  + 0xfd469501, 22) + c;
+
+    a = rotateLeft(a + f1(b,c,d) + words[8]  + 0x698098d8,  7) + b;
+    d = rotateLeft(d + f1(a,b,c) + words[9]  + 0x8b44f7af, 12) + a;
+    c = rotateLeft(c + f1(d,a,b) + words[10] + 0xffff5bb1, 17) + d;
+    b = rotateLeft(b + f1(c,d,a) + words[11] + 0x895cd7be, 22) + c;
+
+    a = rotateLeft(a + f1(b,c,d) + words[12] + 0x6b901122,  7) + b;
+    d = rotateLeft(d + f1(a,b,c) + words[13] + 0xfd987193, 12) + a;
+    c = rotateLeft(c + f1(d,a,b) + words[14] + 0xa679438e, 17) + d;
+    b = rotateLeft(b + f1(c,d,a) + words[15] + 0x49b40821, 22) + c;
+
+    // second round
+    a = rotateLeft(a + f2(b,c,d) + words[1]  + 0xf61e2562,  5) + b;
+    d = rotateLeft(d + f2(a,b,c) + words[6]  + 0xc040b340,  9) + a;
+    c = rotateLeft(c + f2(d,a,b) + words[11] + 0x265e5a51, 14) + d;
+    b = rotateLeft(b + f2(c,d,a) + words[0]  + 0xe9b6c7aa, 20) + c;
+
+    a = rotateLeft(a + f2(b,c,d) + words[5]  + 0xd62f105d,  5) + b;
+    d = rotateLeft(d + f2(a,b,c) + words[10] + 0x02441453,  9) + a;
+    c = rotateLeft(c + f2(d,a,b) + words[15] + 0xd8a1e681, 14) + d;
+    b = rotateLeft(b + f2(c,d,a) + words[4]  + 0xe7d3fbc8, 20) + c;
+
+    a = rotateLeft(a + f2(b,c,d) + words[9]  + 0x21e1cde6,  5) + b;
+    d = rotateLeft(d + f2(a,b,c) + words[14] + 0xc33707d6,  9) + a;
+    c = rotateLeft(c + f2(d,a,b) + words[3]  + 0xf4d50d87, 14) + d;
+    b = rotateLeft(b + f2(c,d,a) + words[8]  + 0x455a14ed, 20) + c;
+
+    a = rotateLeft(a + f2(b,c,d) + words[13] + 0xa9e3e905,  5) + b;
+    d = rotateLeft(d + f2(a,b,c) + words[2]  + 0xfcefa3f8,  9) + a;
+    c = rotateLeft(c + f2(d,a,b) + words[7]  + 0x676f02d9, 14) + d;
+    b = rotateLeft(b + f2(c,d,a) + words[12] + 0x8d2a4c8a, 20) + c;
+
+    // third round
+    a = rotateLeft(a + f3(b,c,d) + words[5]  + 0xfffa3942,  4) + b;
+    d = rotateLeft(d + f3(a,b,c) + words[8]  + 0x8771f681, 11) + a;
+    c = rotateLeft(c + f3(d,a,b) + words[11] + 0x6d9d6122, 16) + d;
+    b = rotateLeft(b + f3(c,d,a) + words[14] + 0xfde5380c, 23) + c;
+
+    a = rotateLeft(a + f3(b,c,d) + words[1]  + 0xa4beea44,  4) + b;
+    d = rotateLeft(d + f3(a,b,c) + words[4]  + 0x4bdecfa9, 11) + a;
+    c = rotateLeft(c + f3(d,a,b) + words[7]  + 0xf6bb4b60, 16) + d;
+    b = rotateLeft(b + f3(c,d,a) + words[10] + 0xbebfbc70, 23) + c;
+
+    a = rotateLeft(a + f3(b,c,d) + words[13] + 0x289b7ec6,  4) + b;
+    d = rotateLeft(d + f3(a,b,c) + words[0]  + 0xeaa127fa, 11) + a;
+    c = rotateLeft(c + f3(d,a,b) + words[3]  + 0xd4ef3085, 16) + d;
+    b = rotateLeft(b + f3(c,d,a) + words[6]  + 0x04881d05, 23) + c;
+
+    a = rotateLeft(a + f3(b,c,d) + words[9]  + 0xd9d4d039,  4) + b;
+    d = rotateLeft(d + f3(a,b,c) + words[12] + 0xe6db99e5, 11) + a;
+    c = rotateLeft(c + f3(d,a,b) + words[15] + 0x1fa27cf8, 16) + d;
+    b = rotateLeft(b + f3(c,d,a) + words[2]  + 0xc4ac5665, 23) + c;
+
+    // fourth round
+    a = rotateLeft(a + f4(b,c,d) + words[0]  + 0xf4292244,  6) + b;
+    d = rotateLeft(d + f4(a,b,c) + words[7]  + 0x432aff97, 10) + a;
+    c = rotateLeft(c + f4(d,a,b) + words[14] + 0xab9423a7, 15) + d;
+    b = rotateLeft(b + f4(c,d,a) + words[5]  + 0xfc93a039, 21) + c;
+
+    a = rotateLeft(a + f4(b,c,d) + words[12] + 0x655b59c3,  6) + b;
+    d = rotateLeft(d + f4(a,b,c) + words[3]  + 0x8f0ccc92, 10) + a;
+    c = rotateLeft(c + f4(d,a,b) + words[10] + 0xffeff47d, 15) + d;
+    b = rotateLeft(b + f4(c,d,a) + words[1]  + 0x85845dd1, 21) + c;
+
+    a = rotateLeft(a + f4(b,c,d) + words[8]  + 0x6fa87e4f,  6) + b;
+    d = rotateLeft(d + f4(a,b,c) + words[15] + 0xfe2ce6e0, 10) + a;
+    c = rotateLeft(c + f4(d,a,b) + words[6]  + 0xa3014314, 15) + d;
+    b = rotateLeft(b + f4(c,d,a) + words[13] + 0x4e0811a1, 21) + c;
+
+    a = rotateLeft(a + f4(b,c,d) + words[4]  + 0xf7537e82,  6) + b;
+    d = rotateLeft(d + f4(a,b,c) + words[11] + 0xbd3af235, 10) + a;
+    c = rotateLeft(c + f4(d,a,b) + words[2]  + 0x2ad7d2bb, 15) + d;
+    b = rotateLeft(b + f4(c,d,a) + words[9]  + 0xeb86d391, 21) + c;
+
+    // update hash
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+  }
+
+  for (int i = 0; i < HASH_SIZE; i++)
+    _hash[i] = state[i];
+}
+
 void MessageDigestMD5::processBlock(const void *data)
 {
-  // get last hash
-  uint32_t a = _hash[0];
-  uint32_t b = _hash[1];
-  uint32_t c = _hash[2];
-  uint32_t d = _hash[3];
-
-  // data represented as 16x 32-bit words
-  const uint32_t* words = (uint32_t*) data;
-
-  // first round
-  a = rotateLeft(a + f1(b,c,d) + words[0]  + 0xd76aa478,  7) + b;
-  d = rotateLeft(d + f1(a,b,c) + words[1]  + 0xe8c7b756, 12) + a;
-  c = rotateLeft(c + f1(d,a,b) + words[2]  + 0x242070db, 17) + d;
-  b = rotateLeft(b + f1(c,d,a) + words[3]  + 0xc1bdceee, 22) + c;
-
-  a = rotateLeft(a + f1(b,c,d) + words[4]  + 0xf57c0faf,  7) + b;
-  d = rotateLeft(d + f1(a,b,c) + words[5]  + 0x4787c62a, 12) + a;
-  c = rotateLeft(c + f1(d,a,b) + words[6]  + 0xa8304613, 17) + d;
-  b = rotateLeft(b + f1(c,d,a) + words[7]  + 0xfd469501, 22) + c;
-
-  a = rotateLeft(a + f1(b,c,d) + words[8]  + 0x698098d8,  7) + b;
-  d = rotateLeft(d + f1(a,b,c) + words[9]  + 0x8b44f7af, 12) + a;
-  c = rotateLeft(c + f1(d,a,b) + words[10] + 0xffff5bb1, 17) + d;
-  b = rotateLeft(b + f1(c,d,a) + words[11] + 0x895cd7be, 22) + c;
-
-  a = rotateLeft(a + f1(b,c,d) + words[12] + 0x6b901122,  7) + b;
-  d = rotateLeft(d + f1(a,b,c) + words[13] + 0xfd987193, 12) + a;
-  c = rotateLeft(c + f1(d,a,b) + words[14] + 0xa679438e, 17) + d;
-  b = rotateLeft(b + f1(c,d,a) + words[15] + 0x49b40821, 22) + c;
-
-  // second round
-  a = rotateLeft(a + f2(b,c,d) + words[1]  + 0xf61e2562,  5) + b;
-  d = rotateLeft(d + f2(a,b,c) + words[6]  + 0xc040b340,  9) + a;
-  c = rotateLeft(c + f2(d,a,b) + words[11] + 0x265e5a51, 14) + d;
-  b = rotateLeft(b + f2(c,d,a) + words[0]  + 0xe9b6c7aa, 20) + c;
-
-  a = rotateLeft(a + f2(b,c,d) + words[5]  + 0xd62f105d,  5) + b;
-  d = rotateLeft(d + f2(a,b,c) + words[10] + 0x02441453,  9) + a;
-  c = rotateLeft(c + f2(d,a,b) + words[15] + 0xd8a1e681, 14) + d;
-  b = rotateLeft(b + f2(c,d,a) + words[4]  + 0xe7d3fbc8, 20) + c;
-
-  a = rotateLeft(a + f2(b,c,d) + words[9]  + 0x21e1cde6,  5) + b;
-  d = rotateLeft(d + f2(a,b,c) + words[14] + 0xc33707d6,  9) + a;
-  c = rotateLeft(c + f2(d,a,b) + words[3]  + 0xf4d50d87, 14) + d;
-  b = rotateLeft(b + f2(c,d,a) + words[8]  + 0x455a14ed, 20) + c;
-
-  a = rotateLeft(a + f2(b,c,d) + words[13] + 0xa9e3e905,  5) + b;
-  d = rotateLeft(d + f2(a,b,c) + words[2]  + 0xfcefa3f8,  9) + a;
-  c = rotateLeft(c + f2(d,a,b) + words[7]  + 0x676f02d9, 14) + d;
-  b = rotateLeft(b + f2(c,d,a) + words[12] + 0x8d2a4c8a, 20) + c;
-
-  // third round
-  a = rotateLeft(a + f3(b,c,d) + words[5]  + 0xfffa3942,  4) + b;
-  d = rotateLeft(d + f3(a,b,c) + words[8]  + 0x8771f681, 11) + a;
-  c = rotateLeft(c + f3(d,a,b) + words[11] + 0x6d9d6122, 16) + d;
-  b = rotateLeft(b + f3(c,d,a) + words[14] + 0xfde5380c, 23) + c;
-
-  a = rotateLeft(a + f3(b,c,d) + words[1]  + 0xa4beea44,  4) + b;
-  d = rotateLeft(d + f3(a,b,c) + words[4]  + 0x4bdecfa9, 11) + a;
-  c = rotateLeft(c + f3(d,a,b) + words[7]  + 0xf6bb4b60, 16) + d;
-  b = rotateLeft(b + f3(c,d,a) + words[10] + 0xbebfbc70, 23) + c;
-
-  a = rotateLeft(a + f3(b,c,d) + words[13] + 0x289b7ec6,  4) + b;
-  d = rotateLeft(d + f3(a,b,c) + words[0]  + 0xeaa127fa, 11) + a;
-  c = rotateLeft(c + f3(d,a,b) + words[3]  + 0xd4ef3085, 16) + d;
-  b = rotateLeft(b + f3(c,d,a) + words[6]  + 0x04881d05, 23) + c;
-
-  a = rotateLeft(a + f3(b,c,d) + words[9]  + 0xd9d4d039,  4) + b;
-  d = rotateLeft(d + f3(a,b,c) + words[12] + 0xe6db99e5, 11) + a;
-  c = rotateLeft(c + f3(d,a,b) + words[15] + 0x1fa27cf8, 16) + d;
-  b = rotateLeft(b + f3(c,d,a) + words[2]  + 0xc4ac5665, 23) + c;
-
-  // fourth round
-  a = rotateLeft(a + f4(b,c,d) + words[0]  + 0xf4292244,  6) + b;
-  d = rotateLeft(d + f4(a,b,c) + words[7]  + 0x432aff97, 10) + a;
-  c = rotateLeft(c + f4(d,a,b) + words[14] + 0xab9423a7, 15) + d;
-  b = rotateLeft(b + f4(c,d,a) + words[5]  + 0xfc93a039, 21) + c;
-
-  a = rotateLeft(a + f4(b,c,d) + words[12] + 0x655b59c3,  6) + b;
-  d = rotateLeft(d + f4(a,b,c) + words[3]  + 0x8f0ccc92, 10) + a;
-  c = rotateLeft(c + f4(d,a,b) + words[10] + 0xffeff47d, 15) + d;
-  b = rotateLeft(b + f4(c,d,a) + words[1]  + 0x85845dd1, 21) + c;
-
-  a = rotateLeft(a + f4(b,c,d) + words[8]  + 0x6fa87e4f,  6) + b;
-  d = rotateLeft(d + f4(a,b,c) + words[15] + 0xfe2ce6e0, 10) + a;
-  c = rotateLeft(c + f4(d,a,b) + words[6]  + 0xa3014314, 15) + d;
-  b = rotateLeft(b + f4(c,d,a) + words[13] + 0x4e0811a1, 21) + c;
-
-  a = rotateLeft(a + f4(b,c,d) + words[4]  + 0xf7537e82,  6) + b;
-  d = rotateLeft(d + f4(a,b,c) + words[11] + 0xbd3af235, 10) + a;
-  c = rotateLeft(c + f4(d,a,b) + words[2]  + 0x2ad7d2bb, 15) + d;
-  b = rotateLeft(b + f4(c,d,a) + words[9]  + 0xeb86d391, 21) + c;
-
-  // update hash
-  _hash[0] += a;
-  _hash[1] += b;
-  _hash[2] += c;
-  _hash[3] += d;
+  processBlocks(data, 1);
 }
 
 /// process final block, less than 64 bytes
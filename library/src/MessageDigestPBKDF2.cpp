@@ -0,0 +1,246 @@
+/**
+ * @file MessageDigestPBKDF2.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/MessageDigestPBKDF2.hpp"
+#include "MessageDigest/MessageDigestSHA1.hpp"
+#include "MessageDigest/MessageDigestSHA224.hpp"
+#include "MessageDigest/MessageDigestSHA256.hpp"
+#include "MessageDigest/MessageDigestSHA384.hpp"
+#include "MessageDigest/MessageDigestSHA512.hpp"
+#include "MessageDigest/MessageDigestSHA512_224.hpp"
+#include "MessageDigest/MessageDigestSHA512_256.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  const uint8_t InnerPad = 0x36;
+  const uint8_t OuterPad = 0x5c;
+
+  /**
+   * The hash with access to its chaining value and compression function.
+   * HMAC only ever hashes one block behind the padded key, so both hashes of
+   * an iteration run on a single prepared block each.
+   */
+  template<class Hash, typename Word>
+  class Engine : public Hash {
+  public:
+    /// hash the padded password, keys longer than a block are hashed first
+    void setPassword(const uint8_t* password, size_t passwordLength)
+    {
+      uint8_t block[Hash::BLOCK_SIZE];
+      std::memset(block, 0, sizeof(block));
+      if (passwordLength > sizeof(block))
+      {
+        this->reset();
+        this->update(password, 0, passwordLength);
+        this->digestBinary(block);
+      }
+      else if (passwordLength > 0)
+        std::memcpy(block, password, passwordLength);
+
+      for (auto& byte : block)
+        byte ^= InnerPad;
+      this->reset();
+      this->processBlocks(block, 1);
+      std::memcpy(_innerKey, this->_hash, sizeof(_innerKey));
+
+      for (auto& byte : block)
+        byte ^= InnerPad ^ OuterPad;
+      this->reset();
+      this->processBlocks(block, 1);
+      std::memcpy(_outerKey, this->_hash, sizeof(_outerKey));
+
+      wipe(block, sizeof(block));
+    }
+
+    /// output block T_index, the first numBytes of it
+    void deriveBlock(const uint8_t* salt, size_t saltLength, uint32_t index, uint32_t iterations,
+                     uint8_t* out, size_t numBytes)
+    {
+      const size_t digestSize = Hash::DIGEST_SIZE;
+      uint8_t inner[Hash::BLOCK_SIZE];
+      uint8_t outer[Hash::BLOCK_SIZE];
+      uint8_t sum[Hash::DIGEST_SIZE];
+
+      // U_1 = HMAC(P, S || INT(index)), the salt may span several blocks
+      setState(_innerKey);
+      this->_numBytes   = Hash::BLOCK_SIZE;
+      this->_bufferSize = 0;
+      this->update(salt, 0, saltLength);
+      const uint8_t counter[4] = { (uint8_t) (index >> 24), (uint8_t) (index >> 16),
+                                   (uint8_t) (index >>  8), (uint8_t)  index };
+      this->update(counter, 0, sizeof(counter));
+      this->digestBinary(outer);
+
+      // the padding of both blocks stays the same for all iterations
+      pad(inner);
+      pad(outer);
+
+      setState(_outerKey);
+      this->processBlocks(outer, 1);
+      store(inner);
+      std::memcpy(sum, inner, digestSize);
+
+      // U_j = HMAC(P, U_j-1)
+      for (uint32_t i = 1; i < iterations; i++)
+      {
+        setState(_innerKey);
+        this->processBlocks(inner, 1);
+        store(outer);
+
+        setState(_outerKey);
+        this->processBlocks(outer, 1);
+        store(inner);
+
+        for (size_t j = 0; j < digestSize; j++)
+          sum[j] ^= inner[j];
+      }
+
+      std::memcpy(out, sum, numBytes);
+      wipe(sum, sizeof(sum));
+    }
+
+  private:
+    void setState(const Word* state)
+    {
+      std::memcpy(this->_hash, state, sizeof(_innerKey));
+    }
+
+    /// big endian digest at the start of block, truncated variants keep the leading bytes
+    void store(uint8_t* block) const
+    {
+      for (size_t i = 0; i < Hash::DIGEST_SIZE; i++)
+        block[i] = (uint8_t) (this->_hash[i / sizeof(Word)] >> (8 * (sizeof(Word) - 1 - i % sizeof(Word))));
+    }
+
+    /// padding of a block behind the key block holding a digest
+    static void pad(uint8_t* block)
+    {
+      const size_t digestSize = Hash::DIGEST_SIZE;
+      const size_t blockSize  = Hash::BLOCK_SIZE;
+      block[digestSize] = 128;
+      std::memset(block + digestSize + 1, 0, blockSize - digestSize - 1);
+
+      uint64_t msgBits = 8 * (blockSize + digestSize);
+      for (size_t i = 1; i <= 8; i++, msgBits >>= 8)
+        block[blockSize - i] = msgBits & 0xFF;
+    }
+
+    /// volatile keeps the compiler from dropping the stores
+    static void wipe(uint8_t* data, size_t numBytes)
+    {
+      volatile uint8_t* current = data;
+      for (size_t i = 0; i < numBytes; i++)
+        current[i] = 0;
+    }
+
+    Word _innerKey[Hash::HASH_SIZE];
+    Word _outerKey[Hash::HASH_SIZE];
+  };
+
+  typedef void (*DeriveFunc)(const MessageDigestInput* passwords, const MessageDigestInput* salts,
+                             size_t numPasswords, uint32_t iterations, uint8_t* keys, size_t keyLength,
+                             unsigned numThreads);
+
+  template<class Hash, typename Word>
+  void derive(const MessageDigestInput* passwords, const MessageDigestInput* salts,
+              size_t numPasswords, uint32_t iterations, uint8_t* keys, size_t keyLength,
+              unsigned numThreads)
+  {
+    const size_t digestSize = Hash::DIGEST_SIZE;
+    size_t numBlocks = (keyLength + digestSize - 1) / digestSize;
+    size_t numJobs   = numPasswords * numBlocks;
+
+    if (numThreads == 0)
+      numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    numThreads = (unsigned) std::min<size_t>(numThreads, numJobs);
+
+    // a job is one output block of one password
+    std::atomic<size_t> nextJob(0);
+    auto worker = [&]()
+    {
+      Engine<Hash,Word> engine;
+      size_t password = numPasswords;
+      for (size_t job = nextJob++; job < numJobs; job = nextJob++)
+      {
+        if (password != job / numBlocks)
+        {
+          password = job / numBlocks;
+          engine.setPassword((const uint8_t*) passwords[password].first, passwords[password].second);
+        }
+
+        size_t block  = job % numBlocks;
+        size_t offset = block * digestSize;
+        engine.deriveBlock((const uint8_t*) salts[password].first, salts[password].second,
+                           (uint32_t) (block + 1), iterations,
+                           keys + password * keyLength + offset, std::min(digestSize, keyLength - offset));
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < numThreads; i++)
+      threads.push_back(std::thread(worker));
+    worker();
+    for (auto& thread : threads)
+      thread.join();
+  }
+
+  DeriveFunc findDerive(const std::string& algorithm)
+  {
+    if (algorithm == "SHA1")
+      return derive<MessageDigestSHA1,uint32_t>;
+    if (algorithm == "SHA224")
+      return derive<MessageDigestSHA224,uint32_t>;
+    if (algorithm == "SHA256")
+      return derive<MessageDigestSHA256,uint32_t>;
+    if (algorithm == "SHA384")
+      return derive<MessageDigestSHA384,uint64_t>;
+    if (algorithm == "SHA512")
+      return derive<MessageDigestSHA512,uint64_t>;
+    if (algorithm == "SHA512/224")
+      return derive<MessageDigestSHA512_224,uint64_t>;
+    if (algorithm == "SHA512/256")
+      return derive<MessageDigestSHA512_256,uint64_t>;
+    return nullptr;
+  }
+}
+
+bool MessageDigestPBKDF2::isSupported(const std::string &algorithm)
+{
+  return findDerive(algorithm) != nullptr;
+}
+
+bool MessageDigestPBKDF2::deriveKey(const std::string &algorithm,
+                                    const void *password, size_t passwordLength,
+                                    const void *salt, size_t saltLength,
+                                    uint32_t iterations, uint8_t *key, size_t keyLength,
+                                    unsigned numThreads)
+{
+  MessageDigestInput passwordInput(password, passwordLength);
+  MessageDigestInput saltInput(salt, saltLength);
+  return deriveKeys(algorithm, &passwordInput, &saltInput, 1, iterations, key, keyLength, numThreads);
+}
+
+bool MessageDigestPBKDF2::deriveKeys(const std::string &algorithm,
+                                     const MessageDigestInput *passwords, const MessageDigestInput *salts,
+                                     size_t numPasswords, uint32_t iterations, uint8_t *keys, size_t keyLength,
+                                     unsigned numThreads)
+{
+  DeriveFunc deriveFunc = findDerive(algorithm);
+  if (deriveFunc == nullptr || iterations == 0)
+    return false;
+
+  if (numPasswords > 0 && keyLength > 0)
+    deriveFunc(passwords, salts, numPasswords, iterations, keys, keyLength, numThreads);
+  return true;
+}
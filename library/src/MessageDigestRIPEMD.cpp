@@ -0,0 +1,688 @@
+/**
+ * @file MessageDigestRIPEMD.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/MessageDigestRIPEMD.hpp"
+#include "MessageDigest/MessageDigestEncoding.hpp"
+#include "MessageDigest/MessageDigestState.hpp"
+#include "MessageDigest/MessageDigestMultiBuffer.hpp"
+
+#include <cstring>
+#include <utility>
+
+// big endian architectures need #define __BYTE_ORDER __BIG_ENDIAN
+#ifndef _MSC_VER
+#include <endian.h>
+#endif
+
+namespace
+{
+  /**
+   * @brief The circular left shift operation
+   */
+  inline uint32_t rotateLeft(uint32_t a, uint32_t c)
+  {
+    return (a << c) | (a >> (32 - c));
+  }
+
+  // mix functions, f1 to f5 in the order of the left line
+  inline uint32_t f1(uint32_t x, uint32_t y, uint32_t z)
+  {
+    return x ^ y ^ z;
+  }
+
+  inline uint32_t f2(uint32_t x, uint32_t y, uint32_t z)
+  {
+    return z ^ (x & (y ^ z)); // original: f = (x & y) | (~x & z);
+  }
+
+  inline uint32_t f3(uint32_t x, uint32_t y, uint32_t z)
+  {
+    return (x | ~y) ^ z;
+  }
+
+  inline uint32_t f4(uint32_t x, uint32_t y, uint32_t z)
+  {
+    return y ^ (z & (x ^ y)); // original: f = (x & z) | (y & ~z);
+  }
+
+  inline uint32_t f5(uint32_t x, uint32_t y, uint32_t z)
+  {
+    return x ^ (y | ~z);
+  }
+
+  /// one step of RIPEMD-128, the caller rotates the names of a, b, c and d
+  inline void step128(uint32_t& a, uint32_t f, uint32_t x, uint32_t k, uint32_t s)
+  {
+    a = rotateLeft(a + f + x + k, s);
+  }
+
+  /// one step of RIPEMD-160, the caller rotates the names of a, b, c, d and e
+  inline void step160(uint32_t& a, uint32_t& c, uint32_t e, uint32_t f, uint32_t x, uint32_t k, uint32_t s)
+  {
+    a = rotateLeft(a + f + x + k, s) + e;
+    c = rotateLeft(c, 10);
+  }
+
+  /// block as 16 little endian words
+  inline void loadWords(const uint8_t* block, uint32_t* words)
+  {
+    const uint32_t* input = (const uint32_t*) block;
+    for (int i = 0; i < 16; i++)
+      {
+#if defined(__BYTE_ORDER) && (__BYTE_ORDER != 0) && (__BYTE_ORDER == __BIG_ENDIAN)
+        words[i] = swap32(input[i]);
+#else
+        words[i] = input[i];
+#endif
+      }
+  }
+
+  /**
+   * @brief The 80 steps of both lines of RIPEMD-160, each left step is
+   * followed by the right one of the same index
+   *
+   * RIPEMD-320 runs the same steps, but swaps one word between the lines
+   * after every round.
+   */
+  template<bool SWAP>
+  inline void rounds160(uint32_t& a1, uint32_t& b1, uint32_t& c1, uint32_t& d1, uint32_t& e1,
+                        uint32_t& a2, uint32_t& b2, uint32_t& c2, uint32_t& d2, uint32_t& e2,
+                        const uint32_t* words)
+  {
+      // first round
+      step160(a1, c1, e1, f1(b1, c1, d1), words[ 0], 0x00000000, 11);
+      step160(a2, c2, e2, f5(b2, c2, d2), words[ 5], 0x50a28be6,  8);
+      step160(e1, b1, d1, f1(a1, b1, c1), words[ 1], 0x00000000, 14);
+      step160(e2, b2, d2, f5(a2, b2, c2), words[14], 0x50a28be6,  9);
+      step160(d1, a1, c1, f1(e1, a1, b1), words[ 2], 0x00000000, 15);
+      step160(d2, a2, c2, f5(e2, a2, b2), words[ 7], 0x50a28be6,  9);
+      step160(c1, e1, b1, f1(d1, e1, a1), words[ 3], 0x00000000, 12);
+      step160(c2, e2, b2, f5(d2, e2, a2), words[ 0], 0x50a28be6, 11);
+      step160(b1, d1, a1, f1(c1, d1, e1), words[ 4], 0x00000000,  5);
+      step160(b2, d2, a2, f5(c2, d2, e2), words[ 9], 0x50a28be6, 13);
+      step160(a1, c1, e1, f1(b1, c1, d1), words[ 5], 0x00000000,  8);
+      step160(a2, c2, e2, f5(b2, c2, d2), words[ 2], 0x50a28be6, 15);
+      step160(e1, b1, d1, f1(a1, b1, c1), words[ 6], 0x00000000,  7);
+      step160(e2, b2, d2, f5(a2, b2, c2), words[11], 0x50a28be6, 15);
+      step160(d1, a1, c1, f1(e1, a1, b1), words[ 7], 0x00000000,  9);
+      step160(d2, a2, c2, f5(e2, a2, b2), words[ 4], 0x50a28be6,  5);
+      step160(c1, e1, b1, f1(d1, e1, a1), words[ 8], 0x00000000, 11);
+      step160(c2, e2, b2, f5(d2, e2, a2), words[13], 0x50a28be6,  7);
+      step160(b1, d1, a1, f1(c1, d1, e1), words[ 9], 0x00000000, 13);
+      step160(b2, d2, a2, f5(c2, d2, e2), words[ 6], 0x50a28be6,  7);
+      step160(a1, c1, e1, f1(b1, c1, d1), words[10], 0x00000000, 14);
+      step160(a2, c2, e2, f5(b2, c2, d2), words[15], 0x50a28be6,  8);
+      step160(e1, b1, d1, f1(a1, b1, c1), words[11], 0x00000000, 15);
+      step160(e2, b2, d2, f5(a2, b2, c2), words[ 8], 0x50a28be6, 11);
+      step160(d1, a1, c1, f1(e1, a1, b1), words[12], 0x00000000,  6);
+      step160(d2, a2, c2, f5(e2, a2, b2), words[ 1], 0x50a28be6, 14);
+      step160(c1, e1, b1, f1(d1, e1, a1), words[13], 0x00000000,  7);
+      step160(c2, e2, b2, f5(d2, e2, a2), words[10], 0x50a28be6, 14);
+      step160(b1, d1, a1, f1(c1, d1, e1), words[14], 0x00000000,  9);
+      step160(b2, d2, a2, f5(c2, d2, e2), words[ 3], 0x50a28be6, 12);
+      step160(a1, c1, e1, f1(b1, c1, d1), words[15], 0x00000000,  8);
+      step160(a2, c2, e2, f5(b2, c2, d2), words[12], 0x50a28be6,  6);
+      if (SWAP)
+        std::swap(a1, a2);
+
+      // second round
+      step160(e1, b1, d1, f2(a1, b1, c1), words[ 7], 0x5a827999,  7);
+      step160(e2, b2, d2, f4(a2, b2, c2), words[ 6], 0x5c4dd124,  9);
+      step160(d1, a1, c1, f2(e1, a1, b1), words[ 4], 0x5a827999,  6);
+      step160(d2, a2, c2, f4(e2, a2, b2), words[11], 0x5c4dd124, 13);
+      step160(c1, e1, b1, f2(d1, e1, a1), words[13], 0x5a827999,  8);
+      step160(c2, e2, b2, f4(d2, e2, a2), words[ 3], 0x5c4dd124, 15);
+      step160(b1, d1, a1, f2(c1, d1, e1), words[ 1], 0x5a827999, 13);
+      step160(b2, d2, a2, f4(c2, d2, e2), words[ 7], 0x5c4dd124,  7);
+      step160(a1, c1, e1, f2(b1, c1, d1), words[10], 0x5a827999, 11);
+      step160(a2, c2, e2, f4(b2, c2, d2), words[ 0], 0x5c4dd124, 12);
+      step160(e1, b1, d1, f2(a1, b1, c1), words[ 6], 0x5a827999,  9);
+      step160(e2, b2, d2, f4(a2, b2, c2), words[13], 0x5c4dd124,  8);
+      step160(d1, a1, c1, f2(e1, a1, b1), words[15], 0x5a827999,  7);
+      step160(d2, a2, c2, f4(e2, a2, b2), words[ 5], 0x5c4dd124,  9);
+      step160(c1, e1, b1, f2(d1, e1, a1), words[ 3], 0x5a827999, 15);
+      step160(c2, e2, b2, f4(d2, e2, a2), words[10], 0x5c4dd124, 11);
+      step160(b1, d1, a1, f2(c1, d1, e1), words[12], 0x5a827999,  7);
+      step160(b2, d2, a2, f4(c2, d2, e2), words[14], 0x5c4dd124,  7);
+      step160(a1, c1, e1, f2(b1, c1, d1), words[ 0], 0x5a827999, 12);
+      step160(a2, c2, e2, f4(b2, c2, d2), words[15], 0x5c4dd124,  7);
+      step160(e1, b1, d1, f2(a1, b1, c1), words[ 9], 0x5a827999, 15);
+      step160(e2, b2, d2, f4(a2, b2, c2), words[ 8], 0x5c4dd124, 12);
+      step160(d1, a1, c1, f2(e1, a1, b1), words[ 5], 0x5a827999,  9);
+      step160(d2, a2, c2, f4(e2, a2, b2), words[12], 0x5c4dd124,  7);
+      step160(c1, e1, b1, f2(d1, e1, a1), words[ 2], 0x5a827999, 11);
+      step160(c2, e2, b2, f4(d2, e2, a2), words[ 4], 0x5c4dd124,  6);
+      step160(b1, d1, a1, f2(c1, d1, e1), words[14], 0x5a827999,  7);
+      step160(b2, d2, a2, f4(c2, d2, e2), words[ 9], 0x5c4dd124, 15);
+      step160(a1, c1, e1, f2(b1, c1, d1), words[11], 0x5a827999, 13);
+      step160(a2, c2, e2, f4(b2, c2, d2), words[ 1], 0x5c4dd124, 13);
+      step160(e1, b1, d1, f2(a1, b1, c1), words[ 8], 0x5a827999, 12);
+      step160(e2, b2, d2, f4(a2, b2, c2), words[ 2], 0x5c4dd124, 11);
+      if (SWAP)
+        std::swap(b1, b2);
+
+      // third round
+      step160(d1, a1, c1, f3(e1, a1, b1), words[ 3], 0x6ed9eba1, 11);
+      step160(d2, a2, c2, f3(e2, a2, b2), words[15], 0x6d703ef3,  9);
+      step160(c1, e1, b1, f3(d1, e1, a1), words[10], 0x6ed9eba1, 13);
+      step160(c2, e2, b2, f3(d2, e2, a2), words[ 5], 0x6d703ef3,  7);
+      step160(b1, d1, a1, f3(c1, d1, e1), words[14], 0x6ed9eba1,  6);
+      step160(b2, d2, a2, f3(c2, d2, e2), words[ 1], 0x6d703ef3, 15);
+      step160(a1, c1, e1, f3(b1, c1, d1), words[ 4], 0x6ed9eba1,  7);
+      step160(a2, c2, e2, f3(b2, c2, d2), words[ 3], 0x6d703ef3, 11);
+      step160(e1, b1, d1, f3(a1, b1, c1), words[ 9], 0x6ed9eba1, 14);
+      step160(e2, b2, d2, f3(a2, b2, c2), words[ 7], 0x6d703ef3,  8);
+      step160(d1, a1, c1, f3(e1, a1, b1), words[15], 0x6ed9eba1,  9);
+      step160(d2, a2, c2, f3(e2, a2, b2), words[14], 0x6d703ef3,  6);
+      step160(c1, e1, b1, f3(d1, e1, a1), words[ 8], 0x6ed9eba1, 13);
+      step160(c2, e2, b2, f3(d2, e2, a2), words[ 6], 0x6d703ef3,  6);
+      step160(b1, d1, a1, f3(c1, d1, e1), words[ 1], 0x6ed9eba1, 15);
+      step160(b2, d2, a2, f3(c2, d2, e2), words[ 9], 0x6d703ef3, 14);
+      step160(a1, c1, e1, f3(b1, c1, d1), words[ 2], 0x6ed9eba1, 14);
+      step160(a2, c2, e2, f3(b2, c2, d2), words[11], 0x6d703ef3, 12);
+      step160(e1, b1, d1, f3(a1, b1, c1), words[ 7], 0x6ed9eba1,  8);
+      step160(e2, b2, d2, f3(a2, b2, c2), words[ 8], 0x6d703ef3, 13);
+      step160(d1, a1, c1, f3(e1, a1, b1), words[ 0], 0x6ed9eba1, 13);
+      step160(d2, a2, c2, f3(e2, a2, b2), words[12], 0x6d703ef3,  5);
+      step160(c1, e1, b1, f3(d1, e1, a1), words[ 6], 0x6ed9eba1,  6);
+      step160(c2, e2, b2, f3(d2, e2, a2), words[ 2], 0x6d703ef3, 14);
+      step160(b1, d1, a1, f3(c1, d1, e1), words[13], 0x6ed9eba1,  5);
+      step160(b2, d2, a2, f3(c2, d2, e2), words[10], 0x6d703ef3, 13);
+      step160(a1, c1, e1, f3(b1, c1, d1), words[11], 0x6ed9eba1, 12);
+      step160(a2, c2, e2, f3(b2, c2, d2), words[ 0], 0x6d703ef3, 13);
+      step160(e1, b1, d1, f3(a1, b1, c1), words[ 5], 0x6ed9eba1,  7);
+      step160(e2, b2, d2, f3(a2, b2, c2), words[ 4], 0x6d703ef3,  7);
+      step160(d1, a1, c1, f3(e1, a1, b1), words[12], 0x6ed9eba1,  5);
+      step160(d2, a2, c2, f3(e2, a2, b2), words[13], 0x6d703ef3,  5);
+      if (SWAP)
+        std::swap(c1, c2);
+
+      // fourth round
+      step160(c1, e1, b1, f4(d1, e1, a1), words[ 1], 0x8f1bbcdc, 11);
+      step160(c2, e2, b2, f2(d2, e2, a2), words[ 8], 0x7a6d76e9, 15);
+      step160(b1, d1, a1, f4(c1, d1, e1), words[ 9], 0x8f1bbcdc, 12);
+      step160(b2, d2, a2, f2(c2, d2, e2), words[ 6], 0x7a6d76e9,  5);
+      step160(a1, c1, e1, f4(b1, c1, d1), words[11], 0x8f1bbcdc, 14);
+      step160(a2, c2, e2, f2(b2, c2, d2), words[ 4], 0x7a6d76e9,  8);
+      step160(e1, b1, d1, f4(a1, b1, c1), words[10], 0x8f1bbcdc, 15);
+      step160(e2, b2, d2, f2(a2, b2, c2), words[ 1], 0x7a6d76e9, 11);
+      step160(d1, a1, c1, f4(e1, a1, b1), words[ 0], 0x8f1bbcdc, 14);
+      step160(d2, a2, c2, f2(e2, a2, b2), words[ 3], 0x7a6d76e9, 14);
+      step160(c1, e1, b1, f4(d1, e1, a1), words[ 8], 0x8f1bbcdc, 15);
+      step160(c2, e2, b2, f2(d2, e2, a2), words[11], 0x7a6d76e9, 14);
+      step160(b1, d1, a1, f4(c1, d1, e1), words[12], 0x8f1bbcdc,  9);
+      step160(b2, d2, a2, f2(c2, d2, e2), words[15], 0x7a6d76e9,  6);
+      step160(a1, c1, e1, f4(b1, c1, d1), words[ 4], 0x8f1bbcdc,  8);
+      step160(a2, c2, e2, f2(b2, c2, d2), words[ 0], 0x7a6d76e9, 14);
+      step160(e1, b1, d1, f4(a1, b1, c1), words[13], 0x8f1bbcdc,  9);
+      step160(e2, b2, d2, f2(a2, b2, c2), words[ 5], 0x7a6d76e9,  6);
+      step160(d1, a1, c1, f4(e1, a1, b1), words[ 3], 0x8f1bbcdc, 14);
+      step160(d2, a2, c2, f2(e2, a2, b2), words[12], 0x7a6d76e9,  9);
+      step160(c1, e1, b1, f4(d1, e1, a1), words[ 7], 0x8f1bbcdc,  5);
+      step160(c2, e2, b2, f2(d2, e2, a2), words[ 2], 0x7a6d76e9, 12);
+      step160(b1, d1, a1, f4(c1, d1, e1), words[15], 0x8f1bbcdc,  6);
+      step160(b2, d2, a2, f2(c2, d2, e2), words[13], 0x7a6d76e9,  9);
+      step160(a1, c1, e1, f4(b1, c1, d1), words[14], 0x8f1bbcdc,  8);
+      step160(a2, c2, e2, f2(b2, c2, d2), words[ 9], 0x7a6d76e9, 12);
+      step160(e1, b1, d1, f4(a1, b1, c1), words[ 5], 0x8f1bbcdc,  6);
+      step160(e2, b2, d2, f2(a2, b2, c2), words[ 7], 0x7a6d76e9,  5);
+      step160(d1, a1, c1, f4(e1, a1, b1), words[ 6], 0x8f1bbcdc,  5);
+      step160(d2, a2, c2, f2(e2, a2, b2), words[10], 0x7a6d76e9, 15);
+      step160(c1, e1, b1, f4(d1, e1, a1), words[ 2], 0x8f1bbcdc, 12);
+      step160(c2, e2, b2, f2(d2, e2, a2), words[14], 0x7a6d76e9,  8);
+      if (SWAP)
+        std::swap(d1, d2);
+
+      // fifth round
+      step160(b1, d1, a1, f5(c1, d1, e1), words[ 4], 0xa953fd4e,  9);
+      step160(b2, d2, a2, f1(c2, d2, e2), words[12], 0x00000000,  8);
+      step160(a1, c1, e1, f5(b1, c1, d1), words[ 0], 0xa953fd4e, 15);
+      step160(a2, c2, e2, f1(b2, c2, d2), words[15], 0x00000000,  5);
+      step160(e1, b1, d1, f5(a1, b1, c1), words[ 5], 0xa953fd4e,  5);
+      step160(e2, b2, d2, f1(a2, b2, c2), words[10], 0x00000000, 12);
+      step160(d1, a1, c1, f5(e1, a1, b1), words[ 9], 0xa953fd4e, 11);
+      step160(d2, a2, c2, f1(e2, a2, b2), words[ 4], 0x00000000,  9);
+      step160(c1, e1, b1, f5(d1, e1, a1), words[ 7], 0xa953fd4e,  6);
+      step160(c2, e2, b2, f1(d2, e2, a2), words[ 1], 0x00000000, 12);
+      step160(b1, d1, a1, f5(c1, d1, e1), words[12], 0xa953fd4e,  8);
+      step160(b2, d2, a2, f1(c2, d2, e2), words[ 5], 0x00000000,  5);
+      step160(a1, c1, e1, f5(b1, c1, d1), words[ 2], 0xa953fd4e, 13);
+      step160(a2, c2, e2, f1(b2, c2, d2), words[ 8], 0x00000000, 14);
+      step160(e1, b1, d1, f5(a1, b1, c1), words[10], 0xa953fd4e, 12);
+      step160(e2, b2, d2, f1(a2, b2, c2), words[ 7], 0x00000000,  6);
+      step160(d1, a1, c1, f5(e1, a1, b1), words[14], 0xa953fd4e,  5);
+      step160(d2, a2, c2, f1(e2, a2, b2), words[ 6], 0x00000000,  8);
+      step160(c1, e1, b1, f5(d1, e1, a1), words[ 1], 0xa953fd4e, 12);
+      step160(c2, e2, b2, f1(d2, e2, a2), words[ 2], 0x00000000, 13);
+      step160(b1, d1, a1, f5(c1, d1, e1), words[ 3], 0xa953fd4e, 13);
+      step160(b2, d2, a2, f1(c2, d2, e2), words[13], 0x00000000,  6);
+      step160(a1, c1, e1, f5(b1, c1, d1), words[ 8], 0xa953fd4e, 14);
+      step160(a2, c2, e2, f1(b2, c2, d2), words[14], 0x00000000,  5);
+      step160(e1, b1, d1, f5(a1, b1, c1), words[11], 0xa953fd4e, 11);
+      step160(e2, b2, d2, f1(a2, b2, c2), words[ 0], 0x00000000, 15);
+      step160(d1, a1, c1, f5(e1, a1, b1), words[ 6], 0xa953fd4e,  8);
+      step160(d2, a2, c2, f1(e2, a2, b2), words[ 3], 0x00000000, 13);
+      step160(c1, e1, b1, f5(d1, e1, a1), words[15], 0xa953fd4e,  5);
+      step160(c2, e2, b2, f1(d2, e2, a2), words[ 9], 0x00000000, 11);
+      step160(b1, d1, a1, f5(c1, d1, e1), words[13], 0xa953fd4e,  6);
+      step160(b2, d2, a2, f1(c2, d2, e2), words[11], 0x00000000, 11);
+      if (SWAP)
+        std::swap(e1, e2);
+  }
+}
+
+MessageDigestRIPEMD::MessageDigestRIPEMD(size_t hashSize)
+  : _hashSize(hashSize), _numBytes(0), _bufferSize(0)
+{
+}
+
+std::vector<uint8_t> MessageDigestRIPEMD::exportState() const
+{
+  MessageDigestStateWriter writer(getAlgorithm());
+  writer.write(_numBytes);
+  for (size_t i = 0; i < _hashSize; i++)
+    writer.write(_hash[i]);
+  writer.write((uint8_t) _bufferSize);
+  writer.write(_buffer, _bufferSize);
+  return writer.state();
+}
+
+bool MessageDigestRIPEMD::importState(const uint8_t *state, size_t size)
+{
+  MessageDigestStateReader reader(state, size);
+  uint64_t numBytes;
+  uint32_t hash[MAX_HASH_SIZE];
+  uint8_t  bufferSize;
+  uint8_t  buffer[BLOCK_SIZE];
+
+  if (!reader.readHeader(getAlgorithm()) || !reader.read(numBytes) || numBytes % BLOCK_SIZE != 0)
+    return false;
+  for (size_t i = 0; i < _hashSize; i++)
+    if (!reader.read(hash[i]))
+      return false;
+  if (!reader.read(bufferSize) || bufferSize >= BLOCK_SIZE || !reader.read(buffer, bufferSize) || !reader.atEnd())
+    return false;
+
+  _numBytes   = numBytes;
+  _bufferSize = bufferSize;
+  for (size_t i = 0; i < _hashSize; i++)
+    _hash[i] = hash[i];
+  for (int i = 0; i < bufferSize; i++)
+    _buffer[i] = buffer[i];
+  return true;
+}
+
+std::string MessageDigestRIPEMD::digest()
+{
+  uint8_t buffer[4*MAX_HASH_SIZE];
+  digestBinary(buffer);
+  return MessageDigestEncoding::toHex(buffer, getDigestSize());
+}
+
+void MessageDigestRIPEMD::digestBinary(uint8_t *buffer)
+{
+  // save old hash if buffer is partially filled
+  uint32_t oldHash[MAX_HASH_SIZE];
+  for (size_t i = 0; i < _hashSize; i++)
+    oldHash[i] = _hash[i];
+
+  // process remaining bytes
+  processBuffer();
+
+  hashToBytes(_hash, _hashSize, buffer);
+
+  // restore old hash
+  for (size_t i = 0; i < _hashSize; i++)
+    _hash[i] = oldHash[i];
+}
+
+size_t MessageDigestRIPEMD::getDigestSize() const
+{
+  return 4*_hashSize;
+}
+
+size_t MessageDigestRIPEMD::getBlockSize() const
+{
+  return BLOCK_SIZE;
+}
+
+void MessageDigestRIPEMD::hashToBytes(const uint32_t *hash, size_t hashSize, uint8_t *buffer)
+{
+  // RIPEMD stores its words little endian
+  for (size_t i = 0; i < hashSize; i++)
+  {
+    *buffer++ =  hash[i]        & 0xFF;
+    *buffer++ = (hash[i] >>  8) & 0xFF;
+    *buffer++ = (hash[i] >> 16) & 0xFF;
+    *buffer++ = (hash[i] >> 24) & 0xFF;
+  }
+}
+
+void MessageDigestRIPEMD::digestBatch(const MessageDigestInput *inputs, size_t numInputs, uint8_t *digests)
+{
+  digestBatchSerial(inputs, numInputs, digests);
+}
+
+void MessageDigestRIPEMD::digestBatchSerial(const MessageDigestInput *inputs, size_t numInputs, uint8_t *digests)
+{
+  reset();
+  uint32_t initialHash[MAX_HASH_SIZE];
+  for (size_t i = 0; i < _hashSize; i++)
+    initialHash[i] = _hash[i];
+
+  size_t digestSize = getDigestSize();
+  uint8_t padded[2*BLOCK_SIZE];
+  for (size_t message = 0; message < numInputs; message++)
+  {
+    const uint8_t* data = (const uint8_t*) inputs[message].first;
+    size_t numBytes = inputs[message].second;
+    size_t fullBlocks = numBytes / BLOCK_SIZE;
+
+    for (size_t i = 0; i < _hashSize; i++)
+      _hash[i] = initialHash[i];
+    if (fullBlocks > 0)
+      processBlocks(data, fullBlocks);
+
+    size_t numPadded = MessageDigestMultiBuffer<1,BLOCK_SIZE,8,false>::pad(
+          padded, data + fullBlocks * BLOCK_SIZE, numBytes % BLOCK_SIZE, numBytes);
+    processBlocks(padded, numPadded);
+
+    hashToBytes(_hash, _hashSize, digests + message * digestSize);
+  }
+
+  reset();
+}
+
+void MessageDigestRIPEMD::update(const void *data, const size_t offset, const size_t len)
+{
+  const uint8_t* current = (const uint8_t*) data + offset;
+  size_t numBytes = len;
+
+  if (_bufferSize > 0)
+  {
+    while (numBytes > 0 && _bufferSize < BLOCK_SIZE)
+    {
+      _buffer[_bufferSize++] = *current++;
+      numBytes--;
+    }
+  }
+
+  // full buffer
+  if (_bufferSize == BLOCK_SIZE)
+  {
+    processBlocks(_buffer, 1);
+    _numBytes  += BLOCK_SIZE;
+    _bufferSize = 0;
+  }
+
+  // no more data ?
+  if (numBytes == 0)
+    return;
+
+  // process full blocks in one run
+  if (numBytes >= BLOCK_SIZE)
+  {
+    size_t nBlocks = numBytes / BLOCK_SIZE;
+    processBlocks(current, nBlocks);
+    current   += nBlocks * BLOCK_SIZE;
+    _numBytes += nBlocks * BLOCK_SIZE;
+    numBytes  -= nBlocks * BLOCK_SIZE;
+  }
+
+  // keep remaining bytes in buffer
+  while (numBytes > 0)
+  {
+    _buffer[_bufferSize++] = *current++;
+    numBytes--;
+  }
+}
+
+/// process final block, less than 64 bytes
+void MessageDigestRIPEMD::processBuffer()
+{
+  // - append "1" bit to message
+  // - append "0" bits until message length in bit mod 512 is 448
+  // - append length as 64 bit little endian integer
+  uint8_t padded[2*BLOCK_SIZE];
+  size_t numPadded = MessageDigestMultiBuffer<1,BLOCK_SIZE,8,false>::pad(
+        padded, _buffer, _bufferSize, _numBytes + _bufferSize);
+  processBlocks(padded, numPadded);
+}
+
+void MessageDigestRIPEMD::compress128(uint32_t *hash, const uint8_t *data, size_t nBlocks)
+{
+  // the chaining state stays in locals for the whole run
+  uint32_t state[4];
+  for (int i = 0; i < 4; i++)
+    state[i] = hash[i];
+
+  uint32_t words[16];
+  for (; nBlocks > 0; nBlocks--, data += BLOCK_SIZE)
+  {
+    loadWords(data, words);
+
+    uint32_t a1 = state[0], a2 = state[0];
+    uint32_t b1 = state[1], b2 = state[1];
+    uint32_t c1 = state[2], c2 = state[2];
+    uint32_t d1 = state[3], d2 = state[3];
+
+      // first round
+      step128(a1, f1(b1, c1, d1), words[ 0], 0x00000000, 11);
+      step128(a2, f4(b2, c2, d2), words[ 5], 0x50a28be6,  8);
+      step128(d1, f1(a1, b1, c1), words[ 1], 0x00000000, 14);
+      step128(d2, f4(a2, b2, c2), words[14], 0x50a28be6,  9);
+      step128(c1, f1(d1, a1, b1), words[ 2], 0x00000000, 15);
+      step128(c2, f4(d2, a2, b2), words[ 7], 0x50a28be6,  9);
+      step128(b1, f1(c1, d1, a1), words[ 3], 0x00000000, 12);
+      step128(b2, f4(c2, d2, a2), words[ 0], 0x50a28be6, 11);
+      step128(a1, f1(b1, c1, d1), words[ 4], 0x00000000,  5);
+      step128(a2, f4(b2, c2, d2), words[ 9], 0x50a28be6, 13);
+      step128(d1, f1(a1, b1, c1), words[ 5], 0x00000000,  8);
+      step128(d2, f4(a2, b2, c2), words[ 2], 0x50a28be6, 15);
+      step128(c1, f1(d1, a1, b1), words[ 6], 0x00000000,  7);
+      step128(c2, f4(d2, a2, b2), words[11], 0x50a28be6, 15);
+      step128(b1, f1(c1, d1, a1), words[ 7], 0x00000000,  9);
+      step128(b2, f4(c2, d2, a2), words[ 4], 0x50a28be6,  5);
+      step128(a1, f1(b1, c1, d1), words[ 8], 0x00000000, 11);
+      step128(a2, f4(b2, c2, d2), words[13], 0x50a28be6,  7);
+      step128(d1, f1(a1, b1, c1), words[ 9], 0x00000000, 13);
+      step128(d2, f4(a2, b2, c2), words[ 6], 0x50a28be6,  7);
+      step128(c1, f1(d1, a1, b1), words[10], 0x00000000, 14);
+      step128(c2, f4(d2, a2, b2), words[15], 0x50a28be6,  8);
+      step128(b1, f1(c1, d1, a1), words[11], 0x00000000, 15);
+      step128(b2, f4(c2, d2, a2), words[ 8], 0x50a28be6, 11);
+      step128(a1, f1(b1, c1, d1), words[12], 0x00000000,  6);
+      step128(a2, f4(b2, c2, d2), words[ 1], 0x50a28be6, 14);
+      step128(d1, f1(a1, b1, c1), words[13], 0x00000000,  7);
+      step128(d2, f4(a2, b2, c2), words[10], 0x50a28be6, 14);
+      step128(c1, f1(d1, a1, b1), words[14], 0x00000000,  9);
+      step128(c2, f4(d2, a2, b2), words[ 3], 0x50a28be6, 12);
+      step128(b1, f1(c1, d1, a1), words[15], 0x00000000,  8);
+      step128(b2, f4(c2, d2, a2), words[12], 0x50a28be6,  6);
+
+      // second round
+      step128(a1, f2(b1, c1, d1), words[ 7], 0x5a827999,  7);
+      step128(a2, f3(b2, c2, d2), words[ 6], 0x5c4dd124,  9);
+      step128(d1, f2(a1, b1, c1), words[ 4], 0x5a827999,  6);
+      step128(d2, f3(a2, b2, c2), words[11], 0x5c4dd124, 13);
+      step128(c1, f2(d1, a1, b1), words[13], 0x5a827999,  8);
+      step128(c2, f3(d2, a2, b2), words[ 3], 0x5c4dd124, 15);
+      step128(b1, f2(c1, d1, a1), words[ 1], 0x5a827999, 13);
+      step128(b2, f3(c2, d2, a2), words[ 7], 0x5c4dd124,  7);
+      step128(a1, f2(b1, c1, d1), words[10], 0x5a827999, 11);
+      step128(a2, f3(b2, c2, d2), words[ 0], 0x5c4dd124, 12);
+      step128(d1, f2(a1, b1, c1), words[ 6], 0x5a827999,  9);
+      step128(d2, f3(a2, b2, c2), words[13], 0x5c4dd124,  8);
+      step128(c1, f2(d1, a1, b1), words[15], 0x5a827999,  7);
+      step128(c2, f3(d2, a2, b2), words[ 5], 0x5c4dd124,  9);
+      step128(b1, f2(c1, d1, a1), words[ 3], 0x5a827999, 15);
+      step128(b2, f3(c2, d2, a2), words[10], 0x5c4dd124, 11);
+      step128(a1, f2(b1, c1, d1), words[12], 0x5a827999,  7);
+      step128(a2, f3(b2, c2, d2), words[14], 0x5c4dd124,  7);
+      step128(d1, f2(a1, b1, c1), words[ 0], 0x5a827999, 12);
+      step128(d2, f3(a2, b2, c2), words[15], 0x5c4dd124,  7);
+      step128(c1, f2(d1, a1, b1), words[ 9], 0x5a827999, 15);
+      step128(c2, f3(d2, a2, b2), words[ 8], 0x5c4dd124, 12);
+      step128(b1, f2(c1, d1, a1), words[ 5], 0x5a827999,  9);
+      step128(b2, f3(c2, d2, a2), words[12], 0x5c4dd124,  7);
+      step128(a1, f2(b1, c1, d1), words[ 2], 0x5a827999, 11);
+      step128(a2, f3(b2, c2, d2), words[ 4], 0x5c4dd124,  6);
+      step128(d1, f2(a1, b1, c1), words[14], 0x5a827999,  7);
+      step128(d2, f3(a2, b2, c2), words[ 9], 0x5c4dd124, 15);
+      step128(c1, f2(d1, a1, b1), words[11], 0x5a827999, 13);
+      step128(c2, f3(d2, a2, b2), words[ 1], 0x5c4dd124, 13);
+      step128(b1, f2(c1, d1, a1), words[ 8], 0x5a827999, 12);
+      step128(b2, f3(c2, d2, a2), words[ 2], 0x5c4dd124, 11);
+
+      // third round
+      step128(a1, f3(b1, c1, d1), words[ 3], 0x6ed9eba1, 11);
+      step128(a2, f2(b2, c2, d2), words[15], 0x6d703ef3,  9);
+      step128(d1, f3(a1, b1, c1), words[10], 0x6ed9eba1, 13);
+      step128(d2, f2(a2, b2, c2), words[ 5], 0x6d703ef3,  7);
+      step128(c1, f3(d1, a1, b1), words[14], 0x6ed9eba1,  6);
+      step128(c2, f2(d2, a2, b2), words[ 1], 0x6d703ef3, 15);
+      step128(b1, f3(c1, d1, a1), words[ 4], 0x6ed9eba1,  7);
+      step128(b2, f2(c2, d2, a2), words[ 3], 0x6d703ef3, 11);
+      step128(a1, f3(b1, c1, d1), words[ 9], 0x6ed9eba1, 14);
+      step128(a2, f2(b2, c2, d2), words[ 7], 0x6d703ef3,  8);
+      step128(d1, f3(a1, b1, c1), words[15], 0x6ed9eba1,  9);
+      step128(d2, f2(a2, b2, c2), words[14], 0x6d703ef3,  6);
+      step128(c1, f3(d1, a1, b1), words[ 8], 0x6ed9eba1, 13);
+      step128(c2, f2(d2, a2, b2), words[ 6], 0x6d703ef3,  6);
+      step128(b1, f3(c1, d1, a1), words[ 1], 0x6ed9eba1, 15);
+      step128(b2, f2(c2, d2, a2), words[ 9], 0x6d703ef3, 14);
+      step128(a1, f3(b1, c1, d1), words[ 2], 0x6ed9eba1, 14);
+      step128(a2, f2(b2, c2, d2), words[11], 0x6d703ef3, 12);
+      step128(d1, f3(a1, b1, c1), words[ 7], 0x6ed9eba1,  8);
+      step128(d2, f2(a2, b2, c2), words[ 8], 0x6d703ef3, 13);
+      step128(c1, f3(d1, a1, b1), words[ 0], 0x6ed9eba1, 13);
+      step128(c2, f2(d2, a2, b2), words[12], 0x6d703ef3,  5);
+      step128(b1, f3(c1, d1, a1), words[ 6], 0x6ed9eba1,  6);
+      step128(b2, f2(c2, d2, a2), words[ 2], 0x6d703ef3, 14);
+      step128(a1, f3(b1, c1, d1), words[13], 0x6ed9eba1,  5);
+      step128(a2, f2(b2, c2, d2), words[10], 0x6d703ef3, 13);
+      step128(d1, f3(a1, b1, c1), words[11], 0x6ed9eba1, 12);
+      step128(d2, f2(a2, b2, c2), words[ 0], 0x6d703ef3, 13);
+      step128(c1, f3(d1, a1, b1), words[ 5], 0x6ed9eba1,  7);
+      step128(c2, f2(d2, a2, b2), words[ 4], 0x6d703ef3,  7);
+      step128(b1, f3(c1, d1, a1), words[12], 0x6ed9eba1,  5);
+      step128(b2, f2(c2, d2, a2), words[13], 0x6d703ef3,  5);
+
+      // fourth round
+      step128(a1, f4(b1, c1, d1), words[ 1], 0x8f1bbcdc, 11);
+      step128(a2, f1(b2, c2, d2), words[ 8], 0x00000000, 15);
+      step128(d1, f4(a1, b1, c1), words[ 9], 0x8f1bbcdc, 12);
+      step128(d2, f1(a2, b2, c2), words[ 6], 0x00000000,  5);
+      step128(c1, f4(d1, a1, b1), words[11], 0x8f1bbcdc, 14);
+      step128(c2, f1(d2, a2, b2), words[ 4], 0x00000000,  8);
+      step128(b1, f4(c1, d1, a1), words[10], 0x8f1bbcdc, 15);
+      step128(b2, f1(c2, d2, a2), words[ 1], 0x00000000, 11);
+      step128(a1, f4(b1, c1, d1), words[ 0], 0x8f1bbcdc, 14);
+      step128(a2, f1(b2, c2, d2), words[ 3], 0x00000000, 14);
+      step128(d1, f4(a1, b1, c1), words[ 8], 0x8f1bbcdc, 15);
+      step128(d2, f1(a2, b2, c2), words[11], 0x00000000, 14);
+      step128(c1, f4(d1, a1, b1), words[12], 0x8f1bbcdc,  9);
+      step128(c2, f1(d2, a2, b2), words[15], 0x00000000,  6);
+      step128(b1, f4(c1, d1, a1), words[ 4], 0x8f1bbcdc,  8);
+      step128(b2, f1(c2, d2, a2), words[ 0], 0x00000000, 14);
+      step128(a1, f4(b1, c1, d1), words[13], 0x8f1bbcdc,  9);
+      step128(a2, f1(b2, c2, d2), words[ 5], 0x00000000,  6);
+      step128(d1, f4(a1, b1, c1), words[ 3], 0x8f1bbcdc, 14);
+      step128(d2, f1(a2, b2, c2), words[12], 0x00000000,  9);
+      step128(c1, f4(d1, a1, b1), words[ 7], 0x8f1bbcdc,  5);
+      step128(c2, f1(d2, a2, b2), words[ 2], 0x00000000, 12);
+      step128(b1, f4(c1, d1, a1), words[15], 0x8f1bbcdc,  6);
+      step128(b2, f1(c2, d2, a2), words[13], 0x00000000,  9);
+      step128(a1, f4(b1, c1, d1), words[14], 0x8f1bbcdc,  8);
+      step128(a2, f1(b2, c2, d2), words[ 9], 0x00000000, 12);
+      step128(d1, f4(a1, b1, c1), words[ 5], 0x8f1bbcdc,  6);
+      step128(d2, f1(a2, b2, c2), words[ 7], 0x00000000,  5);
+      step128(c1, f4(d1, a1, b1), words[ 6], 0x8f1bbcdc,  5);
+      step128(c2, f1(d2, a2, b2), words[10], 0x00000000, 15);
+      step128(b1, f4(c1, d1, a1), words[ 2], 0x8f1bbcdc, 12);
+      step128(b2, f1(c2, d2, a2), words[14], 0x00000000,  8);
+
+    // combine both lines
+    uint32_t t = state[1] + c1 + d2;
+    state[1] = state[2] + d1 + a2;
+    state[2] = state[3] + a1 + b2;
+    state[3] = state[0] + b1 + c2;
+    state[0] = t;
+  }
+
+  for (int i = 0; i < 4; i++)
+    hash[i] = state[i];
+}
+
+void MessageDigestRIPEMD::compress160(uint32_t *hash, const uint8_t *data, size_t nBlocks)
+{
+  uint32_t state[5];
+  for (int i = 0; i < 5; i++)
+    state[i] = hash[i];
+
+  uint32_t words[16];
+  for (; nBlocks > 0; nBlocks--, data += BLOCK_SIZE)
+  {
+    loadWords(data, words);
+
+    uint32_t a1 = state[0], a2 = state[0];
+    uint32_t b1 = state[1], b2 = state[1];
+    uint32_t c1 = state[2], c2 = state[2];
+    uint32_t d1 = state[3], d2 = state[3];
+    uint32_t e1 = state[4], e2 = state[4];
+
+    rounds160<false>(a1, b1, c1, d1, e1, a2, b2, c2, d2, e2, words);
+
+    // combine both lines
+    uint32_t t = state[1] + c1 + d2;
+    state[1] = state[2] + d1 + e2;
+    state[2] = state[3] + e1 + a2;
+    state[3] = state[4] + a1 + b2;
+    state[4] = state[0] + b1 + c2;
+    state[0] = t;
+  }
+
+  for (int i = 0; i < 5; i++)
+    hash[i] = state[i];
+}
+
+void MessageDigestRIPEMD::compress320(uint32_t *hash, const uint8_t *data, size_t nBlocks)
+{
+  // each line keeps its own half of the chaining value
+  uint32_t state[10];
+  for (int i = 0; i < 10; i++)
+    state[i] = hash[i];
+
+  uint32_t words[16];
+  for (; nBlocks > 0; nBlocks--, data += BLOCK_SIZE)
+  {
+    loadWords(data, words);
+
+    uint32_t a1 = state[0], a2 = state[5];
+    uint32_t b1 = state[1], b2 = state[6];
+    uint32_t c1 = state[2], c2 = state[7];
+    uint32_t d1 = state[3], d2 = state[8];
+    uint32_t e1 = state[4], e2 = state[9];
+
+    rounds160<true>(a1, b1, c1, d1, e1, a2, b2, c2, d2, e2, words);
+
+    state[0] += a1;
+    state[1] += b1;
+    state[2] += c1;
+    state[3] += d1;
+    state[4] += e1;
+    state[5] += a2;
+    state[6] += b2;
+    state[7] += c2;
+    state[8] += d2;
+    state[9] += e2;
+  }
+
+  for (int i = 0; i < 10; i++)
+    hash[i] = state[i];
+}
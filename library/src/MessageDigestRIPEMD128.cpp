@@ -0,0 +1,55 @@
+/**
+ * @file MessageDigestRIPEMD128.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/MessageDigestRIPEMD128.hpp"
+#include "MessageDigest/MessageDigest.hpp"
+
+static MessageDigestImplRegistrar<MessageDigestRIPEMD128> registrar("RIPEMD128");
+
+MessageDigestRIPEMD128::MessageDigestRIPEMD128()
+  : MessageDigestRIPEMD(4)
+{
+  reset();
+}
+
+std::string MessageDigestRIPEMD128::getAlgorithm() const
+{
+  return "RIPEMD128";
+}
+
+void MessageDigestRIPEMD128::reset()
+{
+  _numBytes   = 0;
+  _bufferSize = 0;
+
+  // same as MD4 and MD5
+  _hash[0] = 0x67452301;
+  _hash[1] = 0xefcdab89;
+  _hash[2] = 0x98badcfe;
+  _hash[3] = 0x10325476;
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestRIPEMD128::create()
+{
+  return std::unique_ptr<MessageDigestImpl>(new MessageDigestRIPEMD128());
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestRIPEMD128::clone() const
+{
+  return cloneDigest(*this);
+}
+
+bool MessageDigestRIPEMD128::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
+
+void MessageDigestRIPEMD128::processBlocks(const void *data, size_t nBlocks)
+{
+  compress128(_hash, (const uint8_t*) data, nBlocks);
+}
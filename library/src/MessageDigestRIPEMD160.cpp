@@ -0,0 +1,353 @@
+/**
+ * @file MessageDigestRIPEMD160.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/MessageDigestRIPEMD160.hpp"
+#include "MessageDigest/MessageDigest.hpp"
+#include "MessageDigest/CpuFeatures.hpp"
+#include "MessageDigest/MessageDigestMultiBuffer.hpp"
+
+#include <cstring>
+
+#ifdef MESSAGEDIGEST_X86
+#include <immintrin.h>
+#endif
+
+static MessageDigestImplRegistrar<MessageDigestRIPEMD160> registrar("RIPEMD160");
+
+namespace
+{
+#ifdef MESSAGEDIGEST_X86
+  // multi-buffer kernels: hash holds five rows with one word per lane,
+  // blocks points to the next 64 bytes of every lane
+
+  /// message words of the 16 steps of each round, left line
+  static constexpr int RL[5][16] = {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    {  7,  4, 13,  1, 10,  6, 15,  3, 12,  0,  9,  5,  2, 14, 11,  8 },
+    {  3, 10, 14,  4,  9, 15,  8,  1,  2,  7,  0,  6, 13, 11,  5, 12 },
+    {  1,  9, 11, 10,  0,  8, 12,  4, 13,  3,  7, 15, 14,  5,  6,  2 },
+    {  4,  0,  5,  9,  7, 12,  2, 10, 14,  1,  3,  8, 11,  6, 15, 13 }
+  };
+
+  /// message words of the 16 steps of each round, right line
+  static constexpr int RR[5][16] = {
+    {  5, 14,  7,  0,  9,  2, 11,  4, 13,  6, 15,  8,  1, 10,  3, 12 },
+    {  6, 11,  3,  7,  0, 13,  5, 10, 14, 15,  8, 12,  4,  9,  1,  2 },
+    { 15,  5,  1,  3,  7, 14,  6,  9, 11,  8, 12,  2, 10,  0,  4, 13 },
+    {  8,  6,  4,  1,  3, 11, 15,  0,  5, 12,  2, 13,  9,  7, 10, 14 },
+    { 12, 15, 10,  4,  1,  5,  8,  7,  6,  2, 13, 14,  0,  3,  9, 11 }
+  };
+
+  /// rotations of the 16 steps of each round, left line
+  static constexpr int SL[5][16] = {
+    { 11, 14, 15, 12,  5,  8,  7,  9, 11, 13, 14, 15,  6,  7,  9,  8 },
+    {  7,  6,  8, 13, 11,  9,  7, 15,  7, 12, 15,  9, 11,  7, 13, 12 },
+    { 11, 13,  6,  7, 14,  9, 13, 15, 14,  8, 13,  6,  5, 12,  7,  5 },
+    { 11, 12, 14, 15, 14, 15,  9,  8,  9, 14,  5,  6,  8,  6,  5, 12 },
+    {  9, 15,  5, 11,  6,  8, 13, 12,  5, 12, 13, 14, 11,  8,  5,  6 }
+  };
+
+  /// rotations of the 16 steps of each round, right line
+  static constexpr int SR[5][16] = {
+    {  8,  9,  9, 11, 13, 15, 15,  5,  7,  7,  8, 11, 14, 14, 12,  6 },
+    {  9, 13, 15,  7, 12,  8,  9, 11,  7,  7, 12,  7,  6, 15, 13, 11 },
+    {  9,  7, 15, 11,  8,  6,  6, 14, 12, 13,  5, 14, 13, 13,  7,  5 },
+    { 15,  5,  8, 11, 14, 14,  6, 14,  6,  9, 12,  9, 12,  5, 15,  8 },
+    {  8,  5, 12,  9, 12,  5, 14,  6,  8, 13,  6,  5, 15, 13, 11, 11 }
+  };
+
+  /// constants of each round
+  static constexpr uint32_t KL[5] = { 0x00000000, 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xa953fd4e };
+  static constexpr uint32_t KR[5] = { 0x50a28be6, 0x5c4dd124, 0x6d703ef3, 0x7a6d76e9, 0x00000000 };
+
+  MESSAGEDIGEST_TARGET("avx2")
+  inline __m256i rotateLeftAVX2(__m256i a, int c)
+  {
+    return _mm256_or_si256(_mm256_sll_epi32(a, _mm_cvtsi32_si128(c)), _mm256_srl_epi32(a, _mm_cvtsi32_si128(32 - c)));
+  }
+
+  /// mix function f1 to f5, selected by 0 to 4
+  MESSAGEDIGEST_TARGET("avx2")
+  inline __m256i mixAVX2(int f, __m256i x, __m256i y, __m256i z)
+  {
+    const __m256i ones = _mm256_set1_epi32(-1);
+    switch (f)
+    {
+    case 0:
+      return _mm256_xor_si256(_mm256_xor_si256(x, y), z);
+    case 1:
+      return _mm256_xor_si256(z, _mm256_and_si256(x, _mm256_xor_si256(y, z)));
+    case 2:
+      return _mm256_xor_si256(_mm256_or_si256(x, _mm256_xor_si256(y, ones)), z);
+    case 3:
+      return _mm256_xor_si256(y, _mm256_and_si256(z, _mm256_xor_si256(x, y)));
+    default:
+      return _mm256_xor_si256(x, _mm256_or_si256(y, _mm256_xor_si256(z, ones)));
+    }
+  }
+
+  /// 16 steps of both lines, a left step is followed by the right one
+  template<int ROUND>
+  MESSAGEDIGEST_TARGET("avx2")
+  inline void roundAVX2(__m256i* left, __m256i* right, const __m256i* words)
+  {
+    __m256i a1 = left[0],  b1 = left[1],  c1 = left[2],  d1 = left[3],  e1 = left[4];
+    __m256i a2 = right[0], b2 = right[1], c2 = right[2], d2 = right[3], e2 = right[4];
+    const __m256i k1 = _mm256_set1_epi32((int) KL[ROUND]);
+    const __m256i k2 = _mm256_set1_epi32((int) KR[ROUND]);
+
+    for (int i = 0; i < 16; i++)
+    {
+      __m256i x1 = _mm256_add_epi32(_mm256_add_epi32(a1, mixAVX2(ROUND, b1, c1, d1)), _mm256_add_epi32(words[RL[ROUND][i]], k1));
+      __m256i x2 = _mm256_add_epi32(_mm256_add_epi32(a2, mixAVX2(4 - ROUND, b2, c2, d2)), _mm256_add_epi32(words[RR[ROUND][i]], k2));
+      x1 = _mm256_add_epi32(rotateLeftAVX2(x1, SL[ROUND][i]), e1);
+      x2 = _mm256_add_epi32(rotateLeftAVX2(x2, SR[ROUND][i]), e2);
+      a1 = e1; e1 = d1; d1 = rotateLeftAVX2(c1, 10); c1 = b1; b1 = x1;
+      a2 = e2; e2 = d2; d2 = rotateLeftAVX2(c2, 10); c2 = b2; b2 = x2;
+    }
+
+    left[0]  = a1; left[1]  = b1; left[2]  = c1; left[3]  = d1; left[4]  = e1;
+    right[0] = a2; right[1] = b2; right[2] = c2; right[3] = d2; right[4] = e2;
+  }
+
+  /// process one block of each of 8 messages
+  MESSAGEDIGEST_TARGET("avx2")
+  void processBlocksAVX2(uint32_t* hash, const uint8_t* const* blocks)
+  {
+    // transpose to one register per message word
+    __m256i words[16];
+    for (int i = 0; i < 16; i++)
+    {
+      uint32_t column[8];
+      for (int lane = 0; lane < 8; lane++)
+        std::memcpy(&column[lane], blocks[lane] + 4*i, 4);
+      words[i] = _mm256_loadu_si256((const __m256i*) column);
+    }
+
+    __m256i* state = (__m256i*) hash;
+    __m256i left[5], right[5];
+    for (int i = 0; i < 5; i++)
+      left[i] = right[i] = _mm256_loadu_si256(state + i);
+
+    roundAVX2<0>(left, right, words);
+    roundAVX2<1>(left, right, words);
+    roundAVX2<2>(left, right, words);
+    roundAVX2<3>(left, right, words);
+    roundAVX2<4>(left, right, words);
+
+    // combine both lines
+    __m256i t = _mm256_add_epi32(_mm256_loadu_si256(state + 1), _mm256_add_epi32(left[2], right[3]));
+    _mm256_storeu_si256(state + 1, _mm256_add_epi32(_mm256_loadu_si256(state + 2), _mm256_add_epi32(left[3], right[4])));
+    _mm256_storeu_si256(state + 2, _mm256_add_epi32(_mm256_loadu_si256(state + 3), _mm256_add_epi32(left[4], right[0])));
+    _mm256_storeu_si256(state + 3, _mm256_add_epi32(_mm256_loadu_si256(state + 4), _mm256_add_epi32(left[0], right[1])));
+    _mm256_storeu_si256(state + 4, _mm256_add_epi32(_mm256_loadu_si256(state + 0), _mm256_add_epi32(left[1], right[2])));
+    _mm256_storeu_si256(state + 0, t);
+  }
+
+  /**
+   * @brief 16 steps of both lines, a left step is followed by the right one
+   *
+   * The mix functions are ternary logic of x, y and z: 0x96 for f1, 0xCA for
+   * f2, 0x59 for f3, 0xE4 for f4 and 0x2D for f5.
+   */
+  template<int ROUND, int MIX_LEFT, int MIX_RIGHT>
+  MESSAGEDIGEST_TARGET("avx512f")
+  inline void roundAVX512(__m512i* left, __m512i* right, const __m512i* words)
+  {
+    __m512i a1 = left[0],  b1 = left[1],  c1 = left[2],  d1 = left[3],  e1 = left[4];
+    __m512i a2 = right[0], b2 = right[1], c2 = right[2], d2 = right[3], e2 = right[4];
+    const __m512i k1 = _mm512_set1_epi32((int) KL[ROUND]);
+    const __m512i k2 = _mm512_set1_epi32((int) KR[ROUND]);
+
+    for (int i = 0; i < 16; i++)
+    {
+      __m512i f1 = _mm512_ternarylogic_epi32(b1, c1, d1, MIX_LEFT);
+      __m512i f2 = _mm512_ternarylogic_epi32(b2, c2, d2, MIX_RIGHT);
+      __m512i x1 = _mm512_add_epi32(_mm512_add_epi32(a1, f1), _mm512_add_epi32(words[RL[ROUND][i]], k1));
+      __m512i x2 = _mm512_add_epi32(_mm512_add_epi32(a2, f2), _mm512_add_epi32(words[RR[ROUND][i]], k2));
+      x1 = _mm512_add_epi32(_mm512_rolv_epi32(x1, _mm512_set1_epi32(SL[ROUND][i])), e1);
+      x2 = _mm512_add_epi32(_mm512_rolv_epi32(x2, _mm512_set1_epi32(SR[ROUND][i])), e2);
+      a1 = e1; e1 = d1; d1 = _mm512_rol_epi32(c1, 10); c1 = b1; b1 = x1;
+      a2 = e2; e2 = d2; d2 = _mm512_rol_epi32(c2, 10); c2 = b2; b2 = x2;
+    }
+
+    left[0]  = a1; left[1]  = b1; left[2]  = c1; left[3]  = d1; left[4]  = e1;
+    right[0] = a2; right[1] = b2; right[2] = c2; right[3] = d2; right[4] = e2;
+  }
+
+  /// process one block of each of 16 messages
+  MESSAGEDIGEST_TARGET("avx512f")
+  void processBlocksAVX512(uint32_t* hash, const uint8_t* const* blocks)
+  {
+    // transpose to one register per message word
+    __m512i words[16];
+    for (int i = 0; i < 16; i++)
+    {
+      uint32_t column[16];
+      for (int lane = 0; lane < 16; lane++)
+        std::memcpy(&column[lane], blocks[lane] + 4*i, 4);
+      words[i] = _mm512_loadu_si512(column);
+    }
+
+    uint32_t* state = hash;
+    __m512i left[5], right[5];
+    for (int i = 0; i < 5; i++)
+      left[i] = right[i] = _mm512_loadu_si512(state + 16*i);
+
+    roundAVX512<0, 0x96, 0x2D>(left, right, words);
+    roundAVX512<1, 0xCA, 0xE4>(left, right, words);
+    roundAVX512<2, 0x59, 0x59>(left, right, words);
+    roundAVX512<3, 0xE4, 0xCA>(left, right, words);
+    roundAVX512<4, 0x2D, 0x96>(left, right, words);
+
+    // combine both lines
+    __m512i t = _mm512_add_epi32(_mm512_loadu_si512(state + 16), _mm512_add_epi32(left[2], right[3]));
+    _mm512_storeu_si512(state + 16, _mm512_add_epi32(_mm512_loadu_si512(state + 32), _mm512_add_epi32(left[3], right[4])));
+    _mm512_storeu_si512(state + 32, _mm512_add_epi32(_mm512_loadu_si512(state + 48), _mm512_add_epi32(left[4], right[0])));
+    _mm512_storeu_si512(state + 48, _mm512_add_epi32(_mm512_loadu_si512(state + 64), _mm512_add_epi32(left[0], right[1])));
+    _mm512_storeu_si512(state + 64, _mm512_add_epi32(_mm512_loadu_si512(state +  0), _mm512_add_epi32(left[1], right[2])));
+    _mm512_storeu_si512(state +  0, t);
+  }
+#endif
+
+}
+
+MessageDigestRIPEMD160::MessageDigestRIPEMD160()
+  : MessageDigestRIPEMD(HASH_SIZE)
+{
+  if (isSupported(BatchKernel::AVX512))
+    _batchKernel = BatchKernel::AVX512;
+  else if (isSupported(BatchKernel::AVX2))
+    _batchKernel = BatchKernel::AVX2;
+  else
+    _batchKernel = BatchKernel::Serial;
+
+  reset();
+}
+
+std::string MessageDigestRIPEMD160::getAlgorithm() const
+{
+  return "RIPEMD160";
+}
+
+void MessageDigestRIPEMD160::reset()
+{
+  _numBytes   = 0;
+  _bufferSize = 0;
+
+  // same as SHA1
+  _hash[0] = 0x67452301;
+  _hash[1] = 0xefcdab89;
+  _hash[2] = 0x98badcfe;
+  _hash[3] = 0x10325476;
+  _hash[4] = 0xc3d2e1f0;
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestRIPEMD160::create()
+{
+  return std::unique_ptr<MessageDigestImpl>(new MessageDigestRIPEMD160());
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestRIPEMD160::clone() const
+{
+  return cloneDigest(*this);
+}
+
+bool MessageDigestRIPEMD160::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
+
+void MessageDigestRIPEMD160::processBlocks(const void *data, size_t nBlocks)
+{
+  compress160(_hash, (const uint8_t*) data, nBlocks);
+}
+
+bool MessageDigestRIPEMD160::setBatchKernel(BatchKernel kernel)
+{
+  if (!isSupported(kernel))
+    return false;
+
+  _batchKernel = kernel;
+  return true;
+}
+
+MessageDigestRIPEMD160::BatchKernel MessageDigestRIPEMD160::getBatchKernel() const
+{
+  return _batchKernel;
+}
+
+bool MessageDigestRIPEMD160::isSupported(BatchKernel kernel)
+{
+  switch (kernel)
+  {
+#ifdef MESSAGEDIGEST_X86
+  case BatchKernel::AVX2:
+    return CpuFeatures::hasAVX2();
+  case BatchKernel::AVX512:
+    return CpuFeatures::hasAVX512F();
+#else
+  case BatchKernel::AVX2:
+  case BatchKernel::AVX512:
+    return false;
+#endif
+  default:
+    return true;
+  }
+}
+
+void MessageDigestRIPEMD160::digestBatch(const MessageDigestInput *inputs, size_t numInputs, uint8_t *digests)
+{
+  switch (_batchKernel)
+  {
+#ifdef MESSAGEDIGEST_X86
+  case BatchKernel::AVX2:
+    digestBatchMultiBuffer<8>(inputs, numInputs, digests, processBlocksAVX2);
+    break;
+  case BatchKernel::AVX512:
+    digestBatchMultiBuffer<16>(inputs, numInputs, digests, processBlocksAVX512);
+    break;
+#endif
+  default:
+    digestBatchSerial(inputs, numInputs, digests);
+  }
+}
+
+template<size_t LANES>
+void MessageDigestRIPEMD160::digestBatchMultiBuffer(const MessageDigestInput *inputs, size_t numInputs, uint8_t *digests,
+                                                    ProcessBlocksFunc processBlocks)
+{
+  static constexpr uint32_t initialHash[HASH_SIZE] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+
+  // as digestBatchSerial()
+  reset();
+
+  // structure of arrays, row i holds _hash[i] of all lanes
+  uint32_t state[HASH_SIZE*LANES];
+
+  // messages of unequal length are fine: a lane takes the next message
+  // as soon as its current one is done
+  MessageDigestMultiBuffer<LANES,BLOCK_SIZE,8,false> engine(inputs, numInputs);
+  engine.run(
+        [&](size_t lane)
+        {
+          for (int i = 0; i < HASH_SIZE; i++)
+            state[i*LANES + lane] = initialHash[i];
+        },
+        [&](const uint8_t* const* blocks)
+        {
+          processBlocks(state, blocks);
+        },
+        [&](size_t lane, size_t message)
+        {
+          uint32_t hash[HASH_SIZE];
+          for (int i = 0; i < HASH_SIZE; i++)
+            hash[i] = state[i*LANES + lane];
+          hashToBytes(hash, HASH_SIZE, digests + message * DIGEST_SIZE);
+        });
+}
@@ -0,0 +1,61 @@
+/**
+ * @file MessageDigestRIPEMD320.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/MessageDigestRIPEMD320.hpp"
+#include "MessageDigest/MessageDigest.hpp"
+
+static MessageDigestImplRegistrar<MessageDigestRIPEMD320> registrar("RIPEMD320");
+
+MessageDigestRIPEMD320::MessageDigestRIPEMD320()
+  : MessageDigestRIPEMD(10)
+{
+  reset();
+}
+
+std::string MessageDigestRIPEMD320::getAlgorithm() const
+{
+  return "RIPEMD320";
+}
+
+void MessageDigestRIPEMD320::reset()
+{
+  _numBytes   = 0;
+  _bufferSize = 0;
+
+  // left line as RIPEMD-160, the right line swaps the nibbles of every byte
+  _hash[0] = 0x67452301;
+  _hash[1] = 0xefcdab89;
+  _hash[2] = 0x98badcfe;
+  _hash[3] = 0x10325476;
+  _hash[4] = 0xc3d2e1f0;
+  _hash[5] = 0x76543210;
+  _hash[6] = 0xfedcba98;
+  _hash[7] = 0x89abcdef;
+  _hash[8] = 0x01234567;
+  _hash[9] = 0x3c2d1e0f;
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestRIPEMD320::create()
+{
+  return std::unique_ptr<MessageDigestImpl>(new MessageDigestRIPEMD320());
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestRIPEMD320::clone() const
+{
+  return cloneDigest(*this);
+}
+
+bool MessageDigestRIPEMD320::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
+
+void MessageDigestRIPEMD320::processBlocks(const void *data, size_t nBlocks)
+{
+  compress320(_hash, (const uint8_t*) data, nBlocks);
+}
@@ -17,15 +17,24 @@
 
 #include "MessageDigest/MessageDigestSHA1.hpp"
 #include "MessageDigest/MessageDigest.hpp"
+#include "MessageDigest/MessageDigestEncoding.hpp"
+#include "MessageDigest/CpuFeatures.hpp"
+#include "MessageDigest/MessageDigestState.hpp"
+#include "MessageDigest/MessageDigestMultiBuffer.hpp"
 
 #include <iostream>
 
+#ifdef MESSAGEDIGEST_X86
+#include <immintrin.h>
+#endif
+
 // big endian architectures need #define __BYTE_ORDER __BIG_ENDIAN
 #ifndef _MSC_VER
 #include <endian.h>
 #endif
 
-static MessageDigestImplRegistrar<MessageDigestSHA1> registrar("SHA1");
+static MessageDigestKernelRegistrar<MessageDigestSHA1> registrar("SHA1", "generic", 0, MessageDigestSHA1::Kernel::Generic);
+static MessageDigestKernelRegistrar<MessageDigestSHA1> registrarSHANI("SHA1", "shani", 10, MessageDigestSHA1::Kernel::SHANI);
 
 namespace
 {
@@ -61,10 +70,98 @@ namespace
     return (b & c) | (b & d) | (c & d);
   }
 
+#ifdef MESSAGEDIGEST_X86
+  /**
+   * @brief Four rounds with the Intel SHA extensions
+   * @param abcd working state, updated in place
+   * @param e    abcd as it was before the previous four rounds
+   * @param w    next four schedule words
+   * @return abcd as it was before these four rounds
+   */
+  template<int F>
+  MESSAGEDIGEST_TARGET("sha,sse4.1")
+  inline __m128i roundsSHANI(__m128i& abcd, __m128i e, __m128i w)
+  {
+    __m128i previous = abcd;
+    abcd = _mm_sha1rnds4_epu32(abcd, _mm_sha1nexte_epu32(e, w), F);
+    return previous;
+  }
+
+  /**
+   * @brief Extend the message schedule by four words,
+   * w0..w3 are the previous sixteen words, oldest first
+   */
+  MESSAGEDIGEST_TARGET("sha,sse4.1")
+  inline __m128i scheduleSHANI(__m128i w0, __m128i w1, __m128i w2, __m128i w3)
+  {
+    return _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(w0, w1), w2), w3);
+  }
+
+  /// process nBlocks consecutive 64 byte blocks with the Intel SHA extensions
+  MESSAGEDIGEST_TARGET("sha,sse4.1")
+  void processBlocksSHANI(uint32_t* hash, const uint8_t* data, size_t nBlocks)
+  {
+    const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+    // a is kept in the highest lane, e in the highest lane of its own register
+    __m128i abcd  = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) hash), 0x1B);
+    __m128i eLane = _mm_set_epi32((int) hash[4], 0, 0, 0);
+
+    while (nBlocks--)
+    {
+      const __m128i abcdSave = abcd;
+      const __m128i eSave    = eLane;
+
+      // convert to big endian
+      __m128i w0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (data +  0)), byteSwap);
+      __m128i w1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (data + 16)), byteSwap);
+      __m128i w2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (data + 32)), byteSwap);
+      __m128i w3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (data + 48)), byteSwap);
+
+      // first round
+      __m128i e = abcd;
+      abcd = _mm_sha1rnds4_epu32(abcd, _mm_add_epi32(eLane, w0), 0);
+      e = roundsSHANI<0>(abcd, e, w1);
+      e = roundsSHANI<0>(abcd, e, w2);
+      e = roundsSHANI<0>(abcd, e, w3);
+      w0 = scheduleSHANI(w0, w1, w2, w3); e = roundsSHANI<0>(abcd, e, w0);
+
+      // second round
+      w1 = scheduleSHANI(w1, w2, w3, w0); e = roundsSHANI<1>(abcd, e, w1);
+      w2 = scheduleSHANI(w2, w3, w0, w1); e = roundsSHANI<1>(abcd, e, w2);
+      w3 = scheduleSHANI(w3, w0, w1, w2); e = roundsSHANI<1>(abcd, e, w3);
+      w0 = scheduleSHANI(w0, w1, w2, w3); e = roundsSHANI<1>(abcd, e, w0);
+      w1 = scheduleSHANI(w1, w2, w3, w0); e = roundsSHANI<1>(abcd, e, w1);
+
+      // third round
+      w2 = scheduleSHANI(w2, w3, w0, w1); e = roundsSHANI<2>(abcd, e, w2);
+      w3 = scheduleSHANI(w3, w0, w1, w2); e = roundsSHANI<2>(abcd, e, w3);
+      w0 = scheduleSHANI(w0, w1, w2, w3); e = roundsSHANI<2>(abcd, e, w0);
+      w1 = scheduleSHANI(w1, w2, w3, w0); e = roundsSHANI<2>(abcd, e, w1);
+      w2 = scheduleSHANI(w2, w3, w0, w1); e = roundsSHANI<2>(abcd, e, w2);
+
+      // fourth round
+      w3 = scheduleSHANI(w3, w0, w1, w2); e = roundsSHANI<3>(abcd, e, w3);
+      w0 = scheduleSHANI(w0, w1, w2, w3); e = roundsSHANI<3>(abcd, e, w0);
+      w1 = scheduleSHANI(w1, w2, w3, w0); e = roundsSHANI<3>(abcd, e, w1);
+      w2 = scheduleSHANI(w2, w3, w0, w1); e = roundsSHANI<3>(abcd, e, w2);
+      w3 = scheduleSHANI(w3, w0, w1, w2); e = roundsSHANI<3>(abcd, e, w3);
+
+      // update hash
+      eLane = _mm_sha1nexte_epu32(e, eSave);
+      abcd  = _mm_add_epi32(abcd, abcdSave);
+      data += 64;
+    }
+
+    _mm_storeu_si128((__m128i*) hash, _mm_shuffle_epi32(abcd, 0x1B));
+    hash[4] = (uint32_t) _mm_extract_epi32(eLane, 3);
+  }
+#endif
 }
 
 MessageDigestSHA1::MessageDigestSHA1()
 {
+  _kernel = isSupported(Kernel::SHANI) ? Kernel::SHANI : Kernel::Generic;
   reset();
 }
 
@@ -87,16 +184,95 @@ void MessageDigestSHA1::reset()
 
 }
 
+std::vector<uint8_t> MessageDigestSHA1::exportState() const
+{
+  MessageDigestStateWriter writer(getAlgorithm());
+  writer.write(_numBytes);
+  for (int i = 0; i < HASH_SIZE; i++)
+    writer.write(_hash[i]);
+  writer.write((uint8_t) _bufferSize);
+  writer.write(_buffer, _bufferSize);
+  return writer.state();
+}
+
+bool MessageDigestSHA1::importState(const uint8_t *state, size_t size)
+{
+  MessageDigestStateReader reader(state, size);
+  uint64_t numBytes;
+  uint32_t hash[HASH_SIZE];
+  uint8_t  bufferSize;
+  uint8_t  buffer[BLOCK_SIZE];
+
+  if (!reader.readHeader(getAlgorithm()) || !reader.read(numBytes) || numBytes % BLOCK_SIZE != 0)
+    return false;
+  for (int i = 0; i < HASH_SIZE; i++)
+    if (!reader.read(hash[i]))
+      return false;
+  if (!reader.read(bufferSize) || bufferSize >= BLOCK_SIZE || !reader.read(buffer, bufferSize) || !reader.atEnd())
+    return false;
+
+  _numBytes   = numBytes;
+  _bufferSize = bufferSize;
+  for (int i = 0; i < HASH_SIZE; i++)
+    _hash[i] = hash[i];
+  for (int i = 0; i < bufferSize; i++)
+    _buffer[i] = buffer[i];
+  return true;
+}
+
 std::unique_ptr<MessageDigestImpl> MessageDigestSHA1::create()
 {
   return std::unique_ptr<MessageDigestImpl>(new MessageDigestSHA1());
 }
 
+std::unique_ptr<MessageDigestImpl> MessageDigestSHA1::clone() const
+{
+  return cloneDigest(*this);
+}
+
+bool MessageDigestSHA1::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
+
+bool MessageDigestSHA1::setKernel(Kernel kernel)
+{
+  if (!isSupported(kernel))
+    return false;
+
+  _kernel = kernel;
+  return true;
+}
+
+MessageDigestSHA1::Kernel MessageDigestSHA1::getKernel() const
+{
+  return _kernel;
+}
+
+bool MessageDigestSHA1::isSupported(Kernel kernel)
+{
+  switch (kernel)
+    {
+    case Kernel::SHANI:
+#ifdef MESSAGEDIGEST_X86
+      return CpuFeatures::hasSHA() && CpuFeatures::hasSSE41();
+#else
+      return false;
+#endif
+    default:
+      return true;
+    }
+}
+
 std::string MessageDigestSHA1::digest()
 {
-  // convert hash to string
-  static constexpr char dec2hex[16+1] = "0123456789abcdef";
+  uint8_t buffer[DIGEST_SIZE];
+  digestBinary(buffer);
+  return MessageDigestEncoding::toHex(buffer, DIGEST_SIZE);
+}
 
+void MessageDigestSHA1::digestBinary(uint8_t *buffer)
+{
   // save old hash if buffer is partially filled
   uint32_t oldHash[HASH_SIZE];
   for (int i = 0; i < HASH_SIZE; i++)
@@ -107,29 +283,62 @@ std::string MessageDigestSHA1::digest()
   // process remaining bytes
   processBuffer();
 
-  // create hash string
-  char hashBuffer[HASH_SIZE*8+1];
-  size_t offset = 0;
   for (int i = 0; i < HASH_SIZE; i++)
     {
-      hashBuffer[offset++] = dec2hex[(_hash[i] >> 28) & 15];
-      hashBuffer[offset++] = dec2hex[(_hash[i] >> 24) & 15];
-      hashBuffer[offset++] = dec2hex[(_hash[i] >> 20) & 15];
-      hashBuffer[offset++] = dec2hex[(_hash[i] >> 16) & 15];
-      hashBuffer[offset++] = dec2hex[(_hash[i] >> 12) & 15];
-      hashBuffer[offset++] = dec2hex[(_hash[i] >>  8) & 15];
-      hashBuffer[offset++] = dec2hex[(_hash[i] >>  4) & 15];
-      hashBuffer[offset++] = dec2hex[ _hash[i]        & 15];
+      *buffer++ = (_hash[i] >> 24) & 0xFF;
+      *buffer++ = (_hash[i] >> 16) & 0xFF;
+      *buffer++ = (_hash[i] >>  8) & 0xFF;
+      *buffer++ =  _hash[i]        & 0xFF;
 
       // restore old hash
       _hash[i] = oldHash[i];
     }
+}
 
-  // zero-terminated string
-  hashBuffer[offset] = 0;
+size_t MessageDigestSHA1::getDigestSize() const
+{
+  return DIGEST_SIZE;
+}
 
-  // convert to std::string
-  return hashBuffer;
+size_t MessageDigestSHA1::getBlockSize() const
+{
+  return BLOCK_SIZE;
+}
+
+void MessageDigestSHA1::digestBatch(const MessageDigestInput *inputs, size_t numInputs, uint8_t *digests)
+{
+  reset();
+  uint32_t initialHash[HASH_SIZE];
+  for (int i = 0; i < HASH_SIZE; i++)
+    initialHash[i] = _hash[i];
+
+  uint8_t padded[2*BLOCK_SIZE];
+  for (size_t message = 0; message < numInputs; message++)
+  {
+    const uint8_t* data = (const uint8_t*) inputs[message].first;
+    size_t numBytes = inputs[message].second;
+    size_t fullBlocks = numBytes / BLOCK_SIZE;
+
+    for (int i = 0; i < HASH_SIZE; i++)
+      _hash[i] = initialHash[i];
+    if (fullBlocks > 0)
+      processBlocks(data, fullBlocks);
+
+    size_t numPadded = MessageDigestMultiBuffer<1,BLOCK_SIZE,8,true>::pad(
+          padded, data + fullBlocks * BLOCK_SIZE, numBytes % BLOCK_SIZE, numBytes);
+    processBlocks(padded, numPadded);
+
+    uint8_t* buffer = digests + message * DIGEST_SIZE;
+    for (int i = 0; i < HASH_SIZE; i++)
+    {
+      *buffer++ = (_hash[i] >> 24) & 0xFF;
+      *buffer++ = (_hash[i] >> 16) & 0xFF;
+      *buffer++ = (_hash[i] >>  8) & 0xFF;
+      *buffer++ =  _hash[i]        & 0xFF;
+    }
+  }
+
+  reset();
 }
 
 void MessageDigestSHA1::update(const void *data, const size_t offset, const size_t len)
@@ -158,13 +367,14 @@ void MessageDigestSHA1::update(const void *data, const size_t offset, const size
   if (numBytes == 0)
     return;
 
-  // process full blocks
-  while (numBytes >= BLOCK_SIZE)
+  // process full blocks in one run
+  if (numBytes >= BLOCK_SIZE)
     {
-      processBlock(current);
-      current    += BLOCK_SIZE;
-      _numBytes += BLOCK_SIZE;
-      numBytes   -= BLOCK_SIZE;
+      size_t nBlocks = numBytes / BLOCK_SIZE;
+      processBlocks(current, nBlocks);
+      current   += nBlocks * BLOCK_SIZE;
+      _numBytes += nBlocks * BLOCK_SIZE;
+      numBytes  -= nBlocks * BLOCK_SIZE;
     }
 
   // keep remaining bytes in buffer
@@ -175,8 +385,16 @@ void MessageDigestSHA1::update(const void *data, const size_t offset, const size
     }
 }
 
-void MessageDigestSHA1::processBlock(const void *data)
+void MessageDigestSHA1::processBlocks(const void *data, size_t nBlocks)
 {
+#ifdef MESSAGEDIGEST_X86
+  if (_kernel == Kernel::SHANI)
+    {
+      processBlocksSHANI(_hash, (const uint8_t*) data, nBlocks);
+      return;
+    }
+#endif
+
   /* Constants defined in SHA-1   */
   static constexpr uint32_t K[] =    {
     0x5A827999,
@@ -185,83 +403,101 @@ void MessageDigestSHA1::processBlock(const void *data)
     0xCA62C1D6
   };
 
-  // get last hash
-  uint32_t a = _hash[0];
-  uint32_t b = _hash[1];
-  uint32_t c = _hash[2];
-  uint32_t d = _hash[3];
-  uint32_t e = _hash[4];
-
-  // data represented as 16x 32-bit words
-  const uint32_t* input = (uint32_t*) data;
+  // the chaining state stays in locals for the whole run, _hash could
+  // alias the input and would be reloaded for every block
+  uint32_t state[HASH_SIZE];
+  for (int i = 0; i < HASH_SIZE; i++)
+    state[i] = _hash[i];
 
-  // convert to big endian
-  uint32_t words[80];
-  for (int i = 0; i < 16; i++)
-    {
+  const uint8_t* current = (const uint8_t*) data;
+  for (; nBlocks > 0; nBlocks--, current += BLOCK_SIZE)
+  {
+    // get last hash
+    uint32_t a = state[0];
+    uint32_t b = state[1];
+    uint32_t c = state[2];
+    uint32_t d = state[3];
+    uint32_t e = state[4];
+
+    // data represented as 16x 32-bit words
+    const uint32_t* input = (const uint32_t*) current;
+
+    // convert to big endian
+    uint32_t words[80];
+    for (int i = 0; i < 16; i++)
+      {
 #if defined(__BYTE_ORDER) && (__BYTE_ORDER != 0) && (__BYTE_ORDER == __BIG_ENDIAN)
-      words[i] = input[i];
+        words[i] = input[i];
 #else
-      words[i] = swap32(input[i]);
+        words[i] = swap32(input[i]);
 #endif
-    }
-
-  // extend to 80 words
-  for (int i = 16; i < 80; i++)
-    {
-      words[i] = rotateLeft(words[i-3] ^ words[i-8] ^ words[i-14] ^ words[i-16], 1);
-    }
-
-  // first round
-  for (int i = 0; i < 4; i++)
-    {
-      int offset = 5*i;
-      e += rotateLeft(a,5) + f1(b,c,d) + words[offset  ] + K[0]; b = rotateLeft(b,30);
-      d += rotateLeft(e,5) + f1(a,b,c) + words[offset+1] + K[0]; a = rotateLeft(a,30);
-      c += rotateLeft(d,5) + f1(e,a,b) + words[offset+2] + K[0]; e = rotateLeft(e,30);
-      b += rotateLeft(c,5) + f1(d,e,a) + words[offset+3] + K[0]; d = rotateLeft(d,30);
-      a += rotateLeft(b,5) + f1(c,d,e) + words[offset+4] + K[0]; c = rotateLeft(c,30);
-    }
-
-  // second round
-  for (int i = 4; i < 8; i++)
-    {
-      int offset = 5*i;
-      e += rotateLeft(a,5) + f2(b,c,d) + words[offset  ] + K[1]; b = rotateLeft(b,30);
-      d += rotateLeft(e,5) + f2(a,b,c) + words[offset+1] + K[1]; a = rotateLeft(a,30);
-      c += rotateLeft(d,5) + f2(e,a,b) + words[offset+2] + K[1]; e = rotateLeft(e,30);
-      b += rotateLeft(c,5) + f2(d,e,a) + words[offset+3] + K[1]; d = rotateLeft(d,30);
-      a += rotateLeft(b,5) + f2(c,d,e) + words[offset+4] + K[1]; c = rotateLeft(c,30);
-    }
-
-  // third round
-  for (int i = 8; i < 12; i++)
-    {
-      int offset = 5*i;
-      e += rotateLeft(a,5) + f3(b,c,d) + words[offset  ] + K[2]; b = rotateLeft(b,30);
-      d += rotateLeft(e,5) + f3(a,b,c) + words[offset+1] + K[2]; a = rotateLeft(a,30);
-      c += rotateLeft(d,5) + f3(e,a,b) + words[offset+2] + K[2]; e = rotateLeft(e,30);
-      b += rotateLeft(c,5) + f3(d,e,a) + words[offset+3] + K[2]; d = rotateLeft(d,30);
-      a += rotateLeft(b,5) + f3(c,d,e) + words[offset+4] + K[2]; c = rotateLeft(c,30);
-    }
+      }
+
+    // extend to 80 words
+    for (int i = 16; i < 80; i++)
+      {
+        words[i] = rotateLeft(words[i-3] ^ words[i-8] ^ words[i-14] ^ words[i-16], 1);
+      }
+
+    // first round
+    for (int i = 0; i < 4; i++)
+      {
+        int offset = 5*i;
+        e += rotateLeft(a,5) + f1(b,c,d) + words[offset  ] + K[0]; b = rotateLeft(b,30);
+        d += rotateLeft(e,5) + f1(a,b,c) + words[offset+1] + K[0]; a = rotateLeft(a,30);
+        c += rotateLeft(d,5) + f1(e,a,b) + words[offset+2] + K[0]; e = rotateLeft(e,30);
+        b += rotateLeft(c,5) + f1(d,e,a) + words[offset+3] + K[0]; d = rotateLeft(d,30);
+        a += rotateLeft(b,5) + f1(c,d,e) + words[offset+4] + K[0]; c = rotateLeft(c,30);
+      }
+
+    // second round
+    for (int i = 4; i < 8; i++)
+      {
+        int offset = 5*i;
+        e += rotateLeft(a,5) + f2(b,c,d) + words[offset  ] + K[1]; b = rotateLeft(b,30);
+        d += rotateLeft(e,5) + f2(a,b,c) + words[offset+1] + K[1]; a = rotateLeft(a,30);
+        c += rotateLeft(d,5) + f2(e,a,b) + words[offset+2] + K[1]; e = rotateLeft(e,30);
+        b += rotateLeft(c,5) + f2(d,e,a) + words[offset+3] + K[1]; d = rotateLeft(d,30);
+        a += rotateLeft(b,5) + f2(c,d,e) + words[offset+4] + K[1]; c = rotateLeft(c,30);
+      }
+
+    // third round
+    for (int i = 8; i < 12; i++)
+      {
+        int offset = 5*i;
+        e += rotateLeft(a,5) + f3(b,c,d) + words[offset  ] + K[2]; b = rotateLeft(b,30);
+        d += rotateLeft(e,5) + f3(a,b,c) + words[offset+1] + K[2]; a = rotateLeft(a,30);
+        c += rotateLeft(d,5) + f3(e,a,b) + words[offset+2] + K[2]; e = rotateLeft(e,30);
+        b += rotateLeft(c,5) + f3(d,e,a) + words[offset+3] + K[2]; d = rotateLeft(d,30);
+        a += rotateLeft(b,5) + f3(c,d,e) + words[offset+4] + K[2]; c = rotateLeft(c,30);
+      }
+
+    // fourth round
+    for (int i = 12; i < 16; i++)
+      {
+        int offset = 5*i;
+        e += rotateLeft(a,5) + f2(b,c,d) + words[offset  ] + K[3]; b = rotateLeft(b,30);
+        d += rotateLeft(e,5) + f2(a,b,c) + words[offset+1] + K[3]; a = rotateLeft(a,30);
+        c += rotateLeft(d,5) + f2(e,a,b) + words[offset+2] + K[3]; e = rotateLeft(e,30);
+        b += rotateLeft(c,5) + f2(d,e,a) + words[offset+3] + K[3]; d = rotateLeft(d,30);
+        a += rotateLeft(b,5) + f2(c,d,e) + words[offset+4] + K[3]; c = rotateLeft(c,30);
+      }
+
+    // update hash
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+  }
 
-  // fourth round
-  for (int i = 12; i < 16; i++)
-    {
-      int offset = 5*i;
-      e += rotateLeft(a,5) + f2(b,c,d) + words[offset  ] + K[3]; b = rotateLeft(b,30);
-      d += rotateLeft(e,5) + f2(a,b,c) + words[offset+1] + K[3]; a = rotateLeft(a,30);
-      c += rotateLeft(d,5) + f2(e,a,b) + words[offset+2] + K[3]; e = rotateLeft(e,30);
-      b += rotateLeft(c,5) + f2(d,e,a) + words[offset+3] + K[3]; d = rotateLeft(d,30);
-      a += rotateLeft(b,5) + f2(c,d,e) + words[offset+4] + K[3]; c = rotateLeft(c,30);
-    }
+  for (int i = 0; i < HASH_SIZE; i++)
+    _hash[i] = state[i];
+}
 
-  // update hash
-  _hash[0] += a;
-  _hash[1] += b;
-  _hash[2] += c;
-  _hash[3] += d;
-  _hash[4] += e;
+void MessageDigestSHA1::processBlock(const void *data)
+{
+  processBlocks(data, 1);
 }
 
 /// process final block, less than 64 bytes
@@ -25,7 +25,8 @@
 #include <endian.h>
 #endif
 
-static MessageDigestImplRegistrar<MessageDigestSHA224> registrar("SHA224");
+static MessageDigestKernelRegistrar<MessageDigestSHA224> registrar("SHA224", "generic", 0, MessageDigestSHA224::Kernel::Generic);
+static MessageDigestKernelRegistrar<MessageDigestSHA224> registrarSHANI("SHA224", "shani", 10, MessageDigestSHA224::Kernel::SHANI);
 
 MessageDigestSHA224::MessageDigestSHA224()
 {
@@ -59,39 +60,17 @@ std::unique_ptr<MessageDigestImpl> MessageDigestSHA224::create()
   return std::unique_ptr<MessageDigestImpl>(new MessageDigestSHA224());
 }
 
-std::string MessageDigestSHA224::digest()
+std::unique_ptr<MessageDigestImpl> MessageDigestSHA224::clone() const
 {
-  // convert hash to string
-  static const char dec2hex[16+1] = "0123456789abcdef";
-
-  // save old hash if buffer is partially filled
-  uint32_t oldHash[HASH_SIZE];
-  for (int i = 0; i < HASH_SIZE; i++)
-    oldHash[i] = _hash[i];
-
-  // process remaining bytes
-  processBuffer();
-
-  // create hash string
-  char hashBuffer[7*8+1];
-  size_t offset = 0;
-  for (int i = 0; i < 7; i++)
-  {
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 28) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 24) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 20) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 16) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 12) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >>  8) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >>  4) & 15];
-    hashBuffer[offset++] = dec2hex[ _hash[i]        & 15];
+  return cloneDigest(*this);
+}
 
-    // restore old hash
-    _hash[i] = oldHash[i];
-  }
-  // zero-terminated string
-  hashBuffer[offset] = 0;
+bool MessageDigestSHA224::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
 
-  // convert to std::string
-  return hashBuffer;
+size_t MessageDigestSHA224::getDigestSize() const
+{
+  return DIGEST_SIZE;
 }
@@ -17,18 +17,48 @@
 
 #include "MessageDigest/MessageDigestSHA256.hpp"
 #include "MessageDigest/MessageDigest.hpp"
+#include "MessageDigest/MessageDigestEncoding.hpp"
+#include "MessageDigest/CpuFeatures.hpp"
+#include "MessageDigest/MessageDigestState.hpp"
+#include "MessageDigest/MessageDigestMultiBuffer.hpp"
 
 #include <iostream>
+#include <cstring>
+
+#ifdef MESSAGEDIGEST_X86
+#include <immintrin.h>
+#endif
 
 // big endian architectures need #define __BYTE_ORDER __BIG_ENDIAN
 #ifndef _MSC_VER
 #include <endian.h>
 #endif
 
-static MessageDigestImplRegistrar<MessageDigestSHA256> registrar("SHA256");
+static MessageDigestKernelRegistrar<MessageDigestSHA256> registrar("SHA256", "generic", 0, MessageDigestSHA256::Kernel::Generic);
+static MessageDigestKernelRegistrar<MessageDigestSHA256> registrarSHANI("SHA256", "shani", 10, MessageDigestSHA256::Kernel::SHANI);
 
 namespace
 {
+  /* Constants defined in RFC 6234 section 5.1   */
+  static constexpr uint32_t K[] =    {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+  };
+
   /**
    * @brief The circular left shift operation
    */
@@ -69,10 +99,425 @@ namespace
   {
     return rotateRight(a, 17) ^ rotateRight(a, 19) ^ (a >> 10);
   }
+
+  /**
+   * @brief Compression function of Kernel::Generic
+   *
+   * Not inlined on purpose: with eight working and eight chaining words
+   * live across the loop of processBlocks() the registers run out and the
+   * spills cost more than the call.
+   */
+  MESSAGEDIGEST_NOINLINE
+  void processBlockGeneric(uint32_t* hash, const void* data)
+  {
+    // get last hash
+    uint32_t a = hash[0];
+    uint32_t b = hash[1];
+    uint32_t c = hash[2];
+    uint32_t d = hash[3];
+    uint32_t e = hash[4];
+    uint32_t f = hash[5];
+    uint32_t g = hash[6];
+    uint32_t h = hash[7];
+
+    // data represented as 16x 32-bit words
+    const uint32_t* input = (const uint32_t*) data;
+
+    // convert to big endian
+    uint32_t words[64];
+    int i;
+    for (i = 0; i < 16; i++)
+      {
+#if defined(__BYTE_ORDER) && (__BYTE_ORDER != 0) && (__BYTE_ORDER == __BIG_ENDIAN)
+        words[i] = input[i];
+#else
+        words[i] = swap32(input[i]);
+#endif
+      }
+
+    uint32_t x,y; // temporaries
+
+    // first round
+    x = h + f1(e,f,g) + K[0] + words[ 0]; y = f2(a,b,c); d += x; h = x + y;
+    x = g + f1(d,e,f) + K[1] + words[ 1]; y = f2(h,a,b); c += x; g = x + y;
+    x = f + f1(c,d,e) + K[2] + words[ 2]; y = f2(g,h,a); b += x; f = x + y;
+    x = e + f1(b,c,d) + K[3] + words[ 3]; y = f2(f,g,h); a += x; e = x + y;
+    x = d + f1(a,b,c) + K[4] + words[ 4]; y = f2(e,f,g); h += x; d = x + y;
+    x = c + f1(h,a,b) + K[5] + words[ 5]; y = f2(d,e,f); g += x; c = x + y;
+    x = b + f1(g,h,a) + K[6] + words[ 6]; y = f2(c,d,e); f += x; b = x + y;
+    x = a + f1(f,g,h) + K[7] + words[ 7]; y = f2(b,c,d); e += x; a = x + y;
+
+    // secound round
+    x = h + f1(e,f,g) + K[8] + words[ 8]; y = f2(a,b,c); d += x; h = x + y;
+    x = g + f1(d,e,f) + K[9] + words[ 9]; y = f2(h,a,b); c += x; g = x + y;
+    x = f + f1(c,d,e) + K[10] + words[10]; y = f2(g,h,a); b += x; f = x + y;
+    x = e + f1(b,c,d) + K[11] + words[11]; y = f2(f,g,h); a += x; e = x + y;
+    x = d + f1(a,b,c) + K[12] + words[12]; y = f2(e,f,g); h += x; d = x + y;
+    x = c + f1(h,a,b) + K[13] + words[13]; y = f2(d,e,f); g += x; c = x + y;
+    x = b + f1(g,h,a) + K[14] + words[14]; y = f2(c,d,e); f += x; b = x + y;
+    x = a + f1(f,g,h) + K[15] + words[15]; y = f2(b,c,d); e += x; a = x + y;
+
+    // extend to 24 words
+    for (; i < 24; i++)
+      words[i] = words[i-16] + f3(words[i-15]) + words[i-7] + f4(words[i- 2]);
+
+    // third round
+    x = h + f1(e,f,g) + K[16] + words[16]; y = f2(a,b,c); d += x; h = x + y;
+    x = g + f1(d,e,f) + K[17] + words[17]; y = f2(h,a,b); c += x; g = x + y;
+    x = f + f1(c,d,e) + K[18] + words[18]; y = f2(g,h,a); b += x; f = x + y;
+    x = e + f1(b,c,d) + K[19] + words[19]; y = f2(f,g,h); a += x; e = x + y;
+    x = d + f1(a,b,c) + K[20] + words[20]; y = f2(e,f,g); h += x; d = x + y;
+    x = c + f1(h,a,b) + K[21] + words[21]; y = f2(d,e,f); g += x; c = x + y;
+    x = b + f1(g,h,a) + K[22] + words[22]; y = f2(c,d,e); f += x; b = x + y;
+    x = a + f1(f,g,h) + K[23] + words[23]; y = f2(b,c,d); e += x; a = x + y;
+
+    // extend to 32 words
+    for (; i < 32; i++)
+      words[i] = words[i-16] + f3(words[i-15]) + words[i-7] + f4(words[i- 2]);
+
+    // fourth round
+    x = h + f1(e,f,g) + K[24] + words[24]; y = f2(a,b,c); d += x; h = x + y;
+    x = g + f1(d,e,f) + K[25] + words[25]; y = f2(h,a,b); c += x; g = x + y;
+    x = f + f1(c,d,e) + K[26] + words[26]; y = f2(g,h,a); b += x; f = x + y;
+    x = e + f1(b,c,d) + K[27] + words[27]; y = f2(f,g,h); a += x; e = x + y;
+    x = d + f1(a,b,c) + K[28] + words[28]; y = f2(e,f,g); h += x; d = x + y;
+    x = c + f1(h,a,b) + K[29] + words[29]; y = f2(d,e,f); g += x; c = x + y;
+    x = b + f1(g,h,a) + K[30] + words[30]; y = f2(c,d,e); f += x; b = x + y;
+    x = a + f1(f,g,h) + K[31] + words[31]; y = f2(b,c,d); e += x; a = x + y;
+
+    // extend to 40 words
+    for (; i < 40; i++)
+      words[i] = words[i-16] + f3(words[i-15]) + words[i-7] + f4(words[i- 2]);
+
+    // fifth round
+    x = h + f1(e,f,g) + K[32] + words[32]; y = f2(a,b,c); d += x; h = x + y;
+    x = g + f1(d,e,f) + K[33] + words[33]; y = f2(h,a,b); c += x; g = x + y;
+    x = f + f1(c,d,e) + K[34] + words[34]; y = f2(g,h,a); b += x; f = x + y;
+    x = e + f1(b,c,d) + K[35] + words[35]; y = f2(f,g,h); a += x; e = x + y;
+    x = d + f1(a,b,c) + K[36] + words[36]; y = f2(e,f,g); h += x; d = x + y;
+    x = c + f1(h,a,b) + K[37] + words[37]; y = f2(d,e,f); g += x; c = x + y;
+    x = b + f1(g,h,a) + K[38] + words[38]; y = f2(c,d,e); f += x; b = x + y;
+    x = a + f1(f,g,h) + K[39] + words[39]; y = f2(b,c,d); e += x; a = x + y;
+
+    // extend to 48 words
+    for (; i < 48; i++)
+      words[i] = words[i-16] + f3(words[i-15]) + words[i-7] + f4(words[i- 2]);
+
+    // sixth round
+    x = h + f1(e,f,g) + K[40] + words[40]; y = f2(a,b,c); d += x; h = x + y;
+    x = g + f1(d,e,f) + K[41] + words[41]; y = f2(h,a,b); c += x; g = x + y;
+    x = f + f1(c,d,e) + K[42] + words[42]; y = f2(g,h,a); b += x; f = x + y;
+    x = e + f1(b,c,d) + K[43] + words[43]; y = f2(f,g,h); a += x; e = x + y;
+    x = d + f1(a,b,c) + K[44] + words[44]; y = f2(e,f,g); h += x; d = x + y;
+    x = c + f1(h,a,b) + K[45] + words[45]; y = f2(d,e,f); g += x; c = x + y;
+    x = b + f1(g,h,a) + K[46] + words[46]; y = f2(c,d,e); f += x; b = x + y;
+    x = a + f1(f,g,h) + K[47] + words[47]; y = f2(b,c,d); e += x; a = x + y;
+
+    // extend to 56 words
+    for (; i < 56; i++)
+      words[i] = words[i-16] + f3(words[i-15]) + words[i-7] + f4(words[i- 2]);
+
+    // seventh round
+    x = h + f1(e,f,g) + K[48] + words[48]; y = f2(a,b,c); d += x; h = x + y;
+    x = g + f1(d,e,f) + K[49] + words[49]; y = f2(h,a,b); c += x; g = x + y;
+    x = f + f1(c,d,e) + K[50] + words[50]; y = f2(g,h,a); b += x; f = x + y;
+    x = e + f1(b,c,d) + K[51] + words[51]; y = f2(f,g,h); a += x; e = x + y;
+    x = d + f1(a,b,c) + K[52] + words[52]; y = f2(e,f,g); h += x; d = x + y;
+    x = c + f1(h,a,b) + K[53] + words[53]; y = f2(d,e,f); g += x; c = x + y;
+    x = b + f1(g,h,a) + K[54] + words[54]; y = f2(c,d,e); f += x; b = x + y;
+    x = a + f1(f,g,h) + K[55] + words[55]; y = f2(b,c,d); e += x; a = x + y;
+
+    // extend to 64 words
+    for (; i < 64; i++)
+      words[i] = words[i-16] + f3(words[i-15]) + words[i-7] + f4(words[i- 2]);
+
+    // eigth round
+    x = h + f1(e,f,g) + K[56] + words[56]; y = f2(a,b,c); d += x; h = x + y;
+    x = g + f1(d,e,f) + K[57] + words[57]; y = f2(h,a,b); c += x; g = x + y;
+    x = f + f1(c,d,e) + K[58] + words[58]; y = f2(g,h,a); b += x; f = x + y;
+    x = e + f1(b,c,d) + K[59] + words[59]; y = f2(f,g,h); a += x; e = x + y;
+    x = d + f1(a,b,c) + K[60] + words[60]; y = f2(e,f,g); h += x; d = x + y;
+    x = c + f1(h,a,b) + K[61] + words[61]; y = f2(d,e,f); g += x; c = x + y;
+    x = b + f1(g,h,a) + K[62] + words[62]; y = f2(c,d,e); f += x; b = x + y;
+    x = a + f1(f,g,h) + K[63] + words[63]; y = f2(b,c,d); e += x; a = x + y;
+
+    // update hash
+    hash[0] += a;
+    hash[1] += b;
+    hash[2] += c;
+    hash[3] += d;
+    hash[4] += e;
+    hash[5] += f;
+    hash[6] += g;
+    hash[7] += h;
+  }
+
+#ifdef MESSAGEDIGEST_X86
+  /**
+   * @brief Four rounds with the Intel SHA extensions,
+   * msg holds the next four schedule words in native order
+   */
+  MESSAGEDIGEST_TARGET("sha,sse4.1")
+  inline void roundsSHANI(__m128i& abef, __m128i& cdgh, __m128i msg, const uint32_t* k)
+  {
+    msg  = _mm_add_epi32(msg, _mm_loadu_si128((const __m128i*) k));
+    cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+    msg  = _mm_shuffle_epi32(msg, 0x0E);
+    abef = _mm_sha256rnds2_epu32(abef, cdgh, msg);
+  }
+
+  /**
+   * @brief Extend the message schedule by four words,
+   * w0..w3 are the previous sixteen words, oldest first
+   */
+  MESSAGEDIGEST_TARGET("sha,sse4.1")
+  inline __m128i scheduleSHANI(__m128i w0, __m128i w1, __m128i w2, __m128i w3)
+  {
+    __m128i x = _mm_sha256msg1_epu32(w0, w1);
+    x = _mm_add_epi32(x, _mm_alignr_epi8(w3, w2, 4));
+    return _mm_sha256msg2_epu32(x, w3);
+  }
+
+  /// process nBlocks consecutive 64 byte blocks with the Intel SHA extensions
+  MESSAGEDIGEST_TARGET("sha,sse4.1")
+  void processBlocksSHANI(uint32_t* hash, const uint8_t* data, size_t nBlocks)
+  {
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // the rounds instructions want the state as ABEF and CDGH
+    __m128i tmp  = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &hash[0]), 0xB1); // CDAB
+    __m128i cdgh = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &hash[4]), 0x1B); // EFGH
+    __m128i abef = _mm_alignr_epi8(tmp, cdgh, 8);
+    cdgh = _mm_blend_epi16(cdgh, tmp, 0xF0);
+
+    while (nBlocks--)
+    {
+      const __m128i abefSave = abef;
+      const __m128i cdghSave = cdgh;
+
+      // convert to big endian
+      __m128i w0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (data +  0)), byteSwap);
+      __m128i w1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (data + 16)), byteSwap);
+      __m128i w2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (data + 32)), byteSwap);
+      __m128i w3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (data + 48)), byteSwap);
+
+      roundsSHANI(abef, cdgh, w0, K +  0);
+      roundsSHANI(abef, cdgh, w1, K +  4);
+      roundsSHANI(abef, cdgh, w2, K +  8);
+      roundsSHANI(abef, cdgh, w3, K + 12);
+
+      for (int i = 16; i < 64; i += 16)
+      {
+        w0 = scheduleSHANI(w0, w1, w2, w3); roundsSHANI(abef, cdgh, w0, K + i     );
+        w1 = scheduleSHANI(w1, w2, w3, w0); roundsSHANI(abef, cdgh, w1, K + i +  4);
+        w2 = scheduleSHANI(w2, w3, w0, w1); roundsSHANI(abef, cdgh, w2, K + i +  8);
+        w3 = scheduleSHANI(w3, w0, w1, w2); roundsSHANI(abef, cdgh, w3, K + i + 12);
+      }
+
+      abef = _mm_add_epi32(abef, abefSave);
+      cdgh = _mm_add_epi32(cdgh, cdghSave);
+      data += 64;
+    }
+
+    // back to ABCD and EFGH
+    tmp  = _mm_shuffle_epi32(abef, 0x1B); // FEBA
+    cdgh = _mm_shuffle_epi32(cdgh, 0xB1); // DCHG
+    _mm_storeu_si128((__m128i*) &hash[0], _mm_blend_epi16(tmp, cdgh, 0xF0));
+    _mm_storeu_si128((__m128i*) &hash[4], _mm_alignr_epi8(cdgh, tmp, 8));
+  }
+
+  // multi-buffer kernels: hash holds eight rows with one word per lane,
+  // blocks points to the next 64 bytes of every lane
+
+  template<int N>
+  MESSAGEDIGEST_TARGET("avx2")
+  inline __m256i rotateRightAVX2(__m256i a)
+  {
+    return _mm256_or_si256(_mm256_srli_epi32(a, N), _mm256_slli_epi32(a, 32 - N));
+  }
+
+  MESSAGEDIGEST_TARGET("avx2")
+  inline __m256i f1AVX2(__m256i e, __m256i f, __m256i g)
+  {
+    __m256i term1 = _mm256_xor_si256(_mm256_xor_si256(rotateRightAVX2<6>(e), rotateRightAVX2<11>(e)), rotateRightAVX2<25>(e));
+    __m256i term2 = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+    return _mm256_add_epi32(term1, term2);
+  }
+
+  MESSAGEDIGEST_TARGET("avx2")
+  inline __m256i f2AVX2(__m256i a, __m256i b, __m256i c)
+  {
+    __m256i term1 = _mm256_xor_si256(_mm256_xor_si256(rotateRightAVX2<2>(a), rotateRightAVX2<13>(a)), rotateRightAVX2<22>(a));
+    __m256i term2 = _mm256_or_si256(_mm256_and_si256(_mm256_or_si256(a, b), c), _mm256_and_si256(a, b));
+    return _mm256_add_epi32(term1, term2);
+  }
+
+  MESSAGEDIGEST_TARGET("avx2")
+  inline __m256i f3AVX2(__m256i a)
+  {
+    return _mm256_xor_si256(_mm256_xor_si256(rotateRightAVX2<7>(a), rotateRightAVX2<18>(a)), _mm256_srli_epi32(a, 3));
+  }
+
+  MESSAGEDIGEST_TARGET("avx2")
+  inline __m256i f4AVX2(__m256i a)
+  {
+    return _mm256_xor_si256(_mm256_xor_si256(rotateRightAVX2<17>(a), rotateRightAVX2<19>(a)), _mm256_srli_epi32(a, 10));
+  }
+
+  /// process one block of each of 8 messages
+  MESSAGEDIGEST_TARGET("avx2")
+  void processBlocksAVX2(uint32_t* hash, const uint8_t* const* blocks)
+  {
+    const __m256i byteSwap = _mm256_setr_epi8(3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12,
+                                              3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12);
+
+    // transpose to one register per message word, converted to big endian
+    __m256i words[16];
+    for (int i = 0; i < 16; i++)
+    {
+      uint32_t column[8];
+      for (int lane = 0; lane < 8; lane++)
+        std::memcpy(&column[lane], blocks[lane] + 4*i, 4);
+      words[i] = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*) column), byteSwap);
+    }
+
+    __m256i* state = (__m256i*) hash;
+    __m256i a = _mm256_loadu_si256(state + 0);
+    __m256i b = _mm256_loadu_si256(state + 1);
+    __m256i c = _mm256_loadu_si256(state + 2);
+    __m256i d = _mm256_loadu_si256(state + 3);
+    __m256i e = _mm256_loadu_si256(state + 4);
+    __m256i f = _mm256_loadu_si256(state + 5);
+    __m256i g = _mm256_loadu_si256(state + 6);
+    __m256i h = _mm256_loadu_si256(state + 7);
+
+    for (int i = 0; i < 64; i++)
+    {
+      // extend the message schedule in place
+      __m256i& w = words[i & 15];
+      if (i >= 16)
+        w = _mm256_add_epi32(_mm256_add_epi32(w, f3AVX2(words[(i + 1) & 15])),
+                             _mm256_add_epi32(words[(i + 9) & 15], f4AVX2(words[(i + 14) & 15])));
+
+      __m256i x = _mm256_add_epi32(_mm256_add_epi32(h, f1AVX2(e,f,g)),
+                                   _mm256_add_epi32(_mm256_set1_epi32((int) K[i]), w));
+      __m256i y = f2AVX2(a,b,c);
+      h = g; g = f; f = e; e = _mm256_add_epi32(d, x);
+      d = c; c = b; b = a; a = _mm256_add_epi32(x, y);
+    }
+
+    // update hash
+    _mm256_storeu_si256(state + 0, _mm256_add_epi32(_mm256_loadu_si256(state + 0), a));
+    _mm256_storeu_si256(state + 1, _mm256_add_epi32(_mm256_loadu_si256(state + 1), b));
+    _mm256_storeu_si256(state + 2, _mm256_add_epi32(_mm256_loadu_si256(state + 2), c));
+    _mm256_storeu_si256(state + 3, _mm256_add_epi32(_mm256_loadu_si256(state + 3), d));
+    _mm256_storeu_si256(state + 4, _mm256_add_epi32(_mm256_loadu_si256(state + 4), e));
+    _mm256_storeu_si256(state + 5, _mm256_add_epi32(_mm256_loadu_si256(state + 5), f));
+    _mm256_storeu_si256(state + 6, _mm256_add_epi32(_mm256_loadu_si256(state + 6), g));
+    _mm256_storeu_si256(state + 7, _mm256_add_epi32(_mm256_loadu_si256(state + 7), h));
+  }
+
+  // ternary logic: three way xor, choose and majority
+  static constexpr int XOR3 = 0x96;
+  static constexpr int CHOOSE = 0xCA;
+  static constexpr int MAJORITY = 0xE8;
+
+  MESSAGEDIGEST_TARGET("avx512f")
+  inline __m512i f1AVX512(__m512i e, __m512i f, __m512i g)
+  {
+    __m512i term1 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(e, 6), _mm512_ror_epi32(e, 11), _mm512_ror_epi32(e, 25), XOR3);
+    __m512i term2 = _mm512_ternarylogic_epi32(e, f, g, CHOOSE);
+    return _mm512_add_epi32(term1, term2);
+  }
+
+  MESSAGEDIGEST_TARGET("avx512f")
+  inline __m512i f2AVX512(__m512i a, __m512i b, __m512i c)
+  {
+    __m512i term1 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(a, 2), _mm512_ror_epi32(a, 13), _mm512_ror_epi32(a, 22), XOR3);
+    __m512i term2 = _mm512_ternarylogic_epi32(a, b, c, MAJORITY);
+    return _mm512_add_epi32(term1, term2);
+  }
+
+  MESSAGEDIGEST_TARGET("avx512f")
+  inline __m512i f3AVX512(__m512i a)
+  {
+    return _mm512_ternarylogic_epi32(_mm512_ror_epi32(a, 7), _mm512_ror_epi32(a, 18), _mm512_srli_epi32(a, 3), XOR3);
+  }
+
+  MESSAGEDIGEST_TARGET("avx512f")
+  inline __m512i f4AVX512(__m512i a)
+  {
+    return _mm512_ternarylogic_epi32(_mm512_ror_epi32(a, 17), _mm512_ror_epi32(a, 19), _mm512_srli_epi32(a, 10), XOR3);
+  }
+
+  /// process one block of each of 16 messages
+  MESSAGEDIGEST_TARGET("avx512f")
+  void processBlocksAVX512(uint32_t* hash, const uint8_t* const* blocks)
+  {
+    // transpose to one register per message word, converted to big endian
+    __m512i words[16];
+    for (int i = 0; i < 16; i++)
+    {
+      uint32_t column[16];
+      for (int lane = 0; lane < 16; lane++)
+      {
+        uint32_t word;
+        std::memcpy(&word, blocks[lane] + 4*i, 4);
+        column[lane] = swap32(word);
+      }
+      words[i] = _mm512_loadu_si512(column);
+    }
+
+    uint32_t* state = hash;
+    __m512i a = _mm512_loadu_si512(state +  0);
+    __m512i b = _mm512_loadu_si512(state + 16);
+    __m512i c = _mm512_loadu_si512(state + 32);
+    __m512i d = _mm512_loadu_si512(state + 48);
+    __m512i e = _mm512_loadu_si512(state + 64);
+    __m512i f = _mm512_loadu_si512(state + 80);
+    __m512i g = _mm512_loadu_si512(state + 96);
+    __m512i h = _mm512_loadu_si512(state + 112);
+
+    for (int i = 0; i < 64; i++)
+    {
+      // extend the message schedule in place
+      __m512i& w = words[i & 15];
+      if (i >= 16)
+        w = _mm512_add_epi32(_mm512_add_epi32(w, f3AVX512(words[(i + 1) & 15])),
+                             _mm512_add_epi32(words[(i + 9) & 15], f4AVX512(words[(i + 14) & 15])));
+
+      __m512i x = _mm512_add_epi32(_mm512_add_epi32(h, f1AVX512(e,f,g)),
+                                   _mm512_add_epi32(_mm512_set1_epi32((int) K[i]), w));
+      __m512i y = f2AVX512(a,b,c);
+      h = g; g = f; f = e; e = _mm512_add_epi32(d, x);
+      d = c; c = b; b = a; a = _mm512_add_epi32(x, y);
+    }
+
+    // update hash
+    _mm512_storeu_si512(state +   0, _mm512_add_epi32(_mm512_loadu_si512(state +   0), a));
+    _mm512_storeu_si512(state +  16, _mm512_add_epi32(_mm512_loadu_si512(state +  16), b));
+    _mm512_storeu_si512(state +  32, _mm512_add_epi32(_mm512_loadu_si512(state +  32), c));
+    _mm512_storeu_si512(state +  48, _mm512_add_epi32(_mm512_loadu_si512(state +  48), d));
+    _mm512_storeu_si512(state +  64, _mm512_add_epi32(_mm512_loadu_si512(state +  64), e));
+    _mm512_storeu_si512(state +  80, _mm512_add_epi32(_mm512_loadu_si512(state +  80), f));
+    _mm512_storeu_si512(state +  96, _mm512_add_epi32(_mm512_loadu_si512(state +  96), g));
+    _mm512_storeu_si512(state + 112, _mm512_add_epi32(_mm512_loadu_si512(state + 112), h));
+  }
+#endif
 }
 
 MessageDigestSHA256::MessageDigestSHA256()
 {
+  _kernel = isSupported(Kernel::SHANI) ? Kernel::SHANI : Kernel::Generic;
+
+  // a single SHA-NI stream outruns eight AVX2 lanes
+  if (isSupported(BatchKernel::AVX512))
+    _batchKernel = BatchKernel::AVX512;
+  else if (isSupported(BatchKernel::AVX2) && _kernel != Kernel::SHANI)
+    _batchKernel = BatchKernel::AVX2;
+  else
+    _batchKernel = BatchKernel::Serial;
+
   reset();
 }
 
@@ -98,16 +543,207 @@ void MessageDigestSHA256::reset()
 
 }
 
+std::vector<uint8_t> MessageDigestSHA256::exportState() const
+{
+  MessageDigestStateWriter writer(getAlgorithm());
+  writer.write(_numBytes);
+  for (int i = 0; i < HASH_SIZE; i++)
+    writer.write(_hash[i]);
+  writer.write((uint8_t) _bufferSize);
+  writer.write(_buffer, _bufferSize);
+  return writer.state();
+}
+
+bool MessageDigestSHA256::importState(const uint8_t *state, size_t size)
+{
+  MessageDigestStateReader reader(state, size);
+  uint64_t numBytes;
+  uint32_t hash[HASH_SIZE];
+  uint8_t  bufferSize;
+  uint8_t  buffer[BLOCK_SIZE];
+
+  if (!reader.readHeader(getAlgorithm()) || !reader.read(numBytes) || numBytes % BLOCK_SIZE != 0)
+    return false;
+  for (int i = 0; i < HASH_SIZE; i++)
+    if (!reader.read(hash[i]))
+      return false;
+  if (!reader.read(bufferSize) || bufferSize >= BLOCK_SIZE || !reader.read(buffer, bufferSize) || !reader.atEnd())
+    return false;
+
+  _numBytes   = numBytes;
+  _bufferSize = bufferSize;
+  for (int i = 0; i < HASH_SIZE; i++)
+    _hash[i] = hash[i];
+  for (int i = 0; i < bufferSize; i++)
+    _buffer[i] = buffer[i];
+  return true;
+}
+
 std::unique_ptr<MessageDigestImpl> MessageDigestSHA256::create()
 {
   return std::unique_ptr<MessageDigestImpl>(new MessageDigestSHA256());
 }
 
+std::unique_ptr<MessageDigestImpl> MessageDigestSHA256::clone() const
+{
+  return cloneDigest(*this);
+}
+
+bool MessageDigestSHA256::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
+
+bool MessageDigestSHA256::setKernel(Kernel kernel)
+{
+  if (!isSupported(kernel))
+    return false;
+
+  _kernel = kernel;
+  return true;
+}
+
+MessageDigestSHA256::Kernel MessageDigestSHA256::getKernel() const
+{
+  return _kernel;
+}
+
+bool MessageDigestSHA256::setBatchKernel(BatchKernel kernel)
+{
+  if (!isSupported(kernel))
+    return false;
+
+  _batchKernel = kernel;
+  return true;
+}
+
+MessageDigestSHA256::BatchKernel MessageDigestSHA256::getBatchKernel() const
+{
+  return _batchKernel;
+}
+
+bool MessageDigestSHA256::isSupported(Kernel kernel)
+{
+  switch (kernel)
+  {
+  case Kernel::SHANI:
+#ifdef MESSAGEDIGEST_X86
+    return CpuFeatures::hasSHA() && CpuFeatures::hasSSE41();
+#else
+    return false;
+#endif
+  default:
+    return true;
+  }
+}
+
+bool MessageDigestSHA256::isSupported(BatchKernel kernel)
+{
+  switch (kernel)
+  {
+#ifdef MESSAGEDIGEST_X86
+  case BatchKernel::AVX2:
+    return CpuFeatures::hasAVX2();
+  case BatchKernel::AVX512:
+    return CpuFeatures::hasAVX512F();
+#else
+  case BatchKernel::AVX2:
+  case BatchKernel::AVX512:
+    return false;
+#endif
+  default:
+    return true;
+  }
+}
+
+void MessageDigestSHA256::digestBatch(const MessageDigestInput *inputs, size_t numInputs, uint8_t *digests)
+{
+  switch (_batchKernel)
+  {
+#ifdef MESSAGEDIGEST_X86
+  case BatchKernel::AVX2:
+    digestBatchMultiBuffer<8>(inputs, numInputs, digests, processBlocksAVX2);
+    break;
+  case BatchKernel::AVX512:
+    digestBatchMultiBuffer<16>(inputs, numInputs, digests, processBlocksAVX512);
+    break;
+#endif
+  default:
+    digestBatchSerial(inputs, numInputs, digests);
+  }
+}
+
+template<size_t LANES>
+void MessageDigestSHA256::digestBatchMultiBuffer(const MessageDigestInput *inputs, size_t numInputs, uint8_t *digests,
+                                                 ProcessBlocksFunc processBlocks)
+{
+  // initial hash of this algorithm
+  reset();
+
+  // structure of arrays, row i holds _hash[i] of all lanes
+  uint32_t state[HASH_SIZE*LANES];
+  size_t digestSize = getDigestSize();
+
+  MessageDigestMultiBuffer<LANES,BLOCK_SIZE,8,true> engine(inputs, numInputs);
+  engine.run(
+        [&](size_t lane)
+        {
+          for (int i = 0; i < HASH_SIZE; i++)
+            state[i*LANES + lane] = _hash[i];
+        },
+        [&](const uint8_t* const* blocks)
+        {
+          processBlocks(state, blocks);
+        },
+        [&](size_t lane, size_t message)
+        {
+          uint32_t hash[HASH_SIZE];
+          for (int i = 0; i < HASH_SIZE; i++)
+            hash[i] = state[i*LANES + lane];
+          hashToBytes(hash, digests + message * digestSize, digestSize);
+        });
+}
+
+void MessageDigestSHA256::digestBatchSerial(const MessageDigestInput *inputs, size_t numInputs, uint8_t *digests)
+{
+  // initial hash of this algorithm
+  reset();
+  uint32_t initialHash[HASH_SIZE];
+  for (int i = 0; i < HASH_SIZE; i++)
+    initialHash[i] = _hash[i];
+
+  size_t digestSize = getDigestSize();
+  uint8_t padded[2*BLOCK_SIZE];
+  for (size_t message = 0; message < numInputs; message++)
+  {
+    const uint8_t* data = (const uint8_t*) inputs[message].first;
+    size_t numBytes = inputs[message].second;
+    size_t fullBlocks = numBytes / BLOCK_SIZE;
+
+    for (int i = 0; i < HASH_SIZE; i++)
+      _hash[i] = initialHash[i];
+    if (fullBlocks > 0)
+      processBlocks(data, fullBlocks);
+
+    size_t numPadded = MessageDigestMultiBuffer<1,BLOCK_SIZE,8,true>::pad(
+          padded, data + fullBlocks * BLOCK_SIZE, numBytes % BLOCK_SIZE, numBytes);
+    processBlocks(padded, numPadded);
+
+    hashToBytes(_hash, digests + message * digestSize, digestSize);
+  }
+
+  reset();
+}
+
 std::string MessageDigestSHA256::digest()
 {
-  // convert hash to string
-  static const char dec2hex[16+1] = "0123456789abcdef";
+  uint8_t buffer[DIGEST_SIZE];
+  digestBinary(buffer);
+  return MessageDigestEncoding::toHex(buffer, getDigestSize());
+}
 
+void MessageDigestSHA256::digestBinary(uint8_t *buffer)
+{
   // save old hash if buffer is partially filled
   uint32_t oldHash[HASH_SIZE];
   for (int i = 0; i < HASH_SIZE; i++)
@@ -116,28 +752,34 @@ std::string MessageDigestSHA256::digest()
   // process remaining bytes
   processBuffer();
 
-  // create hash string
-  char hashBuffer[HASH_SIZE*8+1];
-  size_t offset = 0;
+  hashToBytes(_hash, buffer, getDigestSize());
+
+  // restore old hash
   for (int i = 0; i < HASH_SIZE; i++)
-  {
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 28) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 24) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 20) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 16) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 12) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >>  8) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >>  4) & 15];
-    hashBuffer[offset++] = dec2hex[ _hash[i]        & 15];
-
-    // restore old hash
     _hash[i] = oldHash[i];
-  }
-  // zero-terminated string
-  hashBuffer[offset] = 0;
+}
 
-  // convert to std::string
-  return hashBuffer;
+size_t MessageDigestSHA256::getDigestSize() const
+{
+  return DIGEST_SIZE;
+}
+
+size_t MessageDigestSHA256::getBlockSize() const
+{
+  return BLOCK_SIZE;
+}
+
+void MessageDigestSHA256::hashToBytes(const uint32_t *hash, uint8_t *buffer, size_t digestSize)
+{
+  // truncated variants keep the leading words
+  size_t numWords = digestSize / 4;
+  for (size_t i = 0; i < numWords; i++)
+  {
+    *buffer++ = (hash[i] >> 24) & 0xFF;
+    *buffer++ = (hash[i] >> 16) & 0xFF;
+    *buffer++ = (hash[i] >>  8) & 0xFF;
+    *buffer++ =  hash[i]        & 0xFF;
+  }
 }
 
 void MessageDigestSHA256::update(const void *data, const size_t offset, const size_t len)
@@ -166,13 +808,14 @@ void MessageDigestSHA256::update(const void *data, const size_t offset, const si
   if (numBytes == 0)
     return;
 
-  // process full blocks
-  while (numBytes >= BLOCK_SIZE)
+  // process full blocks in one run
+  if (numBytes >= BLOCK_SIZE)
   {
-    processBlock(current);
-    current    += BLOCK_SIZE;
-    _numBytes += BLOCK_SIZE;
-    numBytes   -= BLOCK_SIZE;
+    size_t nBlocks = numBytes / BLOCK_SIZE;
+    processBlocks(current, nBlocks);
+    current   += nBlocks * BLOCK_SIZE;
+    _numBytes += nBlocks * BLOCK_SIZE;
+    numBytes  -= nBlocks * BLOCK_SIZE;
   }
 
   // keep remaining bytes in buffer
@@ -183,168 +826,24 @@ void MessageDigestSHA256::update(const void *data, const size_t offset, const si
   }
 }
 
-void MessageDigestSHA256::processBlock(const void *data)
+void MessageDigestSHA256::processBlocks(const void *data, size_t nBlocks)
 {
-  /* Constants defined in RFC 6234 section 5.1   */
-  static constexpr uint32_t K[] =    {
-    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
-    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
-    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
-    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
-    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
-    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
-    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
-    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
-    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
-  };
-
-  // get last hash
-  uint32_t a = _hash[0];
-  uint32_t b = _hash[1];
-  uint32_t c = _hash[2];
-  uint32_t d = _hash[3];
-  uint32_t e = _hash[4];
-  uint32_t f = _hash[5];
-  uint32_t g = _hash[6];
-  uint32_t h = _hash[7];
-
-  // data represented as 16x 32-bit words
-  const uint32_t* input = (uint32_t*) data;
-
-  // convert to big endian
-  uint32_t words[64];
-  int i;
-  for (i = 0; i < 16; i++)
-    {
-#if defined(__BYTE_ORDER) && (__BYTE_ORDER != 0) && (__BYTE_ORDER == __BIG_ENDIAN)
-      words[i] = input[i];
-#else
-      words[i] = swap32(input[i]);
+#ifdef MESSAGEDIGEST_X86
+  if (_kernel == Kernel::SHANI)
+  {
+    processBlocksSHANI(_hash, (const uint8_t*) data, nBlocks);
+    return;
+  }
 #endif
-    }
 
-  uint32_t x,y; // temporaries
-
-  // first round
-  x = h + f1(e,f,g) + K[0] + words[ 0]; y = f2(a,b,c); d += x; h = x + y;
-  x = g + f1(d,e,f) + K[1] + words[ 1]; y = f2(h,a,b); c += x; g = x + y;
-  x = f + f1(c,d,e) + K[2] + words[ 2]; y = f2(g,h,a); b += x; f = x + y;
-  x = e + f1(b,c,d) + K[3] + words[ 3]; y = f2(f,g,h); a += x; e = x + y;
-  x = d + f1(a,b,c) + K[4] + words[ 4]; y = f2(e,f,g); h += x; d = x + y;
-  x = c + f1(h,a,b) + K[5] + words[ 5]; y = f2(d,e,f); g += x; c = x + y;
-  x = b + f1(g,h,a) + K[6] + words[ 6]; y = f2(c,d,e); f += x; b = x + y;
-  x = a + f1(f,g,h) + K[7] + words[ 7]; y = f2(b,c,d); e += x; a = x + y;
-
-  // secound round
-  x = h + f1(e,f,g) + K[8] + words[ 8]; y = f2(a,b,c); d += x; h = x + y;
-  x = g + f1(d,e,f) + K[9] + words[ 9]; y = f2(h,a,b); c += x; g = x + y;
-  x = f + f1(c,d,e) + K[10] + words[10]; y = f2(g,h,a); b += x; f = x + y;
-  x = e + f1(b,c,d) + K[11] + words[11]; y = f2(f,g,h); a += x; e = x + y;
-  x = d + f1(a,b,c) + K[12] + words[12]; y = f2(e,f,g); h += x; d = x + y;
-  x = c + f1(h,a,b) + K[13] + words[13]; y = f2(d,e,f); g += x; c = x + y;
-  x = b + f1(g,h,a) + K[14] + words[14]; y = f2(c,d,e); f += x; b = x + y;
-  x = a + f1(f,g,h) + K[15] + words[15]; y = f2(b,c,d); e += x; a = x + y;
-
-  // extend to 24 words
-  for (; i < 24; i++)
-    words[i] = words[i-16] + f3(words[i-15]) + words[i-7] + f4(words[i- 2]);
-
-  // third round
-  x = h + f1(e,f,g) + K[16] + words[16]; y = f2(a,b,c); d += x; h = x + y;
-  x = g + f1(d,e,f) + K[17] + words[17]; y = f2(h,a,b); c += x; g = x + y;
-  x = f + f1(c,d,e) + K[18] + words[18]; y = f2(g,h,a); b += x; f = x + y;
-  x = e + f1(b,c,d) + K[19] + words[19]; y = f2(f,g,h); a += x; e = x + y;
-  x = d + f1(a,b,c) + K[20] + words[20]; y = f2(e,f,g); h += x; d = x + y;
-  x = c + f1(h,a,b) + K[21] + words[21]; y = f2(d,e,f); g += x; c = x + y;
-  x = b + f1(g,h,a) + K[22] + words[22]; y = f2(c,d,e); f += x; b = x + y;
-  x = a + f1(f,g,h) + K[23] + words[23]; y = f2(b,c,d); e += x; a = x + y;
-
-  // extend to 32 words
-  for (; i < 32; i++)
-    words[i] = words[i-16] + f3(words[i-15]) + words[i-7] + f4(words[i- 2]);
-
-  // fourth round
-  x = h + f1(e,f,g) + K[24] + words[24]; y = f2(a,b,c); d += x; h = x + y;
-  x = g + f1(d,e,f) + K[25] + words[25]; y = f2(h,a,b); c += x; g = x + y;
-  x = f + f1(c,d,e) + K[26] + words[26]; y = f2(g,h,a); b += x; f = x + y;
-  x = e + f1(b,c,d) + K[27] + words[27]; y = f2(f,g,h); a += x; e = x + y;
-  x = d + f1(a,b,c) + K[28] + words[28]; y = f2(e,f,g); h += x; d = x + y;
-  x = c + f1(h,a,b) + K[29] + words[29]; y = f2(d,e,f); g += x; c = x + y;
-  x = b + f1(g,h,a) + K[30] + words[30]; y = f2(c,d,e); f += x; b = x + y;
-  x = a + f1(f,g,h) + K[31] + words[31]; y = f2(b,c,d); e += x; a = x + y;
-
-  // extend to 40 words
-  for (; i < 40; i++)
-    words[i] = words[i-16] + f3(words[i-15]) + words[i-7] + f4(words[i- 2]);
-
-  // fifth round
-  x = h + f1(e,f,g) + K[32] + words[32]; y = f2(a,b,c); d += x; h = x + y;
-  x = g + f1(d,e,f) + K[33] + words[33]; y = f2(h,a,b); c += x; g = x + y;
-  x = f + f1(c,d,e) + K[34] + words[34]; y = f2(g,h,a); b += x; f = x + y;
-  x = e + f1(b,c,d) + K[35] + words[35]; y = f2(f,g,h); a += x; e = x + y;
-  x = d + f1(a,b,c) + K[36] + words[36]; y = f2(e,f,g); h += x; d = x + y;
-  x = c + f1(h,a,b) + K[37] + words[37]; y = f2(d,e,f); g += x; c = x + y;
-  x = b + f1(g,h,a) + K[38] + words[38]; y = f2(c,d,e); f += x; b = x + y;
-  x = a + f1(f,g,h) + K[39] + words[39]; y = f2(b,c,d); e += x; a = x + y;
-
-  // extend to 48 words
-  for (; i < 48; i++)
-    words[i] = words[i-16] + f3(words[i-15]) + words[i-7] + f4(words[i- 2]);
-
-  // sixth round
-  x = h + f1(e,f,g) + K[40] + words[40]; y = f2(a,b,c); d += x; h = x + y;
-  x = g + f1(d,e,f) + K[41] + words[41]; y = f2(h,a,b); c += x; g = x + y;
-  x = f + f1(c,d,e) + K[42] + words[42]; y = f2(g,h,a); b += x; f = x + y;
-  x = e + f1(b,c,d) + K[43] + words[43]; y = f2(f,g,h); a += x; e = x + y;
-  x = d + f1(a,b,c) + K[44] + words[44]; y = f2(e,f,g); h += x; d = x + y;
-  x = c + f1(h,a,b) + K[45] + words[45]; y = f2(d,e,f); g += x; c = x + y;
-  x = b + f1(g,h,a) + K[46] + words[46]; y = f2(c,d,e); f += x; b = x + y;
-  x = a + f1(f,g,h) + K[47] + words[47]; y = f2(b,c,d); e += x; a = x + y;
-
-  // extend to 56 words
-  for (; i < 56; i++)
-    words[i] = words[i-16] + f3(words[i-15]) + words[i-7] + f4(words[i- 2]);
-
-  // seventh round
-  x = h + f1(e,f,g) + K[48] + words[48]; y = f2(a,b,c); d += x; h = x + y;
-  x = g + f1(d,e,f) + K[49] + words[49]; y = f2(h,a,b); c += x; g = x + y;
-  x = f + f1(c,d,e) + K[50] + words[50]; y = f2(g,h,a); b += x; f = x + y;
-  x = e + f1(b,c,d) + K[51] + words[51]; y = f2(f,g,h); a += x; e = x + y;
-  x = d + f1(a,b,c) + K[52] + words[52]; y = f2(e,f,g); h += x; d = x + y;
-  x = c + f1(h,a,b) + K[53] + words[53]; y = f2(d,e,f); g += x; c = x + y;
-  x = b + f1(g,h,a) + K[54] + words[54]; y = f2(c,d,e); f += x; b = x + y;
-  x = a + f1(f,g,h) + K[55] + words[55]; y = f2(b,c,d); e += x; a = x + y;
-
-  // extend to 64 words
-  for (; i < 64; i++)
-    words[i] = words[i-16] + f3(words[i-15]) + words[i-7] + f4(words[i- 2]);
-
-  // eigth round
-  x = h + f1(e,f,g) + K[56] + words[56]; y = f2(a,b,c); d += x; h = x + y;
-  x = g + f1(d,e,f) + K[57] + words[57]; y = f2(h,a,b); c += x; g = x + y;
-  x = f + f1(c,d,e) + K[58] + words[58]; y = f2(g,h,a); b += x; f = x + y;
-  x = e + f1(b,c,d) + K[59] + words[59]; y = f2(f,g,h); a += x; e = x + y;
-  x = d + f1(a,b,c) + K[60] + words[60]; y = f2(e,f,g); h += x; d = x + y;
-  x = c + f1(h,a,b) + K[61] + words[61]; y = f2(d,e,f); g += x; c = x + y;
-  x = b + f1(g,h,a) + K[62] + words[62]; y = f2(c,d,e); f += x; b = x + y;
-  x = a + f1(f,g,h) + K[63] + words[63]; y = f2(b,c,d); e += x; a = x + y;
-
-  // update hash
-  _hash[0] += a;
-  _hash[1] += b;
-  _hash[2] += c;
-  _hash[3] += d;
-  _hash[4] += e;
-  _hash[5] += f;
-  _hash[6] += g;
-  _hash[7] += h;
+  const uint8_t* current = (const uint8_t*) data;
+  for (; nBlocks > 0; nBlocks--, current += BLOCK_SIZE)
+    processBlockGeneric(_hash, current);
+}
+
+void MessageDigestSHA256::processBlock(const void *data)
+{
+  processBlocks(data, 1);
 }
 
 /// process final block, less than 64 bytes
@@ -0,0 +1,326 @@
+/**
+ * @file MessageDigestSHA256Tree.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/MessageDigestSHA256Tree.hpp"
+#include "MessageDigest/MessageDigestSHA256.hpp"
+#include "MessageDigest/MessageDigest.hpp"
+#include "MessageDigest/MessageDigestEncoding.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+static MessageDigestImplRegistrar<MessageDigestSHA256Tree> registrar("SHA256-TREE");
+
+namespace
+{
+  const uint8_t LeafPrefix = 0x00;
+  const uint8_t NodePrefix = 0x01;
+
+  void hashLeaf(MessageDigestSHA256& sha256, const uint8_t* data, size_t numBytes, uint8_t* hash)
+  {
+    sha256.reset();
+    sha256.update(&LeafPrefix, 0, 1);
+    sha256.update(data, 0, numBytes);
+    sha256.digestBinary(hash);
+  }
+
+  void hashNode(const uint8_t* left, const uint8_t* right, uint8_t* hash)
+  {
+    MessageDigestSHA256 sha256;
+    sha256.update(&NodePrefix, 0, 1);
+    sha256.update(left, 0, MessageDigestSHA256Tree::DIGEST_SIZE);
+    sha256.update(right, 0, MessageDigestSHA256Tree::DIGEST_SIZE);
+    sha256.digestBinary(hash);
+  }
+
+  /// leaves first, first + stride, ... of numLeaves full leaves
+  void hashEvery(const uint8_t* data, size_t numLeaves, uint8_t* hashes, size_t first, size_t stride)
+  {
+    MessageDigestSHA256 sha256;
+    for (size_t leaf = first; leaf < numLeaves; leaf += stride)
+      hashLeaf(sha256, data + leaf * MessageDigestSHA256Tree::LEAF_SIZE, MessageDigestSHA256Tree::LEAF_SIZE,
+               hashes + leaf * MessageDigestSHA256Tree::DIGEST_SIZE);
+  }
+}
+
+/**
+ * Threads waiting for batches of leaves. Worker i takes every (size() + 1)-th
+ * leaf from leaf i + 1 on, the calling thread the ones from leaf 0 on.
+ */
+class MessageDigestSHA256Tree::LeafWorkers {
+public:
+  explicit LeafWorkers(unsigned numWorkers)
+  {
+    for (unsigned i = 0; i < numWorkers; i++)
+      _threads.push_back(std::thread(&LeafWorkers::work, this, i + 1));
+  }
+
+  ~LeafWorkers()
+  {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stop = true;
+    }
+    _start.notify_all();
+    for (auto& thread : _threads)
+      thread.join();
+  }
+
+  unsigned size() const
+  {
+    return (unsigned) _threads.size();
+  }
+
+  void hash(const uint8_t* data, size_t numLeaves, uint8_t* hashes)
+  {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _data      = data;
+      _numLeaves = numLeaves;
+      _hashes    = hashes;
+      _busy      = size();
+      _batch++;
+    }
+    _start.notify_all();
+
+    hashEvery(data, numLeaves, hashes, 0, size() + 1);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _finished.wait(lock, [this]() { return _busy == 0; });
+  }
+
+private:
+  void work(unsigned first)
+  {
+    uint64_t batch = 0;
+    for (;;)
+    {
+      const uint8_t* data;
+      size_t numLeaves;
+      uint8_t* hashes;
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _start.wait(lock, [this, batch]() { return _stop || _batch != batch; });
+        if (_stop)
+          return;
+        batch     = _batch;
+        data      = _data;
+        numLeaves = _numLeaves;
+        hashes    = _hashes;
+      }
+
+      hashEvery(data, numLeaves, hashes, first, size() + 1);
+
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (--_busy == 0)
+        _finished.notify_one();
+    }
+  }
+
+  std::vector<std::thread> _threads;
+  std::mutex               _mutex;
+  std::condition_variable  _start;
+  std::condition_variable  _finished;
+  bool                     _stop = false;
+  /// counts the batches, a change wakes the workers
+  uint64_t                 _batch = 0;
+  /// workers still hashing the current batch
+  unsigned                 _busy = 0;
+  const uint8_t*           _data = nullptr;
+  size_t                   _numLeaves = 0;
+  uint8_t*                 _hashes = nullptr;
+};
+
+MessageDigestSHA256Tree::WorkerHandle::WorkerHandle() = default;
+MessageDigestSHA256Tree::WorkerHandle::WorkerHandle(const WorkerHandle&) {}
+MessageDigestSHA256Tree::WorkerHandle::~WorkerHandle() = default;
+
+MessageDigestSHA256Tree::WorkerHandle& MessageDigestSHA256Tree::WorkerHandle::operator=(const WorkerHandle&)
+{
+  return *this;
+}
+
+MessageDigestSHA256Tree::MessageDigestSHA256Tree()
+  : _numThreads(0)
+{
+  reset();
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestSHA256Tree::create()
+{
+  return std::unique_ptr<MessageDigestImpl>(new MessageDigestSHA256Tree());
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestSHA256Tree::clone() const
+{
+  return cloneDigest(*this);
+}
+
+bool MessageDigestSHA256Tree::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
+
+std::string MessageDigestSHA256Tree::getAlgorithm() const
+{
+  return "SHA256-TREE";
+}
+
+size_t MessageDigestSHA256Tree::getDigestSize() const
+{
+  return DIGEST_SIZE;
+}
+
+void MessageDigestSHA256Tree::reset()
+{
+  _pending.clear();
+  _stack.clear();
+  _numBytes = 0;
+}
+
+void MessageDigestSHA256Tree::setNumThreads(unsigned numThreads)
+{
+  _numThreads = numThreads;
+}
+
+unsigned MessageDigestSHA256Tree::getNumThreads() const
+{
+  return _numThreads;
+}
+
+unsigned MessageDigestSHA256Tree::threadCount() const
+{
+  if (_numThreads == 0)
+    return std::max(std::thread::hardware_concurrency(), 1u);
+  return _numThreads;
+}
+
+size_t MessageDigestSHA256Tree::batchSize() const
+{
+  return 2 * threadCount() * LEAF_SIZE;
+}
+
+void MessageDigestSHA256Tree::update(const void *data, const size_t offset, const size_t len)
+{
+  const uint8_t* current = (const uint8_t*) data + offset;
+  size_t numBytes = len;
+  size_t batch = batchSize();
+  // independent of the threads, setNumThreads() may change these between updates
+  const size_t pendingSize = PENDING_LEAVES * LEAF_SIZE;
+
+  _numBytes += numBytes;
+
+  // complete the pending leaves first
+  if (!_pending.empty())
+  {
+    size_t add = std::min(numBytes, pendingSize - _pending.size());
+    _pending.insert(_pending.end(), current, current + add);
+    current  += add;
+    numBytes -= add;
+
+    if (_pending.size() < pendingSize)
+      return;
+
+    hashLeaves(_pending.data(), pendingSize / LEAF_SIZE, _stack);
+    _pending.clear();
+  }
+
+  // whole batches without a copy
+  while (numBytes >= batch)
+  {
+    hashLeaves(current, batch / LEAF_SIZE, _stack);
+    current  += batch;
+    numBytes -= batch;
+  }
+
+  // the rest is shorter than a batch, but may exceed the pending leaves
+  size_t fullLeaves = numBytes / LEAF_SIZE;
+  if (numBytes >= pendingSize && fullLeaves > 0)
+  {
+    hashLeaves(current, fullLeaves, _stack);
+    current  += fullLeaves * LEAF_SIZE;
+    numBytes -= fullLeaves * LEAF_SIZE;
+  }
+
+  _pending.insert(_pending.end(), current, current + numBytes);
+}
+
+void MessageDigestSHA256Tree::hashLeaves(const uint8_t *data, size_t numLeaves, std::vector<Subtree> &stack) const
+{
+  std::vector<uint8_t> hashes(numLeaves * DIGEST_SIZE);
+
+  unsigned numWorkers = threadCount() - 1;
+  if (numLeaves < 2 || numWorkers == 0)
+    hashEvery(data, numLeaves, hashes.data(), 0, 1);
+  else
+  {
+    // started once, again only if setNumThreads() changed the count
+    if (!_workers.workers || _workers.workers->size() != numWorkers)
+    {
+      _workers.workers.reset();
+      _workers.workers.reset(new LeafWorkers(numWorkers));
+    }
+    _workers.workers->hash(data, numLeaves, hashes.data());
+  }
+
+  // merging is cheap and keeps the leaf order
+  for (size_t leaf = 0; leaf < numLeaves; leaf++)
+    pushLeaf(hashes.data() + leaf * DIGEST_SIZE, stack);
+}
+
+void MessageDigestSHA256Tree::pushLeaf(const uint8_t *hash, std::vector<Subtree> &stack)
+{
+  Subtree subtree;
+  std::memcpy(subtree.hash, hash, DIGEST_SIZE);
+  subtree.numLeaves = 1;
+
+  while (!stack.empty() && stack.back().numLeaves == subtree.numLeaves)
+  {
+    hashNode(stack.back().hash, subtree.hash, subtree.hash);
+    subtree.numLeaves *= 2;
+    stack.pop_back();
+  }
+  stack.push_back(subtree);
+}
+
+std::string MessageDigestSHA256Tree::digest()
+{
+  uint8_t buffer[DIGEST_SIZE];
+  digestBinary(buffer);
+  return MessageDigestEncoding::toHex(buffer, DIGEST_SIZE);
+}
+
+void MessageDigestSHA256Tree::digestBinary(uint8_t *buffer)
+{
+  // finish a copy, more data may follow
+  std::vector<Subtree> stack = _stack;
+
+  size_t fullLeaves = _pending.size() / LEAF_SIZE;
+  if (fullLeaves > 0)
+    hashLeaves(_pending.data(), fullLeaves, stack);
+
+  size_t tail = _pending.size() - fullLeaves * LEAF_SIZE;
+  if (tail > 0 || _numBytes == 0)
+  {
+    uint8_t hash[DIGEST_SIZE];
+    MessageDigestSHA256 sha256;
+    hashLeaf(sha256, _pending.data() + fullLeaves * LEAF_SIZE, tail, hash);
+    pushLeaf(hash, stack);
+  }
+
+  // the smaller subtrees on top form the right branches
+  uint8_t root[DIGEST_SIZE];
+  std::memcpy(root, stack.back().hash, DIGEST_SIZE);
+  for (size_t i = stack.size() - 1; i > 0; i--)
+    hashNode(stack[i - 1].hash, root, root);
+
+  std::memcpy(buffer, root, DIGEST_SIZE);
+}
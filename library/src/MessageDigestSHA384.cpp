@@ -0,0 +1,67 @@
+/**
+ * @file MessageDigestSHA384.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ *
+ * based on:
+ * sha256.h and sha256.cpp
+ * from hash-library by Stephan Brume
+ * (http://create.stephan-brumme.com/hash-library)
+ *
+ * Copyright (c) 2014 Stephan Brumme. All rights reserved.
+ * see http://create.stephan-brumme.com/disclaimer.html
+ *
+ */
+
+#include "MessageDigest/MessageDigestSHA384.hpp"
+#include "MessageDigest/MessageDigest.hpp"
+
+static MessageDigestImplRegistrar<MessageDigestSHA384> registrar("SHA384");
+
+MessageDigestSHA384::MessageDigestSHA384()
+{
+  reset();
+}
+
+std::string MessageDigestSHA384::getAlgorithm() const
+{
+  return "SHA384";
+}
+
+void MessageDigestSHA384::reset()
+{
+  _numBytes   = 0;
+  _bufferSize = 0;
+
+  // according to RFC 6234 section 6.3
+  _hash[0] = 0xcbbb9d5dc1059ed8;
+  _hash[1] = 0x629a292a367cd507;
+  _hash[2] = 0x9159015a3070dd17;
+  _hash[3] = 0x152fecd8f70e5939;
+  _hash[4] = 0x67332667ffc00b31;
+  _hash[5] = 0x8eb44a8768581511;
+  _hash[6] = 0xdb0c2e0d64f98fa7;
+  _hash[7] = 0x47b5481dbefa4fa4;
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestSHA384::create()
+{
+  return std::unique_ptr<MessageDigestImpl>(new MessageDigestSHA384());
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestSHA384::clone() const
+{
+  return cloneDigest(*this);
+}
+
+bool MessageDigestSHA384::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
+
+size_t MessageDigestSHA384::getDigestSize() const
+{
+  return DIGEST_SIZE;
+}
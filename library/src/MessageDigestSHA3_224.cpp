@@ -0,0 +1,38 @@
+/**
+ * @file MessageDigestSHA3_224.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/MessageDigestSHA3_224.hpp"
+#include "MessageDigest/MessageDigest.hpp"
+
+static MessageDigestImplRegistrar<MessageDigestSHA3_224> registrar("SHA3-224");
+
+MessageDigestSHA3_224::MessageDigestSHA3_224()
+  : MessageDigestKeccak(144, DIGEST_SIZE, 0x06)
+{
+  // rate and padding according to FIPS 202 section 6.1
+}
+
+std::string MessageDigestSHA3_224::getAlgorithm() const
+{
+  return "SHA3-224";
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestSHA3_224::create()
+{
+  return std::unique_ptr<MessageDigestImpl>(new MessageDigestSHA3_224());
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestSHA3_224::clone() const
+{
+  return cloneDigest(*this);
+}
+
+bool MessageDigestSHA3_224::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
@@ -0,0 +1,38 @@
+/**
+ * @file MessageDigestSHA3_256.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/MessageDigestSHA3_256.hpp"
+#include "MessageDigest/MessageDigest.hpp"
+
+static MessageDigestImplRegistrar<MessageDigestSHA3_256> registrar("SHA3-256");
+
+MessageDigestSHA3_256::MessageDigestSHA3_256()
+  : MessageDigestKeccak(136, DIGEST_SIZE, 0x06)
+{
+  // rate and padding according to FIPS 202 section 6.1
+}
+
+std::string MessageDigestSHA3_256::getAlgorithm() const
+{
+  return "SHA3-256";
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestSHA3_256::create()
+{
+  return std::unique_ptr<MessageDigestImpl>(new MessageDigestSHA3_256());
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestSHA3_256::clone() const
+{
+  return cloneDigest(*this);
+}
+
+bool MessageDigestSHA3_256::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
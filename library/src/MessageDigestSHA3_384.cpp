@@ -0,0 +1,38 @@
+/**
+ * @file MessageDigestSHA3_384.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/MessageDigestSHA3_384.hpp"
+#include "MessageDigest/MessageDigest.hpp"
+
+static MessageDigestImplRegistrar<MessageDigestSHA3_384> registrar("SHA3-384");
+
+MessageDigestSHA3_384::MessageDigestSHA3_384()
+  : MessageDigestKeccak(104, DIGEST_SIZE, 0x06)
+{
+  // rate and padding according to FIPS 202 section 6.1
+}
+
+std::string MessageDigestSHA3_384::getAlgorithm() const
+{
+  return "SHA3-384";
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestSHA3_384::create()
+{
+  return std::unique_ptr<MessageDigestImpl>(new MessageDigestSHA3_384());
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestSHA3_384::clone() const
+{
+  return cloneDigest(*this);
+}
+
+bool MessageDigestSHA3_384::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
@@ -0,0 +1,38 @@
+/**
+ * @file MessageDigestSHA3_512.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/MessageDigestSHA3_512.hpp"
+#include "MessageDigest/MessageDigest.hpp"
+
+static MessageDigestImplRegistrar<MessageDigestSHA3_512> registrar("SHA3-512");
+
+MessageDigestSHA3_512::MessageDigestSHA3_512()
+  : MessageDigestKeccak(72, DIGEST_SIZE, 0x06)
+{
+  // rate and padding according to FIPS 202 section 6.1
+}
+
+std::string MessageDigestSHA3_512::getAlgorithm() const
+{
+  return "SHA3-512";
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestSHA3_512::create()
+{
+  return std::unique_ptr<MessageDigestImpl>(new MessageDigestSHA3_512());
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestSHA3_512::clone() const
+{
+  return cloneDigest(*this);
+}
+
+bool MessageDigestSHA3_512::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
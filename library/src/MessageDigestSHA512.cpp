@@ -17,8 +17,17 @@
 
 #include "MessageDigest/MessageDigestSHA512.hpp"
 #include "MessageDigest/MessageDigest.hpp"
+#include "MessageDigest/MessageDigestEncoding.hpp"
+#include "MessageDigest/CpuFeatures.hpp"
+#include "MessageDigest/MessageDigestState.hpp"
+#include "MessageDigest/MessageDigestMultiBuffer.hpp"
 
 #include <iostream>
+#include <cstring>
+
+#ifdef MESSAGEDIGEST_X86
+#include <immintrin.h>
+#endif
 
 // big endian architectures need #define __BYTE_ORDER __BIG_ENDIAN
 #ifndef _MSC_VER
@@ -29,6 +38,30 @@ static MessageDigestImplRegistrar<MessageDigestSHA512> registrar("SHA512");
 
 namespace
 {
+  /* Constants defined in RFC 6234 section 5.2   */
+  static constexpr uint64_t K[] =    {
+    0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f, 0xe9b5dba58189dbbc,
+    0x3956c25bf348b538, 0x59f111f1b605d019, 0x923f82a4af194f9b, 0xab1c5ed5da6d8118,
+    0xd807aa98a3030242, 0x12835b0145706fbe, 0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2,
+    0x72be5d74f27b896f, 0x80deb1fe3b1696b1, 0x9bdc06a725c71235, 0xc19bf174cf692694,
+    0xe49b69c19ef14ad2, 0xefbe4786384f25e3, 0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65,
+    0x2de92c6f592b0275, 0x4a7484aa6ea6e483, 0x5cb0a9dcbd41fbd4, 0x76f988da831153b5,
+    0x983e5152ee66dfab, 0xa831c66d2db43210, 0xb00327c898fb213f, 0xbf597fc7beef0ee4,
+    0xc6e00bf33da88fc2, 0xd5a79147930aa725, 0x06ca6351e003826f, 0x142929670a0e6e70,
+    0x27b70a8546d22ffc, 0x2e1b21385c26c926, 0x4d2c6dfc5ac42aed, 0x53380d139d95b3df,
+    0x650a73548baf63de, 0x766a0abb3c77b2a8, 0x81c2c92e47edaee6, 0x92722c851482353b,
+    0xa2bfe8a14cf10364, 0xa81a664bbc423001, 0xc24b8b70d0f89791, 0xc76c51a30654be30,
+    0xd192e819d6ef5218, 0xd69906245565a910, 0xf40e35855771202a, 0x106aa07032bbd1b8,
+    0x19a4c116b8d2d0c8, 0x1e376c085141ab53, 0x2748774cdf8eeb99, 0x34b0bcb5e19b48a8,
+    0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb, 0x5b9cca4f7763e373, 0x682e6ff3d6b2b8a3,
+    0x748f82ee5defb2fc, 0x78a5636f43172f60, 0x84c87814a1f0ab72, 0x8cc702081a6439ec,
+    0x90befffa23631e28, 0xa4506cebde82bde9, 0xbef9a3f7b2c67915, 0xc67178f2e372532b,
+    0xca273eceea26619c, 0xd186b8c721c0c207, 0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178,
+    0x06f067aa72176fba, 0x0a637dc5a2c898a6, 0x113f9804bef90dae, 0x1b710b35131c471b,
+    0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc, 0x431d67c49c100d4c,
+    0x4cc5d4becb3e42b6, 0x597f299cfc657e2a, 0x5fcb6fab3ad6faec, 0x6c44198c4a475817
+  };
+
   /**
    * @brief The circular left shift operation
    */
@@ -69,16 +102,204 @@ namespace
   {
     return rotateRight(a, 19) ^ rotateRight(a, 61) ^ (a >> 6);
   }
+
+#ifdef MESSAGEDIGEST_X86
+  // multi-buffer kernels: hash holds eight rows with one word per lane,
+  // blocks points to the next 128 bytes of every lane
+
+  // AVX2 has no 64 bit rotate
+  template<int N>
+  MESSAGEDIGEST_TARGET("avx2")
+  inline __m256i rotateRightAVX2(__m256i a)
+  {
+    return _mm256_or_si256(_mm256_srli_epi64(a, N), _mm256_slli_epi64(a, 64 - N));
+  }
+
+  MESSAGEDIGEST_TARGET("avx2")
+  inline __m256i f1AVX2(__m256i e, __m256i f, __m256i g)
+  {
+    __m256i term1 = _mm256_xor_si256(_mm256_xor_si256(rotateRightAVX2<14>(e), rotateRightAVX2<18>(e)), rotateRightAVX2<41>(e));
+    __m256i term2 = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+    return _mm256_add_epi64(term1, term2);
+  }
+
+  MESSAGEDIGEST_TARGET("avx2")
+  inline __m256i f2AVX2(__m256i a, __m256i b, __m256i c)
+  {
+    __m256i term1 = _mm256_xor_si256(_mm256_xor_si256(rotateRightAVX2<28>(a), rotateRightAVX2<34>(a)), rotateRightAVX2<39>(a));
+    __m256i term2 = _mm256_or_si256(_mm256_and_si256(_mm256_or_si256(a, b), c), _mm256_and_si256(a, b));
+    return _mm256_add_epi64(term1, term2);
+  }
+
+  MESSAGEDIGEST_TARGET("avx2")
+  inline __m256i f3AVX2(__m256i a)
+  {
+    return _mm256_xor_si256(_mm256_xor_si256(rotateRightAVX2<1>(a), rotateRightAVX2<8>(a)), _mm256_srli_epi64(a, 7));
+  }
+
+  MESSAGEDIGEST_TARGET("avx2")
+  inline __m256i f4AVX2(__m256i a)
+  {
+    return _mm256_xor_si256(_mm256_xor_si256(rotateRightAVX2<19>(a), rotateRightAVX2<61>(a)), _mm256_srli_epi64(a, 6));
+  }
+
+  /// process one block of each of 4 messages
+  MESSAGEDIGEST_TARGET("avx2")
+  void processBlocksAVX2(uint64_t* hash, const uint8_t* const* blocks)
+  {
+    const __m256i byteSwap = _mm256_setr_epi8(7,6,5,4,3,2,1,0, 15,14,13,12,11,10,9,8,
+                                              7,6,5,4,3,2,1,0, 15,14,13,12,11,10,9,8);
+
+    // transpose to one register per message word, converted to big endian
+    __m256i words[16];
+    for (int i = 0; i < 16; i++)
+    {
+      uint64_t column[4];
+      for (int lane = 0; lane < 4; lane++)
+        std::memcpy(&column[lane], blocks[lane] + 8*i, 8);
+      words[i] = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*) column), byteSwap);
+    }
+
+    __m256i* state = (__m256i*) hash;
+    __m256i a = _mm256_loadu_si256(state + 0);
+    __m256i b = _mm256_loadu_si256(state + 1);
+    __m256i c = _mm256_loadu_si256(state + 2);
+    __m256i d = _mm256_loadu_si256(state + 3);
+    __m256i e = _mm256_loadu_si256(state + 4);
+    __m256i f = _mm256_loadu_si256(state + 5);
+    __m256i g = _mm256_loadu_si256(state + 6);
+    __m256i h = _mm256_loadu_si256(state + 7);
+
+    for (int i = 0; i < 80; i++)
+    {
+      // extend the message schedule in place
+      __m256i& w = words[i & 15];
+      if (i >= 16)
+        w = _mm256_add_epi64(_mm256_add_epi64(w, f3AVX2(words[(i + 1) & 15])),
+                             _mm256_add_epi64(words[(i + 9) & 15], f4AVX2(words[(i + 14) & 15])));
+
+      __m256i x = _mm256_add_epi64(_mm256_add_epi64(h, f1AVX2(e,f,g)),
+                                   _mm256_add_epi64(_mm256_set1_epi64x((long long) K[i]), w));
+      __m256i y = f2AVX2(a,b,c);
+      h = g; g = f; f = e; e = _mm256_add_epi64(d, x);
+      d = c; c = b; b = a; a = _mm256_add_epi64(x, y);
+    }
+
+    // update hash
+    _mm256_storeu_si256(state + 0, _mm256_add_epi64(_mm256_loadu_si256(state + 0), a));
+    _mm256_storeu_si256(state + 1, _mm256_add_epi64(_mm256_loadu_si256(state + 1), b));
+    _mm256_storeu_si256(state + 2, _mm256_add_epi64(_mm256_loadu_si256(state + 2), c));
+    _mm256_storeu_si256(state + 3, _mm256_add_epi64(_mm256_loadu_si256(state + 3), d));
+    _mm256_storeu_si256(state + 4, _mm256_add_epi64(_mm256_loadu_si256(state + 4), e));
+    _mm256_storeu_si256(state + 5, _mm256_add_epi64(_mm256_loadu_si256(state + 5), f));
+    _mm256_storeu_si256(state + 6, _mm256_add_epi64(_mm256_loadu_si256(state + 6), g));
+    _mm256_storeu_si256(state + 7, _mm256_add_epi64(_mm256_loadu_si256(state + 7), h));
+  }
+
+  // ternary logic: three way xor, choose and majority
+  static constexpr int XOR3 = 0x96;
+  static constexpr int CHOOSE = 0xCA;
+  static constexpr int MAJORITY = 0xE8;
+
+  MESSAGEDIGEST_TARGET("avx512f")
+  inline __m512i f1AVX512(__m512i e, __m512i f, __m512i g)
+  {
+    __m512i term1 = _mm512_ternarylogic_epi64(_mm512_ror_epi64(e, 14), _mm512_ror_epi64(e, 18), _mm512_ror_epi64(e, 41), XOR3);
+    __m512i term2 = _mm512_ternarylogic_epi64(e, f, g, CHOOSE);
+    return _mm512_add_epi64(term1, term2);
+  }
+
+  MESSAGEDIGEST_TARGET("avx512f")
+  inline __m512i f2AVX512(__m512i a, __m512i b, __m512i c)
+  {
+    __m512i term1 = _mm512_ternarylogic_epi64(_mm512_ror_epi64(a, 28), _mm512_ror_epi64(a, 34), _mm512_ror_epi64(a, 39), XOR3);
+    __m512i term2 = _mm512_ternarylogic_epi64(a, b, c, MAJORITY);
+    return _mm512_add_epi64(term1, term2);
+  }
+
+  MESSAGEDIGEST_TARGET("avx512f")
+  inline __m512i f3AVX512(__m512i a)
+  {
+    return _mm512_ternarylogic_epi64(_mm512_ror_epi64(a, 1), _mm512_ror_epi64(a, 8), _mm512_srli_epi64(a, 7), XOR3);
+  }
+
+  MESSAGEDIGEST_TARGET("avx512f")
+  inline __m512i f4AVX512(__m512i a)
+  {
+    return _mm512_ternarylogic_epi64(_mm512_ror_epi64(a, 19), _mm512_ror_epi64(a, 61), _mm512_srli_epi64(a, 6), XOR3);
+  }
+
+  /// process one block of each of 8 messages
+  MESSAGEDIGEST_TARGET("avx512f")
+  void processBlocksAVX512(uint64_t* hash, const uint8_t* const* blocks)
+  {
+    // transpose to one register per message word, converted to big endian
+    __m512i words[16];
+    for (int i = 0; i < 16; i++)
+    {
+      uint64_t column[8];
+      for (int lane = 0; lane < 8; lane++)
+      {
+        uint64_t word;
+        std::memcpy(&word, blocks[lane] + 8*i, 8);
+        column[lane] = swap64(word);
+      }
+      words[i] = _mm512_loadu_si512(column);
+    }
+
+    uint64_t* state = hash;
+    __m512i a = _mm512_loadu_si512(state +  0);
+    __m512i b = _mm512_loadu_si512(state +  8);
+    __m512i c = _mm512_loadu_si512(state + 16);
+    __m512i d = _mm512_loadu_si512(state + 24);
+    __m512i e = _mm512_loadu_si512(state + 32);
+    __m512i f = _mm512_loadu_si512(state + 40);
+    __m512i g = _mm512_loadu_si512(state + 48);
+    __m512i h = _mm512_loadu_si512(state + 56);
+
+    for (int i = 0; i < 80; i++)
+    {
+      // extend the message schedule in place
+      __m512i& w = words[i & 15];
+      if (i >= 16)
+        w = _mm512_add_epi64(_mm512_add_epi64(w, f3AVX512(words[(i + 1) & 15])),
+                             _mm512_add_epi64(words[(i + 9) & 15], f4AVX512(words[(i + 14) & 15])));
+
+      __m512i x = _mm512_add_epi64(_mm512_add_epi64(h, f1AVX512(e,f,g)),
+                                   _mm512_add_epi64(_mm512_set1_epi64((long long) K[i]), w));
+      __m512i y = f2AVX512(a,b,c);
+      h = g; g = f; f = e; e = _mm512_add_epi64(d, x);
+      d = c; c = b; b = a; a = _mm512_add_epi64(x, y);
+    }
+
+    // update hash
+    _mm512_storeu_si512(state +  0, _mm512_add_epi64(_mm512_loadu_si512(state +  0), a));
+    _mm512_storeu_si512(state +  8, _mm512_add_epi64(_mm512_loadu_si512(state +  8), b));
+    _mm512_storeu_si512(state + 16, _mm512_add_epi64(_mm512_loadu_si512(state + 16), c));
+    _mm512_storeu_si512(state + 24, _mm512_add_epi64(_mm512_loadu_si512(state + 24), d));
+    _mm512_storeu_si512(state + 32, _mm512_add_epi64(_mm512_loadu_si512(state + 32), e));
+    _mm512_storeu_si512(state + 40, _mm512_add_epi64(_mm512_loadu_si512(state + 40), f));
+    _mm512_storeu_si512(state + 48, _mm512_add_epi64(_mm512_loadu_si512(state + 48), g));
+    _mm512_storeu_si512(state + 56, _mm512_add_epi64(_mm512_loadu_si512(state + 56), h));
+  }
+#endif
 }
 
 MessageDigestSHA512::MessageDigestSHA512()
 {
+  if (isSupported(BatchKernel::AVX512))
+    _batchKernel = BatchKernel::AVX512;
+  else if (isSupported(BatchKernel::AVX2))
+    _batchKernel = BatchKernel::AVX2;
+  else
+    _batchKernel = BatchKernel::Serial;
+
   reset();
 }
 
 std::string MessageDigestSHA512::getAlgorithm() const
 {
-  return "SHA256";
+  return "SHA512";
 }
 
 void MessageDigestSHA512::reset()
@@ -98,16 +319,178 @@ void MessageDigestSHA512::reset()
 
 }
 
+std::vector<uint8_t> MessageDigestSHA512::exportState() const
+{
+  MessageDigestStateWriter writer(getAlgorithm());
+  writer.write(_numBytes);
+  for (int i = 0; i < HASH_SIZE; i++)
+    writer.write(_hash[i]);
+  writer.write((uint8_t) _bufferSize);
+  writer.write(_buffer, _bufferSize);
+  return writer.state();
+}
+
+bool MessageDigestSHA512::importState(const uint8_t *state, size_t size)
+{
+  MessageDigestStateReader reader(state, size);
+  uint64_t numBytes;
+  uint64_t hash[HASH_SIZE];
+  uint8_t  bufferSize;
+  uint8_t  buffer[BLOCK_SIZE];
+
+  if (!reader.readHeader(getAlgorithm()) || !reader.read(numBytes) || numBytes % BLOCK_SIZE != 0)
+    return false;
+  for (int i = 0; i < HASH_SIZE; i++)
+    if (!reader.read(hash[i]))
+      return false;
+  if (!reader.read(bufferSize) || bufferSize >= BLOCK_SIZE || !reader.read(buffer, bufferSize) || !reader.atEnd())
+    return false;
+
+  _numBytes   = numBytes;
+  _bufferSize = bufferSize;
+  for (int i = 0; i < HASH_SIZE; i++)
+    _hash[i] = hash[i];
+  for (int i = 0; i < bufferSize; i++)
+    _buffer[i] = buffer[i];
+  return true;
+}
+
 std::unique_ptr<MessageDigestImpl> MessageDigestSHA512::create()
 {
   return std::unique_ptr<MessageDigestImpl>(new MessageDigestSHA512());
 }
 
+std::unique_ptr<MessageDigestImpl> MessageDigestSHA512::clone() const
+{
+  return cloneDigest(*this);
+}
+
+bool MessageDigestSHA512::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
+
+bool MessageDigestSHA512::setBatchKernel(BatchKernel kernel)
+{
+  if (!isSupported(kernel))
+    return false;
+
+  _batchKernel = kernel;
+  return true;
+}
+
+MessageDigestSHA512::BatchKernel MessageDigestSHA512::getBatchKernel() const
+{
+  return _batchKernel;
+}
+
+bool MessageDigestSHA512::isSupported(BatchKernel kernel)
+{
+  switch (kernel)
+  {
+#ifdef MESSAGEDIGEST_X86
+  case BatchKernel::AVX2:
+    return CpuFeatures::hasAVX2();
+  case BatchKernel::AVX512:
+    return CpuFeatures::hasAVX512F();
+#else
+  case BatchKernel::AVX2:
+  case BatchKernel::AVX512:
+    return false;
+#endif
+  default:
+    return true;
+  }
+}
+
+void MessageDigestSHA512::digestBatch(const MessageDigestInput *inputs, size_t numInputs, uint8_t *digests)
+{
+  switch (_batchKernel)
+  {
+#ifdef MESSAGEDIGEST_X86
+  case BatchKernel::AVX2:
+    digestBatchMultiBuffer<4>(inputs, numInputs, digests, processBlocksAVX2);
+    break;
+  case BatchKernel::AVX512:
+    digestBatchMultiBuffer<8>(inputs, numInputs, digests, processBlocksAVX512);
+    break;
+#endif
+  default:
+    digestBatchSerial(inputs, numInputs, digests);
+  }
+}
+
+template<size_t LANES>
+void MessageDigestSHA512::digestBatchMultiBuffer(const MessageDigestInput *inputs, size_t numInputs, uint8_t *digests,
+                                                 ProcessBlocksFunc processBlocks)
+{
+  // initial hash of this algorithm
+  reset();
+
+  // structure of arrays, row i holds _hash[i] of all lanes
+  uint64_t state[HASH_SIZE*LANES];
+  size_t digestSize = getDigestSize();
+
+  MessageDigestMultiBuffer<LANES,BLOCK_SIZE,16,true> engine(inputs, numInputs);
+  engine.run(
+        [&](size_t lane)
+        {
+          for (int i = 0; i < HASH_SIZE; i++)
+            state[i*LANES + lane] = _hash[i];
+        },
+        [&](const uint8_t* const* blocks)
+        {
+          processBlocks(state, blocks);
+        },
+        [&](size_t lane, size_t message)
+        {
+          uint64_t hash[HASH_SIZE];
+          for (int i = 0; i < HASH_SIZE; i++)
+            hash[i] = state[i*LANES + lane];
+          hashToBytes(hash, digests + message * digestSize, digestSize);
+        });
+}
+
+void MessageDigestSHA512::digestBatchSerial(const MessageDigestInput *inputs, size_t numInputs, uint8_t *digests)
+{
+  // initial hash of this algorithm
+  reset();
+  uint64_t initialHash[HASH_SIZE];
+  for (int i = 0; i < HASH_SIZE; i++)
+    initialHash[i] = _hash[i];
+
+  size_t digestSize = getDigestSize();
+  uint8_t padded[2*BLOCK_SIZE];
+  for (size_t message = 0; message < numInputs; message++)
+  {
+    const uint8_t* data = (const uint8_t*) inputs[message].first;
+    size_t numBytes = inputs[message].second;
+    size_t fullBlocks = numBytes / BLOCK_SIZE;
+
+    for (int i = 0; i < HASH_SIZE; i++)
+      _hash[i] = initialHash[i];
+    if (fullBlocks > 0)
+      processBlocks(data, fullBlocks);
+
+    size_t numPadded = MessageDigestMultiBuffer<1,BLOCK_SIZE,16,true>::pad(
+          padded, data + fullBlocks * BLOCK_SIZE, numBytes % BLOCK_SIZE, numBytes);
+    processBlocks(padded, numPadded);
+
+    hashToBytes(_hash, digests + message * digestSize, digestSize);
+  }
+
+  reset();
+}
+
 std::string MessageDigestSHA512::digest()
 {
-  // convert hash to string
-  static const char dec2hex[16+1] = "0123456789abcdef";
+  uint8_t buffer[DIGEST_SIZE];
+  digestBinary(buffer);
+  return MessageDigestEncoding::toHex(buffer, getDigestSize());
+}
 
+void MessageDigestSHA512::digestBinary(uint8_t *buffer)
+{
   // save old hash if buffer is partially filled
   uint64_t oldHash[HASH_SIZE];
   for (int i = 0; i < HASH_SIZE; i++)
@@ -116,36 +499,28 @@ std::string MessageDigestSHA512::digest()
   // process remaining bytes
   processBuffer();
 
-  // create hash string
-  char hashBuffer[HASH_SIZE*16+1];
-  size_t offset = 0;
+  hashToBytes(_hash, buffer, getDigestSize());
+
+  // restore old hash
   for (int i = 0; i < HASH_SIZE; i++)
-  {
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 60) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 56) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 52) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 48) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 44) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 40) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 36) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 32) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 28) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 24) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 20) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 16) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >> 12) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >>  8) & 15];
-    hashBuffer[offset++] = dec2hex[(_hash[i] >>  4) & 15];
-    hashBuffer[offset++] = dec2hex[ _hash[i]        & 15];
-
-    // restore old hash
     _hash[i] = oldHash[i];
-  }
-  // zero-terminated string
-  hashBuffer[offset] = 0;
+}
 
-  // convert to std::string
-  return hashBuffer;
+size_t MessageDigestSHA512::getDigestSize() const
+{
+  return DIGEST_SIZE;
+}
+
+size_t MessageDigestSHA512::getBlockSize() const
+{
+  return BLOCK_SIZE;
+}
+
+void MessageDigestSHA512::hashToBytes(const uint64_t *hash, uint8_t *buffer, size_t digestSize)
+{
+  // truncated variants keep the leading bytes, not necessarily whole words
+  for (size_t i = 0; i < digestSize; i++)
+    buffer[i] = (hash[i / 8] >> (56 - 8 * (i % 8))) & 0xFF;
 }
 
 void MessageDigestSHA512::update(const void *data, const size_t offset, const size_t len)
@@ -174,13 +549,14 @@ void MessageDigestSHA512::update(const void *data, const size_t offset, const si
   if (numBytes == 0)
     return;
 
-  // process full blocks
-  while (numBytes >= BLOCK_SIZE)
+  // process full blocks in one run
+  if (numBytes >= BLOCK_SIZE)
   {
-    processBlock(current);
-    current    += BLOCK_SIZE;
-    _numBytes += BLOCK_SIZE;
-    numBytes   -= BLOCK_SIZE;
+    size_t nBlocks = numBytes / BLOCK_SIZE;
+    processBlocks(current, nBlocks);
+    current   += nBlocks * BLOCK_SIZE;
+    _numBytes += nBlocks * BLOCK_SIZE;
+    numBytes  -= nBlocks * BLOCK_SIZE;
   }
 
   // keep remaining bytes in buffer
@@ -191,89 +567,83 @@ void MessageDigestSHA512::update(const void *data, const size_t offset, const si
   }
 }
 
-void MessageDigestSHA512::processBlock(const void *data)
+void MessageDigestSHA512::processBlocks(const void *data, size_t nBlocks)
 {
-  /* Constants defined in RFC 6234 section 5.2   */
-  static constexpr uint64_t K[] =    {
-    0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f, 0xe9b5dba58189dbbc,
-    0x3956c25bf348b538, 0x59f111f1b605d019, 0x923f82a4af194f9b, 0xab1c5ed5da6d8118,
-    0xd807aa98a3030242, 0x12835b0145706fbe, 0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2,
-    0x72be5d74f27b896f, 0x80deb1fe3b1696b1, 0x9bdc06a725c71235, 0xc19bf174cf692694,
-    0xe49b69c19ef14ad2, 0xefbe4786384f25e3, 0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65,
-    0x2de92c6f592b0275, 0x4a7484aa6ea6e483, 0x5cb0a9dcbd41fbd4, 0x76f988da831153b5,
-    0x983e5152ee66dfab, 0xa831c66d2db43210, 0xb00327c898fb213f, 0xbf597fc7beef0ee4,
-    0xc6e00bf33da88fc2, 0xd5a79147930aa725, 0x06ca6351e003826f, 0x142929670a0e6e70,
-    0x27b70a8546d22ffc, 0x2e1b21385c26c926, 0x4d2c6dfc5ac42aed, 0x53380d139d95b3df,
-    0x650a73548baf63de, 0x766a0abb3c77b2a8, 0x81c2c92e47edaee6, 0x92722c851482353b,
-    0xa2bfe8a14cf10364, 0xa81a664bbc423001, 0xc24b8b70d0f89791, 0xc76c51a30654be30,
-    0xd192e819d6ef5218, 0xd69906245565a910, 0xf40e35855771202a, 0x106aa07032bbd1b8,
-    0x19a4c116b8d2d0c8, 0x1e376c085141ab53, 0x2748774cdf8eeb99, 0x34b0bcb5e19b48a8,
-    0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb, 0x5b9cca4f7763e373, 0x682e6ff3d6b2b8a3,
-    0x748f82ee5defb2fc, 0x78a5636f43172f60, 0x84c87814a1f0ab72, 0x8cc702081a6439ec,
-    0x90befffa23631e28, 0xa4506cebde82bde9, 0xbef9a3f7b2c67915, 0xc67178f2e372532b,
-    0xca273eceea26619c, 0xd186b8c721c0c207, 0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178,
-    0x06f067aa72176fba, 0x0a637dc5a2c898a6, 0x113f9804bef90dae, 0x1b710b35131c471b,
-    0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc, 0x431d67c49c100d4c,
-    0x4cc5d4becb3e42b6, 0x597f299cfc657e2a, 0x5fcb6fab3ad6faec, 0x6c44198c4a475817
-  };
+  // the chaining state stays in locals for the whole run, _hash could
+  // alias the input and would be reloaded for every block
+  uint64_t state[HASH_SIZE];
+  for (int i = 0; i < HASH_SIZE; i++)
+    state[i] = _hash[i];
 
-  // data represented as 64-bit words
-  const uint64_t* input = (uint64_t*) data;
+  const uint8_t* current = (const uint8_t*) data;
+  for (; nBlocks > 0; nBlocks--, current += BLOCK_SIZE)
+  {
+    // data represented as 64-bit words
+    const uint64_t* input = (const uint64_t*) current;
 
-  // message schedule of eighty 64-bit words
-  uint64_t words[80];
+    // message schedule of eighty 64-bit words
+    uint64_t words[80];
 
-  //Prepare the message schedule
-  int i;
-  for (i = 0; i < 16; i++)
-    {
+    //Prepare the message schedule
+    int i;
+    for (i = 0; i < 16; i++)
+      {
 #if defined(__BYTE_ORDER) && (__BYTE_ORDER != 0) && (__BYTE_ORDER == __BIG_ENDIAN)
-      words[i] = input[i];
+        words[i] = input[i];
 #else
-      words[i] = swap64(input[i]);
+        words[i] = swap64(input[i]);
 #endif
-    }
-
-  for (;i < 80; i++)
-    {
-      words[i] = words[i-16] + f3(words[i-15]) + words[i-7] + f4(words[i- 2]);
-    }
-
-  uint64_t x,y; // temporaries
+      }
+
+    for (;i < 80; i++)
+      {
+        words[i] = words[i-16] + f3(words[i-15]) + words[i-7] + f4(words[i- 2]);
+      }
+
+    uint64_t x,y; // temporaries
+
+    // get last hash
+    uint64_t a = state[0];
+    uint64_t b = state[1];
+    uint64_t c = state[2];
+    uint64_t d = state[3];
+    uint64_t e = state[4];
+    uint64_t f = state[5];
+    uint64_t g = state[6];
+    uint64_t h = state[7];
+
+    i=0;
+    do
+      {
+        x = h + f1(e,f,g) + K[i] + words[ i]; y = f2(a,b,c); d += x; h = x + y; i++;
+        x = g + f1(d,e,f) + K[i] + words[ i]; y = f2(h,a,b); c += x; g = x + y; i++;
+        x = f + f1(c,d,e) + K[i] + words[ i]; y = f2(g,h,a); b += x; f = x + y; i++;
+        x = e + f1(b,c,d) + K[i] + words[ i]; y = f2(f,g,h); a += x; e = x + y; i++;
+        x = d + f1(a,b,c) + K[i] + words[ i]; y = f2(e,f,g); h += x; d = x + y; i++;
+        x = c + f1(h,a,b) + K[i] + words[ i]; y = f2(d,e,f); g += x; c = x + y; i++;
+        x = b + f1(g,h,a) + K[i] + words[ i]; y = f2(c,d,e); f += x; b = x + y; i++;
+        x = a + f1(f,g,h) + K[i] + words[ i]; y = f2(b,c,d); e += x; a = x + y; i++;
+      }
+    while(i<80);
+
+    // update hash
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+  }
 
-  // get last hash
-  uint64_t a = _hash[0];
-  uint64_t b = _hash[1];
-  uint64_t c = _hash[2];
-  uint64_t d = _hash[3];
-  uint64_t e = _hash[4];
-  uint64_t f = _hash[5];
-  uint64_t g = _hash[6];
-  uint64_t h = _hash[7];
+  for (int i = 0; i < HASH_SIZE; i++)
+    _hash[i] = state[i];
+}
 
-  i=0;
-  do
-    {
-      x = h + f1(e,f,g) + K[i] + words[ i]; y = f2(a,b,c); d += x; h = x + y; i++;
-      x = g + f1(d,e,f) + K[i] + words[ i]; y = f2(h,a,b); c += x; g = x + y; i++;
-      x = f + f1(c,d,e) + K[i] + words[ i]; y = f2(g,h,a); b += x; f = x + y; i++;
-      x = e + f1(b,c,d) + K[i] + words[ i]; y = f2(f,g,h); a += x; e = x + y; i++;
-      x = d + f1(a,b,c) + K[i] + words[ i]; y = f2(e,f,g); h += x; d = x + y; i++;
-      x = c + f1(h,a,b) + K[i] + words[ i]; y = f2(d,e,f); g += x; c = x + y; i++;
-      x = b + f1(g,h,a) + K[i] + words[ i]; y = f2(c,d,e); f += x; b = x + y; i++;
-      x = a + f1(f,g,h) + K[i] + words[ i]; y = f2(b,c,d); e += x; a = x + y; i++;
-    }
-  while(i<80);
-
-  // update hash
-  _hash[0] += a;
-  _hash[1] += b;
-  _hash[2] += c;
-  _hash[3] += d;
-  _hash[4] += e;
-  _hash[5] += f;
-  _hash[6] += g;
-  _hash[7] += h;
+void MessageDigestSHA512::processBlock(const void *data)
+{
+  processBlocks(data, 1);
 }
 
 /// process final block, less than 64 bytes
@@ -312,7 +682,7 @@ void MessageDigestSHA512::processBuffer()
   size_t i;
   for (i = _bufferSize + 1; i < BLOCK_SIZE; i++)
     _buffer[i] = 0;
-  for (; i < paddedLength; i++)
+  for (; i < paddedLength + 16; i++)
     extra[i - BLOCK_SIZE] = 0;
 
   // add message length in bits as 128 bit number
@@ -322,7 +692,7 @@ void MessageDigestSHA512::processBuffer()
   if (paddedLength < BLOCK_SIZE)
     addLength = _buffer + paddedLength + 8;
   else
-    addLength = extra + paddedLength - BLOCK_SIZE;
+    addLength = extra + paddedLength - BLOCK_SIZE + 8;
 
   // must be big endian
   *addLength++ = (msgBits >> 56) & 0xFF;
@@ -0,0 +1,67 @@
+/**
+ * @file MessageDigestSHA512_224.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ *
+ * based on:
+ * sha256.h and sha256.cpp
+ * from hash-library by Stephan Brume
+ * (http://create.stephan-brumme.com/hash-library)
+ *
+ * Copyright (c) 2014 Stephan Brumme. All rights reserved.
+ * see http://create.stephan-brumme.com/disclaimer.html
+ *
+ */
+
+#include "MessageDigest/MessageDigestSHA512_224.hpp"
+#include "MessageDigest/MessageDigest.hpp"
+
+static MessageDigestImplRegistrar<MessageDigestSHA512_224> registrar("SHA512/224");
+
+MessageDigestSHA512_224::MessageDigestSHA512_224()
+{
+  reset();
+}
+
+std::string MessageDigestSHA512_224::getAlgorithm() const
+{
+  return "SHA512/224";
+}
+
+void MessageDigestSHA512_224::reset()
+{
+  _numBytes   = 0;
+  _bufferSize = 0;
+
+  // according to FIPS 180-4 section 5.3.6.1
+  _hash[0] = 0x8c3d37c819544da2;
+  _hash[1] = 0x73e1996689dcd4d6;
+  _hash[2] = 0x1dfab7ae32ff9c82;
+  _hash[3] = 0x679dd514582f9fcf;
+  _hash[4] = 0x0f6d2b697bd44da8;
+  _hash[5] = 0x77e36f7304c48942;
+  _hash[6] = 0x3f9d85a86a1d36c8;
+  _hash[7] = 0x1112e6ad91d692a1;
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestSHA512_224::create()
+{
+  return std::unique_ptr<MessageDigestImpl>(new MessageDigestSHA512_224());
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestSHA512_224::clone() const
+{
+  return cloneDigest(*this);
+}
+
+bool MessageDigestSHA512_224::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
+
+size_t MessageDigestSHA512_224::getDigestSize() const
+{
+  return DIGEST_SIZE;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file MessageDigestSHA512_256.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ *
+ * based on:
+ * sha256.h and sha256.cpp
+ * from hash-library by Stephan Brume
+ * (http://create.stephan-brumme.com/hash-library)
+ *
+ * Copyright (c) 2014 Stephan Brumme. All rights reserved.
+ * see http://create.stephan-brumme.com/disclaimer.html
+ *
+ */
+
+#include "MessageDigest/MessageDigestSHA512_256.hpp"
+#include "MessageDigest/MessageDigest.hpp"
+
+static MessageDigestImplRegistrar<MessageDigestSHA512_256> registrar("SHA512/256");
+
+MessageDigestSHA512_256::MessageDigestSHA512_256()
+{
+  reset();
+}
+
+std::string MessageDigestSHA512_256::getAlgorithm() const
+{
+  return "SHA512/256";
+}
+
+void MessageDigestSHA512_256::reset()
+{
+  _numBytes   = 0;
+  _bufferSize = 0;
+
+  // according to FIPS 180-4 section 5.3.6.2
+  _hash[0] = 0x22312194fc2bf72c;
+  _hash[1] = 0x9f555fa3c84c64c2;
+  _hash[2] = 0x2393b86b6f53b151;
+  _hash[3] = 0x963877195940eabd;
+  _hash[4] = 0x96283ee2a88effe3;
+  _hash[5] = 0xbe5e1e2553863992;
+  _hash[6] = 0x2b0199fc2c85b8aa;
+  _hash[7] = 0x0eb72ddc81c52ca2;
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestSHA512_256::create()
+{
+  return std::unique_ptr<MessageDigestImpl>(new MessageDigestSHA512_256());
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestSHA512_256::clone() const
+{
+  return cloneDigest(*this);
+}
+
+bool MessageDigestSHA512_256::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
+
+size_t MessageDigestSHA512_256::getDigestSize() const
+{
+  return DIGEST_SIZE;
+}
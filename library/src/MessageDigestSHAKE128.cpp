@@ -0,0 +1,47 @@
+/**
+ * @file MessageDigestSHAKE128.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/MessageDigestSHAKE128.hpp"
+#include "MessageDigest/MessageDigest.hpp"
+
+static MessageDigestImplRegistrar<MessageDigestSHAKE128> registrar("SHAKE128");
+
+MessageDigestSHAKE128::MessageDigestSHAKE128()
+  : MessageDigestKeccak(168, DIGEST_SIZE, 0x1F)
+{
+  // rate and padding according to FIPS 202 section 6.2
+}
+
+std::string MessageDigestSHAKE128::getAlgorithm() const
+{
+  return "SHAKE128";
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestSHAKE128::create()
+{
+  return std::unique_ptr<MessageDigestImpl>(new MessageDigestSHAKE128());
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestSHAKE128::clone() const
+{
+  return cloneDigest(*this);
+}
+
+bool MessageDigestSHAKE128::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
+
+bool MessageDigestSHAKE128::setDigestSize(size_t digestSize)
+{
+  if (digestSize == 0)
+    return false;
+
+  _digestSize = digestSize;
+  return true;
+}
@@ -0,0 +1,47 @@
+/**
+ * @file MessageDigestSHAKE256.cpp
+ *
+ * Copyright (c) 2015 Björn Schramke. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSL-1.0
+ */
+
+#include "MessageDigest/MessageDigestSHAKE256.hpp"
+#include "MessageDigest/MessageDigest.hpp"
+
+static MessageDigestImplRegistrar<MessageDigestSHAKE256> registrar("SHAKE256");
+
+MessageDigestSHAKE256::MessageDigestSHAKE256()
+  : MessageDigestKeccak(136, DIGEST_SIZE, 0x1F)
+{
+  // rate and padding according to FIPS 202 section 6.2
+}
+
+std::string MessageDigestSHAKE256::getAlgorithm() const
+{
+  return "SHAKE256";
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestSHAKE256::create()
+{
+  return std::unique_ptr<MessageDigestImpl>(new MessageDigestSHAKE256());
+}
+
+std::unique_ptr<MessageDigestImpl> MessageDigestSHAKE256::clone() const
+{
+  return cloneDigest(*this);
+}
+
+bool MessageDigestSHAKE256::cloneInto(MessageDigestImpl &target) const
+{
+  return cloneDigestInto(*this, target);
+}
+
+bool MessageDigestSHAKE256::setDigestSize(size_t digestSize)
+{
+  if (digestSize == 0)
+    return false;
+
+  _digestSize = digestSize;
+  return true;
+}
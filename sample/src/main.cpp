@@ -29,7 +29,7 @@ int main()
   for(const auto& digest: digestVector)
     {
       digest->update(data);
-      cout << digest->getAlgorithm() << ":\t";
+      cout << digest->getAlgorithm() << " (" << digest->getVariant() << "):\t";
       cout << digest->digest() << endl;
     }
 
@@ -0,0 +1,96 @@
+#include "MessageDigestBLAKE2bTest.hpp"
+#include "MessageDigest/MessageDigestBLAKE2b.hpp"
+#include "TestConstants.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestBLAKE2bTest);
+
+void MessageDigestBLAKE2bTest :: setUp (void)
+{
+}
+
+void MessageDigestBLAKE2bTest :: tearDown (void)
+{
+}
+
+void MessageDigestBLAKE2bTest :: testCallOperator (void)
+{
+  MessageDigestBLAKE2b digestBLAKE2b;
+
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_BLAKE2B,digestBLAKE2b(TEXT1));
+  CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_BLAKE2B,digestBLAKE2b(TEXT2));
+  CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_BLAKE2B,digestBLAKE2b(TEXT3));
+  CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_BLAKE2B,digestBLAKE2b(TEXT4));
+}
+
+void MessageDigestBLAKE2bTest :: testUpdate (void)
+{
+  MessageDigestBLAKE2b digestBLAKE2b;
+  std::string text = TEXT1;
+
+  digestBLAKE2b.update(text.c_str(),0,text.length());
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_BLAKE2B,digestBLAKE2b.digest());
+}
+
+void MessageDigestBLAKE2bTest :: testUpdateWithOffset (void)
+{
+  MessageDigestBLAKE2b digestBLAKE2b;
+  std::string text = TEXT2;
+
+  digestBLAKE2b.update(text.c_str(),5,text.length()-5);
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_BLAKE2B,digestBLAKE2b.digest());
+}
+
+void MessageDigestBLAKE2bTest::testAvalancheEffect()
+{
+  MessageDigestBLAKE2b digestBLAKE2b;
+
+  CPPUNIT_ASSERT_ASSERTION_FAIL( CPPUNIT_ASSERT_EQUAL( digestBLAKE2b(TEXT3),digestBLAKE2b(TEXT4) ) );
+
+}
+
+void MessageDigestBLAKE2bTest::testKernels()
+{
+  const MessageDigestBLAKE2b::Kernel kernels[] = {
+    MessageDigestBLAKE2b::Kernel::Generic,
+    MessageDigestBLAKE2b::Kernel::SSE41,
+    MessageDigestBLAKE2b::Kernel::AVX2
+  };
+
+  for (auto kernel : kernels)
+  {
+    MessageDigestBLAKE2b digestBLAKE2b;
+    if (!digestBLAKE2b.setKernel(kernel))
+      continue;
+
+    CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_BLAKE2B,digestBLAKE2b(TEXT1));
+    CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_BLAKE2B,digestBLAKE2b(TEXT2));
+    CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_BLAKE2B,digestBLAKE2b(TEXT3));
+    CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_BLAKE2B,digestBLAKE2b(TEXT4));
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_BLAKE2B,digestBLAKE2b(TEXT5));
+  }
+}
+
+void MessageDigestBLAKE2bTest::testKeyAndDigestSize()
+{
+  uint8_t key[64 + 1];
+  for (size_t i = 0; i < sizeof(key); i++)
+    key[i] = (uint8_t) i;
+
+  MessageDigestBLAKE2b digestBLAKE2b;
+  CPPUNIT_ASSERT(digestBLAKE2b.setKey(key,64));
+  CPPUNIT_ASSERT_EQUAL(std::string("d187571b80da8e32673ee69e922555743f336bfad69939fe2f5a32dc65f1f7e50342e7cc0d500f25956521a69afda23d0d77ea847acff96454aba40cd6f493da"),digestBLAKE2b(TEXT3));
+
+  // the key stays for the following digests, an empty key removes it
+  CPPUNIT_ASSERT_EQUAL(std::string("d187571b80da8e32673ee69e922555743f336bfad69939fe2f5a32dc65f1f7e50342e7cc0d500f25956521a69afda23d0d77ea847acff96454aba40cd6f493da"),digestBLAKE2b(TEXT3));
+  CPPUNIT_ASSERT(digestBLAKE2b.setKey(key,0));
+  CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_BLAKE2B,digestBLAKE2b(TEXT3));
+
+  CPPUNIT_ASSERT(digestBLAKE2b.setDigestSize(32));
+  CPPUNIT_ASSERT_EQUAL(std::string("4933937731779741dc5730f3e7083f37298019e0071f641b49934dba65531b9c"),digestBLAKE2b(TEXT3));
+
+  // out of range, the settings stay as they are
+  CPPUNIT_ASSERT(!digestBLAKE2b.setKey(key,64 + 1));
+  CPPUNIT_ASSERT(!digestBLAKE2b.setDigestSize(0));
+  CPPUNIT_ASSERT(!digestBLAKE2b.setDigestSize(64 + 1));
+  CPPUNIT_ASSERT_EQUAL(std::string("4933937731779741dc5730f3e7083f37298019e0071f641b49934dba65531b9c"),digestBLAKE2b(TEXT3));
+}
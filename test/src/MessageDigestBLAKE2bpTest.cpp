@@ -0,0 +1,114 @@
+#include "MessageDigestBLAKE2bpTest.hpp"
+#include "MessageDigest/MessageDigestBLAKE2bp.hpp"
+#include "TestConstants.h"
+
+#include <algorithm>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestBLAKE2bpTest);
+
+void MessageDigestBLAKE2bpTest :: setUp (void)
+{
+}
+
+void MessageDigestBLAKE2bpTest :: tearDown (void)
+{
+}
+
+void MessageDigestBLAKE2bpTest :: testCallOperator (void)
+{
+  MessageDigestBLAKE2bp digestBLAKE2bp;
+
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_BLAKE2BP,digestBLAKE2bp(TEXT1));
+  CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_BLAKE2BP,digestBLAKE2bp(TEXT2));
+  CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_BLAKE2BP,digestBLAKE2bp(TEXT3));
+  CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_BLAKE2BP,digestBLAKE2bp(TEXT4));
+}
+
+void MessageDigestBLAKE2bpTest :: testUpdate (void)
+{
+  MessageDigestBLAKE2bp digestBLAKE2bp;
+  std::string text = TEXT1;
+
+  digestBLAKE2bp.update(text.c_str(),0,text.length());
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_BLAKE2BP,digestBLAKE2bp.digest());
+}
+
+void MessageDigestBLAKE2bpTest :: testUpdateWithOffset (void)
+{
+  MessageDigestBLAKE2bp digestBLAKE2bp;
+  std::string text = TEXT2;
+
+  digestBLAKE2bp.update(text.c_str(),5,text.length()-5);
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_BLAKE2BP,digestBLAKE2bp.digest());
+}
+
+void MessageDigestBLAKE2bpTest::testAvalancheEffect()
+{
+  MessageDigestBLAKE2bp digestBLAKE2bp;
+
+  CPPUNIT_ASSERT_ASSERTION_FAIL( CPPUNIT_ASSERT_EQUAL( digestBLAKE2bp(TEXT3),digestBLAKE2bp(TEXT4) ) );
+
+}
+
+void MessageDigestBLAKE2bpTest::testUpdateInPieces()
+{
+  const std::string text = TEXT5;
+
+  // pieces that end inside, at and behind chunk boundaries
+  const size_t pieces[] = { 1, 63, 64, 65, 127, 128, 129, 511, 512, 513, 4096 };
+  for (size_t piece : pieces)
+  {
+    MessageDigestBLAKE2bp digestBLAKE2bp;
+    for (size_t offset = 0; offset < text.length(); offset += piece)
+      digestBLAKE2bp.update(text.c_str(),offset,std::min(piece,text.length()-offset));
+
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_BLAKE2BP,digestBLAKE2bp.digest());
+  }
+}
+
+void MessageDigestBLAKE2bpTest::testKernels()
+{
+  const MessageDigestBLAKE2bp::Kernel kernels[] = {
+    MessageDigestBLAKE2bp::Kernel::Generic,
+    MessageDigestBLAKE2bp::Kernel::SSE41,
+    MessageDigestBLAKE2bp::Kernel::AVX2
+  };
+
+  for (auto kernel : kernels)
+  {
+    MessageDigestBLAKE2bp digestBLAKE2bp;
+    if (!digestBLAKE2bp.setKernel(kernel))
+      continue;
+
+    CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_BLAKE2BP,digestBLAKE2bp(TEXT1));
+    CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_BLAKE2BP,digestBLAKE2bp(TEXT2));
+    CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_BLAKE2BP,digestBLAKE2bp(TEXT3));
+    CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_BLAKE2BP,digestBLAKE2bp(TEXT4));
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_BLAKE2BP,digestBLAKE2bp(TEXT5));
+  }
+}
+
+void MessageDigestBLAKE2bpTest::testKeyAndDigestSize()
+{
+  uint8_t key[64 + 1];
+  for (size_t i = 0; i < sizeof(key); i++)
+    key[i] = (uint8_t) i;
+
+  MessageDigestBLAKE2bp digestBLAKE2bp;
+  CPPUNIT_ASSERT(digestBLAKE2bp.setKey(key,64));
+  CPPUNIT_ASSERT_EQUAL(std::string("89d86ad28f4fbba3cf78d6b5a7163ca4e797ebcf4309b768851b803b4093a6730032f8091266bcc09ca559976eaf37cdb80961b1d7f51db43f40dc36a952995f"),digestBLAKE2bp(TEXT3));
+
+  // the key stays for the following digests, an empty key removes it
+  CPPUNIT_ASSERT_EQUAL(std::string("89d86ad28f4fbba3cf78d6b5a7163ca4e797ebcf4309b768851b803b4093a6730032f8091266bcc09ca559976eaf37cdb80961b1d7f51db43f40dc36a952995f"),digestBLAKE2bp(TEXT3));
+  CPPUNIT_ASSERT(digestBLAKE2bp.setKey(key,0));
+  CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_BLAKE2BP,digestBLAKE2bp(TEXT3));
+
+  CPPUNIT_ASSERT(digestBLAKE2bp.setDigestSize(32));
+  CPPUNIT_ASSERT_EQUAL(std::string("c22b6f99b75d9b26e3a08d60881cad2ea5e21502952d633e0c65ed82d97e9b4a"),digestBLAKE2bp(TEXT3));
+
+  // out of range, the settings stay as they are
+  CPPUNIT_ASSERT(!digestBLAKE2bp.setKey(key,64 + 1));
+  CPPUNIT_ASSERT(!digestBLAKE2bp.setDigestSize(0));
+  CPPUNIT_ASSERT(!digestBLAKE2bp.setDigestSize(64 + 1));
+  CPPUNIT_ASSERT_EQUAL(std::string("c22b6f99b75d9b26e3a08d60881cad2ea5e21502952d633e0c65ed82d97e9b4a"),digestBLAKE2bp(TEXT3));
+}
@@ -0,0 +1,96 @@
+#include "MessageDigestBLAKE2sTest.hpp"
+#include "MessageDigest/MessageDigestBLAKE2s.hpp"
+#include "TestConstants.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestBLAKE2sTest);
+
+void MessageDigestBLAKE2sTest :: setUp (void)
+{
+}
+
+void MessageDigestBLAKE2sTest :: tearDown (void)
+{
+}
+
+void MessageDigestBLAKE2sTest :: testCallOperator (void)
+{
+  MessageDigestBLAKE2s digestBLAKE2s;
+
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_BLAKE2S,digestBLAKE2s(TEXT1));
+  CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_BLAKE2S,digestBLAKE2s(TEXT2));
+  CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_BLAKE2S,digestBLAKE2s(TEXT3));
+  CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_BLAKE2S,digestBLAKE2s(TEXT4));
+}
+
+void MessageDigestBLAKE2sTest :: testUpdate (void)
+{
+  MessageDigestBLAKE2s digestBLAKE2s;
+  std::string text = TEXT1;
+
+  digestBLAKE2s.update(text.c_str(),0,text.length());
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_BLAKE2S,digestBLAKE2s.digest());
+}
+
+void MessageDigestBLAKE2sTest :: testUpdateWithOffset (void)
+{
+  MessageDigestBLAKE2s digestBLAKE2s;
+  std::string text = TEXT2;
+
+  digestBLAKE2s.update(text.c_str(),5,text.length()-5);
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_BLAKE2S,digestBLAKE2s.digest());
+}
+
+void MessageDigestBLAKE2sTest::testAvalancheEffect()
+{
+  MessageDigestBLAKE2s digestBLAKE2s;
+
+  CPPUNIT_ASSERT_ASSERTION_FAIL( CPPUNIT_ASSERT_EQUAL( digestBLAKE2s(TEXT3),digestBLAKE2s(TEXT4) ) );
+
+}
+
+void MessageDigestBLAKE2sTest::testKernels()
+{
+  const MessageDigestBLAKE2s::Kernel kernels[] = {
+    MessageDigestBLAKE2s::Kernel::Generic,
+    MessageDigestBLAKE2s::Kernel::SSE41,
+    MessageDigestBLAKE2s::Kernel::AVX2
+  };
+
+  for (auto kernel : kernels)
+  {
+    MessageDigestBLAKE2s digestBLAKE2s;
+    if (!digestBLAKE2s.setKernel(kernel))
+      continue;
+
+    CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_BLAKE2S,digestBLAKE2s(TEXT1));
+    CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_BLAKE2S,digestBLAKE2s(TEXT2));
+    CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_BLAKE2S,digestBLAKE2s(TEXT3));
+    CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_BLAKE2S,digestBLAKE2s(TEXT4));
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_BLAKE2S,digestBLAKE2s(TEXT5));
+  }
+}
+
+void MessageDigestBLAKE2sTest::testKeyAndDigestSize()
+{
+  uint8_t key[32 + 1];
+  for (size_t i = 0; i < sizeof(key); i++)
+    key[i] = (uint8_t) i;
+
+  MessageDigestBLAKE2s digestBLAKE2s;
+  CPPUNIT_ASSERT(digestBLAKE2s.setKey(key,32));
+  CPPUNIT_ASSERT_EQUAL(std::string("385e7d1ecfe5d97ffb8f1b2058a8ea384baaf6d4372b24f984114a6c64dbe432"),digestBLAKE2s(TEXT3));
+
+  // the key stays for the following digests, an empty key removes it
+  CPPUNIT_ASSERT_EQUAL(std::string("385e7d1ecfe5d97ffb8f1b2058a8ea384baaf6d4372b24f984114a6c64dbe432"),digestBLAKE2s(TEXT3));
+  CPPUNIT_ASSERT(digestBLAKE2s.setKey(key,0));
+  CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_BLAKE2S,digestBLAKE2s(TEXT3));
+
+  CPPUNIT_ASSERT(digestBLAKE2s.setDigestSize(16));
+  CPPUNIT_ASSERT_EQUAL(std::string("e5acf7fc6a8cb147e4e766b42bafa358"),digestBLAKE2s(TEXT3));
+
+  // out of range, the settings stay as they are
+  CPPUNIT_ASSERT(!digestBLAKE2s.setKey(key,32 + 1));
+  CPPUNIT_ASSERT(!digestBLAKE2s.setDigestSize(0));
+  CPPUNIT_ASSERT(!digestBLAKE2s.setDigestSize(32 + 1));
+  CPPUNIT_ASSERT_EQUAL(std::string("e5acf7fc6a8cb147e4e766b42bafa358"),digestBLAKE2s(TEXT3));
+}
@@ -0,0 +1,114 @@
+#include "MessageDigestBLAKE2spTest.hpp"
+#include "MessageDigest/MessageDigestBLAKE2sp.hpp"
+#include "TestConstants.h"
+
+#include <algorithm>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestBLAKE2spTest);
+
+void MessageDigestBLAKE2spTest :: setUp (void)
+{
+}
+
+void MessageDigestBLAKE2spTest :: tearDown (void)
+{
+}
+
+void MessageDigestBLAKE2spTest :: testCallOperator (void)
+{
+  MessageDigestBLAKE2sp digestBLAKE2sp;
+
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_BLAKE2SP,digestBLAKE2sp(TEXT1));
+  CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_BLAKE2SP,digestBLAKE2sp(TEXT2));
+  CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_BLAKE2SP,digestBLAKE2sp(TEXT3));
+  CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_BLAKE2SP,digestBLAKE2sp(TEXT4));
+}
+
+void MessageDigestBLAKE2spTest :: testUpdate (void)
+{
+  MessageDigestBLAKE2sp digestBLAKE2sp;
+  std::string text = TEXT1;
+
+  digestBLAKE2sp.update(text.c_str(),0,text.length());
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_BLAKE2SP,digestBLAKE2sp.digest());
+}
+
+void MessageDigestBLAKE2spTest :: testUpdateWithOffset (void)
+{
+  MessageDigestBLAKE2sp digestBLAKE2sp;
+  std::string text = TEXT2;
+
+  digestBLAKE2sp.update(text.c_str(),5,text.length()-5);
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_BLAKE2SP,digestBLAKE2sp.digest());
+}
+
+void MessageDigestBLAKE2spTest::testAvalancheEffect()
+{
+  MessageDigestBLAKE2sp digestBLAKE2sp;
+
+  CPPUNIT_ASSERT_ASSERTION_FAIL( CPPUNIT_ASSERT_EQUAL( digestBLAKE2sp(TEXT3),digestBLAKE2sp(TEXT4) ) );
+
+}
+
+void MessageDigestBLAKE2spTest::testUpdateInPieces()
+{
+  const std::string text = TEXT5;
+
+  // pieces that end inside, at and behind chunk boundaries
+  const size_t pieces[] = { 1, 63, 64, 65, 127, 128, 129, 511, 512, 513, 4096 };
+  for (size_t piece : pieces)
+  {
+    MessageDigestBLAKE2sp digestBLAKE2sp;
+    for (size_t offset = 0; offset < text.length(); offset += piece)
+      digestBLAKE2sp.update(text.c_str(),offset,std::min(piece,text.length()-offset));
+
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_BLAKE2SP,digestBLAKE2sp.digest());
+  }
+}
+
+void MessageDigestBLAKE2spTest::testKernels()
+{
+  const MessageDigestBLAKE2sp::Kernel kernels[] = {
+    MessageDigestBLAKE2sp::Kernel::Generic,
+    MessageDigestBLAKE2sp::Kernel::SSE41,
+    MessageDigestBLAKE2sp::Kernel::AVX2
+  };
+
+  for (auto kernel : kernels)
+  {
+    MessageDigestBLAKE2sp digestBLAKE2sp;
+    if (!digestBLAKE2sp.setKernel(kernel))
+      continue;
+
+    CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_BLAKE2SP,digestBLAKE2sp(TEXT1));
+    CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_BLAKE2SP,digestBLAKE2sp(TEXT2));
+    CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_BLAKE2SP,digestBLAKE2sp(TEXT3));
+    CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_BLAKE2SP,digestBLAKE2sp(TEXT4));
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_BLAKE2SP,digestBLAKE2sp(TEXT5));
+  }
+}
+
+void MessageDigestBLAKE2spTest::testKeyAndDigestSize()
+{
+  uint8_t key[32 + 1];
+  for (size_t i = 0; i < sizeof(key); i++)
+    key[i] = (uint8_t) i;
+
+  MessageDigestBLAKE2sp digestBLAKE2sp;
+  CPPUNIT_ASSERT(digestBLAKE2sp.setKey(key,32));
+  CPPUNIT_ASSERT_EQUAL(std::string("707b9ed4c21fd70f1f556bc3c11e4aa47bc4b60d0cc7d8c59d462e8c3932de88"),digestBLAKE2sp(TEXT3));
+
+  // the key stays for the following digests, an empty key removes it
+  CPPUNIT_ASSERT_EQUAL(std::string("707b9ed4c21fd70f1f556bc3c11e4aa47bc4b60d0cc7d8c59d462e8c3932de88"),digestBLAKE2sp(TEXT3));
+  CPPUNIT_ASSERT(digestBLAKE2sp.setKey(key,0));
+  CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_BLAKE2SP,digestBLAKE2sp(TEXT3));
+
+  CPPUNIT_ASSERT(digestBLAKE2sp.setDigestSize(16));
+  CPPUNIT_ASSERT_EQUAL(std::string("90deb65007743a6fb442ffced41d6561"),digestBLAKE2sp(TEXT3));
+
+  // out of range, the settings stay as they are
+  CPPUNIT_ASSERT(!digestBLAKE2sp.setKey(key,32 + 1));
+  CPPUNIT_ASSERT(!digestBLAKE2sp.setDigestSize(0));
+  CPPUNIT_ASSERT(!digestBLAKE2sp.setDigestSize(32 + 1));
+  CPPUNIT_ASSERT_EQUAL(std::string("90deb65007743a6fb442ffced41d6561"),digestBLAKE2sp(TEXT3));
+}
@@ -0,0 +1,36 @@
+#ifndef MessageDigest_BLAKE2spTest_INCLUDED
+#define MessageDigest_BLAKE2spTest_INCLUDED
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class MessageDigestBLAKE2spTest : public CPPUNIT_NS :: TestFixture
+{
+  CPPUNIT_TEST_SUITE (MessageDigestBLAKE2spTest);
+  CPPUNIT_TEST (testCallOperator);
+  CPPUNIT_TEST (testUpdate);
+  CPPUNIT_TEST (testUpdateWithOffset);
+  CPPUNIT_TEST (testAvalancheEffect);
+  CPPUNIT_TEST (testUpdateInPieces);
+  CPPUNIT_TEST (testKernels);
+  CPPUNIT_TEST (testKeyAndDigestSize);
+  CPPUNIT_TEST_SUITE_END ();
+
+public:
+  void setUp (void);
+  void tearDown (void);
+
+protected:
+  void testCallOperator (void);
+  void testUpdate (void);
+  void testUpdateWithOffset (void);
+  void testAvalancheEffect (void);
+  void testUpdateInPieces (void);
+  void testKernels (void);
+  void testKeyAndDigestSize (void);
+
+private:
+};
+
+
+#endif //MessageDigest_BLAKE2spTest_INCLUDED
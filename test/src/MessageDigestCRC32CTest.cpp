@@ -0,0 +1,88 @@
+#include "MessageDigestCRC32CTest.hpp"
+#include "MessageDigest/MessageDigestCRC32C.hpp"
+#include "TestConstants.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestCRC32CTest);
+
+void MessageDigestCRC32CTest :: setUp (void)
+{
+}
+
+void MessageDigestCRC32CTest :: tearDown (void)
+{
+}
+
+void MessageDigestCRC32CTest :: testCallOperator (void)
+{
+  MessageDigestCRC32C digestCRC32C;
+
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_CRC32C,digestCRC32C(TEXT1));
+  CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_CRC32C,digestCRC32C(TEXT2));
+  CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_CRC32C,digestCRC32C(TEXT3));
+  CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_CRC32C,digestCRC32C(TEXT4));
+}
+
+void MessageDigestCRC32CTest::testUpdate()
+{
+  MessageDigestCRC32C digestCRC32C;
+  std::string text = TEXT1;
+
+  digestCRC32C.update(text.c_str(),0,text.length());
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_CRC32C,digestCRC32C.digest());
+}
+
+void MessageDigestCRC32CTest :: testUpdateWithOffset (void)
+{
+  MessageDigestCRC32C digestCRC32C;
+  std::string text = TEXT2;
+
+  digestCRC32C.update(text.c_str(),5,text.length()-5);
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_CRC32C,digestCRC32C.digest());
+}
+
+void MessageDigestCRC32CTest::testAvalancheEffect()
+{
+  MessageDigestCRC32C digestCRC32C;
+
+  CPPUNIT_ASSERT_ASSERTION_FAIL( CPPUNIT_ASSERT_EQUAL( digestCRC32C(TEXT3),digestCRC32C(TEXT4) ) );
+}
+
+void MessageDigestCRC32CTest::testKernels()
+{
+  const MessageDigestCRC32C::Kernel kernels[] = {
+    MessageDigestCRC32C::Kernel::SlicingBy8,
+    MessageDigestCRC32C::Kernel::SSE42
+  };
+
+  // every length and alignment around the interleaved blocks
+  std::string text;
+  for (size_t i = 0; i < 30000; i++)
+    text.push_back((char) (i * 7 + 3));
+
+  for (auto kernel : kernels)
+  {
+    MessageDigestCRC32C digestCRC32C;
+    if (!digestCRC32C.setKernel(kernel))
+      continue;
+
+    CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_CRC32C,digestCRC32C(TEXT1));
+    CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_CRC32C,digestCRC32C(TEXT2));
+    CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_CRC32C,digestCRC32C(TEXT3));
+    CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_CRC32C,digestCRC32C(TEXT4));
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_CRC32C,digestCRC32C(TEXT5));
+
+    MessageDigestCRC32C reference;
+    reference.setKernel(MessageDigestCRC32C::Kernel::SlicingBy8);
+    for (size_t offset = 0; offset < 16; offset++)
+    {
+      for (size_t length = 0; offset + length <= text.length(); length += (length < 1000) ? 3 : 997)
+      {
+        digestCRC32C.reset();
+        digestCRC32C.update(text.c_str(), offset, length);
+        reference.reset();
+        reference.update(text.c_str(), offset, length);
+        CPPUNIT_ASSERT_EQUAL(reference.digest(),digestCRC32C.digest());
+      }
+    }
+  }
+}
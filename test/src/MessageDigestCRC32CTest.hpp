@@ -0,0 +1,31 @@
+#ifndef MessageDigest_CRC32CTest_INCLUDED
+#define MessageDigest_CRC32CTest_INCLUDED
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class MessageDigestCRC32CTest : public CPPUNIT_NS :: TestFixture
+{
+  CPPUNIT_TEST_SUITE (MessageDigestCRC32CTest);
+  CPPUNIT_TEST (testCallOperator);
+  CPPUNIT_TEST (testUpdate);
+  CPPUNIT_TEST (testUpdateWithOffset);
+  CPPUNIT_TEST (testAvalancheEffect);
+  CPPUNIT_TEST (testKernels);
+  CPPUNIT_TEST_SUITE_END ();
+
+public:
+  void setUp (void);
+  void tearDown (void);
+
+protected:
+  void testCallOperator (void);
+  void testUpdate (void);
+  void testUpdateWithOffset (void);
+  void testAvalancheEffect (void);
+  void testKernels (void);
+
+private:
+};
+
+#endif //MessageDigest_CRC32CTest_INCLUDED
@@ -2,6 +2,9 @@
 #include "MessageDigest/MessageDigestCRC32.hpp"
 #include "TestConstants.h"
 
+#include <cstdio>
+#include <fstream>
+
 CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestCRC32Test);
 
 void MessageDigestCRC32Test :: setUp (void)
@@ -46,3 +49,98 @@ void MessageDigestCRC32Test::testAvalancheEffect()
 
   CPPUNIT_ASSERT_ASSERTION_FAIL( CPPUNIT_ASSERT_EQUAL( digestCRC32(TEXT3),digestCRC32(TEXT4) ) );
 }
+
+void MessageDigestCRC32Test::testKernels()
+{
+  const MessageDigestCRC32::Kernel kernels[] = {
+    MessageDigestCRC32::Kernel::SlicingBy8,
+    MessageDigestCRC32::Kernel::PCLMUL
+  };
+
+  // every length and alignment around the 16 and 64 byte folds
+  std::string text;
+  for (size_t i = 0; i < 300; i++)
+    text.push_back((char) (i * 7 + 3));
+
+  for (auto kernel : kernels)
+  {
+    MessageDigestCRC32 digestCRC32;
+    if (!digestCRC32.setKernel(kernel))
+      continue;
+
+    CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_CRC32,digestCRC32(TEXT1));
+    CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_CRC32,digestCRC32(TEXT2));
+    CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_CRC32,digestCRC32(TEXT3));
+    CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_CRC32,digestCRC32(TEXT4));
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_CRC32,digestCRC32(TEXT5));
+
+    MessageDigestCRC32 reference;
+    reference.setKernel(MessageDigestCRC32::Kernel::SlicingBy8);
+    for (size_t offset = 0; offset < 16; offset++)
+    {
+      for (size_t length = 0; offset + length <= text.length(); length += 3)
+      {
+        digestCRC32.reset();
+        digestCRC32.update(text.c_str(), offset, length);
+        reference.reset();
+        reference.update(text.c_str(), offset, length);
+        CPPUNIT_ASSERT_EQUAL(reference.digest(),digestCRC32.digest());
+      }
+    }
+  }
+}
+
+void MessageDigestCRC32Test::testCombine()
+{
+  const std::string texts[] = { TEXT1, TEXT2, TEXT3, TEXT4 };
+
+  for (const auto& text : texts)
+  {
+    for (size_t split = 0; split <= text.length(); split++)
+    {
+      MessageDigestCRC32 head;
+      head.update(text.c_str(), 0, split);
+      MessageDigestCRC32 tail;
+      tail.update(text.c_str(), split, text.length() - split);
+
+      head.combine(tail);
+      CPPUNIT_ASSERT_EQUAL(MessageDigestCRC32()(text),head.digest());
+    }
+  }
+}
+
+void MessageDigestCRC32Test::testUpdateParallel()
+{
+  const std::string head = TEXT1;
+  const std::string text = TEXT5;
+
+  for (unsigned numThreads = 0; numThreads <= 5; numThreads++)
+  {
+    MessageDigestCRC32 digestCRC32;
+    digestCRC32.updateParallel(text.c_str(), 0, text.length(), numThreads);
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_CRC32,digestCRC32.digest());
+
+    // continue an existing hash
+    digestCRC32.reset();
+    digestCRC32.update(head.c_str(), 0, head.length());
+    digestCRC32.updateParallel(text.c_str(), 0, text.length(), numThreads);
+    CPPUNIT_ASSERT_EQUAL(MessageDigestCRC32()(head + text),digestCRC32.digest());
+  }
+
+  const char* fileName = "MessageDigestCRC32Test.tmp";
+  {
+    std::ofstream file(fileName, std::ios::binary);
+    file.write(text.c_str(), text.length());
+  }
+
+  for (unsigned numThreads = 1; numThreads <= 5; numThreads++)
+  {
+    MessageDigestCRC32 digestCRC32;
+    CPPUNIT_ASSERT(digestCRC32.updateParallel(fileName, numThreads));
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_CRC32,digestCRC32.digest());
+  }
+  std::remove(fileName);
+
+  MessageDigestCRC32 digestCRC32;
+  CPPUNIT_ASSERT(!digestCRC32.updateParallel(fileName));
+}
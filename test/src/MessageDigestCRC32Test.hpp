@@ -11,6 +11,9 @@ class MessageDigestCRC32Test : public CPPUNIT_NS :: TestFixture
   CPPUNIT_TEST (testUpdate);
   CPPUNIT_TEST (testUpdateWithOffset);
   CPPUNIT_TEST (testAvalancheEffect);
+  CPPUNIT_TEST (testKernels);
+  CPPUNIT_TEST (testCombine);
+  CPPUNIT_TEST (testUpdateParallel);
   CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -22,6 +25,9 @@ protected:
   void testUpdate (void);
   void testUpdateWithOffset (void);
   void testAvalancheEffect (void);
+  void testKernels (void);
+  void testCombine (void);
+  void testUpdateParallel (void);
 
 private:
 };
@@ -0,0 +1,113 @@
+#include "MessageDigestDirectoryTest.hpp"
+#include "MessageDigest/MessageDigestDirectory.hpp"
+#include "MessageDigest/MessageDigest.hpp"
+#include "TestConstants.h"
+
+#include <cstdio>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestDirectoryTest);
+
+void MessageDigestDirectoryTest :: setUp (void)
+{
+}
+
+void MessageDigestDirectoryTest :: tearDown (void)
+{
+}
+
+void MessageDigestDirectoryTest::testHashTree()
+{
+#if defined(__unix__) || defined(__APPLE__)
+  const std::string root = "MessageDigestDirectoryTest.tmp";
+  const char* directories[] = { "", "/b", "/b/c", "/empty" };
+  // one large file among many small ones, sorted by path
+  const char* files[] = { "a.txt", "b/c/deep.txt", "b/large.bin", "b/small0", "b/small1", "b/small2", "z" };
+
+  for (const char* directory : directories)
+    mkdir((root + directory).c_str(), 0755);
+
+  std::vector<MessageDigestDirectoryEntry> expected;
+  for (const char* file : files)
+  {
+    std::string path = root + "/" + file;
+    size_t size = (std::string(file) == "b/large.bin") ? 3*1024*1024 : std::string(file).length() * 100;
+    {
+      std::ofstream out(path, std::ios::binary);
+      out << std::string(size, file[0]);
+    }
+    expected.push_back(MessageDigestDirectoryEntry(file, MessageDigest::hashFile(path, "SHA1")));
+  }
+  // not followed
+  CPPUNIT_ASSERT_EQUAL(0, symlink("b", (root + "/link").c_str()));
+
+  for (unsigned numThreads : { 1u, 2u, 5u })
+  {
+    MessageDigestDirectory directory("SHA1");
+    directory.setNumThreads(numThreads);
+    directory.setBufferSize(4096);
+
+    std::vector<MessageDigestDirectoryEntry> entries;
+    CPPUNIT_ASSERT(directory.hashTree(root + "/", entries));
+    CPPUNIT_ASSERT(expected == entries);
+  }
+
+  std::remove((root + "/link").c_str());
+  for (const char* file : files)
+    std::remove((root + "/" + file).c_str());
+  for (int i = 3; i >= 0; i--)
+    std::remove((root + directories[i]).c_str());
+#endif
+}
+
+void MessageDigestDirectoryTest::testInvalidRoot()
+{
+  std::vector<MessageDigestDirectoryEntry> entries;
+  CPPUNIT_ASSERT(!MessageDigestDirectory("SHA1").hashTree("MessageDigestDirectoryTest.missing", entries));
+  CPPUNIT_ASSERT(!MessageDigestDirectory("unknown").hashTree(".", entries));
+  CPPUNIT_ASSERT(entries.empty());
+}
+
+void MessageDigestDirectoryTest::testUnreadableDirectory()
+{
+#if defined(__unix__) || defined(__APPLE__)
+  // root reads the directory anyway
+  if (geteuid() == 0)
+    return;
+
+  const std::string root = "MessageDigestDirectoryTest.unreadable";
+  mkdir(root.c_str(), 0755);
+  mkdir((root + "/locked").c_str(), 0755);
+  {
+    std::ofstream out(root + "/locked/hidden.txt");
+    out << TEXT1;
+  }
+  {
+    std::ofstream out(root + "/visible.txt");
+    out << TEXT1;
+  }
+  chmod((root + "/locked").c_str(), 0);
+
+  std::vector<MessageDigestDirectoryEntry> entries;
+  CPPUNIT_ASSERT(MessageDigestDirectory("SHA1").hashTree(root, entries));
+  CPPUNIT_ASSERT_EQUAL((size_t) 2, entries.size());
+  CPPUNIT_ASSERT(MessageDigestDirectoryEntry("locked/", "") == entries[0]);
+  CPPUNIT_ASSERT(MessageDigestDirectoryEntry("visible.txt", TEXT1_HASH_SHA1) == entries[1]);
+
+  // nothing at all can be listed
+  chmod(root.c_str(), 0);
+  CPPUNIT_ASSERT(!MessageDigestDirectory("SHA1").hashTree(root, entries));
+  chmod(root.c_str(), 0755);
+
+  chmod((root + "/locked").c_str(), 0755);
+  std::remove((root + "/locked/hidden.txt").c_str());
+  std::remove((root + "/visible.txt").c_str());
+  std::remove((root + "/locked").c_str());
+  std::remove(root.c_str());
+#endif
+}
@@ -0,0 +1,27 @@
+#ifndef MessageDigest_DirectoryTest_INCLUDED
+#define MessageDigest_DirectoryTest_INCLUDED
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class MessageDigestDirectoryTest : public CPPUNIT_NS :: TestFixture
+{
+  CPPUNIT_TEST_SUITE (MessageDigestDirectoryTest);
+  CPPUNIT_TEST (testHashTree);
+  CPPUNIT_TEST (testInvalidRoot);
+  CPPUNIT_TEST (testUnreadableDirectory);
+  CPPUNIT_TEST_SUITE_END ();
+
+public:
+  void setUp (void);
+  void tearDown (void);
+
+protected:
+  void testHashTree (void);
+  void testInvalidRoot (void);
+  void testUnreadableDirectory (void);
+
+private:
+};
+
+#endif //MessageDigest_DirectoryTest_INCLUDED
@@ -0,0 +1,171 @@
+#include "MessageDigestEncodingTest.hpp"
+#include "MessageDigest/MessageDigestEncoding.hpp"
+#include "TestConstants.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestEncodingTest);
+
+namespace
+{
+  const MessageDigestEncoding::Kernel kernels[] = {
+    MessageDigestEncoding::Kernel::Generic,
+    MessageDigestEncoding::Kernel::SSSE3,
+    MessageDigestEncoding::Kernel::AVX2
+  };
+
+  std::vector<uint8_t> bytes(const std::string& text)
+  {
+    return std::vector<uint8_t>(text.begin(), text.end());
+  }
+}
+
+void MessageDigestEncodingTest :: setUp (void)
+{
+}
+
+void MessageDigestEncodingTest :: tearDown (void)
+{
+}
+
+void MessageDigestEncodingTest::testHexKernels()
+{
+  std::vector<uint8_t> data(300);
+  for (size_t i = 0; i < data.size(); i++)
+    data[i] = (uint8_t) (i * 37 + 11);
+
+  // all lengths around the 16 and 32 byte rounds
+  for (size_t size = 0; size < 100; size++)
+  {
+    std::string reference(2*size, 0);
+    MessageDigestEncoding::encodeHex(data.data(), size, &reference[0], MessageDigestEncoding::Kernel::Generic);
+
+    for (auto kernel : kernels)
+    {
+      if (!MessageDigestEncoding::isSupported(kernel))
+        continue;
+
+      std::string hex(2*size, 0);
+      MessageDigestEncoding::encodeHex(data.data(), size, &hex[0], kernel);
+      CPPUNIT_ASSERT_EQUAL(reference, hex);
+
+      std::vector<uint8_t> decoded(size);
+      CPPUNIT_ASSERT(MessageDigestEncoding::decodeHex(hex.data(), hex.length(), decoded.data(), kernel));
+      CPPUNIT_ASSERT(std::equal(decoded.begin(), decoded.end(), data.begin()));
+
+      // upper case decodes to the same bytes
+      for (auto& c : hex)
+        c = toupper(c);
+      CPPUNIT_ASSERT(MessageDigestEncoding::decodeHex(hex.data(), hex.length(), decoded.data(), kernel));
+      CPPUNIT_ASSERT(std::equal(decoded.begin(), decoded.end(), data.begin()));
+    }
+  }
+
+  const uint8_t edges[] = { 0x00, 0xff, 0x7f, 0x80 };
+  CPPUNIT_ASSERT_EQUAL(std::string("00ff7f80"), MessageDigestEncoding::toHex(edges, sizeof(edges)));
+}
+
+void MessageDigestEncodingTest::testInvalidHex()
+{
+  // each position of a long input runs through every part of the SIMD kernels
+  std::string valid(128, 'a');
+  const char invalid[] = { 'g', 'G', '/', ':', '@', '`', ' ', '\0', '\xe1' };
+
+  for (auto kernel : kernels)
+  {
+    if (!MessageDigestEncoding::isSupported(kernel))
+      continue;
+
+    std::vector<uint8_t> decoded(valid.length() / 2);
+    CPPUNIT_ASSERT(!MessageDigestEncoding::decodeHex(valid.data(), 3, decoded.data(), kernel));
+
+    for (size_t position = 0; position < valid.length(); position++)
+    {
+      for (char c : invalid)
+      {
+        std::string hex = valid;
+        hex[position] = c;
+        CPPUNIT_ASSERT(!MessageDigestEncoding::decodeHex(hex.data(), hex.length(), decoded.data(), kernel));
+      }
+    }
+  }
+
+  std::vector<uint8_t> decoded;
+  CPPUNIT_ASSERT(!MessageDigestEncoding::fromHex("abc", decoded));
+  CPPUNIT_ASSERT(decoded.empty());
+}
+
+void MessageDigestEncodingTest::testBase64()
+{
+  // test vectors of RFC 4648 section 10
+  const char* texts[]   = { "", "f", "fo", "foo", "foob", "fooba", "foobar" };
+  const char* encoded[] = { "", "Zg==", "Zm8=", "Zm9v", "Zm9vYg==", "Zm9vYmE=", "Zm9vYmFy" };
+
+  for (int i = 0; i < 7; i++)
+  {
+    std::vector<uint8_t> data = bytes(texts[i]);
+    CPPUNIT_ASSERT_EQUAL(std::string(encoded[i]), MessageDigestEncoding::toBase64(data.data(), data.size()));
+
+    std::vector<uint8_t> decoded;
+    CPPUNIT_ASSERT(MessageDigestEncoding::fromBase64(encoded[i], decoded));
+    CPPUNIT_ASSERT(data == decoded);
+  }
+
+  std::vector<uint8_t> decoded;
+  CPPUNIT_ASSERT(MessageDigestEncoding::fromBase64("Zm9vYg", decoded));
+  CPPUNIT_ASSERT(bytes("foob") == decoded);
+
+  CPPUNIT_ASSERT(!MessageDigestEncoding::fromBase64("Zm9vY", decoded));
+  CPPUNIT_ASSERT(!MessageDigestEncoding::fromBase64("Zm9v!", decoded));
+  CPPUNIT_ASSERT(!MessageDigestEncoding::fromBase64("Zg=", decoded));
+}
+
+void MessageDigestEncodingTest::testBase32()
+{
+  // test vectors of RFC 4648 section 10
+  const char* texts[]   = { "", "f", "fo", "foo", "foob", "fooba", "foobar" };
+  const char* encoded[] = { "", "MY======", "MZXQ====", "MZXW6===", "MZXW6YQ=", "MZXW6YTB", "MZXW6YTBOI======" };
+
+  for (int i = 0; i < 7; i++)
+  {
+    std::vector<uint8_t> data = bytes(texts[i]);
+    CPPUNIT_ASSERT_EQUAL(std::string(encoded[i]), MessageDigestEncoding::toBase32(data.data(), data.size()));
+
+    std::vector<uint8_t> decoded;
+    CPPUNIT_ASSERT(MessageDigestEncoding::fromBase32(encoded[i], decoded));
+    CPPUNIT_ASSERT(data == decoded);
+  }
+
+  std::vector<uint8_t> decoded;
+  CPPUNIT_ASSERT(MessageDigestEncoding::fromBase32("mzxw6ytboi", decoded));
+  CPPUNIT_ASSERT(bytes("foobar") == decoded);
+
+  CPPUNIT_ASSERT(!MessageDigestEncoding::fromBase32("MZX", decoded));
+  CPPUNIT_ASSERT(!MessageDigestEncoding::fromBase32("MZXW1===", decoded));
+}
+
+void MessageDigestEncodingTest::testParseChecksumLine()
+{
+  std::vector<uint8_t> digest;
+  std::string fileName;
+
+  CPPUNIT_ASSERT(MessageDigestEncoding::parseChecksumLine(TEXT1_HASH_CRC32 + "  some file.txt\n", digest, fileName));
+  CPPUNIT_ASSERT_EQUAL(std::string("some file.txt"), fileName);
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_CRC32, MessageDigestEncoding::toHex(digest.data(), digest.size()));
+
+  CPPUNIT_ASSERT(MessageDigestEncoding::parseChecksumLine(TEXT1_HASH_SHA256 + " *image.bin\r\n", digest, fileName));
+  CPPUNIT_ASSERT_EQUAL(std::string("image.bin"), fileName);
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA256, MessageDigestEncoding::toHex(digest.data(), digest.size()));
+
+  CPPUNIT_ASSERT(MessageDigestEncoding::parseChecksumLine("SHA256 (a (b).txt) = " + TEXT2_HASH_SHA256, digest, fileName));
+  CPPUNIT_ASSERT_EQUAL(std::string("a (b).txt"), fileName);
+  CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHA256, MessageDigestEncoding::toHex(digest.data(), digest.size()));
+
+  CPPUNIT_ASSERT(!MessageDigestEncoding::parseChecksumLine("xyz  file.txt", digest, fileName));
+  CPPUNIT_ASSERT(!MessageDigestEncoding::parseChecksumLine("", digest, fileName));
+
+  // empty and odd length digests
+  CPPUNIT_ASSERT(!MessageDigestEncoding::parseChecksumLine("  file.txt", digest, fileName));
+  CPPUNIT_ASSERT(!MessageDigestEncoding::parseChecksumLine("abc  file.txt", digest, fileName));
+  CPPUNIT_ASSERT(!MessageDigestEncoding::parseChecksumLine("SHA256 (file.txt) = ", digest, fileName));
+  CPPUNIT_ASSERT(!MessageDigestEncoding::parseChecksumLine("SHA256 (file.txt) = \n", digest, fileName));
+  CPPUNIT_ASSERT(!MessageDigestEncoding::parseChecksumLine("SHA256 (file.txt) = abc", digest, fileName));
+}
@@ -0,0 +1,31 @@
+#ifndef MessageDigest_EncodingTest_INCLUDED
+#define MessageDigest_EncodingTest_INCLUDED
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class MessageDigestEncodingTest : public CPPUNIT_NS :: TestFixture
+{
+  CPPUNIT_TEST_SUITE (MessageDigestEncodingTest);
+  CPPUNIT_TEST (testHexKernels);
+  CPPUNIT_TEST (testInvalidHex);
+  CPPUNIT_TEST (testBase64);
+  CPPUNIT_TEST (testBase32);
+  CPPUNIT_TEST (testParseChecksumLine);
+  CPPUNIT_TEST_SUITE_END ();
+
+public:
+  void setUp (void);
+  void tearDown (void);
+
+protected:
+  void testHexKernels (void);
+  void testInvalidHex (void);
+  void testBase64 (void);
+  void testBase32 (void);
+  void testParseChecksumLine (void);
+
+private:
+};
+
+#endif //MessageDigest_EncodingTest_INCLUDED
@@ -0,0 +1,94 @@
+#include "MessageDigestFileBatchTest.hpp"
+#include "MessageDigest/MessageDigestFileBatch.hpp"
+#include "MessageDigest/MessageDigest.hpp"
+#include "TestConstants.h"
+
+#include <cstdio>
+#include <fstream>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestFileBatchTest);
+
+namespace
+{
+  /// sizes around the 4096 byte chunks used by the test, one file is missing
+  std::vector<std::string> createFiles()
+  {
+    const size_t sizes[] = { 0, 1, 4095, 4096, 4097, 3*4096 + 5, 100000, 17, 64*1024 };
+
+    std::vector<std::string> fileNames;
+    for (size_t size : sizes)
+    {
+      std::string fileName = "MessageDigestFileBatchTest" + std::to_string(fileNames.size()) + ".tmp";
+      std::string text(size, 0);
+      for (size_t i = 0; i < size; i++)
+        text[i] = (char) (i * 13 + size);
+
+      std::ofstream file(fileName, std::ios::binary);
+      file.write(text.data(), (std::streamsize) text.length());
+      fileNames.push_back(fileName);
+    }
+    fileNames.insert(fileNames.begin() + 3, "MessageDigestFileBatchTest.missing");
+    return fileNames;
+  }
+}
+
+void MessageDigestFileBatchTest :: setUp (void)
+{
+}
+
+void MessageDigestFileBatchTest :: tearDown (void)
+{
+}
+
+void MessageDigestFileBatchTest::testEngines()
+{
+  const MessageDigestFileBatch::Engine engines[] = {
+    MessageDigestFileBatch::Engine::Threads,
+    MessageDigestFileBatch::Engine::IoUring
+  };
+
+  std::vector<std::string> fileNames = createFiles();
+  std::vector<std::string> batchFiles = fileNames;
+#ifndef _WIN32
+  // devices are not read through the ring
+  batchFiles.push_back("/dev/null");
+#endif
+
+  for (auto engine : engines)
+  {
+    // a shallow queue forces reads of several files to interleave
+    for (unsigned queueDepth : { 1u, 3u, 32u })
+    {
+      MessageDigestFileBatch batch("SHA256");
+      if (!batch.setEngine(engine))
+        continue;
+      batch.setQueueDepth(queueDepth);
+      batch.setChunkSize(4096);
+
+      std::vector<std::string> digests = batch.hashFiles(batchFiles);
+      CPPUNIT_ASSERT_EQUAL(batchFiles.size(), digests.size());
+      for (size_t i = 0; i < batchFiles.size(); i++)
+        CPPUNIT_ASSERT_EQUAL(MessageDigest::hashFile(batchFiles[i], "SHA256"), digests[i]);
+      CPPUNIT_ASSERT(digests[3].empty());
+    }
+  }
+
+  for (const auto& fileName : fileNames)
+    std::remove(fileName.c_str());
+
+  // out of range depths are clamped
+  MessageDigestFileBatch clamped("SHA256");
+  clamped.setQueueDepth(0);
+  CPPUNIT_ASSERT_EQUAL(1u, clamped.getQueueDepth());
+  clamped.setQueueDepth(100000);
+  CPPUNIT_ASSERT_EQUAL((unsigned) MessageDigestFileBatch::MaxQueueDepth, clamped.getQueueDepth());
+}
+
+void MessageDigestFileBatchTest::testUnknownAlgorithm()
+{
+
+  MessageDigestFileBatch batch("unknown");
+  std::vector<std::string> digests = batch.hashFiles({ "a", "b" });
+  CPPUNIT_ASSERT_EQUAL((size_t) 2, digests.size());
+  CPPUNIT_ASSERT(digests[0].empty() && digests[1].empty());
+}
@@ -0,0 +1,25 @@
+#ifndef MessageDigest_FileBatchTest_INCLUDED
+#define MessageDigest_FileBatchTest_INCLUDED
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class MessageDigestFileBatchTest : public CPPUNIT_NS :: TestFixture
+{
+  CPPUNIT_TEST_SUITE (MessageDigestFileBatchTest);
+  CPPUNIT_TEST (testEngines);
+  CPPUNIT_TEST (testUnknownAlgorithm);
+  CPPUNIT_TEST_SUITE_END ();
+
+public:
+  void setUp (void);
+  void tearDown (void);
+
+protected:
+  void testEngines (void);
+  void testUnknownAlgorithm (void);
+
+private:
+};
+
+#endif //MessageDigest_FileBatchTest_INCLUDED
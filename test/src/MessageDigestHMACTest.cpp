@@ -0,0 +1,126 @@
+#include "MessageDigestHMACTest.hpp"
+#include "MessageDigest/MessageDigestHMAC.hpp"
+#include "TestConstants.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestHMACTest);
+
+namespace
+{
+  // RFC 2202 and RFC 4231 test case 2
+  const std::string KEY_JEFE("Jefe");
+  const std::string TEXT_JEFE("what do ya want for nothing?");
+
+  // RFC 4231 test case 6, the key is longer than a block
+  const std::string KEY_LONG(131, '\xaa');
+  const std::string TEXT_LONG("Test Using Larger Than Block-Size Key - Hash Key First");
+
+  struct KnownValue
+  {
+    const char* algorithm;
+    const char* jefe;
+    const char* longKey;
+    const char* empty;
+  };
+
+  const KnownValue knownValues[] = {
+    { "MD5",
+      "750c783e6ab0b503eaa86e310a5db738",
+      "bfecaf4efff90a3a668f3922fec3762d",
+      "74e6f7298a9c2d168935f58c001bad88" },
+    { "SHA1",
+      "effcdf6ae5eb2fa2d27416d5f184df9c259a7c79",
+      "90d0dace1c1bdc957339307803160335bde6df2b",
+      "fbdb1d1b18aa6c08324b7d64b71fb76370690e1d" },
+    { "SHA256",
+      "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843",
+      "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54",
+      "b613679a0814d9ec772f95d778c35fc5ff1697c493715653c6c712144292c5ad" },
+    { "SHA512",
+      "164b7a7bfcf819e2e395fbe73b56e0a387bd64222e831fd610270cd7ea2505549758bf75c05a994a6d034f65f8f0e6fdcaeab1a34d4a6b4b636e070a38bce737",
+      "80b24263c7c1a3ebb71493c1dd7be8b49b46d1f41b4aeec1121b013783f8f3526b56d037e05f2598bd0fd2215d6a1e5295e64f73f63f0aec8b915a985d786598",
+      "b936cee86c9f87aa5d3c6f2e84cb5a4239a5fe50480a6ec66b70ab5b1f4ac6730c6c515421b327ec1d69402e53dfb49ad7381eb067b338fd7b0cb22247225d47" }
+  };
+}
+
+void MessageDigestHMACTest :: setUp (void)
+{
+}
+
+void MessageDigestHMACTest :: tearDown (void)
+{
+}
+
+void MessageDigestHMACTest::testKnownValues()
+{
+  for (const auto& known : knownValues)
+  {
+    auto hmac = MessageDigestHMAC::createInstance(known.algorithm, KEY_JEFE);
+    CPPUNIT_ASSERT(hmac != nullptr);
+    CPPUNIT_ASSERT_EQUAL("HMAC-" + std::string(known.algorithm),hmac->getAlgorithm());
+    CPPUNIT_ASSERT_EQUAL(std::string(known.jefe),(*hmac)(TEXT_JEFE));
+    // the keyed midstates are reused
+    CPPUNIT_ASSERT_EQUAL(std::string(known.jefe),(*hmac)(TEXT_JEFE));
+
+    hmac = MessageDigestHMAC::createInstance(known.algorithm, KEY_LONG);
+    CPPUNIT_ASSERT_EQUAL(std::string(known.longKey),(*hmac)(TEXT_LONG));
+
+    hmac = MessageDigestHMAC::createInstance(known.algorithm, std::string());
+    CPPUNIT_ASSERT_EQUAL(std::string(known.empty),(*hmac)(std::string()));
+  }
+}
+
+void MessageDigestHMACTest::testStreaming()
+{
+  auto hmac = MessageDigestHMAC::createInstance("SHA256", KEY_JEFE);
+  hmac->update(TEXT_JEFE.substr(0, 10));
+  std::string partial = hmac->digest();
+  hmac->update(TEXT_JEFE.substr(10));
+  CPPUNIT_ASSERT_EQUAL(std::string(knownValues[2].jefe),hmac->digest());
+  CPPUNIT_ASSERT_EQUAL(partial,(*hmac)(TEXT_JEFE.substr(0, 10)));
+
+  hmac->reset();
+  hmac->update(TEXT_JEFE);
+  CPPUNIT_ASSERT_EQUAL(std::string(knownValues[2].jefe),hmac->digest());
+}
+
+void MessageDigestHMACTest::testVerify()
+{
+  auto hmac = MessageDigestHMAC::createInstance("SHA256", KEY_JEFE);
+  size_t macSize = hmac->getDigestSize();
+  CPPUNIT_ASSERT_EQUAL((size_t) 32,macSize);
+
+  const std::string texts[] = { TEXT1, TEXT2, TEXT3, TEXT_JEFE };
+  std::vector<MessageDigestInput> inputs;
+  for (const auto& text : texts)
+    inputs.push_back(MessageDigestInput(text.c_str(), text.length()));
+
+  std::vector<uint8_t> macs(inputs.size() * macSize);
+  hmac->digestBatch(inputs.data(), inputs.size(), macs.data());
+  for (size_t i = 0; i < inputs.size(); i++)
+  {
+    CPPUNIT_ASSERT(hmac->verify(texts[i].c_str(), texts[i].length(), macs.data() + i * macSize, macSize));
+    // truncated MACs, but not empty ones
+    CPPUNIT_ASSERT(hmac->verify(texts[i].c_str(), texts[i].length(), macs.data() + i * macSize, 16));
+    CPPUNIT_ASSERT(!hmac->verify(texts[i].c_str(), texts[i].length(), macs.data() + i * macSize, 0));
+  }
+
+  bool valid[4];
+  CPPUNIT_ASSERT(hmac->verifyBatch(inputs.data(), inputs.size(), macs.data(), valid));
+
+  macs[2 * macSize + 31] ^= 1;
+  CPPUNIT_ASSERT(!hmac->verifyBatch(inputs.data(), inputs.size(), macs.data(), valid));
+  CPPUNIT_ASSERT(valid[0] && valid[1] && !valid[2] && valid[3]);
+  CPPUNIT_ASSERT(!hmac->verifyBatch(inputs.data(), inputs.size(), macs.data(), nullptr));
+
+  // a different key doesn't verify
+  auto other = MessageDigestHMAC::createInstance("SHA256", "Jeff");
+  CPPUNIT_ASSERT(!other->verify(texts[0].c_str(), texts[0].length(), macs.data(), macSize));
+}
+
+void MessageDigestHMACTest::testUnsupported()
+{
+  CPPUNIT_ASSERT(MessageDigestHMAC::createInstance("CRC32", KEY_JEFE) == nullptr);
+  CPPUNIT_ASSERT(MessageDigestHMAC::createInstance("SHA256-TREE", KEY_JEFE) == nullptr);
+  CPPUNIT_ASSERT(MessageDigestHMAC::createInstance("unknown", KEY_JEFE) == nullptr);
+  CPPUNIT_ASSERT(MessageDigestHMAC::createInstance("SHA224", KEY_JEFE) != nullptr);
+}
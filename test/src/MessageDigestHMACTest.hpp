@@ -0,0 +1,29 @@
+#ifndef MessageDigest_HMACTest_INCLUDED
+#define MessageDigest_HMACTest_INCLUDED
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class MessageDigestHMACTest : public CPPUNIT_NS :: TestFixture
+{
+  CPPUNIT_TEST_SUITE (MessageDigestHMACTest);
+  CPPUNIT_TEST (testKnownValues);
+  CPPUNIT_TEST (testStreaming);
+  CPPUNIT_TEST (testVerify);
+  CPPUNIT_TEST (testUnsupported);
+  CPPUNIT_TEST_SUITE_END ();
+
+public:
+  void setUp (void);
+  void tearDown (void);
+
+protected:
+  void testKnownValues (void);
+  void testStreaming (void);
+  void testVerify (void);
+  void testUnsupported (void);
+
+private:
+};
+
+#endif //MessageDigest_HMACTest_INCLUDED
@@ -48,3 +48,44 @@ void MessageDigestMD5Test :: testAvalancheEffect ()
   CPPUNIT_ASSERT_ASSERTION_FAIL( CPPUNIT_ASSERT_EQUAL( digestMD5(TEXT3),digestMD5(TEXT4) ) );
 
 }
+
+void MessageDigestMD5Test::testDigestBatch()
+{
+  const MessageDigestMD5::BatchKernel kernels[] = {
+    MessageDigestMD5::BatchKernel::Serial,
+    MessageDigestMD5::BatchKernel::AVX2,
+    MessageDigestMD5::BatchKernel::AVX512
+  };
+
+  // known texts, then all lengths around the padding boundaries
+  std::vector<std::string> texts = { TEXT1, TEXT2, TEXT3, TEXT4, TEXT5 };
+  for (size_t length = 0; length < 200; length++)
+    texts.push_back(std::string(length, (char) length));
+
+  std::vector<MessageDigestInput> inputs;
+  for (const auto& text : texts)
+    inputs.push_back(MessageDigestInput(text.c_str(), text.length()));
+
+  for (auto kernel : kernels)
+  {
+    MessageDigestMD5 digestMD5;
+    if (!digestMD5.setBatchKernel(kernel))
+      continue;
+
+    // a batch resets the running digest on every kernel
+    digestMD5.update(texts[0].c_str(),0,texts[0].length());
+    std::vector<std::string> digests = digestMD5.digestBatch(inputs);
+    CPPUNIT_ASSERT_EQUAL(texts.size(), digests.size());
+    CPPUNIT_ASSERT_EQUAL(MessageDigestMD5()(std::string()),digestMD5.digest());
+
+    CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_MD5,digests[0]);
+    CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_MD5,digests[1]);
+    CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_MD5,digests[2]);
+    CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_MD5,digests[3]);
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_MD5,digests[4]);
+
+    MessageDigestMD5 reference;
+    for (size_t i = 0; i < texts.size(); i++)
+      CPPUNIT_ASSERT_EQUAL(reference(texts[i]),digests[i]);
+  }
+}
@@ -11,6 +11,7 @@ class MessageDigestMD5Test : public CPPUNIT_NS :: TestFixture
   CPPUNIT_TEST (testUpdate);
   CPPUNIT_TEST (testUpdateWithOffset);
   CPPUNIT_TEST (testAvalancheEffect);
+  CPPUNIT_TEST (testDigestBatch);
   CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -22,6 +23,7 @@ protected:
   void testUpdate (void);
   void testUpdateWithOffset (void);
   void testAvalancheEffect (void);
+  void testDigestBatch (void);
 
 private:
 };
@@ -0,0 +1,107 @@
+#include "MessageDigestPBKDF2Test.hpp"
+#include "MessageDigest/MessageDigestPBKDF2.hpp"
+#include "MessageDigest/MessageDigestEncoding.hpp"
+
+#include <algorithm>
+#include <vector>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestPBKDF2Test);
+
+namespace
+{
+  struct KnownValue
+  {
+    const char* algorithm;
+    const char* password;
+    const char* salt;
+    uint32_t    iterations;
+    const char* key;
+  };
+
+  // RFC 6070 for SHA1, the others computed with Python's hashlib
+  const KnownValue knownValues[] = {
+    { "SHA1", "password", "salt", 1, "0c60c80f961f0e71f3a9b524af6012062fe037a6" },
+    { "SHA1", "password", "salt", 2, "ea6c014dc72d6f8ccd1ed92ace1d41f0d8de8957" },
+    { "SHA1", "password", "salt", 4096, "4b007901b765489abead49d926f721d065a429c1" },
+    { "SHA1", "passwordPASSWORDpassword", "saltSALTsaltSALTsaltSALTsaltSALTsalt", 4096,
+      "3d2eec4fe41c849b80c8d83662c0e44a8b291a964cf2f07038" },
+    { "SHA224", "password", "salt", 4096, "218c453bf90635bd0a21a75d172703ff6108ef60" },
+    { "SHA256", "password", "salt", 4096, "c5e478d59288c841aa530db6845c4c8d962893a0" },
+    { "SHA256", "passwordPASSWORDpassword", "saltSALTsaltSALTsaltSALTsaltSALTsalt", 4096,
+      "348c89dbcbd32b2f32d814b8116e84cf2b17347ebc1800181c4e2a1fb8dd53e1c635518c" },
+    { "SHA384", "password", "salt", 4096, "559726be38db125bc85ed7895f6e3cf574c7a01c" },
+    { "SHA512", "password", "salt", 4096, "d197b1b33db0143e018b12f3d1d1479e6cdebdcc" },
+    { "SHA512/256", "password", "salt", 4096,
+      "f2fbe5f8ec3618bb145279a8c6a8dfa476c282a3ed53d8c257d51ce021d3877d3b50c84a7f9158d4" },
+    { "SHA512", "passwordPASSWORDpassword", "saltSALTsaltSALTsaltSALTsaltSALTsalt", 4096,
+      "8c0511f4c6e597c6ac6315d8f0362e225f3c501495ba23b868c005174dc4ee71115b59f9e60cd9532fa33e0f75aefe30225c583a186cd82bd4daea9724a3d3b804f75bdd41494fa324cab24bcc680fb3b96a30cf5d21fac3c2875913919f3399b1d9ce7eb54c95ba49118596cf7465719bbe02c4ecab1b1541298c321d13c6f6d414c28163b051a1d313cec13a76ebdbba624eb2c742" }
+  };
+
+  std::string deriveHex(const KnownValue& known, unsigned numThreads)
+  {
+    std::string password(known.password), salt(known.salt);
+    std::vector<uint8_t> key(std::string(known.key).length() / 2);
+    if (!MessageDigestPBKDF2::deriveKey(known.algorithm, password.data(), password.length(),
+                                        salt.data(), salt.length(), known.iterations,
+                                        key.data(), key.size(), numThreads))
+      return "";
+    return MessageDigestEncoding::toHex(key.data(), key.size());
+  }
+}
+
+void MessageDigestPBKDF2Test :: setUp (void)
+{
+}
+
+void MessageDigestPBKDF2Test :: tearDown (void)
+{
+}
+
+void MessageDigestPBKDF2Test::testKnownValues()
+{
+  for (const auto& known : knownValues)
+  {
+    CPPUNIT_ASSERT(MessageDigestPBKDF2::isSupported(known.algorithm));
+    CPPUNIT_ASSERT_EQUAL(std::string(known.key),deriveHex(known, 1));
+    // several output blocks on several threads
+    CPPUNIT_ASSERT_EQUAL(std::string(known.key),deriveHex(known, 3));
+  }
+}
+
+void MessageDigestPBKDF2Test::testDeriveKeys()
+{
+  // passwords and salts longer than a block, keys of several blocks
+  const std::string passwords[] = { std::string(200, 'x'), "password", "" };
+  const std::string salts[] = { std::string(150, 's'), "salt", "" };
+  const size_t keyLength = 40;
+
+  std::vector<MessageDigestInput> passwordInputs, saltInputs;
+  for (int i = 0; i < 3; i++)
+  {
+    passwordInputs.push_back(MessageDigestInput(passwords[i].data(), passwords[i].length()));
+    saltInputs.push_back(MessageDigestInput(salts[i].data(), salts[i].length()));
+  }
+
+  std::vector<uint8_t> keys(3 * keyLength);
+  CPPUNIT_ASSERT(MessageDigestPBKDF2::deriveKeys("SHA256", passwordInputs.data(), saltInputs.data(), 3,
+                                                 3, keys.data(), keyLength, 2));
+  CPPUNIT_ASSERT_EQUAL(std::string("3d4a63bf79e4a86ea38e4ded36da703db9551ed221c252b48dbdb1e88e2583c68d4188dd0a9b9fc0"),
+                       MessageDigestEncoding::toHex(keys.data(), keyLength));
+
+  // every key equals the one derived alone
+  for (int i = 0; i < 3; i++)
+  {
+    std::vector<uint8_t> key(keyLength);
+    CPPUNIT_ASSERT(MessageDigestPBKDF2::deriveKey("SHA256", passwords[i].data(), passwords[i].length(),
+                                                  salts[i].data(), salts[i].length(), 3, key.data(), keyLength));
+    CPPUNIT_ASSERT(std::equal(key.begin(), key.end(), keys.begin() + i * keyLength));
+  }
+}
+
+void MessageDigestPBKDF2Test::testUnsupported()
+{
+  uint8_t key[16];
+  CPPUNIT_ASSERT(!MessageDigestPBKDF2::isSupported("CRC32"));
+  CPPUNIT_ASSERT(!MessageDigestPBKDF2::deriveKey("MD4", "password", 8, "salt", 4, 1, key, sizeof(key)));
+  CPPUNIT_ASSERT(!MessageDigestPBKDF2::deriveKey("SHA256", "password", 8, "salt", 4, 0, key, sizeof(key)));
+}
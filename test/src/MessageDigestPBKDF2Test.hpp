@@ -0,0 +1,27 @@
+#ifndef MessageDigest_PBKDF2Test_INCLUDED
+#define MessageDigest_PBKDF2Test_INCLUDED
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class MessageDigestPBKDF2Test : public CPPUNIT_NS :: TestFixture
+{
+  CPPUNIT_TEST_SUITE (MessageDigestPBKDF2Test);
+  CPPUNIT_TEST (testKnownValues);
+  CPPUNIT_TEST (testDeriveKeys);
+  CPPUNIT_TEST (testUnsupported);
+  CPPUNIT_TEST_SUITE_END ();
+
+public:
+  void setUp (void);
+  void tearDown (void);
+
+protected:
+  void testKnownValues (void);
+  void testDeriveKeys (void);
+  void testUnsupported (void);
+
+private:
+};
+
+#endif //MessageDigest_PBKDF2Test_INCLUDED
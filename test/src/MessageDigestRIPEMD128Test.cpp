@@ -0,0 +1,75 @@
+#include "MessageDigestRIPEMD128Test.hpp"
+#include "MessageDigest/MessageDigestRIPEMD128.hpp"
+#include "TestConstants.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestRIPEMD128Test);
+
+void MessageDigestRIPEMD128Test :: setUp (void)
+{
+}
+
+void MessageDigestRIPEMD128Test :: tearDown (void)
+{
+}
+
+void MessageDigestRIPEMD128Test :: testCallOperator (void)
+{
+  MessageDigestRIPEMD128 digestRIPEMD128;
+
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_RIPEMD128,digestRIPEMD128(TEXT1));
+  CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_RIPEMD128,digestRIPEMD128(TEXT2));
+  CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_RIPEMD128,digestRIPEMD128(TEXT3));
+  CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_RIPEMD128,digestRIPEMD128(TEXT4));
+}
+
+void MessageDigestRIPEMD128Test :: testUpdate (void)
+{
+  MessageDigestRIPEMD128 digestRIPEMD128;
+  std::string text = TEXT1;
+
+  digestRIPEMD128.update(text.c_str(),0,text.length());
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_RIPEMD128,digestRIPEMD128.digest());
+}
+
+void MessageDigestRIPEMD128Test :: testUpdateWithOffset (void)
+{
+  MessageDigestRIPEMD128 digestRIPEMD128;
+  std::string text = TEXT2;
+
+  digestRIPEMD128.update(text.c_str(),5,text.length()-5);
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_RIPEMD128,digestRIPEMD128.digest());
+}
+
+void MessageDigestRIPEMD128Test::testAvalancheEffect()
+{
+  MessageDigestRIPEMD128 digestRIPEMD128;
+
+  CPPUNIT_ASSERT_ASSERTION_FAIL( CPPUNIT_ASSERT_EQUAL( digestRIPEMD128(TEXT3),digestRIPEMD128(TEXT4) ) );
+
+}
+
+void MessageDigestRIPEMD128Test::testDigestBatch()
+{
+  // known texts, then all lengths around the padding boundaries
+  std::vector<std::string> texts = { TEXT1, TEXT2, TEXT3, TEXT4, TEXT5 };
+  for (size_t length = 0; length < 200; length++)
+    texts.push_back(std::string(length, (char) length));
+
+  std::vector<MessageDigestInput> inputs;
+  for (const auto& text : texts)
+    inputs.push_back(MessageDigestInput(text.c_str(), text.length()));
+
+  MessageDigestRIPEMD128 digestRIPEMD128;
+  std::vector<std::string> digests = digestRIPEMD128.digestBatch(inputs);
+  CPPUNIT_ASSERT_EQUAL(texts.size(), digests.size());
+
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_RIPEMD128,digests[0]);
+  CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_RIPEMD128,digests[1]);
+  CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_RIPEMD128,digests[2]);
+  CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_RIPEMD128,digests[3]);
+  CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_RIPEMD128,digests[4]);
+
+  MessageDigestRIPEMD128 reference;
+  for (size_t i = 0; i < texts.size(); i++)
+    CPPUNIT_ASSERT_EQUAL(reference(texts[i]),digests[i]);
+}
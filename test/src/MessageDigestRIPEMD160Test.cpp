@@ -0,0 +1,90 @@
+#include "MessageDigestRIPEMD160Test.hpp"
+#include "MessageDigest/MessageDigestRIPEMD160.hpp"
+#include "TestConstants.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestRIPEMD160Test);
+
+void MessageDigestRIPEMD160Test :: setUp (void)
+{
+}
+
+void MessageDigestRIPEMD160Test :: tearDown (void)
+{
+}
+
+void MessageDigestRIPEMD160Test :: testCallOperator (void)
+{
+  MessageDigestRIPEMD160 digestRIPEMD160;
+
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_RIPEMD160,digestRIPEMD160(TEXT1));
+  CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_RIPEMD160,digestRIPEMD160(TEXT2));
+  CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_RIPEMD160,digestRIPEMD160(TEXT3));
+  CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_RIPEMD160,digestRIPEMD160(TEXT4));
+}
+
+void MessageDigestRIPEMD160Test :: testUpdate (void)
+{
+  MessageDigestRIPEMD160 digestRIPEMD160;
+  std::string text = TEXT1;
+
+  digestRIPEMD160.update(text.c_str(),0,text.length());
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_RIPEMD160,digestRIPEMD160.digest());
+}
+
+void MessageDigestRIPEMD160Test :: testUpdateWithOffset (void)
+{
+  MessageDigestRIPEMD160 digestRIPEMD160;
+  std::string text = TEXT2;
+
+  digestRIPEMD160.update(text.c_str(),5,text.length()-5);
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_RIPEMD160,digestRIPEMD160.digest());
+}
+
+void MessageDigestRIPEMD160Test::testAvalancheEffect()
+{
+  MessageDigestRIPEMD160 digestRIPEMD160;
+
+  CPPUNIT_ASSERT_ASSERTION_FAIL( CPPUNIT_ASSERT_EQUAL( digestRIPEMD160(TEXT3),digestRIPEMD160(TEXT4) ) );
+
+}
+
+void MessageDigestRIPEMD160Test::testDigestBatch()
+{
+  const MessageDigestRIPEMD160::BatchKernel kernels[] = {
+    MessageDigestRIPEMD160::BatchKernel::Serial,
+    MessageDigestRIPEMD160::BatchKernel::AVX2,
+    MessageDigestRIPEMD160::BatchKernel::AVX512
+  };
+
+  // known texts, then all lengths around the padding boundaries
+  std::vector<std::string> texts = { TEXT1, TEXT2, TEXT3, TEXT4, TEXT5 };
+  for (size_t length = 0; length < 200; length++)
+    texts.push_back(std::string(length, (char) length));
+
+  std::vector<MessageDigestInput> inputs;
+  for (const auto& text : texts)
+    inputs.push_back(MessageDigestInput(text.c_str(), text.length()));
+
+  for (auto kernel : kernels)
+  {
+    MessageDigestRIPEMD160 digestRIPEMD160;
+    if (!digestRIPEMD160.setBatchKernel(kernel))
+      continue;
+
+    // a batch resets the running digest on every kernel
+    digestRIPEMD160.update(texts[0].c_str(),0,texts[0].length());
+    std::vector<std::string> digests = digestRIPEMD160.digestBatch(inputs);
+    CPPUNIT_ASSERT_EQUAL(texts.size(), digests.size());
+    CPPUNIT_ASSERT_EQUAL(MessageDigestRIPEMD160()(std::string()),digestRIPEMD160.digest());
+
+    CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_RIPEMD160,digests[0]);
+    CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_RIPEMD160,digests[1]);
+    CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_RIPEMD160,digests[2]);
+    CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_RIPEMD160,digests[3]);
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_RIPEMD160,digests[4]);
+
+    MessageDigestRIPEMD160 reference;
+    for (size_t i = 0; i < texts.size(); i++)
+      CPPUNIT_ASSERT_EQUAL(reference(texts[i]),digests[i]);
+  }
+}
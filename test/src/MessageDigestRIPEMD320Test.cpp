@@ -0,0 +1,75 @@
+#include "MessageDigestRIPEMD320Test.hpp"
+#include "MessageDigest/MessageDigestRIPEMD320.hpp"
+#include "TestConstants.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestRIPEMD320Test);
+
+void MessageDigestRIPEMD320Test :: setUp (void)
+{
+}
+
+void MessageDigestRIPEMD320Test :: tearDown (void)
+{
+}
+
+void MessageDigestRIPEMD320Test :: testCallOperator (void)
+{
+  MessageDigestRIPEMD320 digestRIPEMD320;
+
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_RIPEMD320,digestRIPEMD320(TEXT1));
+  CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_RIPEMD320,digestRIPEMD320(TEXT2));
+  CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_RIPEMD320,digestRIPEMD320(TEXT3));
+  CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_RIPEMD320,digestRIPEMD320(TEXT4));
+}
+
+void MessageDigestRIPEMD320Test :: testUpdate (void)
+{
+  MessageDigestRIPEMD320 digestRIPEMD320;
+  std::string text = TEXT1;
+
+  digestRIPEMD320.update(text.c_str(),0,text.length());
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_RIPEMD320,digestRIPEMD320.digest());
+}
+
+void MessageDigestRIPEMD320Test :: testUpdateWithOffset (void)
+{
+  MessageDigestRIPEMD320 digestRIPEMD320;
+  std::string text = TEXT2;
+
+  digestRIPEMD320.update(text.c_str(),5,text.length()-5);
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_RIPEMD320,digestRIPEMD320.digest());
+}
+
+void MessageDigestRIPEMD320Test::testAvalancheEffect()
+{
+  MessageDigestRIPEMD320 digestRIPEMD320;
+
+  CPPUNIT_ASSERT_ASSERTION_FAIL( CPPUNIT_ASSERT_EQUAL( digestRIPEMD320(TEXT3),digestRIPEMD320(TEXT4) ) );
+
+}
+
+void MessageDigestRIPEMD320Test::testDigestBatch()
+{
+  // known texts, then all lengths around the padding boundaries
+  std::vector<std::string> texts = { TEXT1, TEXT2, TEXT3, TEXT4, TEXT5 };
+  for (size_t length = 0; length < 200; length++)
+    texts.push_back(std::string(length, (char) length));
+
+  std::vector<MessageDigestInput> inputs;
+  for (const auto& text : texts)
+    inputs.push_back(MessageDigestInput(text.c_str(), text.length()));
+
+  MessageDigestRIPEMD320 digestRIPEMD320;
+  std::vector<std::string> digests = digestRIPEMD320.digestBatch(inputs);
+  CPPUNIT_ASSERT_EQUAL(texts.size(), digests.size());
+
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_RIPEMD320,digests[0]);
+  CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_RIPEMD320,digests[1]);
+  CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_RIPEMD320,digests[2]);
+  CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_RIPEMD320,digests[3]);
+  CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_RIPEMD320,digests[4]);
+
+  MessageDigestRIPEMD320 reference;
+  for (size_t i = 0; i < texts.size(); i++)
+    CPPUNIT_ASSERT_EQUAL(reference(texts[i]),digests[i]);
+}
@@ -47,3 +47,24 @@ void MessageDigestSHA1Test::testAvalancheEffect()
   CPPUNIT_ASSERT_ASSERTION_FAIL( CPPUNIT_ASSERT_EQUAL( digestSHA1(TEXT3),digestSHA1(TEXT4) ) );
 
 }
+
+void MessageDigestSHA1Test::testKernels()
+{
+  const MessageDigestSHA1::Kernel kernels[] = {
+    MessageDigestSHA1::Kernel::Generic,
+    MessageDigestSHA1::Kernel::SHANI
+  };
+
+  for (auto kernel : kernels)
+  {
+    MessageDigestSHA1 digestSHA1;
+    if (!digestSHA1.setKernel(kernel))
+      continue;
+
+    CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA1,digestSHA1(TEXT1));
+    CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHA1,digestSHA1(TEXT2));
+    CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_SHA1,digestSHA1(TEXT3));
+    CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_SHA1,digestSHA1(TEXT4));
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_SHA1,digestSHA1(TEXT5));
+  }
+}
@@ -47,3 +47,62 @@ void MessageDigestSHA224Test::testAvalancheEffect()
   CPPUNIT_ASSERT_ASSERTION_FAIL( CPPUNIT_ASSERT_EQUAL( digestSHA224(TEXT3),digestSHA224(TEXT4) ) );
 
 }
+
+void MessageDigestSHA224Test::testKernels()
+{
+  const MessageDigestSHA224::Kernel kernels[] = {
+    MessageDigestSHA224::Kernel::Generic,
+    MessageDigestSHA224::Kernel::SHANI
+  };
+
+  for (auto kernel : kernels)
+  {
+    MessageDigestSHA224 digestSHA224;
+    if (!digestSHA224.setKernel(kernel))
+      continue;
+
+    CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA224,digestSHA224(TEXT1));
+    CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHA224,digestSHA224(TEXT2));
+    CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_SHA224,digestSHA224(TEXT3));
+    CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_SHA224,digestSHA224(TEXT4));
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_SHA224,digestSHA224(TEXT5));
+  }
+}
+
+void MessageDigestSHA224Test::testDigestBatch()
+{
+  const MessageDigestSHA224::BatchKernel kernels[] = {
+    MessageDigestSHA224::BatchKernel::Serial,
+    MessageDigestSHA224::BatchKernel::AVX2,
+    MessageDigestSHA224::BatchKernel::AVX512
+  };
+
+  // known texts, then all lengths around the padding boundaries
+  std::vector<std::string> texts = { TEXT1, TEXT2, TEXT3, TEXT4, TEXT5 };
+  for (size_t length = 0; length < 200; length++)
+    texts.push_back(std::string(length, (char) length));
+
+  std::vector<MessageDigestInput> inputs;
+  for (const auto& text : texts)
+    inputs.push_back(MessageDigestInput(text.c_str(), text.length()));
+
+  for (auto kernel : kernels)
+  {
+    MessageDigestSHA224 digestSHA224;
+    if (!digestSHA224.setBatchKernel(kernel))
+      continue;
+
+    std::vector<std::string> digests = digestSHA224.digestBatch(inputs);
+    CPPUNIT_ASSERT_EQUAL(texts.size(), digests.size());
+
+    CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA224,digests[0]);
+    CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHA224,digests[1]);
+    CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_SHA224,digests[2]);
+    CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_SHA224,digests[3]);
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_SHA224,digests[4]);
+
+    MessageDigestSHA224 reference;
+    for (size_t i = 0; i < texts.size(); i++)
+      CPPUNIT_ASSERT_EQUAL(reference(texts[i]),digests[i]);
+  }
+}
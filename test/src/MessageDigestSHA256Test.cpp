@@ -1,5 +1,6 @@
 #include "MessageDigestSHA256Test.hpp"
 #include "MessageDigest/MessageDigestSHA256.hpp"
+#include "MessageDigest/MessageDigestEncoding.hpp"
 #include "TestConstants.h"
 
 CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestSHA256Test);
@@ -47,3 +48,84 @@ void MessageDigestSHA256Test::testAvalancheEffect()
   CPPUNIT_ASSERT_ASSERTION_FAIL( CPPUNIT_ASSERT_EQUAL( digestSHA256(TEXT3),digestSHA256(TEXT4) ) );
 
 }
+
+void MessageDigestSHA256Test::testKernels()
+{
+  const MessageDigestSHA256::Kernel kernels[] = {
+    MessageDigestSHA256::Kernel::Generic,
+    MessageDigestSHA256::Kernel::SHANI
+  };
+
+  for (auto kernel : kernels)
+  {
+    MessageDigestSHA256 digestSHA256;
+    if (!digestSHA256.setKernel(kernel))
+      continue;
+
+    CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA256,digestSHA256(TEXT1));
+    CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHA256,digestSHA256(TEXT2));
+    CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_SHA256,digestSHA256(TEXT3));
+    CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_SHA256,digestSHA256(TEXT4));
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_SHA256,digestSHA256(TEXT5));
+  }
+}
+
+void MessageDigestSHA256Test::testDigestBatch()
+{
+  const MessageDigestSHA256::BatchKernel kernels[] = {
+    MessageDigestSHA256::BatchKernel::Serial,
+    MessageDigestSHA256::BatchKernel::AVX2,
+    MessageDigestSHA256::BatchKernel::AVX512
+  };
+
+  // known texts, then all lengths around the padding boundaries
+  std::vector<std::string> texts = { TEXT1, TEXT2, TEXT3, TEXT4, TEXT5 };
+  for (size_t length = 0; length < 200; length++)
+    texts.push_back(std::string(length, (char) length));
+
+  std::vector<MessageDigestInput> inputs;
+  for (const auto& text : texts)
+    inputs.push_back(MessageDigestInput(text.c_str(), text.length()));
+
+  for (auto kernel : kernels)
+  {
+    MessageDigestSHA256 digestSHA256;
+    if (!digestSHA256.setBatchKernel(kernel))
+      continue;
+
+    std::vector<std::string> digests = digestSHA256.digestBatch(inputs);
+    CPPUNIT_ASSERT_EQUAL(texts.size(), digests.size());
+
+    CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA256,digests[0]);
+    CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHA256,digests[1]);
+    CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_SHA256,digests[2]);
+    CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_SHA256,digests[3]);
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_SHA256,digests[4]);
+
+    MessageDigestSHA256 reference;
+    for (size_t i = 0; i < texts.size(); i++)
+      CPPUNIT_ASSERT_EQUAL(reference(texts[i]),digests[i]);
+  }
+}
+
+void MessageDigestSHA256Test::testDigestBinary()
+{
+  static_assert(MessageDigestSize<MessageDigestSHA256>::value == 32, "SHA256 digest has 32 bytes");
+
+  MessageDigestSHA256 digestSHA256;
+  uint8_t buffer[MessageDigestSHA256::DIGEST_SIZE];
+  std::string text = TEXT1;
+
+  digestSHA256(text.c_str(),text.length(),buffer);
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA256,MessageDigestEncoding::toHex(buffer,sizeof(buffer)));
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA256,MessageDigestImpl::toHex(buffer,sizeof(buffer)));
+
+  text = TEXT2;
+  digestSHA256.reset();
+  digestSHA256.update(text.c_str(),0,text.length());
+  auto digest = digestArray(digestSHA256);
+  CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHA256,MessageDigestEncoding::toHex(digest.data(),digest.size()));
+
+  // finalization leaves the state untouched
+  CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHA256,digestSHA256.digest());
+}
@@ -0,0 +1,135 @@
+#include "MessageDigestSHA256TreeTest.hpp"
+#include "MessageDigest/MessageDigestSHA256Tree.hpp"
+#include "MessageDigest/MessageDigestSHA256.hpp"
+#include "MessageDigest/MessageDigest.hpp"
+#include "MessageDigest/MessageDigestEncoding.hpp"
+#include "TestConstants.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestSHA256TreeTest);
+
+namespace
+{
+  const size_t LeafSize = MessageDigestSHA256Tree::LEAF_SIZE;
+
+  std::string prefixed(uint8_t prefix, const std::string& data)
+  {
+    return std::string(1, (char) prefix) + data;
+  }
+
+  std::string rawSHA256(const std::string& data)
+  {
+    MessageDigestSHA256 sha256;
+    uint8_t hash[MessageDigestSHA256::DIGEST_SIZE];
+    sha256(data.data(), data.length(), hash);
+    return std::string((const char*) hash, sizeof(hash));
+  }
+
+  /// recursive definition of RFC 6962 section 2.1
+  std::string treeHash(const std::string& data)
+  {
+    if (data.length() <= LeafSize)
+      return rawSHA256(prefixed(0, data));
+
+    size_t numLeaves = (data.length() + LeafSize - 1) / LeafSize;
+    size_t split = 1;
+    while (2 * split < numLeaves)
+      split *= 2;
+
+    std::string left  = treeHash(data.substr(0, split * LeafSize));
+    std::string right = treeHash(data.substr(split * LeafSize));
+    return rawSHA256(prefixed(1, left + right));
+  }
+
+  std::string toHex(const std::string& hash)
+  {
+    return MessageDigestEncoding::toHex((const uint8_t*) hash.data(), hash.length());
+  }
+
+  std::string pattern(size_t size)
+  {
+    std::string text(size, 0);
+    for (size_t i = 0; i < size; i++)
+      text[i] = (char) (i * 7 + i / 1000);
+    return text;
+  }
+}
+
+void MessageDigestSHA256TreeTest :: setUp (void)
+{
+}
+
+void MessageDigestSHA256TreeTest :: tearDown (void)
+{
+}
+
+void MessageDigestSHA256TreeTest::testSingleLeaf()
+{
+  MessageDigestSHA256Tree digestTree;
+
+  // SHA256 of the single byte 0x00
+  CPPUNIT_ASSERT_EQUAL(std::string("6e340b9cffb37a989ca544e6bb780a2c78901d3fb33738768511a30617afa01d"),digestTree(std::string()));
+  CPPUNIT_ASSERT_EQUAL(toHex(rawSHA256(prefixed(0, TEXT1))),digestTree(TEXT1));
+
+  auto digestImpl = MessageDigest::createInstance("SHA256-TREE");
+  CPPUNIT_ASSERT_EQUAL(std::string("SHA256-TREE"),digestImpl->getAlgorithm());
+  digestImpl->update(TEXT2);
+  CPPUNIT_ASSERT_EQUAL(toHex(rawSHA256(prefixed(0, TEXT2))),digestImpl->digest());
+}
+
+void MessageDigestSHA256TreeTest::testTreeShape()
+{
+  // one and two leaves, complete and incomplete trees
+  const size_t sizes[] = { LeafSize, LeafSize + 1, 2*LeafSize, 3*LeafSize - 7, 4*LeafSize, 5*LeafSize + 3 };
+  for (size_t size : sizes)
+  {
+    std::string text = pattern(size);
+    MessageDigestSHA256Tree digestTree;
+    CPPUNIT_ASSERT_EQUAL(toHex(treeHash(text)),digestTree(text));
+  }
+}
+
+void MessageDigestSHA256TreeTest::testThreadsAndChunks()
+{
+  std::string text = pattern(7*LeafSize + 12345);
+  std::string expected = toHex(treeHash(text));
+
+  const size_t chunkSizes[] = { 1000, LeafSize - 1, 3*LeafSize, text.length() };
+  // 8 threads take more leaves per batch than are buffered from small updates
+  for (unsigned numThreads : { 1u, 2u, 3u, 8u })
+  {
+    for (size_t chunkSize : chunkSizes)
+    {
+      MessageDigestSHA256Tree digestTree;
+      digestTree.setNumThreads(numThreads);
+      std::unique_ptr<MessageDigestImpl> copy;
+
+      for (size_t offset = 0; offset < text.length(); offset += chunkSize)
+      {
+        digestTree.update(text.data(), offset, std::min(chunkSize, text.length() - offset));
+
+        // intermediate digests leave the state untouched
+        if (offset == 4*chunkSize)
+        {
+          CPPUNIT_ASSERT_EQUAL(toHex(treeHash(text.substr(0, 5*chunkSize))),digestTree.digest());
+          copy = digestTree.clone();
+        }
+      }
+      CPPUNIT_ASSERT_EQUAL(expected,digestTree.digest());
+
+      // a clone hashes with threads of its own
+      if (copy)
+      {
+        copy->update(text.data(), 5*chunkSize, text.length() - 5*chunkSize);
+        CPPUNIT_ASSERT_EQUAL(expected,copy->digest());
+      }
+    }
+  }
+
+  // fewer threads in the middle of the message
+  MessageDigestSHA256Tree digestTree;
+  digestTree.setNumThreads(4);
+  digestTree.update(text.data(), 0, 3*LeafSize);
+  digestTree.setNumThreads(1);
+  digestTree.update(text.data(), 3*LeafSize, text.length() - 3*LeafSize);
+  CPPUNIT_ASSERT_EQUAL(expected,digestTree.digest());
+}
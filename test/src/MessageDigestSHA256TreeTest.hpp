@@ -0,0 +1,27 @@
+#ifndef MessageDigest_SHA256TreeTest_INCLUDED
+#define MessageDigest_SHA256TreeTest_INCLUDED
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class MessageDigestSHA256TreeTest : public CPPUNIT_NS :: TestFixture
+{
+  CPPUNIT_TEST_SUITE (MessageDigestSHA256TreeTest);
+  CPPUNIT_TEST (testSingleLeaf);
+  CPPUNIT_TEST (testTreeShape);
+  CPPUNIT_TEST (testThreadsAndChunks);
+  CPPUNIT_TEST_SUITE_END ();
+
+public:
+  void setUp (void);
+  void tearDown (void);
+
+protected:
+  void testSingleLeaf (void);
+  void testTreeShape (void);
+  void testThreadsAndChunks (void);
+
+private:
+};
+
+#endif //MessageDigest_SHA256TreeTest_INCLUDED
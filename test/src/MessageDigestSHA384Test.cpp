@@ -0,0 +1,87 @@
+#include "MessageDigestSHA384Test.hpp"
+#include "MessageDigest/MessageDigestSHA384.hpp"
+#include "TestConstants.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestSHA384Test);
+
+void MessageDigestSHA384Test :: setUp (void)
+{
+}
+
+void MessageDigestSHA384Test :: tearDown (void)
+{
+}
+
+void MessageDigestSHA384Test :: testCallOperator (void)
+{
+  MessageDigestSHA384 digestSHA384;
+
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA384,digestSHA384(TEXT1));
+  CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHA384,digestSHA384(TEXT2));
+  CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_SHA384,digestSHA384(TEXT3));
+  CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_SHA384,digestSHA384(TEXT4));
+}
+
+void MessageDigestSHA384Test :: testUpdate (void)
+{
+  MessageDigestSHA384 digestSHA384;
+  std::string text = TEXT1;
+
+  digestSHA384.update(text.c_str(),0,text.length());
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA384,digestSHA384.digest());
+}
+
+void MessageDigestSHA384Test :: testUpdateWithOffset (void)
+{
+  MessageDigestSHA384 digestSHA384;
+  std::string text = TEXT2;
+
+  digestSHA384.update(text.c_str(),5,text.length()-5);
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA384,digestSHA384.digest());
+}
+
+void MessageDigestSHA384Test::testAvalancheEffect()
+{
+  MessageDigestSHA384 digestSHA384;
+
+  CPPUNIT_ASSERT_ASSERTION_FAIL( CPPUNIT_ASSERT_EQUAL( digestSHA384(TEXT3),digestSHA384(TEXT4) ) );
+
+}
+
+void MessageDigestSHA384Test::testDigestBatch()
+{
+  const MessageDigestSHA384::BatchKernel kernels[] = {
+    MessageDigestSHA384::BatchKernel::Serial,
+    MessageDigestSHA384::BatchKernel::AVX2,
+    MessageDigestSHA384::BatchKernel::AVX512
+  };
+
+  // known texts, then all lengths around the padding boundaries
+  std::vector<std::string> texts = { TEXT1, TEXT2, TEXT3, TEXT4, TEXT5 };
+  for (size_t length = 0; length < 200; length++)
+    texts.push_back(std::string(length, (char) length));
+
+  std::vector<MessageDigestInput> inputs;
+  for (const auto& text : texts)
+    inputs.push_back(MessageDigestInput(text.c_str(), text.length()));
+
+  for (auto kernel : kernels)
+  {
+    MessageDigestSHA384 digestSHA384;
+    if (!digestSHA384.setBatchKernel(kernel))
+      continue;
+
+    std::vector<std::string> digests = digestSHA384.digestBatch(inputs);
+    CPPUNIT_ASSERT_EQUAL(texts.size(), digests.size());
+
+    CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA384,digests[0]);
+    CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHA384,digests[1]);
+    CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_SHA384,digests[2]);
+    CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_SHA384,digests[3]);
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_SHA384,digests[4]);
+
+    MessageDigestSHA384 reference;
+    for (size_t i = 0; i < texts.size(); i++)
+      CPPUNIT_ASSERT_EQUAL(reference(texts[i]),digests[i]);
+  }
+}
@@ -0,0 +1,89 @@
+#include "MessageDigestSHA3_256Test.hpp"
+#include "MessageDigest/MessageDigestSHA3_256.hpp"
+#include "TestConstants.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestSHA3_256Test);
+
+void MessageDigestSHA3_256Test :: setUp (void)
+{
+}
+
+void MessageDigestSHA3_256Test :: tearDown (void)
+{
+}
+
+void MessageDigestSHA3_256Test :: testCallOperator (void)
+{
+  MessageDigestSHA3_256 digestSHA3_256;
+
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA3_256,digestSHA3_256(TEXT1));
+  CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHA3_256,digestSHA3_256(TEXT2));
+  CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_SHA3_256,digestSHA3_256(TEXT3));
+  CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_SHA3_256,digestSHA3_256(TEXT4));
+}
+
+void MessageDigestSHA3_256Test :: testUpdate (void)
+{
+  MessageDigestSHA3_256 digestSHA3_256;
+  std::string text = TEXT1;
+
+  digestSHA3_256.update(text.c_str(),0,text.length());
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA3_256,digestSHA3_256.digest());
+}
+
+void MessageDigestSHA3_256Test :: testUpdateWithOffset (void)
+{
+  MessageDigestSHA3_256 digestSHA3_256;
+  std::string text = TEXT2;
+
+  digestSHA3_256.update(text.c_str(),5,text.length()-5);
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA3_256,digestSHA3_256.digest());
+}
+
+void MessageDigestSHA3_256Test::testAvalancheEffect()
+{
+  MessageDigestSHA3_256 digestSHA3_256;
+
+  CPPUNIT_ASSERT_ASSERTION_FAIL( CPPUNIT_ASSERT_EQUAL( digestSHA3_256(TEXT3),digestSHA3_256(TEXT4) ) );
+
+}
+
+void MessageDigestSHA3_256Test::testDigestBatch()
+{
+  const MessageDigestSHA3_256::BatchKernel kernels[] = {
+    MessageDigestSHA3_256::BatchKernel::Serial,
+    MessageDigestSHA3_256::BatchKernel::AVX2
+  };
+
+  // known texts, then all lengths around the padding boundaries
+  std::vector<std::string> texts = { TEXT1, TEXT2, TEXT3, TEXT4, TEXT5 };
+  for (size_t length = 0; length < 200; length++)
+    texts.push_back(std::string(length, (char) length));
+
+  std::vector<MessageDigestInput> inputs;
+  for (const auto& text : texts)
+    inputs.push_back(MessageDigestInput(text.c_str(), text.length()));
+
+  for (auto kernel : kernels)
+  {
+    MessageDigestSHA3_256 digestSHA3_256;
+    if (!digestSHA3_256.setBatchKernel(kernel))
+      continue;
+
+    // a batch resets the running digest on every kernel
+    digestSHA3_256.update(texts[0].c_str(),0,texts[0].length());
+    std::vector<std::string> digests = digestSHA3_256.digestBatch(inputs);
+    CPPUNIT_ASSERT_EQUAL(texts.size(), digests.size());
+    CPPUNIT_ASSERT_EQUAL(MessageDigestSHA3_256()(std::string()),digestSHA3_256.digest());
+
+    CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA3_256,digests[0]);
+    CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHA3_256,digests[1]);
+    CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_SHA3_256,digests[2]);
+    CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_SHA3_256,digests[3]);
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_SHA3_256,digests[4]);
+
+    MessageDigestSHA3_256 reference;
+    for (size_t i = 0; i < texts.size(); i++)
+      CPPUNIT_ASSERT_EQUAL(reference(texts[i]),digests[i]);
+  }
+}
@@ -0,0 +1,86 @@
+#include "MessageDigestSHA3_384Test.hpp"
+#include "MessageDigest/MessageDigestSHA3_384.hpp"
+#include "TestConstants.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestSHA3_384Test);
+
+void MessageDigestSHA3_384Test :: setUp (void)
+{
+}
+
+void MessageDigestSHA3_384Test :: tearDown (void)
+{
+}
+
+void MessageDigestSHA3_384Test :: testCallOperator (void)
+{
+  MessageDigestSHA3_384 digestSHA3_384;
+
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA3_384,digestSHA3_384(TEXT1));
+  CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHA3_384,digestSHA3_384(TEXT2));
+  CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_SHA3_384,digestSHA3_384(TEXT3));
+  CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_SHA3_384,digestSHA3_384(TEXT4));
+}
+
+void MessageDigestSHA3_384Test :: testUpdate (void)
+{
+  MessageDigestSHA3_384 digestSHA3_384;
+  std::string text = TEXT1;
+
+  digestSHA3_384.update(text.c_str(),0,text.length());
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA3_384,digestSHA3_384.digest());
+}
+
+void MessageDigestSHA3_384Test :: testUpdateWithOffset (void)
+{
+  MessageDigestSHA3_384 digestSHA3_384;
+  std::string text = TEXT2;
+
+  digestSHA3_384.update(text.c_str(),5,text.length()-5);
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA3_384,digestSHA3_384.digest());
+}
+
+void MessageDigestSHA3_384Test::testAvalancheEffect()
+{
+  MessageDigestSHA3_384 digestSHA3_384;
+
+  CPPUNIT_ASSERT_ASSERTION_FAIL( CPPUNIT_ASSERT_EQUAL( digestSHA3_384(TEXT3),digestSHA3_384(TEXT4) ) );
+
+}
+
+void MessageDigestSHA3_384Test::testDigestBatch()
+{
+  const MessageDigestSHA3_384::BatchKernel kernels[] = {
+    MessageDigestSHA3_384::BatchKernel::Serial,
+    MessageDigestSHA3_384::BatchKernel::AVX2
+  };
+
+  // known texts, then all lengths around the padding boundaries
+  std::vector<std::string> texts = { TEXT1, TEXT2, TEXT3, TEXT4, TEXT5 };
+  for (size_t length = 0; length < 200; length++)
+    texts.push_back(std::string(length, (char) length));
+
+  std::vector<MessageDigestInput> inputs;
+  for (const auto& text : texts)
+    inputs.push_back(MessageDigestInput(text.c_str(), text.length()));
+
+  for (auto kernel : kernels)
+  {
+    MessageDigestSHA3_384 digestSHA3_384;
+    if (!digestSHA3_384.setBatchKernel(kernel))
+      continue;
+
+    std::vector<std::string> digests = digestSHA3_384.digestBatch(inputs);
+    CPPUNIT_ASSERT_EQUAL(texts.size(), digests.size());
+
+    CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA3_384,digests[0]);
+    CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHA3_384,digests[1]);
+    CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_SHA3_384,digests[2]);
+    CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_SHA3_384,digests[3]);
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_SHA3_384,digests[4]);
+
+    MessageDigestSHA3_384 reference;
+    for (size_t i = 0; i < texts.size(); i++)
+      CPPUNIT_ASSERT_EQUAL(reference(texts[i]),digests[i]);
+  }
+}
@@ -47,3 +47,41 @@ void MessageDigestSHA512Test::testAvalancheEffect()
   CPPUNIT_ASSERT_ASSERTION_FAIL( CPPUNIT_ASSERT_EQUAL( digestSHA512(TEXT3),digestSHA512(TEXT4) ) );
 
 }
+
+void MessageDigestSHA512Test::testDigestBatch()
+{
+  const MessageDigestSHA512::BatchKernel kernels[] = {
+    MessageDigestSHA512::BatchKernel::Serial,
+    MessageDigestSHA512::BatchKernel::AVX2,
+    MessageDigestSHA512::BatchKernel::AVX512
+  };
+
+  // known texts, then all lengths around the padding boundaries
+  std::vector<std::string> texts = { TEXT1, TEXT2, TEXT3, TEXT4, TEXT5 };
+  for (size_t length = 0; length < 200; length++)
+    texts.push_back(std::string(length, (char) length));
+
+  std::vector<MessageDigestInput> inputs;
+  for (const auto& text : texts)
+    inputs.push_back(MessageDigestInput(text.c_str(), text.length()));
+
+  for (auto kernel : kernels)
+  {
+    MessageDigestSHA512 digestSHA512;
+    if (!digestSHA512.setBatchKernel(kernel))
+      continue;
+
+    std::vector<std::string> digests = digestSHA512.digestBatch(inputs);
+    CPPUNIT_ASSERT_EQUAL(texts.size(), digests.size());
+
+    CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA512,digests[0]);
+    CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHA512,digests[1]);
+    CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_SHA512,digests[2]);
+    CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_SHA512,digests[3]);
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_SHA512,digests[4]);
+
+    MessageDigestSHA512 reference;
+    for (size_t i = 0; i < texts.size(); i++)
+      CPPUNIT_ASSERT_EQUAL(reference(texts[i]),digests[i]);
+  }
+}
@@ -0,0 +1,87 @@
+#include "MessageDigestSHA512_256Test.hpp"
+#include "MessageDigest/MessageDigestSHA512_256.hpp"
+#include "TestConstants.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestSHA512_256Test);
+
+void MessageDigestSHA512_256Test :: setUp (void)
+{
+}
+
+void MessageDigestSHA512_256Test :: tearDown (void)
+{
+}
+
+void MessageDigestSHA512_256Test :: testCallOperator (void)
+{
+  MessageDigestSHA512_256 digestSHA512_256;
+
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA512_256,digestSHA512_256(TEXT1));
+  CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHA512_256,digestSHA512_256(TEXT2));
+  CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_SHA512_256,digestSHA512_256(TEXT3));
+  CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_SHA512_256,digestSHA512_256(TEXT4));
+}
+
+void MessageDigestSHA512_256Test :: testUpdate (void)
+{
+  MessageDigestSHA512_256 digestSHA512_256;
+  std::string text = TEXT1;
+
+  digestSHA512_256.update(text.c_str(),0,text.length());
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA512_256,digestSHA512_256.digest());
+}
+
+void MessageDigestSHA512_256Test :: testUpdateWithOffset (void)
+{
+  MessageDigestSHA512_256 digestSHA512_256;
+  std::string text = TEXT2;
+
+  digestSHA512_256.update(text.c_str(),5,text.length()-5);
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA512_256,digestSHA512_256.digest());
+}
+
+void MessageDigestSHA512_256Test::testAvalancheEffect()
+{
+  MessageDigestSHA512_256 digestSHA512_256;
+
+  CPPUNIT_ASSERT_ASSERTION_FAIL( CPPUNIT_ASSERT_EQUAL( digestSHA512_256(TEXT3),digestSHA512_256(TEXT4) ) );
+
+}
+
+void MessageDigestSHA512_256Test::testDigestBatch()
+{
+  const MessageDigestSHA512_256::BatchKernel kernels[] = {
+    MessageDigestSHA512_256::BatchKernel::Serial,
+    MessageDigestSHA512_256::BatchKernel::AVX2,
+    MessageDigestSHA512_256::BatchKernel::AVX512
+  };
+
+  // known texts, then all lengths around the padding boundaries
+  std::vector<std::string> texts = { TEXT1, TEXT2, TEXT3, TEXT4, TEXT5 };
+  for (size_t length = 0; length < 200; length++)
+    texts.push_back(std::string(length, (char) length));
+
+  std::vector<MessageDigestInput> inputs;
+  for (const auto& text : texts)
+    inputs.push_back(MessageDigestInput(text.c_str(), text.length()));
+
+  for (auto kernel : kernels)
+  {
+    MessageDigestSHA512_256 digestSHA512_256;
+    if (!digestSHA512_256.setBatchKernel(kernel))
+      continue;
+
+    std::vector<std::string> digests = digestSHA512_256.digestBatch(inputs);
+    CPPUNIT_ASSERT_EQUAL(texts.size(), digests.size());
+
+    CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA512_256,digests[0]);
+    CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHA512_256,digests[1]);
+    CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_SHA512_256,digests[2]);
+    CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_SHA512_256,digests[3]);
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_SHA512_256,digests[4]);
+
+    MessageDigestSHA512_256 reference;
+    for (size_t i = 0; i < texts.size(); i++)
+      CPPUNIT_ASSERT_EQUAL(reference(texts[i]),digests[i]);
+  }
+}
@@ -0,0 +1,122 @@
+#include "MessageDigestSHAKE128Test.hpp"
+#include "MessageDigest/MessageDigestSHAKE128.hpp"
+#include "MessageDigest/MessageDigestEncoding.hpp"
+#include "TestConstants.h"
+
+#include <algorithm>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestSHAKE128Test);
+
+void MessageDigestSHAKE128Test :: setUp (void)
+{
+}
+
+void MessageDigestSHAKE128Test :: tearDown (void)
+{
+}
+
+void MessageDigestSHAKE128Test :: testCallOperator (void)
+{
+  MessageDigestSHAKE128 digestSHAKE128;
+
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHAKE128,digestSHAKE128(TEXT1));
+  CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHAKE128,digestSHAKE128(TEXT2));
+  CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_SHAKE128,digestSHAKE128(TEXT3));
+  CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_SHAKE128,digestSHAKE128(TEXT4));
+}
+
+void MessageDigestSHAKE128Test :: testUpdate (void)
+{
+  MessageDigestSHAKE128 digestSHAKE128;
+  std::string text = TEXT1;
+
+  digestSHAKE128.update(text.c_str(),0,text.length());
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHAKE128,digestSHAKE128.digest());
+}
+
+void MessageDigestSHAKE128Test :: testUpdateWithOffset (void)
+{
+  MessageDigestSHAKE128 digestSHAKE128;
+  std::string text = TEXT2;
+
+  digestSHAKE128.update(text.c_str(),5,text.length()-5);
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHAKE128,digestSHAKE128.digest());
+}
+
+void MessageDigestSHAKE128Test::testAvalancheEffect()
+{
+  MessageDigestSHAKE128 digestSHAKE128;
+
+  CPPUNIT_ASSERT_ASSERTION_FAIL( CPPUNIT_ASSERT_EQUAL( digestSHAKE128(TEXT3),digestSHAKE128(TEXT4) ) );
+
+}
+
+void MessageDigestSHAKE128Test::testDigestBatch()
+{
+  const MessageDigestSHAKE128::BatchKernel kernels[] = {
+    MessageDigestSHAKE128::BatchKernel::Serial,
+    MessageDigestSHAKE128::BatchKernel::AVX2
+  };
+
+  // known texts, then all lengths around the padding boundaries
+  std::vector<std::string> texts = { TEXT1, TEXT2, TEXT3, TEXT4, TEXT5 };
+  for (size_t length = 0; length < 200; length++)
+    texts.push_back(std::string(length, (char) length));
+
+  std::vector<MessageDigestInput> inputs;
+  for (const auto& text : texts)
+    inputs.push_back(MessageDigestInput(text.c_str(), text.length()));
+
+  for (auto kernel : kernels)
+  {
+    MessageDigestSHAKE128 digestSHAKE128;
+    if (!digestSHAKE128.setBatchKernel(kernel))
+      continue;
+
+    std::vector<std::string> digests = digestSHAKE128.digestBatch(inputs);
+    CPPUNIT_ASSERT_EQUAL(texts.size(), digests.size());
+
+    CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHAKE128,digests[0]);
+    CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHAKE128,digests[1]);
+    CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_SHAKE128,digests[2]);
+    CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_SHAKE128,digests[3]);
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_SHAKE128,digests[4]);
+
+    MessageDigestSHAKE128 reference;
+    for (size_t i = 0; i < texts.size(); i++)
+      CPPUNIT_ASSERT_EQUAL(reference(texts[i]),digests[i]);
+  }
+}
+
+void MessageDigestSHAKE128Test::testSqueeze()
+{
+  // 200 bytes, longer than the rate
+  const std::string expected = std::string("1a008efc7570f3c1909174c7e510abc615b7f26ab53f2e585ce8ee43d611f6b0610724f6393554587feb5d0af026183041f6")
+      + "c8c507e1f48053342769ab0ab369164b31a76a4b98cfc2330219bcba06088a1b6accb61dde130b8e7ea0c8c5795e5c914868"
+      + "e5feab0fd58617d037148012eb10f7c10eb96039b1d3be4091730b10b72d159712d4f20d7f93fcd221c6d33d23e77bbf45da"
+      + "99845d851927d2916f32cc65b101e7fee79d32bc9f4ac597229c28509ee6e99742ccbb6d968e0cebd7ff46249718d8a3bc1d";
+  MessageDigestSHAKE128 digestSHAKE128;
+  std::string text = TEXT1;
+
+  // at once and in pieces of every size, without a new instance
+  for (size_t piece = 1; piece <= 200; piece += 13)
+  {
+    digestSHAKE128.reset();
+    digestSHAKE128.update(text.c_str(),0,text.length());
+
+    std::vector<uint8_t> output(200);
+    for (size_t offset = 0; offset < output.size(); offset += piece)
+      digestSHAKE128.squeeze(output.data() + offset, std::min(piece, output.size() - offset));
+    CPPUNIT_ASSERT_EQUAL(expected,MessageDigestEncoding::toHex(output.data(), output.size()));
+  }
+
+  // digest() is the start of the output and may be longer than the rate
+  CPPUNIT_ASSERT(!digestSHAKE128.setDigestSize(0));
+  CPPUNIT_ASSERT(digestSHAKE128.setDigestSize(200));
+  CPPUNIT_ASSERT_EQUAL(expected,digestSHAKE128.digest());
+  CPPUNIT_ASSERT_EQUAL(expected.substr(0, 20),digestSHAKE128(TEXT1).substr(0, 20));
+
+  std::vector<MessageDigestInput> inputs(3, MessageDigestInput(text.c_str(), text.length()));
+  std::vector<std::string> digests = digestSHAKE128.digestBatch(inputs);
+  CPPUNIT_ASSERT_EQUAL(expected,digests[2]);
+}
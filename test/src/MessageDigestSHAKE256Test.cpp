@@ -0,0 +1,122 @@
+#include "MessageDigestSHAKE256Test.hpp"
+#include "MessageDigest/MessageDigestSHAKE256.hpp"
+#include "MessageDigest/MessageDigestEncoding.hpp"
+#include "TestConstants.h"
+
+#include <algorithm>
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestSHAKE256Test);
+
+void MessageDigestSHAKE256Test :: setUp (void)
+{
+}
+
+void MessageDigestSHAKE256Test :: tearDown (void)
+{
+}
+
+void MessageDigestSHAKE256Test :: testCallOperator (void)
+{
+  MessageDigestSHAKE256 digestSHAKE256;
+
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHAKE256,digestSHAKE256(TEXT1));
+  CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHAKE256,digestSHAKE256(TEXT2));
+  CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_SHAKE256,digestSHAKE256(TEXT3));
+  CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_SHAKE256,digestSHAKE256(TEXT4));
+}
+
+void MessageDigestSHAKE256Test :: testUpdate (void)
+{
+  MessageDigestSHAKE256 digestSHAKE256;
+  std::string text = TEXT1;
+
+  digestSHAKE256.update(text.c_str(),0,text.length());
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHAKE256,digestSHAKE256.digest());
+}
+
+void MessageDigestSHAKE256Test :: testUpdateWithOffset (void)
+{
+  MessageDigestSHAKE256 digestSHAKE256;
+  std::string text = TEXT2;
+
+  digestSHAKE256.update(text.c_str(),5,text.length()-5);
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHAKE256,digestSHAKE256.digest());
+}
+
+void MessageDigestSHAKE256Test::testAvalancheEffect()
+{
+  MessageDigestSHAKE256 digestSHAKE256;
+
+  CPPUNIT_ASSERT_ASSERTION_FAIL( CPPUNIT_ASSERT_EQUAL( digestSHAKE256(TEXT3),digestSHAKE256(TEXT4) ) );
+
+}
+
+void MessageDigestSHAKE256Test::testDigestBatch()
+{
+  const MessageDigestSHAKE256::BatchKernel kernels[] = {
+    MessageDigestSHAKE256::BatchKernel::Serial,
+    MessageDigestSHAKE256::BatchKernel::AVX2
+  };
+
+  // known texts, then all lengths around the padding boundaries
+  std::vector<std::string> texts = { TEXT1, TEXT2, TEXT3, TEXT4, TEXT5 };
+  for (size_t length = 0; length < 200; length++)
+    texts.push_back(std::string(length, (char) length));
+
+  std::vector<MessageDigestInput> inputs;
+  for (const auto& text : texts)
+    inputs.push_back(MessageDigestInput(text.c_str(), text.length()));
+
+  for (auto kernel : kernels)
+  {
+    MessageDigestSHAKE256 digestSHAKE256;
+    if (!digestSHAKE256.setBatchKernel(kernel))
+      continue;
+
+    std::vector<std::string> digests = digestSHAKE256.digestBatch(inputs);
+    CPPUNIT_ASSERT_EQUAL(texts.size(), digests.size());
+
+    CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHAKE256,digests[0]);
+    CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHAKE256,digests[1]);
+    CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_SHAKE256,digests[2]);
+    CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_SHAKE256,digests[3]);
+    CPPUNIT_ASSERT_EQUAL(TEXT5_HASH_SHAKE256,digests[4]);
+
+    MessageDigestSHAKE256 reference;
+    for (size_t i = 0; i < texts.size(); i++)
+      CPPUNIT_ASSERT_EQUAL(reference(texts[i]),digests[i]);
+  }
+}
+
+void MessageDigestSHAKE256Test::testSqueeze()
+{
+  // 200 bytes, longer than the rate
+  const std::string expected = std::string("cb600ad43a3b3f14aaa508cc10d99a548ff4d5ef4bf81eb3e3ca25678763fe3ed003036574607bff35bdffdeaf8ac0359f5b")
+      + "f97cb68453db111a62221251ea2b94bb93686aa4d9796b8c5b6c6f408b719a2121c2eda66070a8c8dae5b2eb9c0cbecdb72a"
+      + "9e8cfc4983cc9e716396aa0bc09848724185e84941b101130b9767e22710a3cbb6e01adca6353ee82368150f0b5999d7b194"
+      + "0276ded6cc89bd14774f6bb491aaf197522cfe00b90d2f81bee7e89f6f98cfc4766ad0a1516f9e27b4c4c2a18cc0fbadb36c";
+  MessageDigestSHAKE256 digestSHAKE256;
+  std::string text = TEXT1;
+
+  // at once and in pieces of every size, without a new instance
+  for (size_t piece = 1; piece <= 200; piece += 13)
+  {
+    digestSHAKE256.reset();
+    digestSHAKE256.update(text.c_str(),0,text.length());
+
+    std::vector<uint8_t> output(200);
+    for (size_t offset = 0; offset < output.size(); offset += piece)
+      digestSHAKE256.squeeze(output.data() + offset, std::min(piece, output.size() - offset));
+    CPPUNIT_ASSERT_EQUAL(expected,MessageDigestEncoding::toHex(output.data(), output.size()));
+  }
+
+  // digest() is the start of the output and may be longer than the rate
+  CPPUNIT_ASSERT(!digestSHAKE256.setDigestSize(0));
+  CPPUNIT_ASSERT(digestSHAKE256.setDigestSize(200));
+  CPPUNIT_ASSERT_EQUAL(expected,digestSHAKE256.digest());
+  CPPUNIT_ASSERT_EQUAL(expected.substr(0, 20),digestSHAKE256(TEXT1).substr(0, 20));
+
+  std::vector<MessageDigestInput> inputs(3, MessageDigestInput(text.c_str(), text.length()));
+  std::vector<std::string> digests = digestSHAKE256.digestBatch(inputs);
+  CPPUNIT_ASSERT_EQUAL(expected,digests[2]);
+}
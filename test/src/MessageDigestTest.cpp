@@ -1,7 +1,13 @@
 #include "MessageDigestTest.hpp"
 #include "MessageDigest/MessageDigest.hpp"
+#include "MessageDigest/MessageDigestEncoding.hpp"
+#include "MessageDigest/MessageDigestMD5.hpp"
 #include "TestConstants.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
 CPPUNIT_TEST_SUITE_REGISTRATION (MessageDigestTest);
 
 void MessageDigestTest :: setUp (void)
@@ -31,6 +37,25 @@ void MessageDigestTest::testCRC32Implementation()
   CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_CRC32,digestImpl->digest());
 }
 
+void MessageDigestTest::testCRC32CImplementation()
+{
+  auto digestImpl = MessageDigest::createInstance("CRC32C");
+  std::string text = TEXT2;
+
+  CPPUNIT_ASSERT_EQUAL(ALGORITHM_CRC32C,digestImpl->getAlgorithm());
+
+  digestImpl->update(TEXT1);
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_CRC32C,digestImpl->digest());
+
+  digestImpl->reset();
+  digestImpl->update(TEXT2);
+  CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_CRC32C,digestImpl->digest());
+
+  digestImpl->reset();
+  digestImpl->update(text.c_str(),5,text.length()-5);
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_CRC32C,digestImpl->digest());
+}
+
 void MessageDigestTest :: testMD5Implementation (void)
 {
   auto digestImpl = MessageDigest::createInstance("MD5");
@@ -87,3 +112,228 @@ void MessageDigestTest::testSHA256Implementation()
   digestImpl->update(text.c_str(),5,text.length()-5);
   CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA256,digestImpl->digest());
 }
+
+void MessageDigestTest::testDigestBatch()
+{
+  auto digestImpl = MessageDigest::createInstance("SHA256");
+  const std::string texts[] = { TEXT1, TEXT2, TEXT3, TEXT4 };
+
+  std::vector<MessageDigestInput> inputs;
+  for (const auto& text : texts)
+    inputs.push_back(MessageDigestInput(text.c_str(), text.length()));
+
+  std::vector<std::string> digests = digestImpl->digestBatch(inputs);
+  CPPUNIT_ASSERT_EQUAL(inputs.size(), digests.size());
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA256,digests[0]);
+  CPPUNIT_ASSERT_EQUAL(TEXT2_HASH_SHA256,digests[1]);
+  CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_SHA256,digests[2]);
+  CPPUNIT_ASSERT_EQUAL(TEXT4_HASH_SHA256,digests[3]);
+}
+
+void MessageDigestTest::testVariants()
+{
+  std::vector<std::string> variants = MessageDigest::getVariants("SHA256");
+  CPPUNIT_ASSERT(!variants.empty());
+  CPPUNIT_ASSERT_EQUAL(std::string("generic"),variants.back());
+
+  // best variant by default
+  auto digestImpl = MessageDigest::createInstance("SHA256");
+  CPPUNIT_ASSERT_EQUAL(variants.front(),digestImpl->getVariant());
+
+  for (const auto& variant : variants)
+  {
+    digestImpl = MessageDigest::createInstance("SHA256", variant);
+    CPPUNIT_ASSERT_EQUAL(variant,digestImpl->getVariant());
+
+    digestImpl->update(TEXT3);
+    CPPUNIT_ASSERT_EQUAL(TEXT3_HASH_SHA256,digestImpl->digest());
+  }
+
+  CPPUNIT_ASSERT(MessageDigest::createInstance("SHA256", "unknown") == nullptr);
+  CPPUNIT_ASSERT(MessageDigest::getVariants("unknown").empty());
+
+  // forced variant
+  CPPUNIT_ASSERT(!MessageDigest::setPreferredVariant("SHA256", "unknown"));
+  CPPUNIT_ASSERT(MessageDigest::setPreferredVariant("SHA256", "generic"));
+  CPPUNIT_ASSERT_EQUAL(std::string("generic"),MessageDigest::createInstance("SHA256")->getVariant());
+
+  CPPUNIT_ASSERT(MessageDigest::setPreferredVariant("SHA256", ""));
+  CPPUNIT_ASSERT_EQUAL(variants.front(),MessageDigest::createInstance("SHA256")->getVariant());
+}
+
+void MessageDigestTest::testDigestBinary()
+{
+  for (const auto& algorithm : MessageDigest::getAlgorithms())
+  {
+    auto digestImpl = MessageDigest::createInstance(algorithm);
+    digestImpl->update(TEXT3);
+
+    size_t digestSize = digestImpl->getDigestSize();
+    std::vector<uint8_t> buffer(digestSize + 1, 0xAA);
+    digestImpl->digestBinary(buffer.data());
+
+    // exactly getDigestSize() bytes are written, hex is their encoding
+    CPPUNIT_ASSERT_EQUAL(2*digestSize,digestImpl->digest().length());
+    CPPUNIT_ASSERT_EQUAL((uint8_t) 0xAA,buffer[digestSize]);
+    CPPUNIT_ASSERT_EQUAL(digestImpl->digest(),MessageDigestEncoding::toHex(buffer.data(),digestSize));
+  }
+}
+
+void MessageDigestTest::testDigestBatchBinary()
+{
+  // all lengths around the padding boundaries of 64 and 128 byte blocks
+  std::vector<std::string> texts;
+  for (size_t length = 0; length < 300; length++)
+    texts.push_back(std::string(length, (char) (length * 7)));
+
+  std::vector<MessageDigestInput> inputs;
+  for (const auto& text : texts)
+    inputs.push_back(MessageDigestInput(text.c_str(), text.length()));
+
+  for (const auto& algorithm : MessageDigest::getAlgorithms())
+  {
+    auto digestImpl = MessageDigest::createInstance(algorithm);
+    size_t digestSize = digestImpl->getDigestSize();
+
+    // pending data is dropped, not mixed into the first message
+    digestImpl->update(TEXT1);
+
+    std::vector<uint8_t> digests(inputs.size() * digestSize + 1, 0xAA);
+    digestImpl->digestBatch(inputs.data(), inputs.size(), digests.data());
+    CPPUNIT_ASSERT_EQUAL((uint8_t) 0xAA,digests.back());
+
+    std::vector<uint8_t> expected(digestSize);
+    for (size_t i = 0; i < texts.size(); i++)
+    {
+      digestImpl->reset();
+      digestImpl->update(texts[i]);
+      digestImpl->digestBinary(expected.data());
+      CPPUNIT_ASSERT(std::equal(expected.begin(), expected.end(), digests.begin() + i * digestSize));
+    }
+  }
+}
+
+void MessageDigestTest::testHashFile()
+{
+  const char* fileName = "MessageDigestTest.tmp";
+
+  // small files are read, large ones mapped in several windows
+  const size_t sizes[] = { 0, 17, 64*1024 - 1, 64*1024, 9*1024*1024 + 123 };
+  for (size_t size : sizes)
+  {
+    std::string text(size, 0);
+    for (size_t i = 0; i < size; i++)
+      text[i] = (char) (i * 31 + i / 4096);
+    {
+      std::ofstream file(fileName, std::ios::binary);
+      file.write(text.data(), (std::streamsize) text.length());
+    }
+
+    auto digestImpl = MessageDigest::createInstance("SHA256");
+    digestImpl->update(text);
+    CPPUNIT_ASSERT_EQUAL(digestImpl->digest(),MessageDigest::hashFile(fileName, "SHA256"));
+
+    // an empty caller buffer falls back to the internal one
+    uint8_t buffer[1];
+    auto fromFile = MessageDigest::createInstance("SHA256");
+    CPPUNIT_ASSERT(fromFile->updateFile(fileName, buffer, 0));
+    CPPUNIT_ASSERT_EQUAL(MessageDigest::hashFile(fileName, "SHA256"),fromFile->digest());
+  }
+  std::remove(fileName);
+
+  CPPUNIT_ASSERT_EQUAL(std::string(),MessageDigest::hashFile(fileName, "SHA256"));
+  CPPUNIT_ASSERT_EQUAL(std::string(),MessageDigest::hashFile("/dev/null", "unknown"));
+
+#ifndef _WIN32
+  // character devices take the read() path
+  CPPUNIT_ASSERT_EQUAL((*MessageDigestMD5::create())(std::string()),MessageDigest::hashFile("/dev/null", "MD5"));
+#endif
+  CPPUNIT_ASSERT(!MessageDigest::createInstance("MD5")->updateFile(fileName));
+}
+
+void MessageDigestTest::testExportState()
+{
+  std::string text(300, 0);
+  for (size_t i = 0; i < text.length(); i++)
+    text[i] = (char) (i * 13);
+
+  for (const auto& algorithm : MessageDigest::getAlgorithms())
+  {
+    auto reference = MessageDigest::createInstance(algorithm);
+    reference->update(text);
+    std::string expected = reference->digest();
+
+    // split inside, at and behind block boundaries
+    const size_t splits[] = { 0, 1, 63, 64, 65, 127, 128, 200 };
+    for (size_t split : splits)
+    {
+      auto first = MessageDigest::createInstance(algorithm);
+      first->update(text.c_str(), split);
+      std::vector<uint8_t> state = first->exportState();
+      if (state.empty())
+        break;
+
+      auto second = MessageDigest::createInstance(algorithm);
+      CPPUNIT_ASSERT(second->importState(state));
+      second->update(text.c_str() + split, text.length() - split);
+      CPPUNIT_ASSERT_EQUAL(expected,second->digest());
+
+      // damaged states are refused and leave the digest alone
+      auto third = MessageDigest::createInstance(algorithm);
+      third->update(text);
+      CPPUNIT_ASSERT(!third->importState(state.data(), state.size() - 1));
+      state.push_back(0);
+      CPPUNIT_ASSERT(!third->importState(state));
+      state.pop_back();
+      state[0]++;
+      CPPUNIT_ASSERT(!third->importState(state));
+      CPPUNIT_ASSERT_EQUAL(expected,third->digest());
+    }
+  }
+
+  // states of a different algorithm with the same layout don't fit
+  auto sha224 = MessageDigest::createInstance("SHA224");
+  sha224->update(TEXT1);
+  CPPUNIT_ASSERT(!MessageDigest::createInstance("SHA256")->importState(sha224->exportState()));
+  CPPUNIT_ASSERT(MessageDigest::createInstance("SHA224")->importState(sha224->exportState()));
+}
+
+void MessageDigestTest::testClone()
+{
+  const std::string prefix(100, 'p');
+
+  for (const auto& algorithm : MessageDigest::getAlgorithms())
+  {
+    auto digestImpl = MessageDigest::createInstance(algorithm);
+    digestImpl->update(prefix);
+
+    // every fork continues independently from the common prefix
+    auto slot = MessageDigest::createInstance(algorithm);
+    const std::string texts[] = { TEXT1, TEXT2, TEXT3 };
+    for (const auto& text : texts)
+    {
+      auto reference = MessageDigest::createInstance(algorithm);
+      reference->update(prefix + text);
+
+      auto copy = digestImpl->clone();
+      copy->update(text);
+      CPPUNIT_ASSERT_EQUAL(reference->digest(),copy->digest());
+      CPPUNIT_ASSERT_EQUAL(digestImpl->getVariant(),copy->getVariant());
+
+      CPPUNIT_ASSERT(digestImpl->cloneInto(*slot));
+      slot->update(text);
+      CPPUNIT_ASSERT_EQUAL(reference->digest(),slot->digest());
+    }
+
+    auto reference = MessageDigest::createInstance(algorithm);
+    reference->update(prefix);
+    CPPUNIT_ASSERT_EQUAL(reference->digest(),digestImpl->digest());
+  }
+
+  auto sha256 = MessageDigest::createInstance("SHA256");
+  auto sha224 = MessageDigest::createInstance("SHA224");
+  sha224->update(TEXT1);
+  CPPUNIT_ASSERT(!sha256->cloneInto(*sha224));
+  CPPUNIT_ASSERT(!sha224->cloneInto(*sha256));
+  CPPUNIT_ASSERT_EQUAL(TEXT1_HASH_SHA224,sha224->digest());
+}
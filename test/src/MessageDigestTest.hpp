@@ -8,9 +8,17 @@ class MessageDigestTest : public CPPUNIT_NS :: TestFixture
 {
   CPPUNIT_TEST_SUITE (MessageDigestTest);
   CPPUNIT_TEST (testCRC32Implementation);
+  CPPUNIT_TEST (testCRC32CImplementation);
   CPPUNIT_TEST (testMD5Implementation);
   CPPUNIT_TEST (testSHA1Implementation);
   CPPUNIT_TEST (testSHA256Implementation);
+  CPPUNIT_TEST (testDigestBatch);
+  CPPUNIT_TEST (testVariants);
+  CPPUNIT_TEST (testDigestBinary);
+  CPPUNIT_TEST (testDigestBatchBinary);
+  CPPUNIT_TEST (testHashFile);
+  CPPUNIT_TEST (testExportState);
+  CPPUNIT_TEST (testClone);
   CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -19,9 +27,17 @@ public:
 
 protected:
   void testCRC32Implementation (void);
+  void testCRC32CImplementation (void);
   void testMD5Implementation (void);
   void testSHA1Implementation (void);
   void testSHA256Implementation (void);
+  void testDigestBatch (void);
+  void testVariants (void);
+  void testDigestBinary (void);
+  void testDigestBatchBinary (void);
+  void testHashFile (void);
+  void testExportState (void);
+  void testClone (void);
 
 private:
 };
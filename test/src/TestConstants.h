@@ -2,62 +2,152 @@
 #define MessageDigest_TestConstants_INCLUDED
 
 #define ALGORITHM_CRC32 std::string("CRC32")
+#define ALGORITHM_CRC32C std::string("CRC32C")
 #define ALGORITHM_MD5 std::string("MD5")
 #define ALGORITHM_SHA1 std::string("SHA1")
 #define ALGORITHM_SHA224 std::string("SHA224")
 #define ALGORITHM_SHA256 std::string("SHA256")
 #define ALGORITHM_SHA384 std::string("SHA384")
 #define ALGORITHM_SHA512 std::string("SHA512")
+#define ALGORITHM_SHA512_224 std::string("SHA512/224")
+#define ALGORITHM_SHA512_256 std::string("SHA512/256")
 #define ALGORITHM_RIPEMD128 std::string("RIPEMD128")
 #define ALGORITHM_RIPEMD160 std::string("RIPEMD160")
 #define ALGORITHM_RIPEMD320 std::string("RIPEMD320")
+#define ALGORITHM_SHA3_224 std::string("SHA3-224")
+#define ALGORITHM_SHA3_256 std::string("SHA3-256")
+#define ALGORITHM_SHA3_384 std::string("SHA3-384")
+#define ALGORITHM_SHA3_512 std::string("SHA3-512")
+#define ALGORITHM_SHAKE128 std::string("SHAKE128")
+#define ALGORITHM_SHAKE256 std::string("SHAKE256")
+#define ALGORITHM_BLAKE2B std::string("BLAKE2b")
+#define ALGORITHM_BLAKE2S std::string("BLAKE2s")
+#define ALGORITHM_BLAKE2BP std::string("BLAKE2bp")
+#define ALGORITHM_BLAKE2SP std::string("BLAKE2sp")
 
 #define TEXT1 std::string("Dies ist ein Test")
 #define TEXT1_HASH_CRC32 std::string("d4293b1f")
+#define TEXT1_HASH_CRC32C std::string("cb8f013d")
 #define TEXT1_HASH_MD5 std::string("6cddeb6a2f0582c82dee9a38e3f035d7")
 #define TEXT1_HASH_SHA1 std::string("46d35759feded708ecd4ac98368f9d4d0c2b61fd")
 #define TEXT1_HASH_SHA224 std::string("766de087abd49a4b558ac2eab27b434a756aea4d54b31059a744e02a")
 #define TEXT1_HASH_SHA256 std::string("9f722959a023c02a3ba0fafdba81aded642d6610eff5dca32dce35132e16b6c5")
 #define TEXT1_HASH_SHA384 std::string("5884508006d6e5bfd1f4d1bd5f4d1cabecd9dba6e3c532d345caa4afa99b57cb34b3c5e91788f6c46c5afb39febe89a4")
 #define TEXT1_HASH_SHA512 std::string("5e600770f22af24bd3638025a71d58307967801860f9aba52cbc77a1dbea37b94434fa293ba4999b8df9917115273d489460db50e5c944774dea914f708646d8")
+#define TEXT1_HASH_SHA512_224 std::string("c486588625e06860f77b30544c6a422aaa65bd7129fe04e8e59fa7e4")
+#define TEXT1_HASH_SHA512_256 std::string("bd9100c47cd5a243820ac2b0bb9b51cc97b6406a3f3e58fdd2d41d4c2a19acd7")
 #define TEXT1_HASH_RIPEMD128 std::string("10f7367bba94a35a0363ba947db88108")
 #define TEXT1_HASH_RIPEMD160 std::string("34c05ccfd699ce7dd6fefdab10846f5041711677")
 #define TEXT1_HASH_RIPEMD320 std::string("70df37f5b1cfae597a29d0b504ab247a10243eb006eea42ee46540e2d03b498893f249ef83917a81")
+#define TEXT1_HASH_SHA3_224 std::string("8a0f1d322672e7a8cb77a200f7bec1cd72ca3c0568761aad892b82ec")
+#define TEXT1_HASH_SHA3_256 std::string("5b8144d0b2621f31eb5ff0ddaedc361c59a3e22788270fb71bb2175f2a49ebee")
+#define TEXT1_HASH_SHA3_384 std::string("269e4f1e07c79497bf3279ca9a63013d045ec038d926380ab27885128a9e189464f930c0061ccdf219b7e151e4c4a9e7")
+#define TEXT1_HASH_SHA3_512 std::string("57b407f0284d78f39e7ce917f634cfbffb0a1be6ff927c3a35d064407bceb74c0b569267328d29068871ede8ac249eae98ffedc0302e326b9b3ebee5691c5522")
+#define TEXT1_HASH_SHAKE128 std::string("1a008efc7570f3c1909174c7e510abc615b7f26ab53f2e585ce8ee43d611f6b0")
+#define TEXT1_HASH_SHAKE256 std::string("cb600ad43a3b3f14aaa508cc10d99a548ff4d5ef4bf81eb3e3ca25678763fe3ed003036574607bff35bdffdeaf8ac0359f5bf97cb68453db111a62221251ea2b")
+#define TEXT1_HASH_BLAKE2B std::string("4584ef7d8035eb0254a47763a20da4bee7ce18fb369537adcd29bd421a343efbd2b465d49353e27fac7e5c36b3ce6bb25c7bc00df57903fea584aa11206073e3")
+#define TEXT1_HASH_BLAKE2S std::string("c7990c421e02675518eb4fc76145cdf4c8006c23383f8b60c64d95856cb25f28")
+#define TEXT1_HASH_BLAKE2BP std::string("a32aa0779da9eaf73d639df61da232a803e924d8ec3b02f1b2bd1a3f21a15b04e5b2a1e10b301534c74028c348bbfb8ba8e5dbe23a97796750880ded224ed129")
+#define TEXT1_HASH_BLAKE2SP std::string("d2812dad296222bc9a4f9e3b30ef7f312ea5ad1767786cb1eb02df59697f228e")
 
 #define TEXT2 std::string("Blub Dies ist ein Test")
 #define TEXT2_HASH_CRC32 std::string("a3e55b3b")
+#define TEXT2_HASH_CRC32C std::string("dbcb4cb6")
 #define TEXT2_HASH_MD5 std::string("96f84b26452a4203b50f5620bf1e1258")
 #define TEXT2_HASH_SHA1 std::string("fd67a6bb5303b3def9dacafe5f58814484c7e76b")
 #define TEXT2_HASH_SHA224 std::string("b32422aaccf431e9688eb7ebb7984d07d58c836f01c218cf97879ba9")
 #define TEXT2_HASH_SHA256 std::string("ae348222a14b5723ab847f4031ac082586121ec9fcb9c6f8d3afb9479f17e3c9")
 #define TEXT2_HASH_SHA384 std::string("8a928cfb081ac41c688bca8cccb09d163ae649d0032e336926cde1c8102d2e33052bd4c17c70f9d85d8650317f69ea05")
 #define TEXT2_HASH_SHA512 std::string("2bae86b7bfe149ea70f95db3434b0f882c39dfde548d044b199f4dd765ed062be95475a46ddb7f8dc509a27829efbdeba550e2abd5c26d4a567a1462aec87859")
+#define TEXT2_HASH_SHA512_224 std::string("400067ef6a88de3db8fad48492df63781aa8b35957d4663a4ae9e7c2")
+#define TEXT2_HASH_SHA512_256 std::string("84a3bfd497be6c284c2f0e8c55024c7219b06ad697e32d314f9332374746f9f6")
 #define TEXT2_HASH_RIPEMD128 std::string("ed28f62aa29e359c7a5ed529272db7c0")
 #define TEXT2_HASH_RIPEMD160 std::string("bdbda4b0d5bd8a725c3cc06a18934567952492d9")
 #define TEXT2_HASH_RIPEMD320 std::string("5000b336cb58df2262b38f625ace369051b5b45a20418b0f1d9dd13e3ced491c6c73ace562259244")
+#define TEXT2_HASH_SHA3_224 std::string("da1fd103f2ee88d08e047c4afe9ed05e15d19d0030b1b4ed3df44dcf")
+#define TEXT2_HASH_SHA3_256 std::string("50afe2ffdab4e3d539dc8efeecbc104924b6048bc3f6bddeeddbc7a1a39e434a")
+#define TEXT2_HASH_SHA3_384 std::string("3f62c233e79fb34a557a8f3a5fab9b7026ae4fff82d2e274d1c708d07b7ac48665fcb52501d6287834a41a33a1456d4a")
+#define TEXT2_HASH_SHA3_512 std::string("02d2e2822f140249b1e39ba8d3c150c9986b26e85282490bd89567b1801e59be60194df62cbd88c5c2792cf8646abc52fa5fdaf4bb723691015842f152a12ade")
+#define TEXT2_HASH_SHAKE128 std::string("f582b05586fae5baa5d365ca968e016419cfe9acc170c62163378aaff711278b")
+#define TEXT2_HASH_SHAKE256 std::string("5a6ed9796897f8684f60ed9036d8bc4535d6e8a2dbb8320136565c015e33da5353edbc1eb3a082dc87310a83659e6ea46ec1d4b52aa5933cb25870477ddd5062")
+#define TEXT2_HASH_BLAKE2B std::string("7a8bed3266b86f3246247b784ccea45aa2ba9b99fe47d3e56b3b29cd78040d031ed8e60f55c93fb8a58019466827ca9f2554841ab1dffea63c66acb4e780fea4")
+#define TEXT2_HASH_BLAKE2S std::string("f9172d91964da9e9aec918f9ca5ce9fffd8c77c1dbc8d77a3b13b2f5fdc89fc5")
+#define TEXT2_HASH_BLAKE2BP std::string("695f00bd1184b815ef4da8e2afe9f34f9ce87c67c31a3eb4f808ed4790fec458806b13fbab526480984f17bf9deb5cd655521bdad3cef7a7ae0fd1c6741c5bf6")
+#define TEXT2_HASH_BLAKE2SP std::string("1de95e5f296b16862cf86930ba1c51ed2e6ab7c6d77f518bffeea16ced7dcff8")
 
 #define TEXT3 std::string("Franz jagt im komplett verwahrlosten Taxi quer durch Bayern")
 #define TEXT3_HASH_CRC32 std::string("2194f08e")
+#define TEXT3_HASH_CRC32C std::string("2b7c122a")
 #define TEXT3_HASH_MD5 std::string("a3cca2b2aa1e3b5b3b5aad99a8529074")
 #define TEXT3_HASH_SHA1 std::string("68ac906495480a3404beee4874ed853a037a7a8f")
 #define TEXT3_HASH_SHA224 std::string("49b08defa65e644cbf8a2dd9270bdededabc741997d1dadd42026d7b")
 #define TEXT3_HASH_SHA256 std::string("d32b568cd1b96d459e7291ebf4b25d007f275c9f13149beeb782fac0716613f8")
 #define TEXT3_HASH_SHA384 std::string("71e8383a4cea32d6fd6877495db2ee353542f46fa44bc23100bca48f3366b84e809f0708e81041f427c6d5219a286677")
 #define TEXT3_HASH_SHA512 std::string("af9ed2de700433b803240a552b41b5a472a6ef3fe1431a722b2063c75e9f07451f67a28e37d09cde769424c96aea6f8971389db9e1993d6c565c3c71b855723c")
+#define TEXT3_HASH_SHA512_224 std::string("52f826f405c5cfa30abb75801f03b26a72b5ffd7070fe66c8bb0695e")
+#define TEXT3_HASH_SHA512_256 std::string("d6fecccc383a17330fb2711c105d18c9ccd7fe404cd1fa7d0b4a2f7f8ebd4584")
 #define TEXT3_HASH_RIPEMD128 std::string("de8a5e5052f6fef094727267823947ed")
 #define TEXT3_HASH_RIPEMD160 std::string("f0d71163bf85f3bfe208002d9a6b15999787e810")
 #define TEXT3_HASH_RIPEMD320 std::string("291d07fa38c3a6e21501b55cc9ec4b91b1b5ec5504c2e83c2ed08591f5799360f2ef9744bc13df3a")
+#define TEXT3_HASH_SHA3_224 std::string("e3674e85c6ff5e6790e95fbc2945acfc0cf5ad60fae620a22117b368")
+#define TEXT3_HASH_SHA3_256 std::string("f72582b93018fe4a471a329287653304ab37b35b1d0e08daaee073a0799c2f80")
+#define TEXT3_HASH_SHA3_384 std::string("14dff06af50cd840d0144415d9c0e8037c2f1bec08ff023fbc55e55143103cb72f2e038bc13827c188b80f2594c2f458")
+#define TEXT3_HASH_SHA3_512 std::string("4e494c231dc6f21064a9c4a6c674adcf904dd3a86b24a2fcfc790af327027b058401f21019eed05db151c399435ed0fd7c697ca880faccee692fb7dfee4e663b")
+#define TEXT3_HASH_SHAKE128 std::string("7e11ff9bb85fcc6cd2117dc834b120f7a8fd5a4997aa34421e7fde01c14ad4b6")
+#define TEXT3_HASH_SHAKE256 std::string("af67419db79584f10a645ff45032266a69f231f31223495804f3a97e0f0b01c2b6719664882d1ac71dbc60aaf0b833a72e77ac9ff555cdeb50251d5e4191a6c5")
+#define TEXT3_HASH_BLAKE2B std::string("4d83e9599273e533d703c15ebc6b9907fa3b2cc7854fc8e79003f4b3c5c15bbca028a2d952d80f448476a8a2a0f7f477d68f0f20bef3fb581b552daf01818817")
+#define TEXT3_HASH_BLAKE2S std::string("29679260641450f45daa6214fb8a10de6bd210ad5709b6d7f42ee4a62431db40")
+#define TEXT3_HASH_BLAKE2BP std::string("2562457ba8fb6115459fd8657b536d05cd4fd1032abcf2e2db4fb093db6c68bd8f50089afb38082e2ec2e96f5ecd3f3a52de4d9943b1aa5bf6d6c462550267be")
+#define TEXT3_HASH_BLAKE2SP std::string("7b3850ccb89b0450ff8c157ffe07d400a0a9872097f0277f3a3223c7435f8257")
 
 #define TEXT4 std::string("Granz jagt im komplett verwahrlosten Taxi quer durch Bayern")
 #define TEXT4_HASH_CRC32 std::string("48d8f57f")
+#define TEXT4_HASH_CRC32C std::string("1f3d9f9e")
 #define TEXT4_HASH_MD5 std::string("fdf56a4d365ded5e048debb26b03848a")
 #define TEXT4_HASH_SHA1 std::string("89fdde0b28373dc4f361cfb810b35342cc2c3232")
 #define TEXT4_HASH_SHA224 std::string("aa71f2e010db4daf58038d15bcf33562bd79b70561169f41c2d7c1e6")
 #define TEXT4_HASH_SHA256 std::string("9022704a003ba30323e94cce1ebf6a6594a55e1e261fae1860ee003963714e11")
 #define TEXT4_HASH_SHA384 std::string("df7afeeaeb3fad2ac88baaefef778859418ffb7710b230d0b71a68d26fa5a656f9199f62cd3b1547f54cc83045e2defb")
 #define TEXT4_HASH_SHA512 std::string("ff58b19de4db5fbae2f8e956d87b651ddfe9d6e6c81f29fd9358e570bea36a942ac3877536705bab5bb16b429907b689a9e802e2c88097b54a5353d33eb0f8ba")
+#define TEXT4_HASH_SHA512_224 std::string("58d8617f263a5b2cc827b7fd97b71fc03aac992d7ba5a4034a83c71b")
+#define TEXT4_HASH_SHA512_256 std::string("22ea765e6476106d8355974a55ad8f87ef81a99b8621c72e853aff14c62400a6")
 #define TEXT4_HASH_RIPEMD128 std::string("0af94d05d58ff3f395be44909709fb23")
 #define TEXT4_HASH_RIPEMD160 std::string("da61938c537517355e770fe8526effd9a48ebaf8")
 #define TEXT4_HASH_RIPEMD320 std::string("f5df2639426ff57ba18ea25bee7fdeeb1777a7d460502f9e6060db31be4c85d280f808b0d63be41e")
+#define TEXT4_HASH_SHA3_224 std::string("a85d5199b5f5d96b2655619ac29b41a29f46779f13748904ab262256")
+#define TEXT4_HASH_SHA3_256 std::string("8d51a500552320bcb2b9eb6a7588dfc9602d842fdfab75a0b0c8c7410133f6c0")
+#define TEXT4_HASH_SHA3_384 std::string("7c7c39380a5ff4b8fedbd2d1c8491c6f57ed183799d05655fe05ee399302e31feaca17d2b79678a28d2f1a14a9551f92")
+#define TEXT4_HASH_SHA3_512 std::string("56865a190b721b311ccf3cf7bcf74ae6149d406caf11f88491cb40e0c58aaf553cfc69a1bda63ae6eb9a5d8a04fdb8755913fc0515d0914e3280a0cdae1be8bb")
+#define TEXT4_HASH_SHAKE128 std::string("21872d2a09466d78da614ce28aa99ff506578dc66f3f7dbad88b3b931f2c8c6b")
+#define TEXT4_HASH_SHAKE256 std::string("c85caf0e4667f4eaf9eaff0ff710712b8a0d951aeb8d46d0680bbfabcf7775644a144e2c3708817dbeb62a0ae3a703a39bc7f2b62b778db0e80e86da2a943081")
+#define TEXT4_HASH_BLAKE2B std::string("d383d1d0706eba280038d05320297212cb7b67a4acef5a0aa42e8812b3b533d8b617d9645eb12e6f17253610c7be611cf17011ebb6db4da0baf36c9636d4d1f0")
+#define TEXT4_HASH_BLAKE2S std::string("a84e16900058654e31f547b3cd3c5b340d6c51b3a159e5f99c9109dc9b767c57")
+#define TEXT4_HASH_BLAKE2BP std::string("5e9d2b65705affa76c32319618971b750e160258d37a5c186941102f29dba30b8dbf64211324277dd1d26fa3add10516fcd4add56b30698a5c88ae45d8fdf49e")
+#define TEXT4_HASH_BLAKE2SP std::string("8b777412a5102a683fb1ba15048f1c867fed0e51780adbe2f7146132bdd4a192")
+
+#define TEXT5 std::string(1000000,'a')
+#define TEXT5_HASH_CRC32 std::string("dc25bfbc")
+#define TEXT5_HASH_CRC32C std::string("436fe240")
+#define TEXT5_HASH_MD5 std::string("7707d6ae4e027c70eea2a935c2296f21")
+#define TEXT5_HASH_SHA1 std::string("34aa973cd4c4daa4f61eeb2bdbad27316534016f")
+#define TEXT5_HASH_SHA224 std::string("20794655980c91d8bbb4c1ea97618a4bf03f42581948b2ee4ee7ad67")
+#define TEXT5_HASH_SHA256 std::string("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0")
+#define TEXT5_HASH_SHA384 std::string("9d0e1809716474cb086e834e310a4a1ced149e9c00f248527972cec5704c2a5b07b8b3dc38ecc4ebae97ddd87f3d8985")
+#define TEXT5_HASH_SHA512 std::string("e718483d0ce769644e2e42c7bc15b4638e1f98b13b2044285632a803afa973ebde0ff244877ea60a4cb0432ce577c31beb009c5c2c49aa2e4eadb217ad8cc09b")
+#define TEXT5_HASH_SHA512_224 std::string("37ab331d76f0d36de422bd0edeb22a28accd487b7a8453ae965dd287")
+#define TEXT5_HASH_SHA512_256 std::string("9a59a052930187a97038cae692f30708aa6491923ef5194394dc68d56c74fb21")
+#define TEXT5_HASH_RIPEMD128 std::string("4a7f5723f954eba1216c9d8f6320431f")
+#define TEXT5_HASH_RIPEMD160 std::string("52783243c1697bdbe16d37f97f68f08325dc1528")
+#define TEXT5_HASH_RIPEMD320 std::string("bdee37f4371e20646b8b0d862dda16292ae36f40965e8c8509e63d1dbddecc503e2b63eb9245bb66")
+#define TEXT5_HASH_SHA3_224 std::string("d69335b93325192e516a912e6d19a15cb51c6ed5c15243e7a7fd653c")
+#define TEXT5_HASH_SHA3_256 std::string("5c8875ae474a3634ba4fd55ec85bffd661f32aca75c6d699d0cdcb6c115891c1")
+#define TEXT5_HASH_SHA3_384 std::string("eee9e24d78c1855337983451df97c8ad9eedf256c6334f8e948d252d5e0e76847aa0774ddb90a842190d2c558b4b8340")
+#define TEXT5_HASH_SHA3_512 std::string("3c3a876da14034ab60627c077bb98f7e120a2a5370212dffb3385a18d4f38859ed311d0a9d5141ce9cc5c66ee689b266a8aa18ace8282a0e0db596c90b0a7b87")
+#define TEXT5_HASH_SHAKE128 std::string("9d222c79c4ff9d092cf6ca86143aa411e369973808ef97093255826c5572ef58")
+#define TEXT5_HASH_SHAKE256 std::string("3578a7a4ca9137569cdf76ed617d31bb994fca9c1bbf8b184013de8234dfd13a3fd124d4df76c0a539ee7dd2f6e1ec346124c815d9410e145eb561bcd97b18ab")
+#define TEXT5_HASH_BLAKE2B std::string("98fb3efb7206fd19ebf69b6f312cf7b64e3b94dbe1a17107913975a793f177e1d077609d7fba363cbba00d05f7aa4e4fa8715d6428104c0a75643b0ff3fd3eaf")
+#define TEXT5_HASH_BLAKE2S std::string("bec0c0e6cde5b67acb73b81f79a67a4079ae1c60dac9d2661af18e9f8b50dfa5")
+#define TEXT5_HASH_BLAKE2BP std::string("4fd1b8c1e05baa115dbf00df2eb2d217e935f5332b55a20d018109f6b5e08009711b40ae8ff73cf94017796a5a9675dbd2b8341a13f010eb33563dd2ffbbea5e")
+#define TEXT5_HASH_BLAKE2SP std::string("106cd96590d84eede13f09f3940b8e1a7c728988f9b771f811a2f21fd768cc92")
 
 #endif //MessageDigest_TestConstants_INCLUDED
@@ -7,22 +7,68 @@ QMAKE_CXXFLAGS += -std=c++11
 
 SOURCES += \
     src/main.cpp \
+    src/MessageDigestBLAKE2bTest.cpp \
+    src/MessageDigestBLAKE2bpTest.cpp \
+    src/MessageDigestBLAKE2sTest.cpp \
+    src/MessageDigestBLAKE2spTest.cpp \
     src/MessageDigestCRC32Test.cpp \
+    src/MessageDigestCRC32CTest.cpp \
+    src/MessageDigestDirectoryTest.cpp \
+    src/MessageDigestEncodingTest.cpp \
+    src/MessageDigestFileBatchTest.cpp \
+    src/MessageDigestHMACTest.cpp \
     src/MessageDigestMD5Test.cpp \
+    src/MessageDigestPBKDF2Test.cpp \
+    src/MessageDigestRIPEMD128Test.cpp \
+    src/MessageDigestRIPEMD160Test.cpp \
+    src/MessageDigestRIPEMD320Test.cpp \
     src/MessageDigestSHA1Test.cpp \
     src/MessageDigestSHA224Test.cpp \
     src/MessageDigestSHA256Test.cpp \
+    src/MessageDigestSHA256TreeTest.cpp \
+    src/MessageDigestSHA384Test.cpp \
+    src/MessageDigestSHA3_224Test.cpp \
+    src/MessageDigestSHA3_256Test.cpp \
+    src/MessageDigestSHA3_384Test.cpp \
+    src/MessageDigestSHA3_512Test.cpp \
     src/MessageDigestSHA512Test.cpp \
+    src/MessageDigestSHA512_224Test.cpp \
+    src/MessageDigestSHA512_256Test.cpp \
+    src/MessageDigestSHAKE128Test.cpp \
+    src/MessageDigestSHAKE256Test.cpp \
     src/MessageDigestTest.cpp
 
 HEADERS += \
     src/TestConstants.h \
+    src/MessageDigestBLAKE2bTest.hpp \
+    src/MessageDigestBLAKE2bpTest.hpp \
+    src/MessageDigestBLAKE2sTest.hpp \
+    src/MessageDigestBLAKE2spTest.hpp \
     src/MessageDigestCRC32Test.hpp \
+    src/MessageDigestCRC32CTest.hpp \
+    src/MessageDigestDirectoryTest.hpp \
+    src/MessageDigestEncodingTest.hpp \
+    src/MessageDigestFileBatchTest.hpp \
+    src/MessageDigestHMACTest.hpp \
     src/MessageDigestMD5Test.hpp \
+    src/MessageDigestPBKDF2Test.hpp \
+    src/MessageDigestRIPEMD128Test.hpp \
+    src/MessageDigestRIPEMD160Test.hpp \
+    src/MessageDigestRIPEMD320Test.hpp \
     src/MessageDigestSHA1Test.hpp \
     src/MessageDigestSHA224Test.hpp \
     src/MessageDigestSHA256Test.hpp \
+    src/MessageDigestSHA256TreeTest.hpp \
+    src/MessageDigestSHA384Test.hpp \
+    src/MessageDigestSHA3_224Test.hpp \
+    src/MessageDigestSHA3_256Test.hpp \
+    src/MessageDigestSHA3_384Test.hpp \
+    src/MessageDigestSHA3_512Test.hpp \
     src/MessageDigestSHA512Test.hpp \
+    src/MessageDigestSHA512_224Test.hpp \
+    src/MessageDigestSHA512_256Test.hpp \
+    src/MessageDigestSHAKE128Test.hpp \
+    src/MessageDigestSHAKE256Test.hpp \
     src/MessageDigestTest.hpp
 
 win32:CONFIG(release, debug|release): LIBS += -L$$OUT_PWD/../library/release/ -lMessageDiggest